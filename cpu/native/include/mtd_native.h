@@ -12,6 +12,22 @@
  * @{
  * @brief       mtd flash emulation for native
  *
+ * The flash is emulated by a file that is mapped into memory on
+ * initialization, so reads and writes are plain memory accesses. Like real
+ * NOR flash, writes can only clear bits, erase sets a whole sector to `0xff`.
+ *
+ * With the `mtd_native_timing` module, every operation additionally takes the
+ * time given in mtd_native_dev_t::timing and the erase cycles of every sector
+ * are counted, so benchmarks of storage stacks on native reflect the cost of
+ * erasing and programming real flash.
+ *
+ * @ref native_sdcard_driver emulates a SD card on the same file backed
+ * storage instead: data is transferred in whole blocks of
+ * mtd_dev_t::page_size bytes, writes overwrite the old content and a single
+ * read or write command may span any number of blocks, like the multi-block
+ * commands of @ref drivers_mtd_sdcard. Use mtd_native_timing_t::cmd_us to
+ * model the fixed cost of a command of the card.
+ *
  * @file
  *
  * @author      Vincent Dupont <vincent@otakeys.com>
@@ -20,16 +36,106 @@
 #ifndef MTD_NATIVE_H
 #define MTD_NATIVE_H
 
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "mtd.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#include "mtd.h"
+/**
+ * @defgroup drivers_mtd_native_config     Native MTD compile configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Default time to issue a command in microseconds
+ *
+ * Added once per read, program or erase command, independent of the amount
+ * of data.
+ */
+#ifndef CONFIG_MTD_NATIVE_CMD_US
+#define CONFIG_MTD_NATIVE_CMD_US            (0U)
+#endif
+
+/**
+ * @brief   Default time to read a page in microseconds
+ */
+#ifndef CONFIG_MTD_NATIVE_PAGE_READ_US
+#define CONFIG_MTD_NATIVE_PAGE_READ_US      (0U)
+#endif
+
+/**
+ * @brief   Default time to program a page in microseconds
+ *
+ * Typical for a 256 byte page of SPI NOR flash.
+ */
+#ifndef CONFIG_MTD_NATIVE_PAGE_PROGRAM_US
+#define CONFIG_MTD_NATIVE_PAGE_PROGRAM_US   (700U)
+#endif
+
+/**
+ * @brief   Default time to erase a sector in microseconds
+ *
+ * Typical for a 4 KiB sector of SPI NOR flash.
+ */
+#ifndef CONFIG_MTD_NATIVE_SECTOR_ERASE_US
+#define CONFIG_MTD_NATIVE_SECTOR_ERASE_US   (45000U)
+#endif
+
+/**
+ * @brief   Default number of erase cycles after which a sector wears out
+ *
+ * 0 for unlimited erase cycles.
+ */
+#ifndef CONFIG_MTD_NATIVE_ENDURANCE
+#define CONFIG_MTD_NATIVE_ENDURANCE         (0U)
+#endif
+/** @} */
+
+/**
+ * @brief   Latency and wear model of the emulated flash
+ */
+typedef struct {
+    uint32_t cmd_us;            /**< time to issue a command in µs */
+    uint32_t page_read_us;      /**< time to read a page in µs */
+    uint32_t page_program_us;   /**< time to program a page in µs */
+    uint32_t sector_erase_us;   /**< time to erase a sector in µs */
+    /**
+     * @brief   erase cycles after which erasing a sector fails with `-EIO`,
+     *          0 for unlimited
+     */
+    uint32_t endurance;
+} mtd_native_timing_t;
+
+/**
+ * @brief   Operation counters of the emulated flash
+ */
+typedef struct {
+    uint32_t commands;          /**< number of commands issued */
+    uint32_t pages_read;        /**< number of pages read */
+    uint32_t pages_programmed;  /**< number of pages programmed */
+    uint32_t sectors_erased;    /**< number of sectors erased */
+    uint32_t max_erase_count;   /**< highest erase count of any sector */
+} mtd_native_stats_t;
 
 /** mtd native descriptor */
 typedef struct mtd_native_dev {
     mtd_dev_t dev;      /**< mtd generic device */
     const char *fname;  /**< filename to use for memory emulation */
+#if IS_USED(MODULE_MTD_NATIVE_TIMING) || defined(DOXYGEN)
+    /**
+     * @brief   latency and wear model, `NULL` for
+     *          @ref mtd_native_timing_default
+     */
+    const mtd_native_timing_t *timing;
+    mtd_native_stats_t stats;   /**< operation counters */
+    uint32_t *erase_count;      /**< erase cycles per sector */
+    uint32_t busy_until;        /**< end of a started erase in µs */
+#endif
+    uint8_t *map;       /**< the mapped file, `NULL` before initialization */
 } mtd_native_dev_t;
 
 /**
@@ -37,6 +143,37 @@ typedef struct mtd_native_dev {
  */
 extern const mtd_desc_t native_flash_driver;
 
+/**
+ * @brief Native SD card emulation driver
+ */
+extern const mtd_desc_t native_sdcard_driver;
+
+#if IS_USED(MODULE_MTD_NATIVE_TIMING) || defined(DOXYGEN)
+/**
+ * @brief   Latency and wear model from the `CONFIG_MTD_NATIVE_*` values
+ */
+extern const mtd_native_timing_t mtd_native_timing_default;
+
+/**
+ * @brief   Gets the number of times a sector was erased
+ *
+ * @param[in] dev       an initialized native MTD device
+ * @param[in] sector    a sector of @p dev
+ *
+ * @return  erase cycles of @p sector
+ */
+uint32_t mtd_native_erase_count(const mtd_native_dev_t *dev, uint32_t sector);
+
+/**
+ * @brief   Resets the operation counters of a device
+ *
+ * The erase cycles per sector are kept, as they model the wear of the flash.
+ *
+ * @param[in] dev       an initialized native MTD device
+ */
+void mtd_native_stats_reset(mtd_native_dev_t *dev);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
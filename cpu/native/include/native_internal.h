@@ -111,6 +111,12 @@ extern int (*real_getpid)(void);
 extern int (*real_gettimeofday)(struct timeval *t, ...);
 extern int (*real_ioctl)(int fildes, int request, ...);
 extern int (*real_listen)(int socket, int backlog);
+extern off_t (*real_lseek)(int fd, off_t offset, int whence);
+extern void *(*real_mmap)(void *addr, size_t length, int prot, int flags,
+                          int fd, off_t offset);
+extern int (*real_msync)(void *addr, size_t length, int flags);
+extern int (*real_munmap)(void *addr, size_t length);
+extern int (*real_ftruncate)(int fd, off_t length);
 extern int (*real_open)(const char *path, int oflag, ...);
 extern int (*real_pause)(void);
 extern int (*real_pipe)(int[2]);
@@ -18,9 +18,15 @@
 #include <stdio.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
 
 #include "mtd.h"
 #include "mtd_native.h"
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+#include "xtimer.h"
+#endif
 
 #include "native_internal.h"
 
@@ -29,27 +35,174 @@
 
 #define MIN(a, b) ((a) > (b) ? (b) : (a))
 
-static int _init(mtd_dev_t *dev)
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+const mtd_native_timing_t mtd_native_timing_default = {
+    .cmd_us = CONFIG_MTD_NATIVE_CMD_US,
+    .page_read_us = CONFIG_MTD_NATIVE_PAGE_READ_US,
+    .page_program_us = CONFIG_MTD_NATIVE_PAGE_PROGRAM_US,
+    .sector_erase_us = CONFIG_MTD_NATIVE_SECTOR_ERASE_US,
+    .endurance = CONFIG_MTD_NATIVE_ENDURANCE,
+};
+
+static inline const mtd_native_timing_t *_timing(const mtd_native_dev_t *dev)
 {
-    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    return (dev->timing != NULL) ? dev->timing : &mtd_native_timing_default;
+}
 
-    DEBUG("mtd_native: init, filename=%s\n", _dev->fname);
+static void _delay(uint32_t us)
+{
+    if (us > 0) {
+        xtimer_usleep(us);
+    }
+}
+#endif
+
+static inline size_t _mtd_size(const mtd_dev_t *dev)
+{
+    return (size_t)dev->sector_count * dev->pages_per_sector * dev->page_size;
+}
+
+static inline unsigned _pages_touched(const mtd_dev_t *dev, uint32_t addr,
+                                      uint32_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+    return ((addr + size - 1) / dev->page_size) - (addr / dev->page_size) + 1;
+}
 
-    FILE *f = real_fopen(_dev->fname, "r");
+static void _account_read(mtd_native_dev_t *dev, uint32_t addr, uint32_t size)
+{
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+    const mtd_native_timing_t *timing = _timing(dev);
+    unsigned pages = _pages_touched(&dev->dev, addr, size);
+
+    dev->stats.commands++;
+    dev->stats.pages_read += pages;
+    _delay(timing->cmd_us + pages * timing->page_read_us);
+#else
+    (void)dev;
+    (void)addr;
+    (void)size;
+#endif
+}
+
+static void _account_program(mtd_native_dev_t *dev, unsigned pages)
+{
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+    const mtd_native_timing_t *timing = _timing(dev);
+
+    dev->stats.commands++;
+    dev->stats.pages_programmed += pages;
+    _delay(timing->cmd_us + pages * timing->page_program_us);
+#else
+    (void)dev;
+    (void)pages;
+#endif
+}
+
+/* returns the time the erase takes in µs or a negative error */
+static int32_t _account_erase(mtd_native_dev_t *dev, uint32_t sector,
+                              uint32_t count)
+{
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+    const mtd_native_timing_t *timing = _timing(dev);
 
-    if (!f) {
-        DEBUG("mtd_native: init: creating file %s\n", _dev->fname);
-        f = real_fopen(_dev->fname, "w+");
-        if (!f) {
+    for (uint32_t i = sector; i < (sector + count); i++) {
+        if ((timing->endurance > 0) &&
+            (dev->erase_count[i] >= timing->endurance)) {
+            DEBUG("mtd_native: sector %" PRIu32 " worn out\n", i);
             return -EIO;
         }
-        size_t size = dev->sector_count * dev->pages_per_sector * dev->page_size;
-        for (size_t i = 0; i < size; i++) {
-            real_fputc(0xff, f);
+    }
+    for (uint32_t i = sector; i < (sector + count); i++) {
+        if (++dev->erase_count[i] > dev->stats.max_erase_count) {
+            dev->stats.max_erase_count = dev->erase_count[i];
         }
     }
+    dev->stats.commands++;
+    dev->stats.sectors_erased += count;
+    return timing->cmd_us + count * timing->sector_erase_us;
+#else
+    (void)dev;
+    (void)sector;
+    (void)count;
+    return 0;
+#endif
+}
 
-    real_fclose(f);
+/* flash can only clear bits, so AND the new data into the memory */
+static void _program(uint8_t *dst, const uint8_t *src, size_t size)
+{
+    /* handle as much as possible word-wise */
+    while (size >= sizeof(uint64_t)) {
+        uint64_t d, s;
+
+        memcpy(&d, dst, sizeof(d));
+        memcpy(&s, src, sizeof(s));
+        d &= s;
+        memcpy(dst, &d, sizeof(d));
+        dst += sizeof(d);
+        src += sizeof(s);
+        size -= sizeof(d);
+    }
+    while (size--) {
+        *(dst++) &= *(src++);
+    }
+}
+
+static int _init(mtd_dev_t *dev)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t size = _mtd_size(dev);
+    off_t file_size;
+    uint8_t *map;
+    int fd;
+
+    DEBUG("mtd_native: init, filename=%s\n", _dev->fname);
+
+    if (_dev->map != NULL) {
+        /* already mapped */
+        return 0;
+    }
+
+    _native_syscall_enter();
+    fd = real_open(_dev->fname, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        _native_syscall_leave();
+        return -EIO;
+    }
+    file_size = real_lseek(fd, 0, SEEK_END);
+    if ((file_size < 0) ||
+        (((size_t)file_size < size) && (real_ftruncate(fd, size) < 0))) {
+        real_close(fd);
+        _native_syscall_leave();
+        return -EIO;
+    }
+    map = real_mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    /* the mapping stays valid without the file descriptor */
+    real_close(fd);
+    if (map == MAP_FAILED) {
+        _native_syscall_leave();
+        return -EIO;
+    }
+    if ((size_t)file_size < size) {
+        DEBUG("mtd_native: init: erasing %u new bytes of file %s\n",
+              (unsigned)(size - file_size), _dev->fname);
+        memset(&map[file_size], 0xff, size - file_size);
+    }
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+    _dev->erase_count = real_calloc(dev->sector_count,
+                                    sizeof(*_dev->erase_count));
+    if (_dev->erase_count == NULL) {
+        real_munmap(map, size);
+        _native_syscall_leave();
+        return -ENOMEM;
+    }
+    memset(&_dev->stats, 0, sizeof(_dev->stats));
+#endif
+    _native_syscall_leave();
+    _dev->map = map;
 
     return 0;
 }
@@ -57,50 +210,40 @@ static int _init(mtd_dev_t *dev)
 static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
 
     DEBUG("mtd_native: read from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
-    if (addr + size > mtd_size) {
+    if (addr + size > _mtd_size(dev)) {
         return -EOVERFLOW;
     }
-
-    FILE *f = real_fopen(_dev->fname, "r");
-    if (!f) {
+    if (_dev->map == NULL) {
         return -EIO;
     }
-    real_fseek(f, addr, SEEK_SET);
-    size_t nread = real_fread(buff, 1, size, f);
-    real_fclose(f);
 
-    return (nread == size) ? 0 : -EIO;
+    memcpy(buff, &_dev->map[addr], size);
+    _account_read(_dev, addr, size);
+
+    return 0;
 }
 
 static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
 
     DEBUG("mtd_native: write from 0x%" PRIx32 " count %" PRIu32 "\n", addr, size);
 
-    if (addr + size > mtd_size) {
+    if (addr + size > _mtd_size(dev)) {
         return -EOVERFLOW;
     }
     if (((addr % dev->page_size) + size) > dev->page_size) {
         return -EOVERFLOW;
     }
-
-    FILE *f = real_fopen(_dev->fname, "r+");
-    if (!f) {
+    if (_dev->map == NULL) {
         return -EIO;
     }
-    real_fseek(f, addr, SEEK_SET);
-    for (size_t i = 0; i < size; i++) {
-        uint8_t c = real_fgetc(f);
-        real_fseek(f, -1, SEEK_CUR);
-        real_fputc(c & ((uint8_t*)buff)[i], f);
-    }
-    real_fclose(f);
+
+    _program(&_dev->map[addr], buff, size);
+    _account_program(_dev, 1);
 
     return 0;
 }
@@ -114,28 +257,27 @@ static int _write_page(mtd_dev_t *dev, const void *buff, uint32_t page, uint32_t
     DEBUG("mtd_native: write from page %" PRIx32 ", offset 0x%" PRIx32 " count %" PRIu32 "\n",
           page, offset, size);
 
-    if (page > dev->sector_count * dev->pages_per_sector) {
+    if (page >= dev->sector_count * dev->pages_per_sector) {
         return -EOVERFLOW;
     }
 
-    if (offset > dev->page_size) {
+    if (offset >= dev->page_size) {
         return -EOVERFLOW;
     }
+    if (_dev->map == NULL) {
+        return -EIO;
+    }
 
     uint32_t remaining = dev->page_size - offset;
     size = MIN(remaining, size);
 
-    FILE *f = real_fopen(_dev->fname, "r+");
-    if (!f) {
-        return -EIO;
+    if (size == 0) {
+        /* nothing to program, don't count it against the program limit */
+        return 0;
     }
-    real_fseek(f, addr, SEEK_SET);
-    for (size_t i = 0; i < size; i++) {
-        uint8_t c = real_fgetc(f);
-        real_fseek(f, -1, SEEK_CUR);
-        real_fputc(c & ((uint8_t*)buff)[i], f);
-    }
-    real_fclose(f);
+
+    _program(&_dev->map[addr], buff, size);
+    _account_program(_dev, 1);
 
     return size;
 }
@@ -143,39 +285,175 @@ static int _write_page(mtd_dev_t *dev, const void *buff, uint32_t page, uint32_t
 static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
     size_t sector_size = dev->pages_per_sector * dev->page_size;
+    int32_t res;
 
     DEBUG("mtd_native: erase from sector %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
-    if (addr + size > mtd_size) {
+    if (addr + size > _mtd_size(dev)) {
         return -EOVERFLOW;
     }
     if (((addr % sector_size) != 0) || ((size % sector_size) != 0)) {
         return -EOVERFLOW;
     }
+    if (_dev->map == NULL) {
+        return -EIO;
+    }
+
+    res = _account_erase(_dev, addr / sector_size, size / sector_size);
+    if (res < 0) {
+        return res;
+    }
+    memset(&_dev->map[addr], 0xff, size);
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+    _delay(res);
+#endif
+
+    return 0;
+}
+
+static int _erase_sector_start(mtd_dev_t *dev, uint32_t sector, uint32_t count,
+                               uint32_t *wait_us)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t sector_size = dev->pages_per_sector * dev->page_size;
+    int32_t res;
 
-    FILE *f = real_fopen(_dev->fname, "r+");
-    if (!f) {
+    DEBUG("mtd_native: start erase from sector %" PRIu32 " count %" PRIu32 "\n",
+          sector, count);
+
+    if (sector + count > dev->sector_count) {
+        return -EOVERFLOW;
+    }
+    if (_dev->map == NULL) {
         return -EIO;
     }
-    real_fseek(f, addr, SEEK_SET);
-    for (size_t i = 0; i < size; i++) {
-        real_fputc(0xff, f);
+
+    res = _account_erase(_dev, sector, count);
+    if (res < 0) {
+        return res;
     }
-    real_fclose(f);
+    memset(&_dev->map[sector * sector_size], 0xff, count * sector_size);
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+    /* the erased content is visible right away, but the device stays busy */
+    _dev->busy_until = xtimer_now_usec() + res;
+#endif
+    *wait_us = res;
+
+    return count;
+}
+
+static int _busy(mtd_dev_t *dev)
+{
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
 
+    return (int32_t)(_dev->busy_until - xtimer_now_usec()) > 0;
+#else
+    (void)dev;
     return 0;
+#endif
 }
 
 static int _power(mtd_dev_t *dev, enum mtd_power_state power)
 {
-    (void) dev;
-    (void) power;
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+
+    if ((power == MTD_POWER_DOWN) && (_dev->map != NULL)) {
+        /* make sure the image is complete in case RIOT is killed */
+        _native_syscall_enter();
+        real_msync(_dev->map, _mtd_size(dev), MS_SYNC);
+        _native_syscall_leave();
+        return 0;
+    }
 
     return -ENOTSUP;
 }
 
+/* SD card emulation: whole blocks only, but any number of them at once */
+static int _sd_check(mtd_dev_t *dev, uint32_t page, uint32_t offset,
+                     uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+
+    if ((offset != 0) || (size < dev->page_size)) {
+        return -ENOTSUP;
+    }
+    if (page + size / dev->page_size > dev->sector_count * dev->pages_per_sector) {
+        return -EOVERFLOW;
+    }
+    if (_dev->map == NULL) {
+        return -EIO;
+    }
+    return size / dev->page_size;
+}
+
+static int _sd_read_page(mtd_dev_t *dev, void *buff, uint32_t page,
+                         uint32_t offset, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    uint32_t addr = page * dev->page_size;
+    int blocks = _sd_check(dev, page, offset, size);
+
+    DEBUG("mtd_native: sd read from block %" PRIu32 " count %d\n", page, blocks);
+
+    if (blocks < 0) {
+        return blocks;
+    }
+
+    size = blocks * dev->page_size;
+    memcpy(buff, &_dev->map[addr], size);
+    _account_read(_dev, addr, size);
+
+    return size;
+}
+
+static int _sd_write_page(mtd_dev_t *dev, const void *buff, uint32_t page,
+                          uint32_t offset, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    int blocks = _sd_check(dev, page, offset, size);
+
+    DEBUG("mtd_native: sd write to block %" PRIu32 " count %d\n", page, blocks);
+
+    if (blocks < 0) {
+        return blocks;
+    }
+
+    size = blocks * dev->page_size;
+    memcpy(&_dev->map[page * dev->page_size], buff, size);
+    _account_program(_dev, blocks);
+
+    return size;
+}
+
+static int _sd_erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    (void)addr;
+    (void)size;
+
+    /* like mtd_sdcard: the card handles erasing internally on writes */
+    return 0;
+}
+
+#if IS_USED(MODULE_MTD_NATIVE_TIMING)
+uint32_t mtd_native_erase_count(const mtd_native_dev_t *dev, uint32_t sector)
+{
+    if ((dev->erase_count == NULL) || (sector >= dev->dev.sector_count)) {
+        return 0;
+    }
+    return dev->erase_count[sector];
+}
+
+void mtd_native_stats_reset(mtd_native_dev_t *dev)
+{
+    uint32_t max_erase_count = dev->stats.max_erase_count;
+
+    memset(&dev->stats, 0, sizeof(dev->stats));
+    dev->stats.max_erase_count = max_erase_count;
+}
+#endif
 
 const mtd_desc_t native_flash_driver = {
     .read = _read,
@@ -184,6 +462,17 @@ const mtd_desc_t native_flash_driver = {
     .write_page = _write_page,
     .erase = _erase,
     .init = _init,
+    .erase_sector_start = _erase_sector_start,
+    .busy = _busy,
+};
+
+const mtd_desc_t native_sdcard_driver = {
+    .init = _init,
+    .read_page = _sd_read_page,
+    .write_page = _sd_write_page,
+    .erase = _sd_erase,
+    .power = _power,
+    .flags = MTD_DRIVER_FLAG_DIRECT_WRITE,
 };
 
 /** @} */
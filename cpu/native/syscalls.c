@@ -76,6 +76,12 @@ int (*real_fork)(void);
 int (*real_feof)(FILE *stream);
 int (*real_ferror)(FILE *stream);
 int (*real_listen)(int socket, int backlog);
+off_t (*real_lseek)(int fd, off_t offset, int whence);
+void *(*real_mmap)(void *addr, size_t length, int prot, int flags,
+                   int fd, off_t offset);
+int (*real_msync)(void *addr, size_t length, int flags);
+int (*real_munmap)(void *addr, size_t length);
+int (*real_ftruncate)(int fd, off_t length);
 int (*real_ioctl)(int fildes, int request, ...);
 int (*real_open)(const char *path, int oflag, ...);
 int (*real_pause)(void);
@@ -476,6 +482,11 @@ void _native_init_syscalls(void)
     *(void **)(&real_execve) = dlsym(RTLD_NEXT, "execve");
     *(void **)(&real_ioctl) = dlsym(RTLD_NEXT, "ioctl");
     *(void **)(&real_listen) = dlsym(RTLD_NEXT, "listen");
+    *(void **)(&real_lseek) = dlsym(RTLD_NEXT, "lseek");
+    *(void **)(&real_mmap) = dlsym(RTLD_NEXT, "mmap");
+    *(void **)(&real_msync) = dlsym(RTLD_NEXT, "msync");
+    *(void **)(&real_munmap) = dlsym(RTLD_NEXT, "munmap");
+    *(void **)(&real_ftruncate) = dlsym(RTLD_NEXT, "ftruncate");
     *(void **)(&real_open) = dlsym(RTLD_NEXT, "open");
     *(void **)(&real_pause) = dlsym(RTLD_NEXT, "pause");
     *(void **)(&real_fopen) = dlsym(RTLD_NEXT, "fopen");
@@ -212,6 +212,39 @@ struct mtd_desc {
      */
     int (*power)(mtd_dev_t *dev, enum mtd_power_state power);
 
+    /**
+     * @brief   Start erasing sector(s) without waiting for completion
+     *
+     * Optional, used by @ref drivers_mtd_async to serve other devices while
+     * the device is erasing. The driver erases as many sectors starting at
+     * @p sector as it can with a single command. No other operation may be
+     * issued until @ref mtd_desc::busy returns 0.
+     *
+     * @param[in]  dev      Pointer to the selected driver
+     * @param[in]  sector   the first sector number to erase
+     * @param[in]  count    Number of sectors to erase
+     * @param[out] wait_us  Expected time until the erase is done in µs
+     *
+     * @return number of sectors covered by the started erase (> 0)
+     * @return < 0 value on error
+     */
+    int (*erase_sector_start)(mtd_dev_t *dev,
+                              uint32_t sector,
+                              uint32_t count,
+                              uint32_t *wait_us);
+
+    /**
+     * @brief   Check if an operation started with
+     *          @ref mtd_desc::erase_sector_start is still in progress
+     *
+     * @param[in] dev       Pointer to the selected driver
+     *
+     * @return 1 if the device is busy
+     * @return 0 if the operation is done
+     * @return < 0 value on error
+     */
+    int (*busy)(mtd_dev_t *dev);
+
     /**
      * @brief   Properties of the MTD driver
      */
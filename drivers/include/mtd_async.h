@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_async  Asynchronous MTD requests
+ * @ingroup     drivers_storage
+ * @brief       Queue MTD operations and get notified on completion
+ *
+ * All operations of the @ref drivers_mtd interface block the calling thread,
+ * e.g. for tens of milliseconds while a SPI NOR flash erases a sector. With
+ * this module, read, write and erase requests are instead queued per device
+ * and executed by a worker thread, which calls the callback of the request
+ * once it is done. The caller is free to compute or do network I/O in the
+ * meantime.
+ *
+ * If the driver implements @ref mtd_desc::erase_sector_start and
+ * @ref mtd_desc::busy (e.g. @ref drivers_mtd_spi_nor and
+ * @ref drivers_mtd_native), the worker does not block while a device erases,
+ * but continues with the requests of other devices and polls the erasing
+ * device for completion. Other drivers (e.g. @ref drivers_mtd_sdcard) are
+ * operated with their blocking functions from the worker thread.
+ *
+ * ## Usage
+ *
+ * ```
+ * USEMODULE += mtd_async
+ * ```
+ *
+ * ```
+ * static mtd_async_dev_t adev;
+ * static mtd_async_req_t req;
+ *
+ * static void _erased(mtd_async_req_t *req)
+ * {
+ *     printf("erase done: %d\n", req->res);
+ * }
+ *
+ * mtd_async_init(&adev, MTD_0);
+ * mtd_async_erase_sector(&adev, &req, 0, 4, _erased, NULL);
+ * ```
+ *
+ * The callback is executed in the worker thread. To continue in another
+ * thread, post an event or send a message from there.
+ *
+ * @warning While requests of a device are pending, the device must not be
+ *          used with the blocking MTD functions.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definitions for asynchronous MTD requests
+ */
+
+#ifndef MTD_ASYNC_H
+#define MTD_ASYNC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtd.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup drivers_mtd_async_config     Asynchronous MTD compile configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Stack size of the worker thread
+ */
+#ifndef CONFIG_MTD_ASYNC_STACKSIZE
+#define CONFIG_MTD_ASYNC_STACKSIZE      (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the worker thread
+ */
+#ifndef CONFIG_MTD_ASYNC_PRIO
+#define CONFIG_MTD_ASYNC_PRIO           (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Shortest interval to poll an erasing device in µs
+ */
+#ifndef CONFIG_MTD_ASYNC_POLL_MIN_US
+#define CONFIG_MTD_ASYNC_POLL_MIN_US    (100U)
+#endif
+/** @} */
+
+/**
+ * @brief   Operations of a request
+ */
+typedef enum {
+    MTD_ASYNC_OP_READ,          /**< @ref mtd_read_page */
+    MTD_ASYNC_OP_WRITE,         /**< @ref mtd_write_page_raw */
+    MTD_ASYNC_OP_ERASE,         /**< @ref mtd_erase_sector */
+} mtd_async_op_t;
+
+/**
+ * @brief   Forward declaration of a request
+ */
+typedef struct mtd_async_req mtd_async_req_t;
+
+/**
+ * @brief   Completion callback of a request
+ *
+ * Called in the worker thread, mtd_async_req::res holds the result.
+ * The request may be submitted again from the callback.
+ *
+ * @param[in] req   the completed request
+ */
+typedef void (*mtd_async_cb_t)(mtd_async_req_t *req);
+
+/**
+ * @brief   Asynchronous MTD request
+ */
+struct mtd_async_req {
+    mtd_async_req_t *next;      /**< next request in the device queue */
+    mtd_async_op_t op;          /**< operation */
+    void *buf;                  /**< data to write or buffer to read into */
+    uint32_t page;              /**< first page or sector */
+    uint32_t offset;            /**< byte offset in the page */
+    uint32_t count;             /**< number of bytes or sectors */
+    /**
+     * @brief   result of the operation, `-EINPROGRESS` until completion
+     */
+    int res;
+    mtd_async_cb_t cb;          /**< completion callback, may be `NULL` */
+    void *arg;                  /**< argument for the callback */
+};
+
+/**
+ * @brief   Request queue of a MTD device
+ */
+typedef struct mtd_async_dev {
+    struct mtd_async_dev *next; /**< next device served by the worker */
+    mtd_dev_t *mtd;             /**< the MTD device */
+    mtd_async_req_t *head;      /**< oldest pending request */
+    mtd_async_req_t *tail;      /**< newest pending request */
+    mtd_async_req_t *active;    /**< request in progress */
+    uint32_t erase_next;        /**< next sector to erase of mtd_async_dev::active */
+    uint32_t erase_left;        /**< sectors left to erase of mtd_async_dev::active */
+    uint32_t poll_us;           /**< time until the device is polled again */
+    bool erasing;               /**< device is busy with an erase */
+} mtd_async_dev_t;
+
+/**
+ * @brief   Registers a MTD device for asynchronous requests
+ *
+ * Starts the worker thread on first use.
+ *
+ * @param[out] adev     request queue of @p mtd
+ * @param[in]  mtd      an initialized MTD device
+ */
+void mtd_async_init(mtd_async_dev_t *adev, mtd_dev_t *mtd);
+
+/**
+ * @brief   Queues a request
+ *
+ * @param[in] adev      request queue of the device
+ * @param[in] req       request with mtd_async_req::op and the operation
+ *                      parameters set, must stay valid until completion
+ */
+void mtd_async_submit(mtd_async_dev_t *adev, mtd_async_req_t *req);
+
+/**
+ * @brief   Queues reading from a device, see @ref mtd_read_page
+ *
+ * @param[in]  adev     request queue of the device
+ * @param[in]  req      request to use
+ * @param[out] dest     the buffer to fill in
+ * @param[in]  page     page number to start reading from
+ * @param[in]  offset   offset from the start of the page (in bytes)
+ * @param[in]  size     the number of bytes to read
+ * @param[in]  cb       completion callback
+ * @param[in]  arg      argument for @p cb
+ */
+static inline void mtd_async_read_page(mtd_async_dev_t *adev,
+                                       mtd_async_req_t *req, void *dest,
+                                       uint32_t page, uint32_t offset,
+                                       uint32_t size, mtd_async_cb_t cb,
+                                       void *arg)
+{
+    req->op = MTD_ASYNC_OP_READ;
+    req->buf = dest;
+    req->page = page;
+    req->offset = offset;
+    req->count = size;
+    req->cb = cb;
+    req->arg = arg;
+    mtd_async_submit(adev, req);
+}
+
+/**
+ * @brief   Queues writing to a device, see @ref mtd_write_page_raw
+ *
+ * @param[in] adev      request queue of the device
+ * @param[in] req       request to use
+ * @param[in] src       the buffer to write, must stay valid until completion
+ * @param[in] page      page number to start writing to
+ * @param[in] offset    byte offset from the start of the page
+ * @param[in] size      the number of bytes to write
+ * @param[in] cb        completion callback
+ * @param[in] arg       argument for @p cb
+ */
+static inline void mtd_async_write_page_raw(mtd_async_dev_t *adev,
+                                            mtd_async_req_t *req,
+                                            const void *src, uint32_t page,
+                                            uint32_t offset, uint32_t size,
+                                            mtd_async_cb_t cb, void *arg)
+{
+    req->op = MTD_ASYNC_OP_WRITE;
+    req->buf = (void *)src;
+    req->page = page;
+    req->offset = offset;
+    req->count = size;
+    req->cb = cb;
+    req->arg = arg;
+    mtd_async_submit(adev, req);
+}
+
+/**
+ * @brief   Queues erasing sectors of a device, see @ref mtd_erase_sector
+ *
+ * @param[in] adev      request queue of the device
+ * @param[in] req       request to use
+ * @param[in] sector    the first sector number to erase
+ * @param[in] num       the number of sectors to erase
+ * @param[in] cb        completion callback
+ * @param[in] arg       argument for @p cb
+ */
+static inline void mtd_async_erase_sector(mtd_async_dev_t *adev,
+                                          mtd_async_req_t *req,
+                                          uint32_t sector, uint32_t num,
+                                          mtd_async_cb_t cb, void *arg)
+{
+    req->op = MTD_ASYNC_OP_ERASE;
+    req->buf = NULL;
+    req->page = sector;
+    req->offset = 0;
+    req->count = num;
+    req->cb = cb;
+    req->arg = arg;
+    mtd_async_submit(adev, req);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_ASYNC_H */
+/** @} */
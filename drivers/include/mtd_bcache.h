@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_bcache  MTD block cache with read-ahead
+ * @ingroup     drivers_storage
+ * @brief       Shared LRU read cache for MTD devices used by file systems
+ *
+ * This MTD module sits between a file system and its backing MTD device and
+ * keeps recently read blocks of @ref CONFIG_MTD_BCACHE_BLOCK_SIZE bytes in
+ * RAM. The @ref CONFIG_MTD_BCACHE_BLOCKS blocks of the cache are shared by
+ * all cache devices, so e.g. a littlefs2 and a FatFs volume compete for the
+ * same RAM and the least recently used block is replaced first.
+ *
+ * File systems re-read their metadata (littlefs2 directory pairs, the FAT
+ * and directory sectors of FatFs) much more often than the data, so walking
+ * directories or opening files hits the cache most of the time.
+ *
+ * When a block is missed right after the block before it was read, the
+ * access is considered sequential and @ref CONFIG_MTD_BCACHE_READAHEAD
+ * following blocks are read from the backing device with the same request.
+ * This turns a sequential file read into fewer, larger requests, which is
+ * much cheaper on devices with a high per-command latency like SD cards.
+ * Reads of whole blocks that are not cached go to the destination buffer
+ * directly, so a large read does not flush the metadata from the cache.
+ *
+ * Writes go through to the backing device immediately. Cached copies are
+ * updated if the backing device overwrites data (e.g. SD cards) and dropped
+ * otherwise, as are the blocks of erased sectors.
+ *
+ * ## Usage
+ *
+ * ```
+ * USEMODULE += mtd_bcache
+ * ```
+ *
+ * ```
+ * static mtd_bcache_t bcache = MTD_BCACHE_INIT(MTD_0);
+ *
+ * static littlefs2_desc_t fs_desc = {
+ *     .dev = &bcache.mtd,
+ * };
+ * ```
+ *
+ * For FatFs, the cache device is put into `fatfs_mtd_devs[]` instead of the
+ * backing device. The hit and miss counters of all cache devices are shown
+ * by the `bcache` shell command.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definitions for the MTD block cache
+ */
+
+#ifndef MTD_BCACHE_H
+#define MTD_BCACHE_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup drivers_mtd_bcache_config     MTD block cache compile configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Size of a cache block in bytes
+ *
+ * Must be a multiple of the page size of all backing devices, and the size
+ * of all backing devices must be a multiple of it.
+ */
+#ifndef CONFIG_MTD_BCACHE_BLOCK_SIZE
+#define CONFIG_MTD_BCACHE_BLOCK_SIZE    (512U)
+#endif
+
+/**
+ * @brief   Number of cache blocks shared by all cache devices
+ */
+#ifndef CONFIG_MTD_BCACHE_BLOCKS
+#define CONFIG_MTD_BCACHE_BLOCKS        (8U)
+#endif
+
+/**
+ * @brief   Number of blocks read ahead on a sequential miss, 0 to disable
+ *
+ * Must be less than @ref CONFIG_MTD_BCACHE_BLOCKS.
+ */
+#ifndef CONFIG_MTD_BCACHE_READAHEAD
+#define CONFIG_MTD_BCACHE_READAHEAD     (2U)
+#endif
+/** @} */
+
+/**
+ * @brief   Shortcut macro for initializing the members of an
+ *          @ref mtd_bcache_t struct
+ *
+ * @param[in] _parent   backing MTD device
+ */
+#define MTD_BCACHE_INIT(_parent) \
+{ \
+    .mtd = { .driver = &mtd_bcache_driver }, \
+    .parent = _parent, \
+}
+
+/**
+ * @brief   Operation counters of a cache device
+ */
+typedef struct {
+    uint32_t hits;              /**< reads served from the cache */
+    uint32_t misses;            /**< reads that loaded a block */
+    uint32_t bypassed;          /**< whole block reads past the cache */
+    uint32_t readahead;         /**< blocks loaded ahead of a read */
+    uint32_t readahead_hits;    /**< of these, blocks that were read later */
+    uint32_t evictions;         /**< valid blocks replaced */
+    uint32_t parent_reads;      /**< read requests to the backing device */
+} mtd_bcache_stats_t;
+
+/**
+ * @brief   MTD block cache device
+ */
+typedef struct mtd_bcache {
+    mtd_dev_t mtd;              /**< MTD context */
+    mtd_dev_t *parent;          /**< backing MTD device */
+    struct mtd_bcache *next;    /**< next cache device */
+    uint32_t next_block;        /**< block following the last one read */
+    mtd_bcache_stats_t stats;   /**< operation counters */
+} mtd_bcache_t;
+
+/**
+ * @brief   Block cache MTD device operations table
+ */
+extern const mtd_desc_t mtd_bcache_driver;
+
+/**
+ * @brief   Returns the first initialized cache device
+ *
+ * The others are reached through mtd_bcache_t::next.
+ *
+ * @return  the cache device initialized last, NULL if there is none
+ */
+mtd_bcache_t *mtd_bcache_get_first(void);
+
+/**
+ * @brief   Drops all cached blocks of a cache device
+ *
+ * Needed if the backing device was modified without going through the
+ * cache device.
+ *
+ * @param[in] cache     an initialized cache device
+ */
+void mtd_bcache_invalidate(mtd_bcache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_BCACHE_H */
+/** @} */
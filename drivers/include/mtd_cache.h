@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache  MTD write-back sector cache
+ * @ingroup     drivers_storage
+ * @brief       Write-back sector cache on top of another MTD device
+ *
+ * This MTD module keeps one sector of a backing MTD device in RAM. Writes to
+ * the cache device may overwrite arbitrary data, as with
+ * @ref mtd_write_page: consecutive writes to the same sector are merged in
+ * RAM and only written back to the backing device when another sector is
+ * accessed, on @ref mtd_cache_sync, on @ref mtd_power or, with the
+ * `mtd_cache_autoflush` module, @ref CONFIG_MTD_CACHE_AUTOFLUSH_MS after the
+ * sector was first modified.
+ *
+ * On write back, the sector is only erased if the modified pages differ from
+ * data that is already programmed on the backing device. If they are still
+ * erased there, only the modified pages are programmed, which saves the erase
+ * cycle as well as the time to erase the sector and to rewrite its unmodified
+ * pages. Programmed data is never programmed over, as this is not allowed on
+ * flash with ECC or double-word programming.
+ *
+ * The erase, program and merge counters in mtd_cache_t::stats allow to
+ * quantify the savings, e.g. for FatFs or a region of @ref drivers_mtd_mapper.
+ *
+ * ## Usage
+ *
+ * ```
+ * USEMODULE += mtd_cache
+ * ```
+ *
+ * ```
+ * static uint8_t cache_buf[4096];
+ * static mtd_cache_t cache = MTD_CACHE_INIT(MTD_0, cache_buf);
+ *
+ * mtd_dev_t *dev = &cache.mtd;
+ * ```
+ *
+ * The geometry of the cache device is taken from the backing device on
+ * initialization. The buffer has to hold one sector of the backing device.
+ *
+ * @warning Data that was written to the cache device is lost on a reset
+ *          before it was written back.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definitions for the MTD write-back sector cache
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "mtd.h"
+#include "mutex.h"
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+#include "event/timeout.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup drivers_mtd_cache_config     MTD cache compile configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Time after which a modified sector is written back, in ms
+ *
+ * Only used with the `mtd_cache_autoflush` module. The time is counted from
+ * the first write to a clean cache, so it bounds the time that data may only
+ * be in RAM.
+ */
+#ifndef CONFIG_MTD_CACHE_AUTOFLUSH_MS
+#define CONFIG_MTD_CACHE_AUTOFLUSH_MS   (1000U)
+#endif
+/** @} */
+
+/**
+ * @brief   Value of mtd_cache_t::sector if no sector is cached
+ */
+#define MTD_CACHE_SECTOR_NONE   (UINT32_MAX)
+
+/**
+ * @brief   Shortcut macro for initializing the members of an
+ *          @ref mtd_cache_t struct
+ *
+ * @param[in] _parent   backing MTD device
+ * @param[in] _buf      buffer of the size of a sector of @p _parent
+ */
+#define MTD_CACHE_INIT(_parent, _buf) \
+{ \
+    .mtd = { .driver = &mtd_cache_driver }, \
+    .parent = _parent, \
+    .buf = _buf, \
+    .sector = MTD_CACHE_SECTOR_NONE, \
+    .lock = MUTEX_INIT, \
+}
+
+/**
+ * @brief   Operation counters of a cache device
+ */
+typedef struct {
+    uint32_t writes;            /**< write requests to the cache device */
+    uint32_t writes_merged;     /**< writes to an already modified sector */
+    uint32_t flushes;           /**< write backs of a modified sector */
+    uint32_t erases;            /**< sectors erased on the backing device */
+    uint32_t erases_avoided;    /**< write backs that did not need an erase */
+    uint32_t pages_programmed;  /**< pages programmed on the backing device */
+} mtd_cache_stats_t;
+
+/**
+ * @brief   MTD write-back sector cache
+ */
+typedef struct {
+    mtd_dev_t mtd;              /**< MTD context */
+    mtd_dev_t *parent;          /**< backing MTD device */
+    uint8_t *buf;               /**< content of the cached sector */
+    uint32_t sector;            /**< cached sector or @ref MTD_CACHE_SECTOR_NONE */
+    uint32_t dirty_start;       /**< first modified byte in the sector */
+    uint32_t dirty_end;         /**< end of modified bytes, 0 if clean */
+    mutex_t lock;               /**< guards the cache and the parent */
+    mtd_cache_stats_t stats;    /**< operation counters */
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH) || DOXYGEN
+    event_t flush_event;        /**< write back event */
+    event_timeout_t flush_timeout;  /**< timeout for mtd_cache_t::flush_event */
+#endif
+} mtd_cache_t;
+
+/**
+ * @brief   Cache MTD device operations table
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+/**
+ * @brief   Writes the cached sector back to the backing device if modified
+ *
+ * @param[in] cache     an initialized cache device
+ *
+ * @return  0 on success
+ * @return  < 0 on error of the backing device, the sector stays cached
+ */
+int mtd_cache_sync(mtd_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
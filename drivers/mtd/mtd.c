@@ -161,6 +161,19 @@ int mtd_write_page(mtd_dev_t *mtd, const void *data, uint32_t page,
         return res;
     }
 
+    /* no need to erase if the target range is still erased */
+    const uint8_t *old = work + (page - sector_page) * mtd->page_size + offset;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        if (old[i] != 0xff) {
+            break;
+        }
+    }
+    if (i == len) {
+        return mtd_write_page_raw(mtd, data, page, offset, len);
+    }
+
     /* erase sector */
     res = mtd_erase_sector(mtd, sector, 1);
     if (res < 0) {
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_async
+ * @{
+ *
+ * @file
+ * @brief       Worker thread for asynchronous MTD requests
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtd.h"
+#include "mtd_async.h"
+#include "mutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define MIN(a, b) ((a) > (b) ? (b) : (a))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+#define FLAG_SUBMIT     (1U << 0)
+
+static char _stack[CONFIG_MTD_ASYNC_STACKSIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+/* guards the device list and the request queues */
+static mutex_t _lock = MUTEX_INIT;
+static mtd_async_dev_t *_devs;
+
+static mtd_async_req_t *_pop(mtd_async_dev_t *adev)
+{
+    mutex_lock(&_lock);
+    mtd_async_req_t *req = adev->head;
+
+    if (req != NULL) {
+        adev->head = req->next;
+        if (adev->head == NULL) {
+            adev->tail = NULL;
+        }
+    }
+    mutex_unlock(&_lock);
+    return req;
+}
+
+static void _complete(mtd_async_dev_t *adev, int res)
+{
+    mtd_async_req_t *req = adev->active;
+
+    DEBUG("mtd_async: %p: request %p done: %d\n", (void *)adev, (void *)req,
+          res);
+    adev->active = NULL;
+    req->res = res;
+    if (req->cb != NULL) {
+        req->cb(req);
+    }
+}
+
+static bool _can_start_erase(const mtd_dev_t *mtd)
+{
+    return (mtd->driver->erase_sector_start != NULL) &&
+           (mtd->driver->busy != NULL);
+}
+
+/* continues the erase of the active request, returns true on progress */
+static bool _serve_erase(mtd_async_dev_t *adev, uint32_t *wait_us)
+{
+    mtd_dev_t *mtd = adev->mtd;
+    int res;
+
+    if (adev->erasing) {
+        res = mtd->driver->busy(mtd);
+        if (res > 0) {
+            *wait_us = MIN(*wait_us, adev->poll_us);
+            /* poll more often if the erase takes longer than expected */
+            adev->poll_us = MAX(adev->poll_us / 2,
+                                CONFIG_MTD_ASYNC_POLL_MIN_US);
+            return false;
+        }
+        adev->erasing = false;
+        if (res < 0) {
+            _complete(adev, res);
+            return true;
+        }
+    }
+    if (adev->erase_left == 0) {
+        _complete(adev, 0);
+        return true;
+    }
+    if (!_can_start_erase(mtd)) {
+        _complete(adev, mtd_erase_sector(mtd, adev->erase_next,
+                                         adev->erase_left));
+        return true;
+    }
+    if ((adev->erase_next + adev->erase_left) > mtd->sector_count) {
+        _complete(adev, -EOVERFLOW);
+        return true;
+    }
+
+    uint32_t us = 0;
+
+    res = mtd->driver->erase_sector_start(mtd, adev->erase_next,
+                                          adev->erase_left, &us);
+    if (res <= 0) {
+        _complete(adev, (res < 0) ? res : -EIO);
+        return true;
+    }
+    adev->erase_next += res;
+    adev->erase_left -= res;
+    adev->erasing = true;
+    adev->poll_us = MAX(us, CONFIG_MTD_ASYNC_POLL_MIN_US);
+    *wait_us = MIN(*wait_us, adev->poll_us);
+    return true;
+}
+
+/* advances the requests of a device by one step, returns true on progress */
+static bool _serve(mtd_async_dev_t *adev, uint32_t *wait_us)
+{
+    mtd_async_req_t *req = adev->active;
+
+    if (req == NULL) {
+        req = _pop(adev);
+        if (req == NULL) {
+            return false;
+        }
+        adev->active = req;
+        switch (req->op) {
+        case MTD_ASYNC_OP_READ:
+            _complete(adev, mtd_read_page(adev->mtd, req->buf, req->page,
+                                          req->offset, req->count));
+            return true;
+        case MTD_ASYNC_OP_WRITE:
+            _complete(adev, mtd_write_page_raw(adev->mtd, req->buf,
+                                               req->page, req->offset,
+                                               req->count));
+            return true;
+        case MTD_ASYNC_OP_ERASE:
+            adev->erase_next = req->page;
+            adev->erase_left = req->count;
+            adev->erasing = false;
+            break;
+        default:
+            _complete(adev, -ENOTSUP);
+            return true;
+        }
+    }
+    return _serve_erase(adev, wait_us);
+}
+
+static void *_worker(void *arg)
+{
+    xtimer_t timer = { 0 };
+
+    (void)arg;
+    while (1) {
+        uint32_t wait_us = UINT32_MAX;
+        bool progress = false;
+
+        /* one step per device and round, so no device starves the others */
+        for (mtd_async_dev_t *adev = _devs; adev != NULL; adev = adev->next) {
+            progress |= _serve(adev, &wait_us);
+        }
+        if (progress) {
+            continue;
+        }
+        if (wait_us != UINT32_MAX) {
+            xtimer_set_timeout_flag(&timer, wait_us);
+        }
+        thread_flags_wait_any(FLAG_SUBMIT | THREAD_FLAG_TIMEOUT);
+        xtimer_remove(&timer);
+    }
+    return NULL;
+}
+
+void mtd_async_init(mtd_async_dev_t *adev, mtd_dev_t *mtd)
+{
+    adev->mtd = mtd;
+    adev->head = NULL;
+    adev->tail = NULL;
+    adev->active = NULL;
+    adev->erasing = false;
+
+    mutex_lock(&_lock);
+    adev->next = _devs;
+    _devs = adev;
+    if (_pid == KERNEL_PID_UNDEF) {
+        _pid = thread_create(_stack, sizeof(_stack), CONFIG_MTD_ASYNC_PRIO,
+                             THREAD_CREATE_STACKTEST, _worker, NULL,
+                             "mtd_async");
+    }
+    mutex_unlock(&_lock);
+}
+
+void mtd_async_submit(mtd_async_dev_t *adev, mtd_async_req_t *req)
+{
+    req->next = NULL;
+    req->res = -EINPROGRESS;
+
+    mutex_lock(&_lock);
+    if (adev->tail == NULL) {
+        adev->head = req;
+    }
+    else {
+        adev->tail->next = req;
+    }
+    adev->tail = req;
+    mutex_unlock(&_lock);
+
+    thread_flags_set(thread_get(_pid), FLAG_SUBMIT);
+}
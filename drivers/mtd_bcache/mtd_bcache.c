@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_bcache
+ * @{
+ *
+ * @file
+ * @brief       MTD block cache implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "mtd.h"
+#include "mtd_bcache.h"
+#include "mutex.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define MIN(a, b) ((a) > (b) ? (b) : (a))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+#define BLOCK_SIZE      CONFIG_MTD_BCACHE_BLOCK_SIZE
+#define BLOCK_NUM       CONFIG_MTD_BCACHE_BLOCKS
+
+#if CONFIG_MTD_BCACHE_READAHEAD >= CONFIG_MTD_BCACHE_BLOCKS
+#error "CONFIG_MTD_BCACHE_READAHEAD must be less than CONFIG_MTD_BCACHE_BLOCKS"
+#endif
+
+typedef struct {
+    mtd_bcache_t *owner;        /* NULL if the slot is unused */
+    uint32_t block;             /* block number on the owner */
+    uint32_t last_use;          /* value of _tick on the last access */
+    bool prefetched;            /* read ahead and not accessed yet */
+} _slot_t;
+
+static const mtd_desc_t _direct_driver;
+
+/* adjacent slots have adjacent data, so read-ahead is a single request */
+static uint8_t _data[BLOCK_NUM][BLOCK_SIZE];
+static _slot_t _slots[BLOCK_NUM];
+static uint32_t _tick;
+/* guards the slots and the list of cache devices */
+static mutex_t _lock = MUTEX_INIT;
+static mtd_bcache_t *_caches;
+
+static inline uint32_t _pages_per_block(const mtd_dev_t *mtd)
+{
+    return BLOCK_SIZE / mtd->page_size;
+}
+
+static inline uint32_t _block_count(const mtd_dev_t *mtd)
+{
+    return (mtd->sector_count * mtd->pages_per_sector)
+           / _pages_per_block(mtd);
+}
+
+static int _find(const mtd_bcache_t *cache, uint32_t block)
+{
+    for (unsigned i = 0; i < BLOCK_NUM; i++) {
+        if ((_slots[i].owner == cache) && (_slots[i].block == block)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void _drop(unsigned i)
+{
+    _slots[i].owner = NULL;
+    _slots[i].last_use = 0;
+}
+
+/* drops the cached blocks in [first, last] */
+static void _drop_range(const mtd_bcache_t *cache, uint32_t first,
+                        uint32_t last)
+{
+    for (unsigned i = 0; i < BLOCK_NUM; i++) {
+        if ((_slots[i].owner == cache) && (_slots[i].block >= first) &&
+            (_slots[i].block <= last)) {
+            _drop(i);
+        }
+    }
+}
+
+/* number of blocks from @p block on that are not cached, at most @p max */
+static uint32_t _uncached(const mtd_bcache_t *cache, uint32_t block,
+                          uint32_t max)
+{
+    uint32_t num = 0;
+
+    max = MIN(max, _block_count(&cache->mtd) - block);
+    while ((num < max) && (_find(cache, block + num) < 0)) {
+        num++;
+    }
+    return num;
+}
+
+/* first slot of the least recently used run of @p num adjacent slots */
+static unsigned _victim(unsigned num)
+{
+    uint32_t oldest = UINT32_MAX;
+    unsigned victim = 0;
+
+    for (unsigned i = 0; i + num <= BLOCK_NUM; i++) {
+        uint32_t newest = 0;
+
+        for (unsigned j = i; j < i + num; j++) {
+            newest = MAX(newest, _slots[j].last_use);
+        }
+        if (newest < oldest) {
+            oldest = newest;
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+/* loads @p block and up to @p readahead blocks after it, returns the slot */
+static int _load(mtd_bcache_t *cache, uint32_t block, uint32_t readahead)
+{
+    const uint32_t num = _uncached(cache, block, 1 + readahead);
+    const unsigned first = _victim(num);
+
+    for (unsigned i = first; i < first + num; i++) {
+        if (_slots[i].owner != NULL) {
+            _slots[i].owner->stats.evictions++;
+            _drop(i);
+        }
+    }
+
+    DEBUG("mtd_bcache: %p: load blocks %" PRIu32 "-%" PRIu32 " to slot %u\n",
+          (void *)cache, block, block + num - 1, first);
+    cache->stats.parent_reads++;
+    int res = mtd_read_page(cache->parent, _data[first],
+                            block * _pages_per_block(&cache->mtd), 0,
+                            num * BLOCK_SIZE);
+    if (res < 0) {
+        return res;
+    }
+
+    for (unsigned i = 0; i < num; i++) {
+        _slots[first + i].owner = cache;
+        _slots[first + i].block = block + i;
+        _slots[first + i].prefetched = (i > 0);
+        _slots[first + i].last_use = ++_tick;
+    }
+    cache->stats.readahead += num - 1;
+    return first;
+}
+
+static int _init(mtd_dev_t *mtd)
+{
+    mtd_bcache_t *cache = container_of(mtd, mtd_bcache_t, mtd);
+    mtd_dev_t *parent = cache->parent;
+    int res = mtd_init(parent);
+
+    if (res < 0) {
+        return res;
+    }
+    if ((parent->page_size > BLOCK_SIZE) ||
+        (BLOCK_SIZE % parent->page_size)) {
+        return -EINVAL;
+    }
+    /* a partial block at the end of the device could not be read */
+    if ((parent->sector_count * parent->pages_per_sector)
+        % _pages_per_block(parent)) {
+        return -EINVAL;
+    }
+
+    mtd->sector_count = parent->sector_count;
+    mtd->pages_per_sector = parent->pages_per_sector;
+    mtd->page_size = parent->page_size;
+    /* mtd_write_page() only needs to erase if the backing device does */
+    mtd->driver = (parent->driver->flags & MTD_DRIVER_FLAG_DIRECT_WRITE)
+                ? &_direct_driver : &mtd_bcache_driver;
+
+    mutex_lock(&_lock);
+    _drop_range(cache, 0, UINT32_MAX);
+    cache->next_block = UINT32_MAX;
+
+    mtd_bcache_t *c = _caches;
+    while ((c != NULL) && (c != cache)) {
+        c = c->next;
+    }
+    if (c == NULL) {
+        cache->next = _caches;
+        _caches = cache;
+    }
+    mutex_unlock(&_lock);
+
+    return 0;
+}
+
+static int _read_page(mtd_dev_t *mtd, void *dest, uint32_t page,
+                      uint32_t offset, uint32_t count)
+{
+    mtd_bcache_t *cache = container_of(mtd, mtd_bcache_t, mtd);
+    const uint32_t block = page / _pages_per_block(mtd);
+    const uint32_t pos = (page % _pages_per_block(mtd)) * mtd->page_size
+                       + offset;
+    int res;
+
+    if (block >= _block_count(mtd)) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&_lock);
+    const bool sequential = (block == cache->next_block);
+    int slot = _find(cache, block);
+
+    if ((slot < 0) && (pos == 0) && (count >= BLOCK_SIZE)) {
+        /* don't replace cached blocks by data the caller keeps anyway */
+        uint32_t num = _uncached(cache, block, count / BLOCK_SIZE);
+
+        cache->stats.parent_reads++;
+        cache->stats.bypassed += num;
+        cache->next_block = block + num;
+        res = mtd_read_page(cache->parent, dest, page, 0, num * BLOCK_SIZE);
+        mutex_unlock(&_lock);
+        return (res < 0) ? res : (int)(num * BLOCK_SIZE);
+    }
+
+    if (slot < 0) {
+        cache->stats.misses++;
+        slot = _load(cache, block,
+                     sequential ? CONFIG_MTD_BCACHE_READAHEAD : 0);
+        if (slot < 0) {
+            mutex_unlock(&_lock);
+            return slot;
+        }
+    }
+    else {
+        cache->stats.hits++;
+        if (_slots[slot].prefetched) {
+            cache->stats.readahead_hits++;
+            _slots[slot].prefetched = false;
+        }
+        _slots[slot].last_use = ++_tick;
+    }
+
+    count = MIN(count, BLOCK_SIZE - pos);
+    memcpy(dest, &_data[slot][pos], count);
+    cache->next_block = block + 1;
+    mutex_unlock(&_lock);
+
+    return count;
+}
+
+static int _write_page(mtd_dev_t *mtd, const void *src, uint32_t page,
+                       uint32_t offset, uint32_t count)
+{
+    mtd_bcache_t *cache = container_of(mtd, mtd_bcache_t, mtd);
+    const uint64_t start = (uint64_t)page * mtd->page_size + offset;
+    const uint64_t end = start + count;
+
+    if (page >= mtd->sector_count * mtd->pages_per_sector) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&_lock);
+    /* pass multi-block writes on as they are, they may be cheaper */
+    int res = mtd_write_page_raw(cache->parent, src, page, offset, count);
+
+    for (unsigned i = 0; i < BLOCK_NUM; i++) {
+        const uint64_t block_start = (uint64_t)_slots[i].block * BLOCK_SIZE;
+
+        if ((_slots[i].owner != cache) || (block_start >= end) ||
+            (block_start + BLOCK_SIZE <= start)) {
+            continue;
+        }
+        if ((res == 0) && (mtd->driver == &_direct_driver)) {
+            const uint64_t from = MAX(start, block_start);
+            const uint64_t to = MIN(end, block_start + BLOCK_SIZE);
+
+            memcpy(&_data[i][from - block_start],
+                   (const uint8_t *)src + (from - start), to - from);
+        }
+        else {
+            /* the result of programming depends on the previous content */
+            _drop(i);
+        }
+    }
+    mutex_unlock(&_lock);
+
+    return (res < 0) ? res : (int)count;
+}
+
+static int _erase_sector(mtd_dev_t *mtd, uint32_t sector, uint32_t count)
+{
+    mtd_bcache_t *cache = container_of(mtd, mtd_bcache_t, mtd);
+    const uint32_t first_page = sector * mtd->pages_per_sector;
+    const uint32_t end_page = (sector + count) * mtd->pages_per_sector;
+
+    if ((sector + count) > mtd->sector_count) {
+        return -EOVERFLOW;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    mutex_lock(&_lock);
+    int res = mtd_erase_sector(cache->parent, sector, count);
+    /* also on error, the erase may have been started */
+    _drop_range(cache, first_page / _pages_per_block(mtd),
+                (end_page - 1) / _pages_per_block(mtd));
+    mutex_unlock(&_lock);
+
+    return res;
+}
+
+static int _power(mtd_dev_t *mtd, enum mtd_power_state power)
+{
+    mtd_bcache_t *cache = container_of(mtd, mtd_bcache_t, mtd);
+
+    return mtd_power(cache->parent, power);
+}
+
+mtd_bcache_t *mtd_bcache_get_first(void)
+{
+    return _caches;
+}
+
+void mtd_bcache_invalidate(mtd_bcache_t *cache)
+{
+    mutex_lock(&_lock);
+    _drop_range(cache, 0, UINT32_MAX);
+    cache->next_block = UINT32_MAX;
+    mutex_unlock(&_lock);
+}
+
+const mtd_desc_t mtd_bcache_driver = {
+    .init = _init,
+    .read_page = _read_page,
+    .write_page = _write_page,
+    .erase_sector = _erase_sector,
+    .power = _power,
+};
+
+static const mtd_desc_t _direct_driver = {
+    .init = _init,
+    .read_page = _read_page,
+    .write_page = _write_page,
+    .erase_sector = _erase_sector,
+    .power = _power,
+    .flags = MTD_DRIVER_FLAG_DIRECT_WRITE,
+};
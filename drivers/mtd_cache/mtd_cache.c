@@ -0,0 +1,382 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       MTD write-back sector cache implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "mutex.h"
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+#include "event/thread.h"
+#include "timex.h"
+#endif
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define MIN(a, b) ((a) > (b) ? (b) : (a))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/* bytes of the backing device compared at once on write back */
+#define CMP_CHUNK_SIZE      (32U)
+
+/* results of _compare() */
+#define CMP_DIFFERS         (1 << 0)
+#define CMP_PROGRAMMED      (1 << 1)
+
+static inline uint32_t _sector_size(const mtd_dev_t *mtd)
+{
+    return mtd->pages_per_sector * mtd->page_size;
+}
+
+static inline bool _is_dirty(const mtd_cache_t *cache)
+{
+    return cache->dirty_end > 0;
+}
+
+static void _mark_dirty(mtd_cache_t *cache, uint32_t start, uint32_t end)
+{
+    if (_is_dirty(cache)) {
+        cache->dirty_start = MIN(cache->dirty_start, start);
+        cache->dirty_end = MAX(cache->dirty_end, end);
+        return;
+    }
+    cache->dirty_start = start;
+    cache->dirty_end = end;
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+    event_timeout_set(&cache->flush_timeout,
+                      CONFIG_MTD_CACHE_AUTOFLUSH_MS * US_PER_MS);
+#endif
+}
+
+static bool _is_erased(const uint8_t *data, uint32_t len)
+{
+    while (len--) {
+        if (*(data++) != 0xff) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* compares [start, end) of the cached sector with the backing device, stops
+ * as soon as the range differs from programmed data on the backing device */
+static int _compare(mtd_cache_t *cache, uint32_t start, uint32_t end)
+{
+    const uint32_t page = cache->sector * cache->mtd.pages_per_sector;
+    const uint8_t *data = &cache->buf[start];
+    uint8_t chunk[CMP_CHUNK_SIZE];
+    int cmp = 0;
+
+    while (start < end) {
+        uint32_t len = MIN(sizeof(chunk), end - start);
+        int res = mtd_read_page(cache->parent, chunk, page, start, len);
+
+        if (res < 0) {
+            return res;
+        }
+        if (!_is_erased(chunk, len)) {
+            cmp |= CMP_PROGRAMMED;
+        }
+        if (memcmp(chunk, data, len)) {
+            cmp |= CMP_DIFFERS;
+        }
+        if (cmp == (CMP_DIFFERS | CMP_PROGRAMMED)) {
+            break;
+        }
+        start += len;
+        data += len;
+    }
+    return cmp;
+}
+
+static int _program_page(mtd_cache_t *cache, uint32_t page)
+{
+    const uint32_t page_size = cache->mtd.page_size;
+    int res = mtd_write_page_raw(cache->parent, &cache->buf[page * page_size],
+                                 cache->sector * cache->mtd.pages_per_sector
+                                 + page, 0, page_size);
+
+    if (res == 0) {
+        cache->stats.pages_programmed++;
+    }
+    return res;
+}
+
+static int _flush(mtd_cache_t *cache)
+{
+    mtd_dev_t *parent = cache->parent;
+    const uint32_t page_size = cache->mtd.page_size;
+    const bool direct = parent->driver->flags & MTD_DRIVER_FLAG_DIRECT_WRITE;
+    uint32_t page, end;
+    int res;
+
+    if (!_is_dirty(cache)) {
+        return 0;
+    }
+    page = cache->dirty_start / page_size;
+    end = (cache->dirty_end + page_size - 1) / page_size;
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+    event_timeout_clear(&cache->flush_timeout);
+#endif
+    DEBUG("mtd_cache: write back sector %" PRIu32 ", pages %" PRIu32
+          "-%" PRIu32 "\n", cache->sector, page, end - 1);
+
+    if (!direct) {
+        /* check all modified pages before programming any of them */
+        res = _compare(cache, page * page_size, end * page_size);
+        if (res < 0) {
+            return res;
+        }
+        if (res == (CMP_DIFFERS | CMP_PROGRAMMED)) {
+            /* programming over programmed data is not allowed on flash with
+             * ECC or double-word programming, all pages of the sector need
+             * to be programmed again after the erase */
+            res = mtd_erase_sector(parent, cache->sector, 1);
+            if (res < 0) {
+                return res;
+            }
+            cache->stats.erases++;
+            page = 0;
+            end = cache->mtd.pages_per_sector;
+        }
+        else {
+            cache->stats.erases_avoided++;
+            if (!(res & CMP_DIFFERS)) {
+                /* data was written back unmodified */
+                end = page;
+            }
+        }
+    }
+
+    /* the target range is erased now, unless the device writes directly */
+    for (; page < end; page++) {
+        if (!direct && _is_erased(&cache->buf[page * page_size], page_size)) {
+            continue;
+        }
+        res = _program_page(cache, page);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    cache->dirty_end = 0;
+    cache->stats.flushes++;
+    return 0;
+}
+
+static int _load(mtd_cache_t *cache, uint32_t sector)
+{
+    int res = mtd_read_page(cache->parent, cache->buf,
+                            sector * cache->mtd.pages_per_sector, 0,
+                            _sector_size(&cache->mtd));
+
+    cache->sector = (res < 0) ? MTD_CACHE_SECTOR_NONE : sector;
+    return res;
+}
+
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+static void _flush_handler(event_t *event)
+{
+    mtd_cache_t *cache = container_of(event, mtd_cache_t, flush_event);
+
+    if (mtd_cache_sync(cache) < 0) {
+        DEBUG("mtd_cache: write back of sector %" PRIu32 " failed\n",
+              cache->sector);
+    }
+}
+#endif
+
+static int _init(mtd_dev_t *mtd)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    int res;
+
+    assert(cache->buf);
+
+    mutex_lock(&cache->lock);
+    /* don't lose modifications on re-initialization */
+    res = _flush(cache);
+    if (res == 0) {
+        res = mtd_init(cache->parent);
+    }
+    if (res < 0) {
+        mutex_unlock(&cache->lock);
+        return res;
+    }
+
+    mtd->sector_count = cache->parent->sector_count;
+    mtd->pages_per_sector = cache->parent->pages_per_sector;
+    mtd->page_size = cache->parent->page_size;
+    cache->sector = MTD_CACHE_SECTOR_NONE;
+    cache->dirty_end = 0;
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+    cache->flush_event.handler = _flush_handler;
+    event_timeout_init(&cache->flush_timeout, EVENT_PRIO_LOWEST,
+                       &cache->flush_event);
+#endif
+    mutex_unlock(&cache->lock);
+    return res;
+}
+
+static int _read_page(mtd_dev_t *mtd, void *dest, uint32_t page,
+                      uint32_t offset, uint32_t count)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    const uint32_t sector = page / mtd->pages_per_sector;
+    const uint32_t pos = (page % mtd->pages_per_sector) * mtd->page_size
+                       + offset;
+    int res = 0;
+
+    if (sector >= mtd->sector_count) {
+        return -EOVERFLOW;
+    }
+    /* stop at the end of the sector, the next one may be cached */
+    count = MIN(count, _sector_size(mtd) - pos);
+
+    mutex_lock(&cache->lock);
+    if (sector == cache->sector) {
+        memcpy(dest, &cache->buf[pos], count);
+    }
+    else {
+        res = mtd_read_page(cache->parent, dest, page, offset, count);
+    }
+    mutex_unlock(&cache->lock);
+
+    return (res < 0) ? res : (int)count;
+}
+
+static int _write_page(mtd_dev_t *mtd, const void *src, uint32_t page,
+                       uint32_t offset, uint32_t count)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    const uint32_t sector_size = _sector_size(mtd);
+    const uint32_t sector = page / mtd->pages_per_sector;
+    const uint32_t pos = (page % mtd->pages_per_sector) * mtd->page_size
+                       + offset;
+    int res = 0;
+
+    if (sector >= mtd->sector_count) {
+        return -EOVERFLOW;
+    }
+    count = MIN(count, sector_size - pos);
+
+    mutex_lock(&cache->lock);
+    if (sector != cache->sector) {
+        res = _flush(cache);
+        if (res == 0) {
+            if ((pos == 0) && (count == sector_size)) {
+                /* whole sector is overwritten, no need to read it */
+                cache->sector = sector;
+            }
+            else {
+                res = _load(cache, sector);
+            }
+        }
+    }
+    if (res == 0) {
+        cache->stats.writes++;
+        if (_is_dirty(cache)) {
+            cache->stats.writes_merged++;
+        }
+        memcpy(&cache->buf[pos], src, count);
+        _mark_dirty(cache, pos, pos + count);
+    }
+    mutex_unlock(&cache->lock);
+
+    return (res < 0) ? res : (int)count;
+}
+
+static int _erase_sector(mtd_dev_t *mtd, uint32_t sector, uint32_t count)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    int res = 0;
+
+    if ((sector + count) > mtd->sector_count) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&cache->lock);
+    if (count == 1) {
+        /* defer the erase, it is often followed by writes to the sector */
+        if (sector != cache->sector) {
+            res = _flush(cache);
+            if (res == 0) {
+                cache->sector = sector;
+            }
+        }
+        if (res == 0) {
+            memset(cache->buf, 0xff, _sector_size(mtd));
+            _mark_dirty(cache, 0, _sector_size(mtd));
+        }
+    }
+    else {
+        if ((cache->sector >= sector) && (cache->sector < (sector + count))) {
+            /* pending modifications are erased anyway */
+            cache->sector = MTD_CACHE_SECTOR_NONE;
+            cache->dirty_end = 0;
+        }
+        res = mtd_erase_sector(cache->parent, sector, count);
+        if (res == 0) {
+            cache->stats.erases += count;
+        }
+    }
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+static int _power(mtd_dev_t *mtd, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    int res = 0;
+
+    mutex_lock(&cache->lock);
+    if (power == MTD_POWER_DOWN) {
+        res = _flush(cache);
+    }
+    if (res == 0) {
+        res = mtd_power(cache->parent, power);
+    }
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+int mtd_cache_sync(mtd_cache_t *cache)
+{
+    mutex_lock(&cache->lock);
+    int res = _flush(cache);
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = _init,
+    .read_page = _read_page,
+    .write_page = _write_page,
+    .erase_sector = _erase_sector,
+    .power = _power,
+    .flags = MTD_DRIVER_FLAG_DIRECT_WRITE,
+};
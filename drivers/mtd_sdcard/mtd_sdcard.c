@@ -69,7 +69,9 @@ static int mtd_sdcard_read_page(mtd_dev_t *dev, void *buff, uint32_t page,
     DEBUG("mtd_sdcard_read_page: page:%" PRIu32 " offset:%" PRIu32 " size:%" PRIu32 "\n",
           page, offset, size);
 
-    if (offset) {
+    /* only whole blocks can be transferred, but as many as requested with
+       a single multi-block command */
+    if (offset || (size < SD_HC_BLOCK_SIZE)) {
         return -ENOTSUP;
     }
 
@@ -107,7 +109,9 @@ static int mtd_sdcard_write_page(mtd_dev_t *dev, const void *buff, uint32_t page
     DEBUG("mtd_sdcard_write_page: page:%" PRIu32 " offset:%" PRIu32 " size:%" PRIu32 "\n",
           page, offset, size);
 
-    if (offset) {
+    /* only whole blocks can be transferred, but as many as requested with
+       a single multi-block command */
+    if (offset || (size < SD_HC_BLOCK_SIZE)) {
         return -ENOTSUP;
     }
 
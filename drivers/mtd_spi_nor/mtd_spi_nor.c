@@ -45,6 +45,8 @@
 #define SFLASH_CMD_4_BYTE_ADDR (0xB7)   /**< enable 32 bit addressing */
 #define SFLASH_CMD_3_BYTE_ADDR (0xE9)   /**< enable 24 bit addressing */
 
+#define SFLASH_STATUS_WIP      (0x01)   /**< write in progress */
+
 #define MTD_64K             (65536ul)
 #define MTD_64K_ADDR_MASK   (0xFFFF)
 #define MTD_32K             (32768ul)
@@ -321,7 +323,7 @@ static inline void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us
         mtd_spi_cmd_read(dev, dev->params->opcode->rdsr, &status, sizeof(status));
 
         TRACE("mtd_spi_nor: wait device status = 0x%02x\n", (unsigned int)status);
-        if ((status & 1) == 0) { /* TODO magic number */
+        if ((status & SFLASH_STATUS_WIP) == 0) {
             break;
         }
         i++;
@@ -596,6 +598,48 @@ static int mtd_spi_nor_write_page(mtd_dev_t *mtd, const void *src, uint32_t page
     return size;
 }
 
+/* issues the largest erase command that fits, returns the bytes it erases */
+static int _erase_start(const mtd_spi_nor_t *dev, uint32_t addr, uint32_t size,
+                        uint32_t *us)
+{
+    uint32_t total_size = dev->base.page_size * dev->base.pages_per_sector *
+                          dev->base.sector_count;
+
+    /* write enable */
+    mtd_spi_cmd(dev, dev->params->opcode->wren);
+
+    if (size == total_size) {
+        mtd_spi_cmd(dev, dev->params->opcode->chip_erase);
+        *us = dev->params->wait_chip_erase;
+        return total_size;
+    }
+    else if ((dev->params->flag & SPI_NOR_F_SECT_64K) && (size >= MTD_64K) &&
+             ((addr & MTD_64K_ADDR_MASK) == 0)) {
+        /* 64 KiB blocks can be erased with block erase command */
+        mtd_spi_cmd_addr_write(dev, dev->params->opcode->block_erase_64k, addr, NULL, 0);
+        *us = dev->params->wait_64k_erase;
+        return MTD_64K;
+    }
+    else if ((dev->params->flag & SPI_NOR_F_SECT_32K) && (size >= MTD_32K) &&
+             ((addr & MTD_32K_ADDR_MASK) == 0)) {
+        /* 32 KiB blocks can be erased with block erase command */
+        mtd_spi_cmd_addr_write(dev, dev->params->opcode->block_erase_32k, addr, NULL, 0);
+        *us = dev->params->wait_32k_erase;
+        return MTD_32K;
+    }
+    else if ((dev->params->flag & SPI_NOR_F_SECT_4K) && (size >= MTD_4K) &&
+             ((addr & MTD_4K_ADDR_MASK) == 0)) {
+        /* 4 KiB sectors can be erased with sector erase command */
+        mtd_spi_cmd_addr_write(dev, dev->params->opcode->sector_erase, addr, NULL, 0);
+        *us = dev->params->wait_sector_erase;
+        return MTD_4K;
+    }
+
+    /* no suitable erase block found */
+    assert(0);
+    return -EINVAL;
+}
+
 static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
 {
     DEBUG("mtd_spi_nor_erase: %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
@@ -623,46 +667,14 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
     mtd_spi_acquire(dev);
     while (size) {
         uint32_t us;
+        int erased = _erase_start(dev, addr, size, &us);
 
-        /* write enable */
-        mtd_spi_cmd(dev, dev->params->opcode->wren);
-
-        if (size == total_size) {
-            mtd_spi_cmd(dev, dev->params->opcode->chip_erase);
-            size -= total_size;
-            us = dev->params->wait_chip_erase;
-        }
-        else if ((dev->params->flag & SPI_NOR_F_SECT_64K) && (size >= MTD_64K) &&
-                 ((addr & MTD_64K_ADDR_MASK) == 0)) {
-            /* 64 KiB blocks can be erased with block erase command */
-            mtd_spi_cmd_addr_write(dev, dev->params->opcode->block_erase_64k, addr, NULL, 0);
-            addr += MTD_64K;
-            size -= MTD_64K;
-            us = dev->params->wait_64k_erase;
-        }
-        else if ((dev->params->flag & SPI_NOR_F_SECT_32K) && (size >= MTD_32K) &&
-                 ((addr & MTD_32K_ADDR_MASK) == 0)) {
-            /* 32 KiB blocks can be erased with block erase command */
-            mtd_spi_cmd_addr_write(dev, dev->params->opcode->block_erase_32k, addr, NULL, 0);
-            addr += MTD_32K;
-            size -= MTD_32K;
-            us = dev->params->wait_32k_erase;
-        }
-        else if ((dev->params->flag & SPI_NOR_F_SECT_4K) && (size >= MTD_4K) &&
-                 ((addr & MTD_4K_ADDR_MASK) == 0)) {
-            /* 4 KiB sectors can be erased with sector erase command */
-            mtd_spi_cmd_addr_write(dev, dev->params->opcode->sector_erase, addr, NULL, 0);
-            addr += MTD_4K;
-            size -= MTD_4K;
-            us = dev->params->wait_sector_erase;
-        }
-        else {
-            /* no suitable erase block found */
-            assert(0);
-
+        if (erased < 0) {
             mtd_spi_release(dev);
-            return -EINVAL;
+            return erased;
         }
+        addr += erased;
+        size -= erased;
 
         /* waiting for the command to complete before continuing */
         wait_for_write_complete(dev, us);
@@ -672,6 +684,38 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
     return 0;
 }
 
+static int mtd_spi_nor_erase_sector_start(mtd_dev_t *mtd, uint32_t sector,
+                                          uint32_t count, uint32_t *wait_us)
+{
+    DEBUG("mtd_spi_nor_erase_sector_start: %p, %" PRIu32 ", %" PRIu32 "\n",
+          (void *)mtd, sector, count);
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
+
+    if ((sector + count) > mtd->sector_count) {
+        return -EOVERFLOW;
+    }
+
+    mtd_spi_acquire(dev);
+    int erased = _erase_start(dev, sector * sector_size, count * sector_size,
+                              wait_us);
+    mtd_spi_release(dev);
+
+    return (erased < 0) ? erased : (int)(erased / sector_size);
+}
+
+static int mtd_spi_nor_busy(mtd_dev_t *mtd)
+{
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    uint8_t status;
+
+    mtd_spi_acquire(dev);
+    mtd_spi_cmd_read(dev, dev->params->opcode->rdsr, &status, sizeof(status));
+    mtd_spi_release(dev);
+
+    return status & SFLASH_STATUS_WIP;
+}
+
 const mtd_desc_t mtd_spi_nor_driver = {
     .init = mtd_spi_nor_init,
     .read = mtd_spi_nor_read,
@@ -679,4 +723,6 @@ const mtd_desc_t mtd_spi_nor_driver = {
     .write_page = mtd_spi_nor_write_page,
     .erase = mtd_spi_nor_erase,
     .power = mtd_spi_nor_power,
+    .erase_sector_start = mtd_spi_nor_erase_sector_start,
+    .busy = mtd_spi_nor_busy,
 };
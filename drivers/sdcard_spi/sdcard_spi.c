@@ -752,6 +752,15 @@ static inline int _write_blocks(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr,
     _select_card_spi(card);
     int written = 0;
 
+    if (cmd_idx == SD_CMD_25) {
+        /* let the card pre-erase all blocks of the write at once, this is
+           only a hint so the write is done without it if the card refuses */
+        uint8_t acmd_r1_resu = sdcard_spi_send_acmd(card, SD_CMD_23, nbl, 0);
+        if (!R1_VALID(acmd_r1_resu) || R1_ERROR(acmd_r1_resu)) {
+            DEBUG("_write_blocks: send ACMD23: [FAILED] (ignored)\n");
+        }
+    }
+
     uint32_t addr = card->use_block_addr ? bladdr : (bladdr * SD_HC_BLOCK_SIZE);
     uint8_t cmd_r1_resu = sdcard_spi_send_cmd(card, cmd_idx, addr, SD_BLOCK_WRITE_CMD_RETRY_US);
 
@@ -793,8 +802,10 @@ static inline int _write_blocks(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr,
             /* sd card needs dummy byte before we can wait for not-busy
                state */
             _send_dummy_byte(card);
-            if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_US)) {
-                _unselect_card_spi(card);
+            if (_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_US)) {
+                *state = SD_RW_OK;
+            }
+            else {
                 *state = SD_RW_TIMEOUT;
             }
         }
@@ -14,6 +14,9 @@ PSEUDOMODULES += can_pm
 PSEUDOMODULES += can_raw
 PSEUDOMODULES += ccn-lite-utils
 PSEUDOMODULES += cc2538_rf_obs_sig
+PSEUDOMODULES += checksum_crc32_armv8
+PSEUDOMODULES += checksum_crc32_pclmul
+PSEUDOMODULES += checksum_crc_periph
 PSEUDOMODULES += conn_can_isotp_multi
 PSEUDOMODULES += cord_ep_standalone
 PSEUDOMODULES += core_%
@@ -62,7 +65,10 @@ PSEUDOMODULES += gnrc_sixloenc
 PSEUDOMODULES += gnrc_sixlowpan_border_router_default
 PSEUDOMODULES += gnrc_sixlowpan_default
 PSEUDOMODULES += gnrc_sixlowpan_frag_hint
+PSEUDOMODULES += gnrc_sixlowpan_frag_sfr_congure
+PSEUDOMODULES += gnrc_sixlowpan_frag_sfr_congure_%
 PSEUDOMODULES += gnrc_sixlowpan_frag_sfr_stats
+PSEUDOMODULES += gnrc_sixlowpan_iphc_cache
 PSEUDOMODULES += gnrc_sixlowpan_iphc_nhc
 PSEUDOMODULES += gnrc_sixlowpan_nd_border_router
 PSEUDOMODULES += gnrc_sixlowpan_router_default
@@ -86,6 +92,8 @@ PSEUDOMODULES += log_color
 PSEUDOMODULES += lora
 PSEUDOMODULES += mpu_stack_guard
 PSEUDOMODULES += mpu_noexec_ram
+PSEUDOMODULES += mtd_cache_autoflush
+PSEUDOMODULES += mtd_native_timing
 PSEUDOMODULES += mtd_write_page
 PSEUDOMODULES += nanocoap_%
 PSEUDOMODULES += netdev_default
@@ -318,6 +326,16 @@ PSEUDOMODULES += crypto_aes_256
 PSEUDOMODULES += crypto_aes_precalculated
 # This pseudomodule causes a loop in AES to be unrolled (more flash, less CPU)
 PSEUDOMODULES += crypto_aes_unroll
+# Alternative AES backends, replacing the T-table implementation
+PSEUDOMODULES += crypto_aes_armv8
+PSEUDOMODULES += crypto_aes_ct
+PSEUDOMODULES += crypto_aes_ni
+# Alternative SHA-224/256 compression functions
+PSEUDOMODULES += hashes_sha256_armv8
+PSEUDOMODULES += hashes_sha256_mb_avx2
+PSEUDOMODULES += hashes_sha256_ni
+PSEUDOMODULES += hashes_sha256_periph
+PSEUDOMODULES += hashes_sha256_unroll
 
 # declare shell version of test_utils_interactive_sync
 PSEUDOMODULES += test_utils_interactive_sync_shell
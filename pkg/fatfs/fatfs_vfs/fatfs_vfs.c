@@ -227,6 +227,60 @@ static ssize_t _read(vfs_file_t *filp, void *dest, size_t nbytes)
     return (ssize_t)br;
 }
 
+static ssize_t _writev(vfs_file_t *filp, const iolist_t *iolist)
+{
+    fatfs_file_desc_t *fd = (fatfs_file_desc_t *)filp->private_data.buffer;
+    ssize_t total = 0;
+
+    for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+        UINT bw;
+
+        if (iol->iol_len == 0) {
+            continue;
+        }
+
+        FRESULT res = f_write(&fd->file, iol->iol_base, iol->iol_len, &bw);
+
+        if (res != FR_OK) {
+            return (total > 0) ? total : fatfs_err_to_errno(res);
+        }
+        total += bw;
+        if (bw < iol->iol_len) {
+            /* volume full */
+            break;
+        }
+    }
+
+    return total;
+}
+
+static ssize_t _readv(vfs_file_t *filp, const iolist_t *iolist)
+{
+    fatfs_file_desc_t *fd = (fatfs_file_desc_t *)filp->private_data.buffer;
+    ssize_t total = 0;
+
+    for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+        UINT br;
+
+        if (iol->iol_len == 0) {
+            continue;
+        }
+
+        FRESULT res = f_read(&fd->file, iol->iol_base, iol->iol_len, &br);
+
+        if (res != FR_OK) {
+            return (total > 0) ? total : fatfs_err_to_errno(res);
+        }
+        total += br;
+        if (br < iol->iol_len) {
+            /* end of file */
+            break;
+        }
+    }
+
+    return total;
+}
+
 static off_t _lseek(vfs_file_t *filp, off_t off, int whence)
 {
     fatfs_file_desc_t *fd = (fatfs_file_desc_t *)filp->private_data.buffer;
@@ -453,6 +507,8 @@ static const vfs_file_ops_t fatfs_file_ops = {
     .close = _close,
     .read = _read,
     .write = _write,
+    .readv = _readv,
+    .writev = _writev,
     .lseek = _lseek,
     .fstat = _fstat,
 };
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_checksum_crc
+ * @{
+ *
+ * @file
+ * @brief       Generic CRC engine with slicing-by-8
+ *
+ * Non-reflected CRCs are kept in the upper bits of the 32-bit register and
+ * processed MSB first, reflected CRCs in the lower bits and processed LSB
+ * first. This way, one loop of each kind serves all widths.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "byteorder.h"
+#include "checksum/crc.h"
+#include "kernel_defines.h"
+
+#include "crc_internal.h"
+
+/*
+ * A CRC is linear: the table entry of a byte is the XOR of the entries of
+ * its bits. CRC_TABLE() expands a table from the entries of the 8 single bits
+ * (i.e. of 0x01, 0x02, ..., 0x80), which crc_table_init() gives for any
+ * polynomial.
+ */
+#define CRC_ENTRY(i, b0, b1, b2, b3, b4, b5, b6, b7)                         \
+    ((((i) & 0x01) ? (b0) : 0) ^ (((i) & 0x02) ? (b1) : 0) ^                \
+     (((i) & 0x04) ? (b2) : 0) ^ (((i) & 0x08) ? (b3) : 0) ^                \
+     (((i) & 0x10) ? (b4) : 0) ^ (((i) & 0x20) ? (b5) : 0) ^                \
+     (((i) & 0x40) ? (b6) : 0) ^ (((i) & 0x80) ? (b7) : 0))
+
+#define CRC_ENTRIES4(i, ...)                                                \
+    CRC_ENTRY((i), __VA_ARGS__), CRC_ENTRY((i) + 1, __VA_ARGS__),           \
+    CRC_ENTRY((i) + 2, __VA_ARGS__), CRC_ENTRY((i) + 3, __VA_ARGS__)
+
+#define CRC_ENTRIES16(i, ...)                                               \
+    CRC_ENTRIES4((i), __VA_ARGS__), CRC_ENTRIES4((i) + 4, __VA_ARGS__),     \
+    CRC_ENTRIES4((i) + 8, __VA_ARGS__), CRC_ENTRIES4((i) + 12, __VA_ARGS__)
+
+#define CRC_ENTRIES64(i, ...)                                               \
+    CRC_ENTRIES16((i), __VA_ARGS__), CRC_ENTRIES16((i) + 16, __VA_ARGS__),  \
+    CRC_ENTRIES16((i) + 32, __VA_ARGS__), CRC_ENTRIES16((i) + 48, __VA_ARGS__)
+
+#define CRC_TABLE(...)                                                      \
+    { CRC_ENTRIES64(0, __VA_ARGS__), CRC_ENTRIES64(64, __VA_ARGS__),        \
+      CRC_ENTRIES64(128, __VA_ARGS__), CRC_ENTRIES64(192, __VA_ARGS__) }
+
+/* the unused tables are not even expanded */
+#if CONFIG_CRC_SLICES == 8
+#define CRC_TABLES(t0, t1, t2, t3, t4, t5, t6, t7)                          \
+    { t0, t1, t2, t3, t4, t5, t6, t7 }
+#elif CONFIG_CRC_SLICES == 4
+#define CRC_TABLES(t0, t1, t2, t3, t4, t5, t6, t7)  { t0, t1, t2, t3 }
+#else
+#define CRC_TABLES(t0, t1, t2, t3, t4, t5, t6, t7)  { t0 }
+#endif
+
+static const crc_table_t _crc_8_table = { CRC_TABLES(
+    CRC_TABLE(0x07000000, 0x0e000000, 0x1c000000, 0x38000000,
+              0x70000000, 0xe0000000, 0xc7000000, 0x89000000),
+    CRC_TABLE(0x15000000, 0x2a000000, 0x54000000, 0xa8000000,
+              0x57000000, 0xae000000, 0x5b000000, 0xb6000000),
+    CRC_TABLE(0x6b000000, 0xd6000000, 0xab000000, 0x51000000,
+              0xa2000000, 0x43000000, 0x86000000, 0x0b000000),
+    CRC_TABLE(0x16000000, 0x2c000000, 0x58000000, 0xb0000000,
+              0x67000000, 0xce000000, 0x9b000000, 0x31000000),
+    CRC_TABLE(0x62000000, 0xc4000000, 0x8f000000, 0x19000000,
+              0x32000000, 0x64000000, 0xc8000000, 0x97000000),
+    CRC_TABLE(0x29000000, 0x52000000, 0xa4000000, 0x4f000000,
+              0x9e000000, 0x3b000000, 0x76000000, 0xec000000),
+    CRC_TABLE(0xdf000000, 0xb9000000, 0x75000000, 0xea000000,
+              0xd3000000, 0xa1000000, 0x45000000, 0x8a000000),
+    CRC_TABLE(0x13000000, 0x26000000, 0x4c000000, 0x98000000,
+              0x37000000, 0x6e000000, 0xdc000000, 0xbf000000)) };
+
+static const crc_table_t _crc_16_ccitt_table = { CRC_TABLES(
+    CRC_TABLE(0x10210000, 0x20420000, 0x40840000, 0x81080000,
+              0x12310000, 0x24620000, 0x48c40000, 0x91880000),
+    CRC_TABLE(0x33310000, 0x66620000, 0xccc40000, 0x89a90000,
+              0x03730000, 0x06e60000, 0x0dcc0000, 0x1b980000),
+    CRC_TABLE(0x37300000, 0x6e600000, 0xdcc00000, 0xa9a10000,
+              0x43630000, 0x86c60000, 0x1dad0000, 0x3b5a0000),
+    CRC_TABLE(0x76b40000, 0xed680000, 0xcaf10000, 0x85c30000,
+              0x1ba70000, 0x374e0000, 0x6e9c0000, 0xdd380000),
+    CRC_TABLE(0xaa510000, 0x44830000, 0x89060000, 0x022d0000,
+              0x045a0000, 0x08b40000, 0x11680000, 0x22d00000),
+    CRC_TABLE(0x45a00000, 0x8b400000, 0x06a10000, 0x0d420000,
+              0x1a840000, 0x35080000, 0x6a100000, 0xd4200000),
+    CRC_TABLE(0xb8610000, 0x60e30000, 0xc1c60000, 0x93ad0000,
+              0x377b0000, 0x6ef60000, 0xddec0000, 0xabf90000),
+    CRC_TABLE(0x47d30000, 0x8fa60000, 0x0f6d0000, 0x1eda0000,
+              0x3db40000, 0x7b680000, 0xf6d00000, 0xfd810000)) };
+
+static const crc_table_t _crc_32_table = { CRC_TABLES(
+    CRC_TABLE(0x77073096, 0xee0e612c, 0x076dc419, 0x0edb8832,
+              0x1db71064, 0x3b6e20c8, 0x76dc4190, 0xedb88320),
+    CRC_TABLE(0x191b3141, 0x32366282, 0x646cc504, 0xc8d98a08,
+              0x4ac21251, 0x958424a2, 0xf0794f05, 0x3b83984b),
+    CRC_TABLE(0x01c26a37, 0x0384d46e, 0x0709a8dc, 0x0e1351b8,
+              0x1c26a370, 0x384d46e0, 0x709a8dc0, 0xe1351b80),
+    CRC_TABLE(0xb8bc6765, 0xaa09c88b, 0x8f629757, 0xc5b428ef,
+              0x5019579f, 0xa032af3e, 0x9b14583d, 0xed59b63b),
+    CRC_TABLE(0x3d6029b0, 0x7ac05360, 0xf580a6c0, 0x30704bc1,
+              0x60e09782, 0xc1c12f04, 0x58f35849, 0xb1e6b092),
+    CRC_TABLE(0xcb5cd3a5, 0x4dc8a10b, 0x9b914216, 0xec53826d,
+              0x03d6029b, 0x07ac0536, 0x0f580a6c, 0x1eb014d8),
+    CRC_TABLE(0xa6770bb4, 0x979f1129, 0xf44f2413, 0x33ef4e67,
+              0x67de9cce, 0xcfbd399c, 0x440b7579, 0x8816eaf2),
+    CRC_TABLE(0xccaa009e, 0x4225077d, 0x844a0efa, 0xd3e51bb5,
+              0x7cbb312b, 0xf9766256, 0x299dc2ed, 0x533b85da)) };
+
+static const crc_table_t _crc_32c_table = { CRC_TABLES(
+    CRC_TABLE(0xf26b8303, 0xe13b70f7, 0xc79a971f, 0x8ad958cf,
+              0x105ec76f, 0x20bd8ede, 0x417b1dbc, 0x82f63b78),
+    CRC_TABLE(0x13a29877, 0x274530ee, 0x4e8a61dc, 0x9d14c3b8,
+              0x3fc5f181, 0x7f8be302, 0xff17c604, 0xfbc3faf9),
+    CRC_TABLE(0xa541927e, 0x4f6f520d, 0x9edea41a, 0x38513ec5,
+              0x70a27d8a, 0xe144fb14, 0xc76580d9, 0x8b277743),
+    CRC_TABLE(0xdd45aab8, 0xbf672381, 0x7b2231f3, 0xf64463e6,
+              0xe964b13d, 0xd725148b, 0xaba65fe7, 0x52a0c93f),
+    CRC_TABLE(0x38116fac, 0x7022df58, 0xe045beb0, 0xc5670b91,
+              0x8f2261d3, 0x1ba8b557, 0x37516aae, 0x6ea2d55c),
+    CRC_TABLE(0xef306b19, 0xdb8ca0c3, 0xb2f53777, 0x6006181f,
+              0xc00c303e, 0x85f4168d, 0x0e045beb, 0x1c08b7d6),
+    CRC_TABLE(0x68032cc8, 0xd0065990, 0xa5e0c5d1, 0x4e2dfd53,
+              0x9c5bfaa6, 0x3d5b83bd, 0x7ab7077a, 0xf56e0ef4),
+    CRC_TABLE(0x493c7d27, 0x9278fa4e, 0x211d826d, 0x423b04da,
+              0x847609b4, 0x0d006599, 0x1a00cb32, 0x34019664)) };
+
+#if IS_USED(MODULE_CHECKSUM_CRC32_PCLMUL)
+#define CRC_32_ACCEL    crc32_pclmul
+#define CRC_32C_ACCEL   crc32c_pclmul
+#elif IS_USED(MODULE_CHECKSUM_CRC32_ARMV8)
+#define CRC_32_ACCEL    crc32_armv8
+#define CRC_32C_ACCEL   crc32c_armv8
+#else
+#define CRC_32_ACCEL    NULL
+#define CRC_32C_ACCEL   NULL
+#endif
+
+const crc_t crc_8 = {
+    .table = &_crc_8_table,
+    .poly = 0x07,
+    .init = 0x00,
+    .xorout = 0x00,
+    .width = 8,
+    .reflected = false,
+};
+
+const crc_t crc_16_ccitt = {
+    .table = &_crc_16_ccitt_table,
+    .poly = 0x1021,
+    .init = 0x1d0f,
+    .xorout = 0x0000,
+    .width = 16,
+    .reflected = false,
+};
+
+const crc_t crc_32 = {
+    .table = &_crc_32_table,
+    .accel = CRC_32_ACCEL,
+    .poly = 0x04c11db7,
+    .init = 0xffffffff,
+    .xorout = 0xffffffff,
+    .width = 32,
+    .reflected = true,
+};
+
+const crc_t crc_32c = {
+    .table = &_crc_32c_table,
+    .accel = CRC_32C_ACCEL,
+    .poly = 0x1edc6f41,
+    .init = 0xffffffff,
+    .xorout = 0xffffffff,
+    .width = 32,
+    .reflected = true,
+};
+
+static uint32_t _reflect(uint32_t value, uint8_t width)
+{
+    value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+    value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+    value = ((value >> 4) & 0x0f0f0f0f) | ((value & 0x0f0f0f0f) << 4);
+    value = ((value >> 8) & 0x00ff00ff) | ((value & 0x00ff00ff) << 8);
+    value = (value >> 16) | (value << 16);
+
+    return value >> (32 - width);
+}
+
+void crc_table_init(crc_table_t *table, uint32_t poly, uint8_t width,
+                    bool reflected)
+{
+    uint32_t (*t)[256] = table->t;
+
+    if (reflected) {
+        poly = _reflect(poly, width);
+        for (unsigned i = 0; i < 256; i++) {
+            uint32_t reg = i;
+
+            for (unsigned bit = 0; bit < 8; bit++) {
+                reg = (reg & 1) ? (reg >> 1) ^ poly : reg >> 1;
+            }
+            t[0][i] = reg;
+        }
+        for (unsigned k = 1; k < CONFIG_CRC_SLICES; k++) {
+            for (unsigned i = 0; i < 256; i++) {
+                uint32_t reg = t[k - 1][i];
+
+                t[k][i] = (reg >> 8) ^ t[0][reg & 0xff];
+            }
+        }
+    }
+    else {
+        poly <<= 32 - width;
+        for (unsigned i = 0; i < 256; i++) {
+            uint32_t reg = (uint32_t)i << 24;
+
+            for (unsigned bit = 0; bit < 8; bit++) {
+                reg = (reg & 0x80000000) ? (reg << 1) ^ poly : reg << 1;
+            }
+            t[0][i] = reg;
+        }
+        for (unsigned k = 1; k < CONFIG_CRC_SLICES; k++) {
+            for (unsigned i = 0; i < 256; i++) {
+                uint32_t reg = t[k - 1][i];
+
+                t[k][i] = (reg << 8) ^ t[0][reg >> 24];
+            }
+        }
+    }
+}
+
+static uint32_t _update_reflected(const uint32_t (*t)[256], uint32_t reg,
+                                  const uint8_t *buf, size_t len)
+{
+#if CONFIG_CRC_SLICES == 8
+    for (; len >= 8; len -= 8, buf += 8) {
+        uint32_t lo = reg ^ byteorder_lebuftohl(buf);
+        uint32_t hi = byteorder_lebuftohl(buf + 4);
+
+        reg = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^
+              t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+              t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+              t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+    }
+#elif CONFIG_CRC_SLICES == 4
+    for (; len >= 4; len -= 4, buf += 4) {
+        uint32_t v = reg ^ byteorder_lebuftohl(buf);
+
+        reg = t[3][v & 0xff] ^ t[2][(v >> 8) & 0xff] ^
+              t[1][(v >> 16) & 0xff] ^ t[0][v >> 24];
+    }
+#endif
+    for (; len; len--, buf++) {
+        reg = (reg >> 8) ^ t[0][(reg ^ *buf) & 0xff];
+    }
+
+    return reg;
+}
+
+static uint32_t _update_normal(const uint32_t (*t)[256], uint32_t reg,
+                               const uint8_t *buf, size_t len)
+{
+#if CONFIG_CRC_SLICES == 8
+    for (; len >= 8; len -= 8, buf += 8) {
+        uint32_t hi = reg ^ byteorder_bebuftohl(buf);
+        uint32_t lo = byteorder_bebuftohl(buf + 4);
+
+        reg = t[7][hi >> 24] ^ t[6][(hi >> 16) & 0xff] ^
+              t[5][(hi >> 8) & 0xff] ^ t[4][hi & 0xff] ^
+              t[3][lo >> 24] ^ t[2][(lo >> 16) & 0xff] ^
+              t[1][(lo >> 8) & 0xff] ^ t[0][lo & 0xff];
+    }
+#elif CONFIG_CRC_SLICES == 4
+    for (; len >= 4; len -= 4, buf += 4) {
+        uint32_t v = reg ^ byteorder_bebuftohl(buf);
+
+        reg = t[3][v >> 24] ^ t[2][(v >> 16) & 0xff] ^
+              t[1][(v >> 8) & 0xff] ^ t[0][v & 0xff];
+    }
+#endif
+    for (; len; len--, buf++) {
+        reg = (reg << 8) ^ t[0][(reg >> 24) ^ *buf];
+    }
+
+    return reg;
+}
+
+uint32_t crc_start(const crc_t *crc)
+{
+    if (crc->reflected) {
+        return _reflect(crc->init, crc->width);
+    }
+    return crc->init << (32 - crc->width);
+}
+
+uint32_t crc_update(const crc_t *crc, uint32_t reg, const void *buf,
+                    size_t len)
+{
+    const uint8_t *data = buf;
+    size_t done = 0;
+
+#if IS_USED(MODULE_CHECKSUM_CRC_PERIPH)
+    done = crc_periph_update(crc, &reg, data, len);
+#endif
+    if ((done == 0) && crc->accel) {
+        done = crc->accel(&reg, data, len);
+    }
+    data += done;
+    len -= done;
+
+    if (crc->reflected) {
+        return _update_reflected(crc->table->t, reg, data, len);
+    }
+    return _update_normal(crc->table->t, reg, data, len);
+}
+
+uint32_t crc_finish(const crc_t *crc, uint32_t reg)
+{
+    if (!crc->reflected) {
+        reg >>= 32 - crc->width;
+    }
+    return reg ^ crc->xorout;
+}
+
+uint32_t crc_calc(const crc_t *crc, const void *buf, size_t len)
+{
+    return crc_finish(crc, crc_update(crc, crc_start(crc), buf, len));
+}
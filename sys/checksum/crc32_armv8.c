@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_checksum_crc
+ * @{
+ *
+ * @file
+ * @brief       CRC-32 and CRC-32C with the ARMv8 CRC32 instructions
+ *
+ * Selected by the `checksum_crc32_armv8` pseudomodule. The target must be
+ * built with the instructions enabled, e.g. with `-march=armv8-a+crc`.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_CHECKSUM_CRC32_ARMV8)
+
+#ifndef __ARM_FEATURE_CRC32
+#error "checksum_crc32_armv8: build with the ARMv8 CRC32 instructions enabled"
+#endif
+
+#include <arm_acle.h>
+
+#include "byteorder.h"
+#include "crc_internal.h"
+
+size_t crc32_armv8(uint32_t *reg, const uint8_t *buf, size_t len)
+{
+    uint32_t crc = *reg;
+    size_t done = len & ~(size_t)7;
+
+    for (size_t i = 0; i < done; i += 8) {
+        crc = __crc32d(crc, byteorder_lebuftohll(buf + i));
+    }
+    *reg = crc;
+
+    return done;
+}
+
+size_t crc32c_armv8(uint32_t *reg, const uint8_t *buf, size_t len)
+{
+    uint32_t crc = *reg;
+    size_t done = len & ~(size_t)7;
+
+    for (size_t i = 0; i < done; i += 8) {
+        crc = __crc32cd(crc, byteorder_lebuftohll(buf + i));
+    }
+    *reg = crc;
+
+    return done;
+}
+
+#endif /* MODULE_CHECKSUM_CRC32_ARMV8 */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_checksum_crc
+ * @{
+ *
+ * @file
+ * @brief       CRC-32 and CRC-32C with carry-less multiplication on x86
+ *
+ * Four 128-bit lanes of the input are folded in parallel with PCLMULQDQ,
+ * then folded into one lane, reduced to 64 bits and finally to 32 bits with
+ * a Barrett reduction, as described in Intel's "Fast CRC Computation for
+ * Generic Polynomials Using PCLMULQDQ Instruction". The instructions are
+ * enabled per function, so the rest of the build does not depend on the CPU
+ * of the host. Selected by the `checksum_crc32_pclmul` pseudomodule.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_CHECKSUM_CRC32_PCLMUL)
+
+#if !defined(__x86_64__) && !defined(__i386__)
+#error "checksum_crc32_pclmul: PCLMULQDQ is only available on x86"
+#endif
+
+#include <immintrin.h>
+
+#include "crc_internal.h"
+
+/* the folding constants of a reflected polynomial P, all bit reflected:
+ * x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32) and x^64 mod P,
+ * shifted left by one; P itself and floor(x^64 / P) */
+typedef struct {
+    uint64_t k1k2[2];
+    uint64_t k3k4[2];
+    uint64_t k5;
+    uint64_t poly[2];
+} _fold_t;
+
+static const _fold_t _crc32 = {
+    .k1k2 = { 0x154442bd4, 0x1c6e41596 },
+    .k3k4 = { 0x1751997d0, 0x0ccaa009e },
+    .k5 = 0x163cd6124,
+    .poly = { 0x1db710641, 0x1f7011641 },
+};
+
+static const _fold_t _crc32c = {
+    .k1k2 = { 0x0740eef02, 0x09e4addf8 },
+    .k3k4 = { 0x0f20c0dfe, 0x14cd00bd6 },
+    .k5 = 0x0dd45aab8,
+    .poly = { 0x105ec76f1, 0x0dea713f1 },
+};
+
+#define FOLD(x, k, y)                                                       \
+    _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),           \
+                                _mm_clmulepi64_si128(x, k, 0x11)), y)
+
+__attribute__((target("pclmul,sse4.1")))
+static size_t _fold(const _fold_t *c, uint32_t *reg, const uint8_t *buf,
+                    size_t len)
+{
+    const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    size_t done = len & ~(size_t)15;
+    __m128i x0, x1, x2, x3, x4;
+
+    if (len < 64) {
+        return 0;
+    }
+
+    x1 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+    x2 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(*reg));
+    buf += 64;
+    len -= 64;
+
+    /* fold 4 x 128 bits */
+    x0 = _mm_loadu_si128((const __m128i *)c->k1k2);
+    for (; len >= 64; len -= 64, buf += 64) {
+        x1 = FOLD(x1, x0, _mm_loadu_si128((const __m128i *)(buf + 0x00)));
+        x2 = FOLD(x2, x0, _mm_loadu_si128((const __m128i *)(buf + 0x10)));
+        x3 = FOLD(x3, x0, _mm_loadu_si128((const __m128i *)(buf + 0x20)));
+        x4 = FOLD(x4, x0, _mm_loadu_si128((const __m128i *)(buf + 0x30)));
+    }
+
+    /* fold into 128 bits, then the remaining 16 byte blocks */
+    x0 = _mm_loadu_si128((const __m128i *)c->k3k4);
+    x1 = FOLD(x1, x0, x2);
+    x1 = FOLD(x1, x0, x3);
+    x1 = FOLD(x1, x0, x4);
+    for (; len >= 16; len -= 16, buf += 16) {
+        x1 = FOLD(x1, x0, _mm_loadu_si128((const __m128i *)buf));
+    }
+
+    /* reduce to 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0 = _mm_loadl_epi64((const __m128i *)&c->k5);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x00), x2);
+
+    /* Barrett reduction to 32 bits */
+    x0 = _mm_loadu_si128((const __m128i *)c->poly);
+    x2 = _mm_and_si128(x1, mask);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, mask);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    *reg = _mm_extract_epi32(x1, 1);
+
+    return done;
+}
+
+size_t crc32_pclmul(uint32_t *reg, const uint8_t *buf, size_t len)
+{
+    return _fold(&_crc32, reg, buf, len);
+}
+
+size_t crc32c_pclmul(uint32_t *reg, const uint8_t *buf, size_t len)
+{
+    return _fold(&_crc32c, reg, buf, len);
+}
+
+#endif /* MODULE_CHECKSUM_CRC32_PCLMUL */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_checksum_crc
+ * @{
+ *
+ * @file
+ * @brief       CPU implementations of CRC-32 and CRC-32C
+ *
+ * @}
+ */
+
+#ifndef CRC_INTERNAL_H
+#define CRC_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    CRC-32 and CRC-32C with carry-less multiplication on x86
+ *
+ * Process 64 bytes or more, in multiples of 16 bytes.
+ * @{
+ */
+size_t crc32_pclmul(uint32_t *reg, const uint8_t *buf, size_t len);
+size_t crc32c_pclmul(uint32_t *reg, const uint8_t *buf, size_t len);
+/** @} */
+
+/**
+ * @name    CRC-32 and CRC-32C with the ARMv8 CRC32 instructions
+ *
+ * Process multiples of 8 bytes.
+ * @{
+ */
+size_t crc32_armv8(uint32_t *reg, const uint8_t *buf, size_t len);
+size_t crc32c_armv8(uint32_t *reg, const uint8_t *buf, size_t len);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC_INTERNAL_H */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+
+#include "congure/aimd.h"
+
+static void _snd_init(congure_snd_t *cong, void *ctx);
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs);
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack);
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time);
+
+static const congure_snd_driver_t _driver = {
+    .init = _snd_init,
+    .inter_msg_interval = _snd_inter_msg_interval,
+    .report_msg_sent = _snd_report_msg_sent,
+    .report_msg_discarded = _snd_report_msg_discarded,
+    /* AIMD does not distinguish between ACK timeout and loss */
+    .report_msgs_timeout = _snd_report_msgs_lost,
+    .report_msgs_lost = _snd_report_msgs_lost,
+    .report_msg_acked = _snd_report_msg_acked,
+    .report_ecn_ce = _snd_report_ecn_ce,
+};
+
+void congure_aimd_snd_setup(congure_aimd_snd_t *c,
+                            const congure_aimd_consts_t *consts)
+{
+    assert(consts->md_percent < 100U);
+    assert(consts->min_wnd <= consts->init_wnd);
+    assert(consts->init_wnd <= consts->max_wnd);
+    c->super.driver = &_driver;
+    c->consts = consts;
+}
+
+static void _decrease(congure_aimd_snd_t *c, ztimer_now_t send_time)
+{
+    uint32_t cwnd;
+
+    if (c->in_recovery && ((int32_t)(send_time - c->recover) <= 0)) {
+        /* congestion event was already reacted upon */
+        return;
+    }
+    cwnd = ((uint32_t)c->super.cwnd * c->consts->md_percent) / 100U;
+    c->super.cwnd = (cwnd < c->consts->min_wnd) ? c->consts->min_wnd
+                                                : (congure_wnd_size_t)cwnd;
+    c->acked = 0;
+    c->recover = send_time;
+    c->in_recovery = true;
+}
+
+static void _snd_init(congure_snd_t *cong, void *ctx)
+{
+    congure_aimd_snd_t *c = (congure_aimd_snd_t *)cong;
+
+    c->super.ctx = ctx;
+    c->super.cwnd = c->consts->init_wnd;
+    c->acked = 0;
+    c->recover = 0;
+    c->in_recovery = false;
+}
+
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+    /* no pacing */
+    return -1;
+}
+
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size)
+{
+    /* in-flight accounting is up to the caller */
+    (void)cong;
+    (void)msg_size;
+}
+
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+}
+
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs)
+{
+    congure_snd_msg_t *msg = msgs;
+    ztimer_now_t newest;
+
+    if (msgs == NULL) {
+        return;
+    }
+    newest = msgs->send_time;
+    /* msgs is the tail of a circular list, so the walk ends at msgs */
+    do {
+        msg = (congure_snd_msg_t *)msg->super.next;
+        if ((int32_t)(msg->send_time - newest) > 0) {
+            newest = msg->send_time;
+        }
+    } while (msg != msgs);
+    _decrease((congure_aimd_snd_t *)cong, newest);
+}
+
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack)
+{
+    congure_aimd_snd_t *c = (congure_aimd_snd_t *)cong;
+    uint32_t acked = (uint32_t)c->acked + msg->size;
+
+    (void)ack;
+    if (acked >= c->super.cwnd) {
+        uint32_t cwnd = (uint32_t)c->super.cwnd + c->consts->ai;
+
+        acked -= c->super.cwnd;
+        c->super.cwnd = (cwnd > c->consts->max_wnd) ? c->consts->max_wnd
+                                                    : (congure_wnd_size_t)cwnd;
+    }
+    c->acked = (acked > c->super.cwnd) ? c->super.cwnd
+                                       : (congure_wnd_size_t)acked;
+}
+
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time)
+{
+    _decrease((congure_aimd_snd_t *)cong, time);
+}
+
+/** @} */
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+
+#include "congure/reno.h"
+
+static void _snd_init(congure_snd_t *cong, void *ctx);
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs);
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs);
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack);
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time);
+
+static const congure_snd_driver_t _driver = {
+    .init = _snd_init,
+    .inter_msg_interval = _snd_inter_msg_interval,
+    .report_msg_sent = _snd_report_msg_sent,
+    .report_msg_discarded = _snd_report_msg_discarded,
+    .report_msgs_timeout = _snd_report_msgs_timeout,
+    .report_msgs_lost = _snd_report_msgs_lost,
+    .report_msg_acked = _snd_report_msg_acked,
+    .report_ecn_ce = _snd_report_ecn_ce,
+};
+
+void congure_reno_snd_setup(congure_reno_snd_t *c,
+                            const congure_reno_consts_t *consts)
+{
+    assert(consts->min_wnd <= consts->init_wnd);
+    assert(consts->init_wnd <= consts->max_wnd);
+    assert(consts->mss > 0);
+    c->super.driver = &_driver;
+    c->consts = consts;
+}
+
+static inline congure_wnd_size_t _limit(const congure_reno_snd_t *c,
+                                        uint32_t wnd)
+{
+    if (wnd < c->consts->min_wnd) {
+        return c->consts->min_wnd;
+    }
+    if (wnd > c->consts->max_wnd) {
+        return c->consts->max_wnd;
+    }
+    return (congure_wnd_size_t)wnd;
+}
+
+static ztimer_now_t _newest_send_time(congure_snd_msg_t *msgs)
+{
+    congure_snd_msg_t *msg = msgs;
+    ztimer_now_t newest = msgs->send_time;
+
+    /* msgs is the tail of a circular list, so the walk ends at msgs */
+    do {
+        msg = (congure_snd_msg_t *)msg->super.next;
+        if ((int32_t)(msg->send_time - newest) > 0) {
+            newest = msg->send_time;
+        }
+    } while (msg != msgs);
+    return newest;
+}
+
+/* returns false if the congestion event was already reacted upon */
+static bool _enter_recovery(congure_reno_snd_t *c, ztimer_now_t send_time)
+{
+    if (c->in_recovery && ((int32_t)(send_time - c->recover) <= 0)) {
+        return false;
+    }
+    c->ssthresh = _limit(c, c->super.cwnd / 2U);
+    c->acked = 0;
+    c->recover = send_time;
+    c->in_recovery = true;
+    return true;
+}
+
+static void _snd_init(congure_snd_t *cong, void *ctx)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    c->super.ctx = ctx;
+    c->super.cwnd = c->consts->init_wnd;
+    c->ssthresh = c->consts->init_ssthresh;
+    c->acked = 0;
+    c->recover = 0;
+    c->in_recovery = false;
+}
+
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+    /* no pacing */
+    return -1;
+}
+
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size)
+{
+    /* in-flight accounting is up to the caller */
+    (void)cong;
+    (void)msg_size;
+}
+
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+}
+
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    if ((msgs != NULL) && _enter_recovery(c, _newest_send_time(msgs))) {
+        /* back to slow start */
+        c->super.cwnd = c->consts->min_wnd;
+    }
+}
+
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    if ((msgs != NULL) && _enter_recovery(c, _newest_send_time(msgs))) {
+        /* fast recovery: continue in congestion avoidance */
+        c->super.cwnd = c->ssthresh;
+    }
+}
+
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    (void)ack;
+    if (c->super.cwnd < c->ssthresh) {
+        /* slow start */
+        c->super.cwnd = _limit(c, (uint32_t)c->super.cwnd + msg->size);
+    }
+    else {
+        /* congestion avoidance */
+        uint32_t acked = (uint32_t)c->acked + msg->size;
+
+        if (acked >= c->super.cwnd) {
+            acked -= c->super.cwnd;
+            c->super.cwnd = _limit(c, (uint32_t)c->super.cwnd +
+                                      c->consts->mss);
+        }
+        c->acked = (acked > c->super.cwnd) ? c->super.cwnd
+                                           : (congure_wnd_size_t)acked;
+    }
+}
+
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    if (_enter_recovery(c, time)) {
+        c->super.cwnd = c->ssthresh;
+    }
+}
+
+/** @} */
@@ -69,12 +69,25 @@ static const cipher_interface_t aes_interface = {
     AES_BLOCK_SIZE,
     aes_init,
     aes_encrypt,
-    aes_decrypt
+    aes_decrypt,
+    aes_encrypt_blocks,
+    aes_decrypt_blocks,
 };
 
 const cipher_id_t CIPHER_AES_128 = &aes_interface;
 const cipher_id_t CIPHER_AES = &aes_interface;
 
+/* The T-table implementation below is replaced by aes_ni.c, aes_armv8.c or
+ * aes_ct.c if one of them is selected */
+#if !IS_USED(MODULE_CRYPTO_AES_NI) && !IS_USED(MODULE_CRYPTO_AES_ARMV8) && \
+    !IS_USED(MODULE_CRYPTO_AES_CT)
+#  define AES_TTABLE 1
+#else
+#  define AES_TTABLE 0
+#endif
+
+#if AES_TTABLE
+
 static const u32 Te0[256] = {
     0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU,
     0xfff2f20dU, 0xd66b6bbdU, 0xde6f6fb1U, 0x91c5c554U,
@@ -818,6 +831,8 @@ static const u32 rcon[] = {
     0x1B000000, 0x36000000,
 };
 
+#endif /* AES_TTABLE */
+
 int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
 {
     uint8_t i;
@@ -857,6 +872,27 @@ int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
     return CIPHER_INIT_SUCCESS;
 }
 
+/*
+ * Encrypt a single block
+ * in and out can overlap
+ */
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
+
+/*
+ * Decrypt a single block
+ * in and out can overlap
+ */
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+    return aes_decrypt_blocks(context, cipherBlock, plainBlock, 1);
+}
+
+#if AES_TTABLE
 /**
  * Expand the cipher key into the encryption key schedule.
  */
@@ -1055,23 +1091,12 @@ static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
 
 #ifndef AES_ASM
 /*
- * Encrypt a single block
+ * Encrypt a single block with an expanded key
  * in and out can overlap
  */
-int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
-                uint8_t *cipherBlock)
+static void _encrypt_block(const AES_KEY *key, const uint8_t *plainBlock,
+                           uint8_t *cipherBlock)
 {
-    /* setup AES_KEY */
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-
-    res = aes_set_encrypt_key((unsigned char *)context->context,
-                              AES_KEY_SIZE(context) * 8, &aeskey);
-    if (res < 0) {
-        return res;
-    }
-
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 
@@ -1320,28 +1345,41 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         (Te4((t2) & 0xff)       & 0x000000ff) ^
         rk[3];
     PUTU32(cipherBlock + 12, s3);
-    return 1;
 }
 
 /*
- * Decrypt a single block
+ * Encrypt consecutive blocks, expanding the key only once
  * in and out can overlap
  */
-int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
-                uint8_t *plainBlock)
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks)
 {
     /* setup AES_KEY */
     int res;
     AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
 
-    res = aes_set_decrypt_key((unsigned char *)context->context,
+    res = aes_set_encrypt_key((unsigned char *)context->context,
                               AES_KEY_SIZE(context) * 8, &aeskey);
-
     if (res < 0) {
         return res;
     }
 
+    for (; blocks; blocks--) {
+        _encrypt_block(&aeskey, in, out);
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+
+    return 1;
+}
+
+/*
+ * Decrypt a single block with an expanded key
+ * in and out can overlap
+ */
+static void _decrypt_block(const AES_KEY *key, const uint8_t *cipherBlock,
+                           uint8_t *plainBlock)
+{
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 
@@ -1582,7 +1620,33 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
         (Td4((t0) & 0xff)       & 0x000000ff) ^
         rk[3];
     PUTU32(plainBlock + 12, s3);
+}
+
+/*
+ * Decrypt consecutive blocks, expanding the key only once
+ * in and out can overlap
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks)
+{
+    /* setup AES_KEY */
+    int res;
+    AES_KEY aeskey;
+
+    res = aes_set_decrypt_key((unsigned char *)context->context,
+                              AES_KEY_SIZE(context) * 8, &aeskey);
+    if (res < 0) {
+        return res;
+    }
+
+    for (; blocks; blocks--) {
+        _decrypt_block(&aeskey, in, out);
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+
     return 1;
 }
 
 #endif /* AES_ASM */
+#endif /* AES_TTABLE */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       AES backend using the ARMv8 Cryptography Extension
+ *
+ * Selected by the `crypto_aes_armv8` pseudomodule. The target must be built
+ * with the extension enabled, e.g. with `-march=armv8-a+crypto`.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_CRYPTO_AES_ARMV8)
+
+#if !defined(__ARM_FEATURE_CRYPTO) && !defined(__ARM_FEATURE_AES)
+#error "crypto_aes_armv8: build with the ARMv8 Cryptography Extension enabled"
+#endif
+
+#include <stdint.h>
+#include <arm_neon.h>
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/helper.h"
+#include "aes_internal.h"
+
+static uint32_t _sub_word(uint32_t w)
+{
+    /* with four equal columns, ShiftRows of AESE has no effect */
+    uint8x16_t x = vreinterpretq_u8_u32(vdupq_n_u32(w));
+
+    x = vaeseq_u8(x, vdupq_n_u8(0));
+    return vgetq_lane_u32(vreinterpretq_u32_u8(x), 0);
+}
+
+static unsigned _expand_key(const cipher_context_t *context, uint8x16_t *rk)
+{
+    uint32_t w[4 * (AES_MAXNR + 1)];
+    unsigned rounds = AES_ROUNDS(context->key_size);
+
+    aes_expand_key(context->context, context->key_size, w, _sub_word);
+    for (unsigned r = 0; r <= rounds; r++) {
+        rk[r] = vreinterpretq_u8_u32(vld1q_u32(&w[4 * r]));
+    }
+    crypto_secure_wipe(w, sizeof(w));
+
+    return rounds;
+}
+
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks)
+{
+    uint8x16_t rk[AES_MAXNR + 1];
+    unsigned rounds = _expand_key(context, rk);
+
+    for (; blocks; blocks--) {
+        uint8x16_t x = vld1q_u8(in);
+
+        /* AESE adds the round key before SubBytes and ShiftRows */
+        for (unsigned r = 0; r < rounds - 1; r++) {
+            x = vaesmcq_u8(vaeseq_u8(x, rk[r]));
+        }
+        x = veorq_u8(vaeseq_u8(x, rk[rounds - 1]), rk[rounds]);
+        vst1q_u8(out, x);
+
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+
+    crypto_secure_wipe(rk, sizeof(rk));
+    return 1;
+}
+
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks)
+{
+    uint8x16_t rk[AES_MAXNR + 1];
+    uint8x16_t dk[AES_MAXNR + 1];
+    unsigned rounds = _expand_key(context, rk);
+
+    /* round keys of the equivalent inverse cipher */
+    dk[0] = rk[rounds];
+    for (unsigned r = 1; r < rounds; r++) {
+        dk[r] = vaesimcq_u8(rk[rounds - r]);
+    }
+    dk[rounds] = rk[0];
+
+    for (; blocks; blocks--) {
+        uint8x16_t x = vld1q_u8(in);
+
+        for (unsigned r = 0; r < rounds - 1; r++) {
+            x = vaesimcq_u8(vaesdq_u8(x, dk[r]));
+        }
+        x = veorq_u8(vaesdq_u8(x, dk[rounds - 1]), dk[rounds]);
+        vst1q_u8(out, x);
+
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+
+    crypto_secure_wipe(rk, sizeof(rk));
+    crypto_secure_wipe(dk, sizeof(dk));
+    return 1;
+}
+
+#endif /* MODULE_CRYPTO_AES_ARMV8 */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Constant-time AES backend for MCUs without a crypto engine
+ *
+ * The T-table implementation in aes.c indexes tables with secret data, so
+ * its timing depends on the key on any CPU with a data cache or flash
+ * wait-state buffer. This backend uses no lookup tables and no
+ * data-dependent branches: the S-box is computed as the inverse in GF(2^8)
+ * followed by the affine transformation, with the four bytes of a column
+ * packed into one 32-bit word and processed in parallel.
+ *
+ * It is considerably slower than the T-table implementation. Selected by
+ * the `crypto_aes_ct` pseudomodule.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_CRYPTO_AES_CT)
+
+#include <stdint.h>
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/helper.h"
+#include "aes_internal.h"
+
+/* 0x01 in each byte set to 1 in x, without a multiplication */
+static inline uint32_t _lsb_mask(uint32_t x)
+{
+    x &= 0x01010101;
+    return (x << 8) - x;
+}
+
+/* multiplies each byte by x in GF(2^8) */
+static inline uint32_t _xtime(uint32_t x)
+{
+    uint32_t hi = (x >> 7) & 0x01010101;
+
+    return ((x & 0x7f7f7f7f) << 1) ^ hi ^ (hi << 1) ^ (hi << 3) ^ (hi << 4);
+}
+
+/* multiplies each byte of a by the corresponding byte of b in GF(2^8) */
+static uint32_t _gmul(uint32_t a, uint32_t b)
+{
+    uint32_t r = 0;
+
+    for (unsigned i = 0; i < 8; i++) {
+        r ^= a & _lsb_mask(b >> i);
+        a = _xtime(a);
+    }
+    return r;
+}
+
+/* inverts each byte in GF(2^8), mapping 0 to 0: x^254 */
+static uint32_t _ginv(uint32_t x)
+{
+    uint32_t x2 = _gmul(x, x);
+    uint32_t x3 = _gmul(x2, x);
+    uint32_t x12 = _gmul(x3, x3);
+    uint32_t y;
+
+    x12 = _gmul(x12, x12);
+    y = _gmul(x12, x3);             /* x^15 */
+    y = _gmul(y, y);
+    y = _gmul(y, y);
+    y = _gmul(y, y);
+    y = _gmul(y, y);                /* x^240 */
+    y = _gmul(y, x12);              /* x^252 */
+    return _gmul(y, x2);
+}
+
+/* rotates each byte left by n bits */
+static inline uint32_t _rotb(uint32_t x, unsigned n)
+{
+    uint32_t hi = (0xffu << n) & 0xff;
+
+    return ((x << n) & (hi * 0x01010101)) |
+           ((x >> (8 - n)) & ((~hi & 0xff) * 0x01010101));
+}
+
+static uint32_t _sub_word(uint32_t x)
+{
+    x = _ginv(x);
+    return x ^ _rotb(x, 1) ^ _rotb(x, 2) ^ _rotb(x, 3) ^ _rotb(x, 4) ^
+           0x63636363;
+}
+
+static uint32_t _inv_sub_word(uint32_t x)
+{
+    return _ginv(_rotb(x, 1) ^ _rotb(x, 3) ^ _rotb(x, 6) ^ 0x05050505);
+}
+
+static inline uint32_t _ror(uint32_t x, unsigned n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+/* columns are words, row r is byte r of each word */
+static void _shift_rows(uint32_t *s)
+{
+    uint32_t t[4];
+
+    for (unsigned c = 0; c < 4; c++) {
+        t[c] = (s[c] & 0x000000ff) | (s[(c + 1) % 4] & 0x0000ff00) |
+               (s[(c + 2) % 4] & 0x00ff0000) | (s[(c + 3) % 4] & 0xff000000);
+    }
+    for (unsigned c = 0; c < 4; c++) {
+        s[c] = t[c];
+    }
+}
+
+static void _inv_shift_rows(uint32_t *s)
+{
+    uint32_t t[4];
+
+    for (unsigned c = 0; c < 4; c++) {
+        t[c] = (s[c] & 0x000000ff) | (s[(c + 3) % 4] & 0x0000ff00) |
+               (s[(c + 2) % 4] & 0x00ff0000) | (s[(c + 1) % 4] & 0xff000000);
+    }
+    for (unsigned c = 0; c < 4; c++) {
+        s[c] = t[c];
+    }
+}
+
+static inline uint32_t _mix_column(uint32_t x)
+{
+    uint32_t r1 = _ror(x, 8);
+
+    return _xtime(x ^ r1) ^ r1 ^ _ror(x, 16) ^ _ror(x, 24);
+}
+
+static inline uint32_t _inv_mix_column(uint32_t x)
+{
+    /* InvMixColumns is MixColumns after adding 4 * (a[i] ^ a[i + 2]) */
+    return _mix_column(x ^ _xtime(_xtime(x ^ _ror(x, 16))));
+}
+
+static inline uint32_t _load_column(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static inline void _store_column(uint8_t *p, uint32_t x)
+{
+    p[0] = x;
+    p[1] = x >> 8;
+    p[2] = x >> 16;
+    p[3] = x >> 24;
+}
+
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks)
+{
+    uint32_t rk[4 * (AES_MAXNR + 1)];
+    unsigned rounds = AES_ROUNDS(context->key_size);
+
+    aes_expand_key(context->context, context->key_size, rk, _sub_word);
+
+    for (; blocks; blocks--) {
+        uint32_t s[4];
+
+        for (unsigned c = 0; c < 4; c++) {
+            s[c] = _load_column(in + 4 * c) ^ rk[c];
+        }
+        for (unsigned r = 1; r <= rounds; r++) {
+            for (unsigned c = 0; c < 4; c++) {
+                s[c] = _sub_word(s[c]);
+            }
+            _shift_rows(s);
+            for (unsigned c = 0; c < 4; c++) {
+                if (r < rounds) {
+                    s[c] = _mix_column(s[c]);
+                }
+                s[c] ^= rk[4 * r + c];
+            }
+        }
+        for (unsigned c = 0; c < 4; c++) {
+            _store_column(out + 4 * c, s[c]);
+        }
+
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+
+    crypto_secure_wipe(rk, sizeof(rk));
+    return 1;
+}
+
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks)
+{
+    uint32_t rk[4 * (AES_MAXNR + 1)];
+    unsigned rounds = AES_ROUNDS(context->key_size);
+
+    aes_expand_key(context->context, context->key_size, rk, _sub_word);
+
+    for (; blocks; blocks--) {
+        uint32_t s[4];
+
+        for (unsigned c = 0; c < 4; c++) {
+            s[c] = _load_column(in + 4 * c) ^ rk[4 * rounds + c];
+        }
+        for (unsigned r = rounds; r--;) {
+            _inv_shift_rows(s);
+            for (unsigned c = 0; c < 4; c++) {
+                s[c] = _inv_sub_word(s[c]) ^ rk[4 * r + c];
+                if (r > 0) {
+                    s[c] = _inv_mix_column(s[c]);
+                }
+            }
+        }
+        for (unsigned c = 0; c < 4; c++) {
+            _store_column(out + 4 * c, s[c]);
+        }
+
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+
+    crypto_secure_wipe(rk, sizeof(rk));
+    return 1;
+}
+
+#endif /* MODULE_CRYPTO_AES_CT */
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Key schedule shared by the alternative AES backends
+ *
+ * @internal
+ */
+
+#ifndef AES_INTERNAL_H
+#define AES_INTERNAL_H
+
+#include <stdint.h>
+
+#include "crypto/aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of rounds for a key of @p key_size bytes
+ */
+#define AES_ROUNDS(key_size)    ((key_size) / 4 + 6)
+
+/**
+ * @brief   Applies the S-box to each byte of a word
+ */
+typedef uint32_t (*aes_sub_word_t)(uint32_t w);
+
+/**
+ * @brief   Expands a key into the encryption round keys of FIPS-197
+ *
+ * Byte `i` of each round key is stored in bits `8 * (i % 4)` of word
+ * `i / 4`, i.e. on a little-endian CPU, the round keys are laid out in
+ * memory like the state.
+ *
+ * @param[in]  key          cipher key
+ * @param[in]  key_size     size of @p key in bytes
+ * @param[out] rk           round keys, 4 * (AES_ROUNDS(key_size) + 1) words
+ * @param[in]  sub_word     S-box of the backend
+ */
+static inline void aes_expand_key(const uint8_t *key, uint8_t key_size,
+                                  uint32_t *rk, aes_sub_word_t sub_word)
+{
+    unsigned nk = key_size / 4;
+    unsigned words = 4 * (AES_ROUNDS(key_size) + 1);
+    uint8_t rcon = 0x01;
+
+    for (unsigned i = 0; i < nk; i++) {
+        rk[i] = (uint32_t)key[4 * i] | ((uint32_t)key[4 * i + 1] << 8) |
+                ((uint32_t)key[4 * i + 2] << 16) |
+                ((uint32_t)key[4 * i + 3] << 24);
+    }
+
+    for (unsigned i = nk; i < words; i++) {
+        uint32_t t = rk[i - 1];
+
+        if (i % nk == 0) {
+            /* RotWord, SubWord and Rcon */
+            t = sub_word((t >> 8) | (t << 24)) ^ rcon;
+            rcon = (rcon << 1) ^ ((rcon >> 7) * 0x1b);
+        }
+        else if (nk > 6 && i % nk == 4) {
+            t = sub_word(t);
+        }
+        rk[i] = rk[i - nk] ^ t;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AES_INTERNAL_H */
+/** @} */
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       AES backend using the x86 AES-NI instructions
+ *
+ * The instructions are enabled per function, so the rest of the build does
+ * not depend on the CPU of the host. Selected by the `crypto_aes_ni`
+ * pseudomodule.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_CRYPTO_AES_NI)
+
+#if !defined(__x86_64__) && !defined(__i386__)
+#error "crypto_aes_ni: AES-NI is only available on x86"
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include <wmmintrin.h>
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/helper.h"
+#include "aes_internal.h"
+
+#define AES_NI_TARGET   __attribute__((target("aes,sse2")))
+
+AES_NI_TARGET
+static uint32_t _sub_word(uint32_t w)
+{
+    /* aeskeygenassist puts SubWord() of the second word into the first */
+    __m128i x = _mm_set1_epi32((int)w);
+
+    return (uint32_t)_mm_cvtsi128_si32(_mm_aeskeygenassist_si128(x, 0));
+}
+
+static unsigned _expand_key(const cipher_context_t *context, __m128i *rk)
+{
+    uint32_t w[4 * (AES_MAXNR + 1)];
+    unsigned rounds = AES_ROUNDS(context->key_size);
+
+    aes_expand_key(context->context, context->key_size, w, _sub_word);
+    memcpy(rk, w, 16 * (rounds + 1));
+    crypto_secure_wipe(w, sizeof(w));
+
+    return rounds;
+}
+
+AES_NI_TARGET
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks)
+{
+    __m128i rk[AES_MAXNR + 1];
+    unsigned rounds = _expand_key(context, rk);
+
+    for (; blocks; blocks--) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(const void *)in);
+
+        x = _mm_xor_si128(x, rk[0]);
+        for (unsigned r = 1; r < rounds; r++) {
+            x = _mm_aesenc_si128(x, rk[r]);
+        }
+        x = _mm_aesenclast_si128(x, rk[rounds]);
+        _mm_storeu_si128((__m128i *)(void *)out, x);
+
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+
+    crypto_secure_wipe(rk, sizeof(rk));
+    return 1;
+}
+
+AES_NI_TARGET
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks)
+{
+    __m128i rk[AES_MAXNR + 1];
+    __m128i dk[AES_MAXNR + 1];
+    unsigned rounds = _expand_key(context, rk);
+
+    /* round keys of the equivalent inverse cipher */
+    dk[0] = rk[rounds];
+    for (unsigned r = 1; r < rounds; r++) {
+        dk[r] = _mm_aesimc_si128(rk[rounds - r]);
+    }
+    dk[rounds] = rk[0];
+
+    for (; blocks; blocks--) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(const void *)in);
+
+        x = _mm_xor_si128(x, dk[0]);
+        for (unsigned r = 1; r < rounds; r++) {
+            x = _mm_aesdec_si128(x, dk[r]);
+        }
+        x = _mm_aesdeclast_si128(x, dk[rounds]);
+        _mm_storeu_si128((__m128i *)(void *)out, x);
+
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+
+    crypto_secure_wipe(rk, sizeof(rk));
+    crypto_secure_wipe(dk, sizeof(dk));
+    return 1;
+}
+
+#endif /* MODULE_CRYPTO_AES_NI */
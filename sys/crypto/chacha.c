@@ -25,13 +25,15 @@
  * Please notice:
  *  - This implementation of the ChaCha stream cipher is very stripped down.
  *  - It assumes a little-endian system.
- *  - It is implemented for little code and data size, but will likely be
- *    slower than the refenrence implementation. Optimized implementation will
- *    out-perform the code even more.
+ *  - Single blocks are computed with a loop for little code size, several
+ *    blocks are computed side by side in the lanes of SIMD registers or, on
+ *    CPUs without them, two blocks interleaved in general purpose registers.
  */
 
 #include "crypto/chacha.h"
+#include "crypto/helper.h"
 #include "byteorder.h"
+#include "chacha_internal.h"
 
 #if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
 #   error \
@@ -74,6 +76,92 @@ static void _doubleround(void *output_, const uint32_t input[16],
     }
 }
 
+#if CHACHA_LANES == 4 && (defined(__i386__) || defined(__x86_64__))
+#define CHACHA_TARGET   __attribute__((target("sse2")))
+#else
+#define CHACHA_TARGET
+#endif
+
+/* one block per lane */
+typedef uint32_t chacha_vec_t __attribute__((vector_size(4 * CHACHA_LANES)));
+
+#define ROTL(x, n)  (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define QUARTERROUND(a, b, c, d)        \
+    do {                                \
+        a += b; d ^= a; d = ROTL(d, 16); \
+        c += d; b ^= c; b = ROTL(b, 12); \
+        a += b; d ^= a; d = ROTL(d, 8);  \
+        c += d; b ^= c; b = ROTL(b, 7);  \
+    } while (0)
+
+/* computes CHACHA_LANES consecutive blocks */
+CHACHA_TARGET
+static void _blocks_lanes(const uint32_t state[16], unsigned rounds,
+                          uint8_t *out)
+{
+    chacha_vec_t in[16];
+    chacha_vec_t x[16];
+
+    for (unsigned i = 0; i < 16; i++) {
+        in[i] = (chacha_vec_t){ 0 } + state[i];
+    }
+    for (unsigned l = 0; l < CHACHA_LANES; l++) {
+        in[12][l] += l;
+    }
+    memcpy(x, in, sizeof(x));
+
+    for (unsigned r = 0; r < rounds; r += 2) {
+        QUARTERROUND(x[0], x[4], x[8], x[12]);
+        QUARTERROUND(x[1], x[5], x[9], x[13]);
+        QUARTERROUND(x[2], x[6], x[10], x[14]);
+        QUARTERROUND(x[3], x[7], x[11], x[15]);
+        QUARTERROUND(x[0], x[5], x[10], x[15]);
+        QUARTERROUND(x[1], x[6], x[11], x[12]);
+        QUARTERROUND(x[2], x[7], x[8], x[13]);
+        QUARTERROUND(x[3], x[4], x[9], x[14]);
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        x[i] += in[i];
+        for (unsigned l = 0; l < CHACHA_LANES; l++) {
+            uint32_t w = x[i][l];
+
+            memcpy(&out[CHACHA_BLOCK_SIZE * l + 4 * i], &w, sizeof(w));
+        }
+    }
+}
+
+void chacha_blocks(const uint32_t state[16], unsigned rounds, void *out_,
+                   size_t blocks)
+{
+    uint8_t *out = out_;
+    uint32_t s[16];
+
+    memcpy(s, state, sizeof(s));
+
+    for (; blocks >= CHACHA_LANES; blocks -= CHACHA_LANES) {
+        _blocks_lanes(s, rounds, out);
+        s[12] += CHACHA_LANES;
+        out += CHACHA_LANES * CHACHA_BLOCK_SIZE;
+    }
+
+    if (blocks > 1) {
+        uint8_t tmp[CHACHA_LANES * CHACHA_BLOCK_SIZE];
+
+        _blocks_lanes(s, rounds, tmp);
+        memcpy(out, tmp, blocks * CHACHA_BLOCK_SIZE);
+        crypto_secure_wipe(tmp, sizeof(tmp));
+    }
+    else if (blocks) {
+        uint32_t x[16];
+
+        _doubleround(x, s, rounds);
+        memcpy(out, x, sizeof(x));
+        crypto_secure_wipe(x, sizeof(x));
+    }
+}
+
 int chacha_init(chacha_ctx *ctx,
                 unsigned rounds,
                 const uint8_t *key, uint32_t keylen,
@@ -115,6 +203,26 @@ void chacha_keystream_bytes(chacha_ctx *ctx, void *x)
     }
 }
 
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x_, size_t blocks)
+{
+    uint8_t *x = x_;
+
+    while (blocks) {
+        /* chacha_blocks() only increments the lower word of the counter */
+        uint64_t until_wrap = (uint64_t)UINT32_MAX + 1 - ctx->state[12];
+        size_t n = (blocks < until_wrap) ? blocks : (size_t)until_wrap;
+
+        chacha_blocks(ctx->state, ctx->rounds, x, n);
+
+        ctx->state[12] += n;
+        if (ctx->state[12] == 0) {
+            ++ctx->state[13];
+        }
+        x += n * CHACHA_BLOCK_SIZE;
+        blocks -= n;
+    }
+}
+
 void chacha_encrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c)
 {
     uint8_t x[64];
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       ChaCha block function shared by chacha.c and chacha20poly1305.c
+ *
+ * @}
+ */
+
+#ifndef CHACHA_INTERNAL_H
+#define CHACHA_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of a ChaCha keystream block in bytes
+ */
+#define CHACHA_BLOCK_SIZE   (64U)
+
+/**
+ * @brief   Number of blocks computed in parallel
+ *
+ * 4 with SSE2 on x86 and NEON on ARM, otherwise 2 interleaved blocks in
+ * general purpose registers.
+ */
+#if defined(__i386__) || defined(__x86_64__) || defined(__ARM_NEON)
+#define CHACHA_LANES        (4U)
+#else
+#define CHACHA_LANES        (2U)
+#endif
+
+/**
+ * @brief   Computes consecutive keystream blocks
+ *
+ * The block counter is the 32-bit word 12 of @p state and is incremented for
+ * each block, the caller has to make sure it does not wrap.
+ *
+ * @param[in]  state    input state: constant, key, counter, nonce
+ * @param[in]  rounds   number of rounds: 8, 12 or 20
+ * @param[out] out      @p blocks * CHACHA_BLOCK_SIZE bytes of keystream
+ * @param[in]  blocks   number of blocks
+ */
+void chacha_blocks(const uint32_t state[16], unsigned rounds, void *out,
+                   size_t blocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHACHA_INTERNAL_H */
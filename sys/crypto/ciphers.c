@@ -17,6 +17,7 @@
 #include <string.h>
 #include <stdio.h>
 #include "crypto/ciphers.h"
+#include "crypto/helper.h"
 
 
 int cipher_init(cipher_t *cipher, cipher_id_t cipher_id, const uint8_t *key,
@@ -41,6 +42,69 @@ int cipher_decrypt(const cipher_t *cipher, const uint8_t *input,
 }
 
 
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks)
+{
+    uint8_t block_size = cipher->interface->block_size;
+
+    if (cipher->interface->encrypt_blocks) {
+        return cipher->interface->encrypt_blocks(&cipher->context, input,
+                                                 output, blocks);
+    }
+
+    for (; blocks; blocks--) {
+        int res = cipher->interface->encrypt(&cipher->context, input, output);
+        if (res != 1) {
+            return res;
+        }
+        input += block_size;
+        output += block_size;
+    }
+
+    return 1;
+}
+
+
+int cipher_decrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks)
+{
+    uint8_t block_size = cipher->interface->block_size;
+
+    if (cipher->interface->decrypt_blocks) {
+        return cipher->interface->decrypt_blocks(&cipher->context, input,
+                                                 output, blocks);
+    }
+
+    for (; blocks; blocks--) {
+        int res = cipher->interface->decrypt(&cipher->context, input, output);
+        if (res != 1) {
+            return res;
+        }
+        input += block_size;
+        output += block_size;
+    }
+
+    return 1;
+}
+
+
+int cipher_ctr_keystream(const cipher_t *cipher, uint8_t *nonce_counter,
+                         uint8_t nonce_len, uint8_t *stream, size_t blocks)
+{
+    uint8_t block_size = cipher->interface->block_size;
+    uint8_t *block = stream;
+
+    /* lay out the counter blocks, then encrypt them in place */
+    for (size_t i = 0; i < blocks; i++) {
+        memcpy(block, nonce_counter, block_size);
+        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        block += block_size;
+    }
+
+    return cipher_encrypt_blocks(cipher, stream, stream, blocks);
+}
+
+
 int cipher_get_block_size(const cipher_t *cipher)
 {
     return cipher->interface->block_size;
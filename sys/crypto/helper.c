@@ -7,6 +7,8 @@
  * directory for more details.
  */
 
+#include <string.h>
+
 #include "crypto/helper.h"
 
 void crypto_block_inc_ctr(uint8_t block[16], int L)
@@ -20,6 +22,27 @@ void crypto_block_inc_ctr(uint8_t block[16], int L)
     }
 }
 
+void crypto_xor(uint8_t *out, const uint8_t *a, const uint8_t *b, size_t len)
+{
+    /* memcpy() lets the compiler use word accesses where the CPU allows
+     * unaligned ones, and keeps it safe where it does not */
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+        uint32_t x, y;
+
+        memcpy(&x, a, sizeof(x));
+        memcpy(&y, b, sizeof(y));
+        x ^= y;
+        memcpy(out, &x, sizeof(x));
+        out += sizeof(uint32_t);
+        a += sizeof(uint32_t);
+        b += sizeof(uint32_t);
+    }
+
+    for (; len; len--) {
+        *out++ = *a++ ^ *b++;
+    }
+}
+
 int crypto_equals(const uint8_t *a, const uint8_t *b, size_t len)
 {
     uint8_t diff = 0;
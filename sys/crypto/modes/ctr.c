@@ -26,24 +26,33 @@ int cipher_encrypt_ctr(const cipher_t *cipher, uint8_t nonce_counter[16],
                        uint8_t *output)
 {
     size_t offset = 0;
-    uint8_t stream_block[16] = { 0 }, block_size;
+    uint8_t stream[CONFIG_CIPHER_CTR_STREAM_BLOCKS * CIPHER_MAX_BLOCK_SIZE];
+    uint8_t block_size;
 
     block_size = cipher_get_block_size(cipher);
     do {
-        uint8_t block_size_input;
+        size_t blocks = (length - offset + block_size - 1) / block_size;
+        size_t stream_len;
 
-        if (cipher_encrypt(cipher, nonce_counter, stream_block) != 1) {
+        if (blocks > CONFIG_CIPHER_CTR_STREAM_BLOCKS) {
+            blocks = CONFIG_CIPHER_CTR_STREAM_BLOCKS;
+        }
+        else if (blocks == 0) {
+            blocks = 1;
+        }
+
+        if (cipher_ctr_keystream(cipher, nonce_counter, nonce_len, stream,
+                                 blocks) != 1) {
             return CIPHER_ERR_ENC_FAILED;
         }
 
-        block_size_input = (length - offset > block_size) ?
-                           block_size : length - offset;
-        for (uint8_t i = 0; i < block_size_input; ++i) {
-            output[offset + i] = stream_block[i] ^ input[offset + i];
+        stream_len = blocks * block_size;
+        if (stream_len > length - offset) {
+            stream_len = length - offset;
         }
+        crypto_xor(output + offset, input + offset, stream, stream_len);
 
-        offset += block_size_input;
-        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        offset += stream_len;
     } while (offset < length);
 
     return offset;
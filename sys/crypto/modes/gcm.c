@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Crypto mode - Galois/Counter Mode
+ *
+ * @author      RIOT Developers
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "crypto/helper.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/gcm.h"
+
+#if IS_USED(MODULE_CRYPTO_AES_NI)
+#define GHASH_PCLMUL    1
+#elif IS_USED(MODULE_CRYPTO_AES_ARMV8)
+#define GHASH_PMULL     1
+#endif
+
+#if GHASH_PCLMUL
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+#define GHASH_TARGET    __attribute__((target("pclmul,sse2,ssse3")))
+
+typedef struct {
+    __m128i h;              /**< hash key, byte-reversed */
+} _ghash_key_t;
+
+GHASH_TARGET
+static inline __m128i _load_bswap(const uint8_t *p)
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                       8, 9, 10, 11, 12, 13, 14, 15);
+
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)p),
+                            bswap);
+}
+
+GHASH_TARGET
+static void _ghash_init(_ghash_key_t *key, const uint8_t h[16])
+{
+    key->h = _load_bswap(h);
+}
+
+/*
+ * Multiplication in GF(2^128) of byte-reversed operands, after Gueron and
+ * Kounavis, "Intel Carry-Less Multiplication Instruction and its Usage for
+ * Computing the GCM Mode", Algorithm 5. The bit-reflection of GCM is handled
+ * by shifting the product left by one bit before the reduction.
+ */
+GHASH_TARGET
+static void _ghash_mul(const _ghash_key_t *key, uint8_t y[16])
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                       8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i a = _load_bswap(y);
+    __m128i lo, hi, mid, t0, t1, t2;
+
+    lo = _mm_clmulepi64_si128(a, key->h, 0x00);
+    hi = _mm_clmulepi64_si128(a, key->h, 0x11);
+    mid = _mm_xor_si128(_mm_clmulepi64_si128(a, key->h, 0x10),
+                        _mm_clmulepi64_si128(a, key->h, 0x01));
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    /* shift the 256 bit product hi:lo left by one bit */
+    t0 = _mm_srli_epi32(lo, 31);
+    t1 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    t2 = _mm_srli_si128(t0, 12);
+    t1 = _mm_slli_si128(t1, 4);
+    t0 = _mm_slli_si128(t0, 4);
+    lo = _mm_or_si128(lo, t0);
+    hi = _mm_or_si128(hi, t1);
+    hi = _mm_or_si128(hi, t2);
+
+    /* reduce modulo x^128 + x^7 + x^2 + x + 1 */
+    t0 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31),
+                                     _mm_slli_epi32(lo, 30)),
+                       _mm_slli_epi32(lo, 25));
+    t1 = _mm_srli_si128(t0, 4);
+    t0 = _mm_slli_si128(t0, 12);
+    lo = _mm_xor_si128(lo, t0);
+    t2 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1),
+                                     _mm_srli_epi32(lo, 2)),
+                       _mm_srli_epi32(lo, 7));
+    t2 = _mm_xor_si128(t2, t1);
+    lo = _mm_xor_si128(lo, t2);
+    hi = _mm_xor_si128(hi, lo);
+
+    _mm_storeu_si128((__m128i *)(void *)y, _mm_shuffle_epi8(hi, bswap));
+}
+
+#elif GHASH_PMULL
+#include <arm_neon.h>
+
+typedef struct {
+    uint64x2_t h;           /**< hash key, bits of each byte reversed */
+} _ghash_key_t;
+
+/* reversing the bits of each byte turns a GCM block into a polynomial with
+ * the coefficient of x^i in bit i of the little-endian 128 bit integer */
+static inline uint64x2_t _load_rbit(const uint8_t *p)
+{
+    return vreinterpretq_u64_u8(vrbitq_u8(vld1q_u8(p)));
+}
+
+static inline uint64x2_t _pmull(uint64_t a, uint64_t b)
+{
+    return vreinterpretq_u64_p128(vmull_p64((poly64_t)a, (poly64_t)b));
+}
+
+static void _ghash_init(_ghash_key_t *key, const uint8_t h[16])
+{
+    key->h = _load_rbit(h);
+}
+
+static void _ghash_mul(const _ghash_key_t *key, uint8_t y[16])
+{
+    uint64x2_t a = _load_rbit(y);
+    uint64_t a0 = vgetq_lane_u64(a, 0), a1 = vgetq_lane_u64(a, 1);
+    uint64_t b0 = vgetq_lane_u64(key->h, 0), b1 = vgetq_lane_u64(key->h, 1);
+    uint64x2_t lo = _pmull(a0, b0);
+    uint64x2_t hi = _pmull(a1, b1);
+    uint64x2_t mid = veorq_u64(_pmull(a0, b1), _pmull(a1, b0));
+    uint64_t z0 = vgetq_lane_u64(lo, 0);
+    uint64_t z1 = vgetq_lane_u64(lo, 1) ^ vgetq_lane_u64(mid, 0);
+    uint64_t z2 = vgetq_lane_u64(hi, 0) ^ vgetq_lane_u64(mid, 1);
+    uint64_t z3 = vgetq_lane_u64(hi, 1);
+    uint64x2_t t;
+
+    /* reduce modulo x^128 + x^7 + x^2 + x + 1: x^128 = 0x87 */
+    t = _pmull(z3, 0x87);
+    z1 ^= vgetq_lane_u64(t, 0);
+    z2 ^= vgetq_lane_u64(t, 1);
+    t = _pmull(z2, 0x87);
+    z0 ^= vgetq_lane_u64(t, 0);
+    z1 ^= vgetq_lane_u64(t, 1);
+
+    t = vcombine_u64(vcreate_u64(z0), vcreate_u64(z1));
+    vst1q_u8(y, vrbitq_u8(vreinterpretq_u8_u64(t)));
+}
+
+#else /* 4-bit table */
+
+typedef struct {
+    uint64_t hh[16];        /**< upper halves of i * H */
+    uint64_t hl[16];        /**< lower halves of i * H */
+} _ghash_key_t;
+
+/* reduction of the four bits shifted out of a 128 bit value, times x^-64 */
+static const uint16_t _last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static inline uint64_t _load_be64(const uint8_t *p)
+{
+    uint64_t x = 0;
+
+    for (unsigned i = 0; i < 8; i++) {
+        x = (x << 8) | p[i];
+    }
+    return x;
+}
+
+static inline void _store_be64(uint8_t *p, uint64_t x)
+{
+    for (unsigned i = 8; i--;) {
+        p[i] = x;
+        x >>= 8;
+    }
+}
+
+/*
+ * Shoup's method: the table holds the products of H with all 4-bit
+ * polynomials, the bit order of GCM puts the polynomial i * H at index i.
+ */
+static void _ghash_init(_ghash_key_t *key, const uint8_t h[16])
+{
+    uint64_t vh = _load_be64(h);
+    uint64_t vl = _load_be64(h + 8);
+
+    key->hh[0] = 0;
+    key->hl[0] = 0;
+    key->hh[8] = vh;
+    key->hl[8] = vl;
+
+    /* 4, 2 and 1 are H times x, x^2 and x^3 */
+    for (unsigned i = 4; i > 0; i >>= 1) {
+        uint64_t carry = (vl & 1) * 0xe100000000000000ULL;
+
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ carry;
+        key->hh[i] = vh;
+        key->hl[i] = vl;
+    }
+
+    for (unsigned i = 2; i <= 8; i *= 2) {
+        for (unsigned j = 1; j < i; j++) {
+            key->hh[i + j] = key->hh[i] ^ key->hh[j];
+            key->hl[i + j] = key->hl[i] ^ key->hl[j];
+        }
+    }
+}
+
+static void _ghash_mul(const _ghash_key_t *key, uint8_t y[16])
+{
+    uint64_t zh = 0;
+    uint64_t zl = 0;
+
+    for (unsigned i = 16; i--;) {
+        uint8_t nibble[2] = { y[i] & 0xf, y[i] >> 4 };
+
+        for (unsigned j = 0; j < 2; j++) {
+            uint8_t rem = zl & 0xf;
+
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((uint64_t)_last4[rem] << 48);
+            zh ^= key->hh[nibble[j]];
+            zl ^= key->hl[nibble[j]];
+        }
+    }
+
+    _store_be64(y, zh);
+    _store_be64(y + 8, zl);
+}
+
+#endif
+
+/* absorbs data into the hash, zero padding the last block */
+static void _ghash_update(const _ghash_key_t *key, uint8_t y[16],
+                          const uint8_t *data, size_t len)
+{
+    while (len) {
+        size_t n = len < GCM_BLOCK_SIZE ? len : GCM_BLOCK_SIZE;
+
+        crypto_xor(y, y, data, n);
+        _ghash_mul(key, y);
+        data += n;
+        len -= n;
+    }
+}
+
+static void _ghash_lengths(const _ghash_key_t *key, uint8_t y[16],
+                           uint64_t len_a, uint64_t len_b)
+{
+    uint8_t block[GCM_BLOCK_SIZE];
+
+    len_a *= 8;
+    len_b *= 8;
+    for (unsigned i = 8; i--;) {
+        block[i] = len_a;
+        block[i + 8] = len_b;
+        len_a >>= 8;
+        len_b >>= 8;
+    }
+    _ghash_update(key, y, block, sizeof(block));
+}
+
+static int _gcm(const cipher_t *cipher, const uint8_t *auth_data,
+                size_t auth_data_len, const uint8_t *nonce, size_t nonce_len,
+                const uint8_t *input, size_t len, uint8_t *output,
+                uint8_t tag[GCM_BLOCK_SIZE], bool encrypt)
+{
+    _ghash_key_t key;
+    uint8_t y[GCM_BLOCK_SIZE] = { 0 };
+    uint8_t j0[GCM_BLOCK_SIZE] = { 0 };
+    uint8_t ctr[GCM_BLOCK_SIZE];
+    uint8_t stream[CONFIG_CIPHER_CTR_STREAM_BLOCKS * GCM_BLOCK_SIZE];
+    size_t offset = 0;
+
+    /* hash key H = E(0) */
+    if (cipher_encrypt(cipher, y, stream) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    _ghash_init(&key, stream);
+
+    if (nonce_len == GCM_NONCE_LEN) {
+        memcpy(j0, nonce, GCM_NONCE_LEN);
+        j0[GCM_BLOCK_SIZE - 1] = 1;
+    }
+    else {
+        _ghash_update(&key, j0, nonce, nonce_len);
+        _ghash_lengths(&key, j0, 0, nonce_len);
+    }
+
+    /* the counter is the last 32 bit of the block, starting at J0 + 1 */
+    memcpy(ctr, j0, sizeof(ctr));
+    crypto_block_inc_ctr(ctr, 4);
+
+    _ghash_update(&key, y, auth_data, auth_data_len);
+
+    while (offset < len) {
+        size_t blocks = (len - offset + GCM_BLOCK_SIZE - 1) / GCM_BLOCK_SIZE;
+        size_t stream_len;
+
+        if (blocks > CONFIG_CIPHER_CTR_STREAM_BLOCKS) {
+            blocks = CONFIG_CIPHER_CTR_STREAM_BLOCKS;
+        }
+        if (cipher_ctr_keystream(cipher, ctr, GCM_BLOCK_SIZE - 4, stream,
+                                 blocks) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+
+        stream_len = blocks * GCM_BLOCK_SIZE;
+        if (stream_len > len - offset) {
+            stream_len = len - offset;
+        }
+        if (!encrypt) {
+            _ghash_update(&key, y, input + offset, stream_len);
+        }
+        crypto_xor(output + offset, input + offset, stream, stream_len);
+        if (encrypt) {
+            _ghash_update(&key, y, output + offset, stream_len);
+        }
+        offset += stream_len;
+    }
+
+    _ghash_lengths(&key, y, auth_data_len, len);
+
+    /* tag = E(J0) ^ GHASH */
+    if (cipher_encrypt(cipher, j0, tag) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    crypto_xor(tag, tag, y, GCM_BLOCK_SIZE);
+
+    crypto_secure_wipe(&key, sizeof(key));
+    crypto_secure_wipe(stream, sizeof(stream));
+    return 0;
+}
+
+static int _check_params(const cipher_t *cipher, uint8_t tag_len,
+                         size_t nonce_len, size_t len)
+{
+    if (cipher_get_block_size(cipher) != GCM_BLOCK_SIZE) {
+        return GCM_ERR_INVALID_BLOCK_LENGTH;
+    }
+    if (nonce_len == 0) {
+        return GCM_ERR_INVALID_NONCE_LENGTH;
+    }
+    if (tag_len != 4 && tag_len != 8 &&
+        (tag_len < 12 || tag_len > GCM_TAG_MAX_LEN)) {
+        return GCM_ERR_INVALID_TAG_LENGTH;
+    }
+    if (len > INT32_MAX - GCM_TAG_MAX_LEN) {
+        return GCM_ERR_INVALID_DATA_LENGTH;
+    }
+    return 0;
+}
+
+int32_t cipher_encrypt_gcm(const cipher_t *cipher,
+                           const uint8_t *auth_data, size_t auth_data_len,
+                           uint8_t tag_len,
+                           const uint8_t *nonce, size_t nonce_len,
+                           const uint8_t *input, size_t input_len,
+                           uint8_t *output)
+{
+    uint8_t tag[GCM_BLOCK_SIZE];
+    int res = _check_params(cipher, tag_len, nonce_len, input_len);
+
+    if (res < 0) {
+        return res;
+    }
+
+    res = _gcm(cipher, auth_data, auth_data_len, nonce, nonce_len,
+               input, input_len, output, tag, true);
+    if (res < 0) {
+        return res;
+    }
+    memcpy(output + input_len, tag, tag_len);
+
+    return input_len + tag_len;
+}
+
+int32_t cipher_decrypt_gcm(const cipher_t *cipher,
+                           const uint8_t *auth_data, size_t auth_data_len,
+                           uint8_t tag_len,
+                           const uint8_t *nonce, size_t nonce_len,
+                           const uint8_t *input, size_t input_len,
+                           uint8_t *output)
+{
+    uint8_t tag[GCM_BLOCK_SIZE];
+    size_t len;
+    int res;
+
+    if (input_len < tag_len) {
+        return GCM_ERR_INVALID_DATA_LENGTH;
+    }
+    len = input_len - tag_len;
+
+    res = _check_params(cipher, tag_len, nonce_len, len);
+    if (res < 0) {
+        return res;
+    }
+
+    res = _gcm(cipher, auth_data, auth_data_len, nonce, nonce_len,
+               input, len, output, tag, false);
+    if (res < 0) {
+        return res;
+    }
+    if (!crypto_equals(tag, input + len, tag_len)) {
+        memset(output, 0, len);
+        return GCM_ERR_INVALID_TAG;
+    }
+
+    return len;
+}
@@ -17,6 +17,7 @@
  *
  */
 
+#include "crypto/helper.h"
 #include "crypto/modes/ocb.h"
 #include <stdint.h>
 #include <string.h>
@@ -72,9 +73,7 @@ static void calculate_l_i(const uint8_t l_zero[16], size_t i, uint8_t output[16]
 static void xor_block(const uint8_t block1[16], const uint8_t block2[16],
                       uint8_t output[16])
 {
-    for (uint8_t i = 0; i < 16; ++i) {
-        output[i] = block1[i] ^ block2[i];
-    }
+    crypto_xor(output, block1, block2, 16);
 }
 
 static void processBlock(ocb_state_t *state, size_t blockNumber,
@@ -14,6 +14,11 @@
  * @brief   Implementation of Poly1305. Based on Floodberry's and Loup
  *          Valliant's implementation. Optimized for small flash size.
  *
+ * The accumulator is multiplied with 32-bit limbs and 64-bit products. On
+ * CPUs with 64x64->128-bit multiplication (those with `__int128` support)
+ * it uses 64-bit limbs instead, which needs a quarter of the multiplications.
+ * Both store the accumulator in the same radix 2^32 words of the context.
+ *
  * @author  Koen Zandberg <koen@bergzand.net>
  * @}
  */
@@ -21,8 +26,6 @@
 #include <string.h>
 #include "crypto/poly1305.h"
 
-static void poly1305_block(poly1305_ctx_t *ctx, uint8_t c4);
-
 static uint32_t u8to32(const uint8_t *p)
 {
     return
@@ -40,16 +43,72 @@ static void u32to8(uint8_t *p, uint32_t v)
     p[3] = (uint8_t)(v >> 24);
 }
 
-static void _clear_c(poly1305_ctx_t *ctx)
+#ifdef __SIZEOF_INT128__
+
+__extension__ typedef unsigned __int128 u128;
+
+/* 1 if a + b overflowed into a, without a branch */
+static inline uint64_t _carry(uint64_t a, uint64_t b)
 {
-    ctx->c[0] = 0;
-    ctx->c[1] = 0;
-    ctx->c[2] = 0;
-    ctx->c[3] = 0;
-    ctx->c_idx = 0;
+    return (a ^ ((a ^ b) | ((a - b) ^ b))) >> 63;
 }
 
-static void poly1305_block(poly1305_ctx_t *ctx, uint8_t c4)
+static void poly1305_blocks(poly1305_ctx_t *ctx, const uint8_t *in,
+                            size_t blocks, uint8_t c4)
+{
+    /* Local copies, h = h0 + h1 * 2^64 + h2 * 2^128 */
+    const uint64_t r0 = ctx->r[0] | (uint64_t)ctx->r[1] << 32;
+    const uint64_t r1 = ctx->r[2] | (uint64_t)ctx->r[3] << 32;
+    /* 2^130 = 5 mod p, the clamped r1 is a multiple of 4 */
+    const uint64_t rr1 = r1 + (r1 >> 2);
+    uint64_t h0 = ctx->h[0] | (uint64_t)ctx->h[1] << 32;
+    uint64_t h1 = ctx->h[2] | (uint64_t)ctx->h[3] << 32;
+    uint64_t h2 = ctx->h[4];
+
+    for (; blocks; blocks--, in += POLY1305_BLOCK_SIZE) {
+        u128 d0, d1;
+        uint64_t c;
+
+        /* h += c */
+        d0 = (u128)h0 + (u8to32(in) | (uint64_t)u8to32(in + 4) << 32);
+        h0 = (uint64_t)d0;
+        d1 = (u128)h1 + (d0 >> 64) +
+             (u8to32(in + 8) | (uint64_t)u8to32(in + 12) << 32);
+        h1 = (uint64_t)d1;
+        h2 += (uint64_t)(d1 >> 64) + c4;
+
+        /* h * r, without carry propagation */
+        d0 = (u128)h0 * r0 + (u128)h1 * rr1;
+        d1 = (u128)h0 * r1 + (u128)h1 * r0 + (u128)h2 * rr1;
+        h2 = h2 * r0;
+
+        /* carry propagation */
+        h0 = (uint64_t)d0;
+        d1 += d0 >> 64;
+        h1 = (uint64_t)d1;
+        h2 += (uint64_t)(d1 >> 64);
+
+        /* partial reduction modulo 2^130 - 5 */
+        c = (h2 >> 2) + (h2 & ~(uint64_t)3);
+        h2 &= 3;
+        h0 += c;
+        c = _carry(h0, c);
+        h1 += c;
+        h2 += _carry(h1, c);
+    }
+
+    /* Update the hash */
+    ctx->h[0] = (uint32_t)h0;
+    ctx->h[1] = (uint32_t)(h0 >> 32);
+    ctx->h[2] = (uint32_t)h1;
+    ctx->h[3] = (uint32_t)(h1 >> 32);
+    ctx->h[4] = (uint32_t)h2;
+}
+
+#else /* __SIZEOF_INT128__ */
+
+static void poly1305_blocks(poly1305_ctx_t *ctx, const uint8_t *in,
+                            size_t blocks, uint8_t c4)
 {
     /* Local copies */
     const uint32_t r0 = ctx->r[0];
@@ -62,54 +121,81 @@ static void poly1305_block(poly1305_ctx_t *ctx, uint8_t c4)
     const uint32_t rr2 = (r2 >> 2) + r2;
     const uint32_t rr3 = (r3 >> 2) + r3;
 
-    /* s = h + c, without carry propagation */
-    const uint64_t s0 = ctx->h[0] + (uint64_t)ctx->c[0];
-    const uint64_t s1 = ctx->h[1] + (uint64_t)ctx->c[1];
-    const uint64_t s2 = ctx->h[2] + (uint64_t)ctx->c[2];
-    const uint64_t s3 = ctx->h[3] + (uint64_t)ctx->c[3];
-    const uint32_t s4 = ctx->h[4] + c4;
-
-    /* (h + c) * r, without carry propagation */
-    const uint64_t x0 = s0 * r0 + s1 * rr3 + s2 * rr2 + s3 * rr1 + s4 * rr0;
-    const uint64_t x1 = s0 * r1 + s1 * r0  + s2 * rr3 + s3 * rr2 + s4 * rr1;
-    const uint64_t x2 = s0 * r2 + s1 * r1  + s2 * r0  + s3 * rr3 + s4 * rr2;
-    const uint64_t x3 = s0 * r3 + s1 * r2  + s2 * r1  + s3 * r0  + s4 * rr3;
-    const uint32_t x4 = s4 * (r0 & 3);
-
-    /* partial reduction modulo 2^130 - 5 */
-    const uint32_t u5 = x4 + (x3 >> 32); // u5 <= 7ffffff5
-    const uint64_t u0 = (u5 >>  2) * 5 + (x0 & 0xffffffff);
-    const uint64_t u1 = (u0 >> 32)     + (x1 & 0xffffffff) + (x0 >> 32);
-    const uint64_t u2 = (u1 >> 32)     + (x2 & 0xffffffff) + (x1 >> 32);
-    const uint64_t u3 = (u2 >> 32)     + (x3 & 0xffffffff) + (x2 >> 32);
-    const uint64_t u4 = (u3 >> 32)     + (u5 & 3);
+    uint32_t h0 = ctx->h[0];
+    uint32_t h1 = ctx->h[1];
+    uint32_t h2 = ctx->h[2];
+    uint32_t h3 = ctx->h[3];
+    uint32_t h4 = ctx->h[4];
 
-    /* Update the hash */
-    ctx->h[0] = (uint32_t)u0;
-    ctx->h[1] = (uint32_t)u1;
-    ctx->h[2] = (uint32_t)u2;
-    ctx->h[3] = (uint32_t)u3;
-    ctx->h[4] = (uint32_t)u4;
-}
+    for (; blocks; blocks--, in += POLY1305_BLOCK_SIZE) {
+        /* s = h + c, without carry propagation */
+        const uint64_t s0 = h0 + (uint64_t)u8to32(in);
+        const uint64_t s1 = h1 + (uint64_t)u8to32(in + 4);
+        const uint64_t s2 = h2 + (uint64_t)u8to32(in + 8);
+        const uint64_t s3 = h3 + (uint64_t)u8to32(in + 12);
+        const uint32_t s4 = h4 + c4;
 
-static void _take_input(poly1305_ctx_t *ctx, uint8_t input)
-{
-    size_t word = ctx->c_idx >> 2;
-    size_t byte = ctx->c_idx & 3;
+        /* (h + c) * r, without carry propagation */
+        const uint64_t x0 = s0 * r0 + s1 * rr3 + s2 * rr2 + s3 * rr1 + s4 * rr0;
+        const uint64_t x1 = s0 * r1 + s1 * r0  + s2 * rr3 + s3 * rr2 + s4 * rr1;
+        const uint64_t x2 = s0 * r2 + s1 * r1  + s2 * r0  + s3 * rr3 + s4 * rr2;
+        const uint64_t x3 = s0 * r3 + s1 * r2  + s2 * r1  + s3 * r0  + s4 * rr3;
+        const uint32_t x4 = s4 * (r0 & 3);
+
+        /* partial reduction modulo 2^130 - 5 */
+        const uint32_t u5 = x4 + (x3 >> 32); // u5 <= 7ffffff5
+        const uint64_t u0 = (u5 >>  2) * 5 + (x0 & 0xffffffff);
+        const uint64_t u1 = (u0 >> 32)     + (x1 & 0xffffffff) + (x0 >> 32);
+        const uint64_t u2 = (u1 >> 32)     + (x2 & 0xffffffff) + (x1 >> 32);
+        const uint64_t u3 = (u2 >> 32)     + (x3 & 0xffffffff) + (x2 >> 32);
+        const uint64_t u4 = (u3 >> 32)     + (u5 & 3);
 
-    ctx->c[word] |= (uint32_t)input << (byte * 8);
-    ctx->c_idx++;
+        h0 = (uint32_t)u0;
+        h1 = (uint32_t)u1;
+        h2 = (uint32_t)u2;
+        h3 = (uint32_t)u3;
+        h4 = (uint32_t)u4;
+    }
+
+    /* Update the hash */
+    ctx->h[0] = h0;
+    ctx->h[1] = h1;
+    ctx->h[2] = h2;
+    ctx->h[3] = h3;
+    ctx->h[4] = h4;
 }
 
+#endif /* __SIZEOF_INT128__ */
+
 void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len)
 {
-    for (size_t i = 0; i < len; i++) {
-        _take_input(ctx, data[i]);
-        if (ctx->c_idx == 16) {
-            poly1305_block(ctx, 1);
-            _clear_c(ctx);
+    /* the chunk words are used as a byte buffer for partial blocks */
+    uint8_t *chunk = (uint8_t *)ctx->c;
+
+    if (ctx->c_idx) {
+        size_t n = POLY1305_BLOCK_SIZE - ctx->c_idx;
+
+        if (len < n) {
+            n = len;
+        }
+        memcpy(chunk + ctx->c_idx, data, n);
+        ctx->c_idx += n;
+        data += n;
+        len -= n;
+        if (ctx->c_idx < POLY1305_BLOCK_SIZE) {
+            return;
         }
+        poly1305_blocks(ctx, chunk, 1, 1);
+        ctx->c_idx = 0;
     }
+
+    /* full blocks are processed straight from the input */
+    poly1305_blocks(ctx, data, len / POLY1305_BLOCK_SIZE, 1);
+    data += len & ~(size_t)(POLY1305_BLOCK_SIZE - 1);
+    len &= POLY1305_BLOCK_SIZE - 1;
+
+    memcpy(chunk, data, len);
+    ctx->c_idx = len;
 }
 
 void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key)
@@ -125,18 +211,22 @@ void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key)
 
     /* Zero the hash */
     memset(ctx->h, 0, sizeof(ctx->h));
-    _clear_c(ctx);
+    ctx->c_idx = 0;
 }
 
 void poly1305_finish(poly1305_ctx_t *ctx, uint8_t *mac)
 {
     /* Process the last block if there is data remaining */
     if (ctx->c_idx) {
+        uint8_t *chunk = (uint8_t *)ctx->c;
+
         /* move the final 1 according to remaining input length */
         /* (We may add less than 2^130 to the last input block) */
-        _take_input(ctx, 1);
+        chunk[ctx->c_idx] = 1;
+        memset(chunk + ctx->c_idx + 1, 0,
+               POLY1305_BLOCK_SIZE - ctx->c_idx - 1);
         /* And update hash */
-        poly1305_block(ctx, 0);
+        poly1305_blocks(ctx, chunk, 1, 0);
     }
 
     /* check if we should subtract 2^130-5 by performing the
@@ -46,6 +46,7 @@ static off_t constfs_lseek(vfs_file_t *filp, off_t off, int whence);
 static int constfs_open(vfs_file_t *filp, const char *name, int flags, mode_t mode, const char *abs_path);
 static ssize_t constfs_read(vfs_file_t *filp, void *dest, size_t nbytes);
 static ssize_t constfs_write(vfs_file_t *filp, const void *src, size_t nbytes);
+static ssize_t constfs_readv(vfs_file_t *filp, const iolist_t *iolist);
 
 /* Directory operations */
 static int constfs_opendir(vfs_DIR *dirp, const char *dirname, const char *abs_path);
@@ -67,6 +68,7 @@ static const vfs_file_ops_t constfs_file_ops = {
     .open  = constfs_open,
     .read  = constfs_read,
     .write = constfs_write,
+    .readv = constfs_readv,
 };
 
 static const vfs_dir_ops_t constfs_dir_ops = {
@@ -246,6 +248,32 @@ static ssize_t constfs_read(vfs_file_t *filp, void *dest, size_t nbytes)
     return nbytes;
 }
 
+static ssize_t constfs_readv(vfs_file_t *filp, const iolist_t *iolist)
+{
+    constfs_file_t *fp = filp->private_data.ptr;
+    DEBUG("constfs_readv: %p, %p\n", (void *)filp, (void *)iolist);
+    if ((size_t)filp->pos >= fp->size) {
+        return 0;
+    }
+
+    const uint8_t *src = fp->data + filp->pos;
+    size_t left = fp->size - filp->pos;
+    for (const iolist_t *iol = iolist; (iol != NULL) && (left > 0);
+         iol = iol->iol_next) {
+        size_t nbytes = (iol->iol_len > left) ? left : iol->iol_len;
+        if (nbytes == 0) {
+            continue;
+        }
+        memcpy(iol->iol_base, src, nbytes);
+        src += nbytes;
+        left -= nbytes;
+    }
+    size_t total = fp->size - filp->pos - left;
+    DEBUG("constfs_readv: read %lu bytes\n", (long unsigned)total);
+    filp->pos += total;
+    return total;
+}
+
 static ssize_t constfs_write(vfs_file_t *filp, const void *src, size_t nbytes)
 {
     DEBUG("constfs_write: %p, %p, %lu\n", (void *)filp, src, (unsigned long)nbytes);
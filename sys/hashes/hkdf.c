@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+/**
+ * @ingroup     sys_hashes_hkdf
+ * @{
+ *
+ * @file
+ * @brief       HKDF key derivation with HMAC-SHA-256 (RFC 5869)
+ *
+ * The key pads of the pseudorandom key are compressed once for all blocks
+ * of the output keying material.
+ *
+ * @author      RIOT Developers
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "crypto/helper.h"
+#include "hashes/hkdf.h"
+#include "hashes/sha256.h"
+
+void hkdf_sha256_extract(const void *salt, size_t salt_len,
+                         const void *ikm, size_t ikm_len,
+                         uint8_t *prk)
+{
+    /* an HMAC key of zeros is the same as an empty key */
+    if (salt == NULL) {
+        salt_len = 0;
+    }
+    hmac_sha256(salt, salt_len, ikm, ikm_len, prk);
+}
+
+int hkdf_sha256_expand(const void *prk, size_t prk_len,
+                       const void *info, size_t info_len,
+                       uint8_t *okm, size_t okm_len)
+{
+    hmac_sha256_key_t pk;
+    hmac_context_t ctx;
+    uint8_t t[SHA256_DIGEST_LENGTH];
+
+    if (okm_len > HKDF_SHA256_MAX_OKM_SIZE) {
+        return -EINVAL;
+    }
+
+    hmac_sha256_precompute(&pk, prk, prk_len);
+
+    /* T(i) = HMAC(PRK, T(i - 1) || info || i), with an empty T(0) */
+    for (uint8_t i = 1; okm_len; i++) {
+        size_t n = (okm_len < sizeof(t)) ? okm_len : sizeof(t);
+
+        hmac_sha256_init_precomputed(&ctx, &pk);
+        if (i > 1) {
+            hmac_sha256_update(&ctx, t, sizeof(t));
+        }
+        hmac_sha256_update(&ctx, info, info_len);
+        hmac_sha256_update(&ctx, &i, 1);
+        hmac_sha256_final(&ctx, t);
+
+        memcpy(okm, t, n);
+        okm += n;
+        okm_len -= n;
+    }
+
+    crypto_secure_wipe(&pk, sizeof(pk));
+    crypto_secure_wipe(&ctx, sizeof(ctx));
+    crypto_secure_wipe(t, sizeof(t));
+
+    return 0;
+}
+
+int hkdf_sha256(const void *salt, size_t salt_len,
+                const void *ikm, size_t ikm_len,
+                const void *info, size_t info_len,
+                uint8_t *okm, size_t okm_len)
+{
+    uint8_t prk[HKDF_SHA256_PRK_SIZE];
+    int res;
+
+    hkdf_sha256_extract(salt, salt_len, ikm, ikm_len, prk);
+    res = hkdf_sha256_expand(prk, sizeof(prk), info, info_len, okm, okm_len);
+    crypto_secure_wipe(prk, sizeof(prk));
+
+    return res;
+}
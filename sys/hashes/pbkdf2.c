@@ -20,18 +20,12 @@
 
 #include <string.h>
 
+#include "byteorder.h"
 #include "hashes/sha256.h"
+#include "hashes/sha2xx_common.h"
 #include "hashes/pbkdf2.h"
 #include "crypto/helper.h"
 
-static void inplace_xor_scalar(uint8_t *bytes, size_t len, uint8_t c)
-{
-    while (len--) {
-        *bytes ^= c;
-        bytes++;
-    }
-}
-
 static void inplace_xor_digests(uint8_t *d1, const uint8_t *d2)
 {
     int len = SHA256_DIGEST_LENGTH;
@@ -43,70 +37,65 @@ static void inplace_xor_digests(uint8_t *d1, const uint8_t *d2)
     }
 }
 
+static void _compress(const uint32_t iv[8],
+                      uint8_t block[SHA256_INTERNAL_BLOCK_SIZE])
+{
+    uint32_t state[8];
+
+    memcpy(state, iv, sizeof(state));
+    sha2xx_transform_blocks(state, block, 1);
+    for (unsigned i = 0; i < 8; i++) {
+        byteorder_htobebufl(&block[4 * i], state[i]);
+    }
+}
+
+/*
+ * HMAC of the digest in the first SHA256_DIGEST_LENGTH bytes of block, the
+ * rest of block holds the padding. Both the inner and the outer hash are a
+ * single compression starting from the precomputed key pad states.
+ */
+static void _hmac_digest(const hmac_sha256_key_t *pk,
+                         uint8_t block[SHA256_INTERNAL_BLOCK_SIZE])
+{
+    _compress(pk->in, block);
+    _compress(pk->out, block);
+}
+
 void pbkdf2_sha256(const uint8_t *password, size_t password_len,
                    const uint8_t *salt, size_t salt_len,
                    int iterations,
                    uint8_t *output)
 {
-    sha256_context_t inner;
-    sha256_context_t outer;
-    uint8_t tmp_digest[SHA256_DIGEST_LENGTH];
-    int first_iter = 1;
-
-    {
-        uint8_t processed_pass[SHA256_INTERNAL_BLOCK_SIZE] = {0};
-
-        if (password_len > sizeof(processed_pass)) {
-            sha256_init(&inner);
-            sha256_update(&inner, password, password_len);
-            sha256_final(&inner, processed_pass);
-        } else {
-            memcpy(processed_pass, password, password_len);
-        }
-
-        sha256_init(&inner);
-        sha256_init(&outer);
-
-        /* Trick: doing inner.update(processed_pass XOR 0x36) followed by
-         * inner.update(processed_pass XOR 0x5C) requires remembering
-         * processed_pass. Instead undo the first XOR while doing the second.
-         */
-        inplace_xor_scalar(processed_pass, sizeof(processed_pass), 0x36);
-        sha256_update(&inner, processed_pass, sizeof(processed_pass));
-
-        inplace_xor_scalar(processed_pass, sizeof(processed_pass), 0x36 ^ 0x5C);
-        sha256_update(&outer, processed_pass, sizeof(processed_pass));
-
-        crypto_secure_wipe(&processed_pass, sizeof(processed_pass));
-    }
+    hmac_sha256_key_t pk;
+    hmac_context_t ctx;
+    uint8_t block[SHA256_INTERNAL_BLOCK_SIZE] = { 0 };
 
     memset(output, 0, SHA256_DIGEST_LENGTH);
 
-    while (iterations--) {
-        sha256_context_t inner_copy = inner, outer_copy = outer;
-
-        if (first_iter) {
-            sha256_update(&inner_copy, salt, salt_len);
-            sha256_update(&inner_copy, "\x00\x00\x00\x01", 4);
-            first_iter = 0;
-        } else {
-            sha256_update(&inner_copy, tmp_digest, sizeof(tmp_digest));
-        }
+    if (iterations <= 0) {
+        return;
+    }
 
-        sha256_final(&inner_copy, tmp_digest);
+    hmac_sha256_precompute(&pk, password, password_len);
 
-        sha256_update(&outer_copy, tmp_digest, sizeof(tmp_digest));
-        sha256_final(&outer_copy, tmp_digest);
+    /* U_1 = HMAC(password, salt || INT(1)) */
+    hmac_sha256_init_precomputed(&ctx, &pk);
+    hmac_sha256_update(&ctx, salt, salt_len);
+    hmac_sha256_update(&ctx, "\x00\x00\x00\x01", 4);
+    hmac_sha256_final(&ctx, block);
+    inplace_xor_digests(output, block);
 
-        inplace_xor_digests(output, tmp_digest);
+    /* U_i = HMAC(password, U_i-1), the message length in bits including
+     * the key pad is 768 */
+    block[SHA256_DIGEST_LENGTH] = 0x80;
+    block[SHA256_INTERNAL_BLOCK_SIZE - 2] = 0x03;
 
-        if (iterations == 0) {
-            crypto_secure_wipe(&inner_copy, sizeof(inner_copy));
-            crypto_secure_wipe(&outer_copy, sizeof(outer_copy));
-        }
+    while (--iterations) {
+        _hmac_digest(&pk, block);
+        inplace_xor_digests(output, block);
     }
 
-    crypto_secure_wipe(&inner, sizeof(inner));
-    crypto_secure_wipe(&outer, sizeof(outer));
-    crypto_secure_wipe(&tmp_digest, sizeof(tmp_digest));
+    crypto_secure_wipe(&pk, sizeof(pk));
+    crypto_secure_wipe(&ctx, sizeof(ctx));
+    crypto_secure_wipe(block, sizeof(block));
 }
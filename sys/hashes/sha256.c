@@ -48,6 +48,8 @@
 #include <string.h>
 #include <assert.h>
 
+#include "byteorder.h"
+#include "crypto/helper.h"
 #include "hashes/sha256.h"
 #include "hashes/sha2xx_common.h"
 
@@ -86,7 +88,8 @@ void *sha256(const void *data, size_t len, void *digest)
 }
 
 
-void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length)
+void hmac_sha256_precompute(hmac_sha256_key_t *pk,
+                            const void *key, size_t key_length)
 {
     unsigned char k[SHA256_INTERNAL_BLOCK_SIZE];
 
@@ -113,19 +116,48 @@ void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length)
     }
 
     /*
-     * Initiate calculation of the inner hash
-     * tmp = hash(i_key_pad CONCAT message)
+     * each key pad is exactly one block, so compress it right away and
+     * keep only the resulting states
      */
-    sha256_init(&ctx->c_in);
-    sha2xx_update(&ctx->c_in, i_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
+    sha256_context_t c;
+
+    sha256_init(&c);
+    sha2xx_transform_blocks(c.state, i_key_pad, 1);
+    memcpy(pk->in, c.state, sizeof(pk->in));
+
+    sha256_init(&c);
+    sha2xx_transform_blocks(c.state, o_key_pad, 1);
+    memcpy(pk->out, c.state, sizeof(pk->out));
 
+    crypto_secure_wipe(&c, sizeof(c));
+    crypto_secure_wipe(k, sizeof(k));
+    crypto_secure_wipe(o_key_pad, sizeof(o_key_pad));
+    crypto_secure_wipe(i_key_pad, sizeof(i_key_pad));
+}
+
+void hmac_sha256_init_precomputed(hmac_context_t *ctx,
+                                  const hmac_sha256_key_t *pk)
+{
     /*
-     * Initiate calculation of the outer hash
-     * result = hash(o_key_pad CONCAT tmp)
+     * the inner hash is hash(i_key_pad CONCAT message), the outer hash is
+     * hash(o_key_pad CONCAT tmp), both continue after their key pad
      */
-    sha256_init(&ctx->c_out);
-    sha2xx_update(&ctx->c_out, o_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
+    memcpy(ctx->c_in.state, pk->in, sizeof(ctx->c_in.state));
+    ctx->c_in.count[0] = 0;
+    ctx->c_in.count[1] = SHA256_INTERNAL_BLOCK_SIZE * 8;
 
+    memcpy(ctx->c_out.state, pk->out, sizeof(ctx->c_out.state));
+    ctx->c_out.count[0] = 0;
+    ctx->c_out.count[1] = SHA256_INTERNAL_BLOCK_SIZE * 8;
+}
+
+void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length)
+{
+    hmac_sha256_key_t pk;
+
+    hmac_sha256_precompute(&pk, key, key_length);
+    hmac_sha256_init_precomputed(ctx, &pk);
+    crypto_secure_wipe(&pk, sizeof(pk));
 }
 
 void hmac_sha256_update(hmac_context_t *ctx, const void *data, size_t len)
@@ -148,6 +180,16 @@ void hmac_sha256_final(hmac_context_t *ctx, void *digest)
     sha256_final(&ctx->c_out, digest);
 }
 
+void hmac_sha256_precomputed(const hmac_sha256_key_t *pk,
+                             const void *data, size_t len, void *digest)
+{
+    hmac_context_t ctx;
+
+    hmac_sha256_init_precomputed(&ctx, pk);
+    hmac_sha256_update(&ctx, data, len);
+    hmac_sha256_final(&ctx, digest);
+}
+
 const void *hmac_sha256(const void *key, size_t key_length,
                         const void *data, size_t len, void *digest)
 {
@@ -164,16 +206,28 @@ const void *hmac_sha256(const void *key, size_t key_length,
 /**
  * @brief helper to compute sha256 inplace for the given buffer
  *
+ * A chain element and its padding fit into a single block, so the block is
+ * built directly and compressed once instead of going through
+ * sha2xx_update() and sha2xx_final().
+ *
  * @param[in, out] element the buffer to compute a sha256 and store it back to it
  *
  */
 static inline void sha256_inplace(unsigned char element[SHA256_DIGEST_LENGTH])
 {
     sha256_context_t ctx;
+    unsigned char block[SHA256_INTERNAL_BLOCK_SIZE] = { 0 };
+
+    memcpy(block, element, SHA256_DIGEST_LENGTH);
+    block[SHA256_DIGEST_LENGTH] = 0x80;
+    /* message length in bits: 256 */
+    block[SHA256_INTERNAL_BLOCK_SIZE - 2] = 0x01;
 
     sha256_init(&ctx);
-    sha2xx_update(&ctx, element, SHA256_DIGEST_LENGTH);
-    sha256_final(&ctx, element);
+    sha2xx_transform_blocks(ctx.state, block, 1);
+    for (unsigned i = 0; i < 8; i++) {
+        byteorder_htobebufl(&element[4 * i], ctx.state[i]);
+    }
 }
 
 void *sha256_chain(const void *seed, size_t seed_length,
@@ -222,10 +276,9 @@ void *sha256_chain_with_waypoints(const void *seed,
 
         /* perform consecutive iterations starting at index 1*/
         for (size_t i = 1; i < elements; ++i) {
-            sha256_context_t ctx;
-            sha256_init(&ctx);
-            sha2xx_update(&ctx, waypoints[(i - 1)].element, SHA256_DIGEST_LENGTH);
-            sha256_final(&ctx, waypoints[i].element);
+            memcpy(waypoints[i].element, waypoints[(i - 1)].element,
+                   SHA256_DIGEST_LENGTH);
+            sha256_inplace(waypoints[i].element);
             waypoints[i].index = i;
         }
 
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_hashes
+ * @{
+ *
+ * @file
+ * @brief       Multi-buffer SHA-256
+ *
+ * SHA-256 has no parallelism within a message, but independent messages can
+ * be hashed side by side: each message occupies one lane of a SIMD register
+ * and the compression function is run on all lanes at once. The vector code
+ * is written with the GCC vector extensions, which map onto SSE2/AVX2 on x86
+ * and NEON on ARM. Messages that are done before the others of their group
+ * are fed zero blocks until the longest message is done.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "crypto/helper.h"
+#include "hashes/sha256.h"
+#include "hashes/sha2xx_common.h"
+
+#if SHA256_MB_LANES > 1
+
+#if SHA256_MB_LANES == 8
+#define MB_TARGET   __attribute__((target("avx2")))
+#elif defined(__i386__) || defined(__x86_64__)
+#define MB_TARGET   __attribute__((target("sse2")))
+#else
+#define MB_TARGET
+#endif
+
+typedef uint32_t mb_vec_t __attribute__((vector_size(4 * SHA256_MB_LANES)));
+
+static const uint8_t _zero_block[SHA256_INTERNAL_BLOCK_SIZE];
+
+/* compresses one block of each lane, the vectors are passed by reference to
+ * keep them out of the calling convention */
+MB_TARGET
+static void _transform(mb_vec_t state[8], const uint8_t *const block[])
+{
+    mb_vec_t W[16];
+    mb_vec_t a = state[0], b = state[1], c = state[2], d = state[3];
+    mb_vec_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (unsigned i = 0; i < 16; i++) {
+        uint32_t w[SHA256_MB_LANES];
+
+        for (unsigned l = 0; l < SHA256_MB_LANES; l++) {
+            w[l] = byteorder_bebuftohl(&block[l][4 * i]);
+        }
+        memcpy(&W[i], w, sizeof(W[i]));
+    }
+
+    for (unsigned i = 0; i < 64; i++) {
+        mb_vec_t t0, t1;
+
+        if (i >= 16) {
+            W[i & 15] += s1(W[(i - 2) & 15]) + W[(i - 7) & 15] +
+                         s0(W[(i - 15) & 15]);
+        }
+        t0 = h + S1(e) + Ch(e, f, g) + W[i & 15] + K[i];
+        t1 = S0(a) + Maj(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + t0;
+        d = c;
+        c = b;
+        b = a;
+        a = t0 + t1;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+/* hashes up to SHA256_MB_LANES messages, starting from iv after prefix bytes
+ * have already been processed */
+MB_TARGET
+static void _mb_group(const uint32_t iv[8], size_t prefix,
+                      const void *const data[], const size_t len[],
+                      void *const digest[], unsigned lanes)
+{
+    /* the last one or two blocks of each message, padding included */
+    uint8_t tail[SHA256_MB_LANES][2 * SHA256_INTERNAL_BLOCK_SIZE];
+    size_t full[SHA256_MB_LANES];
+    size_t total[SHA256_MB_LANES];
+    size_t steps = 0;
+    mb_vec_t state[8];
+
+    for (unsigned l = 0; l < SHA256_MB_LANES; l++) {
+        full[l] = total[l] = 0;
+        if (l >= lanes) {
+            continue;
+        }
+
+        size_t rem = len[l] % SHA256_INTERNAL_BLOCK_SIZE;
+        uint64_t bits = (uint64_t)(prefix + len[l]) * 8;
+
+        full[l] = len[l] / SHA256_INTERNAL_BLOCK_SIZE;
+        total[l] = full[l] + ((rem < SHA256_INTERNAL_BLOCK_SIZE - 8) ? 1 : 2);
+
+        memset(tail[l], 0, sizeof(tail[l]));
+        memcpy(tail[l], (const uint8_t *)data[l] +
+               full[l] * SHA256_INTERNAL_BLOCK_SIZE, rem);
+        tail[l][rem] = 0x80;
+        byteorder_htobebufll(&tail[l][(total[l] - full[l]) *
+                                      SHA256_INTERNAL_BLOCK_SIZE - 8], bits);
+
+        if (total[l] > steps) {
+            steps = total[l];
+        }
+    }
+
+    for (unsigned i = 0; i < 8; i++) {
+        state[i] = (mb_vec_t){ 0 } + iv[i];
+    }
+
+    for (size_t step = 0; step < steps; step++) {
+        const uint8_t *block[SHA256_MB_LANES];
+
+        for (unsigned l = 0; l < SHA256_MB_LANES; l++) {
+            if (step < full[l]) {
+                block[l] = (const uint8_t *)data[l] +
+                           step * SHA256_INTERNAL_BLOCK_SIZE;
+            }
+            else if (step < total[l]) {
+                block[l] = tail[l] +
+                           (step - full[l]) * SHA256_INTERNAL_BLOCK_SIZE;
+            }
+            else {
+                block[l] = _zero_block;
+            }
+        }
+
+        _transform(state, block);
+
+        for (unsigned l = 0; l < lanes; l++) {
+            if (step + 1 != total[l]) {
+                continue;
+            }
+            for (unsigned i = 0; i < 8; i++) {
+                uint32_t s[SHA256_MB_LANES];
+
+                memcpy(s, &state[i], sizeof(s));
+                byteorder_htobebufl((uint8_t *)digest[l] + 4 * i, s[l]);
+            }
+        }
+    }
+}
+
+static void _mb(const uint32_t iv[8], size_t prefix,
+                const void *const data[], const size_t len[],
+                void *const digest[], size_t n)
+{
+    while (n) {
+        unsigned lanes = (n < SHA256_MB_LANES) ? n : SHA256_MB_LANES;
+
+        _mb_group(iv, prefix, data, len, digest, lanes);
+        data += lanes;
+        len += lanes;
+        digest += lanes;
+        n -= lanes;
+    }
+}
+
+#else /* SHA256_MB_LANES == 1 */
+
+static void _mb(const uint32_t iv[8], size_t prefix,
+                const void *const data[], const size_t len[],
+                void *const digest[], size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        sha256_context_t ctx;
+
+        memcpy(ctx.state, iv, sizeof(ctx.state));
+        ctx.count[0] = 0;
+        ctx.count[1] = prefix * 8;
+        sha2xx_update(&ctx, data[i], len[i]);
+        sha256_final(&ctx, digest[i]);
+    }
+}
+
+#endif /* SHA256_MB_LANES == 1 */
+
+void sha256_mb(const void *const data[], const size_t len[],
+               void *const digest[], size_t n)
+{
+    sha256_context_t ctx;
+
+    sha256_init(&ctx);
+    _mb(ctx.state, 0, data, len, digest, n);
+}
+
+void hmac_sha256_mb(const void *key, size_t key_length,
+                    const void *const data[], const size_t len[],
+                    void *const digest[], size_t n)
+{
+    hmac_context_t ctx;
+    const void *inner[SHA256_MB_LANES];
+    size_t inner_len[SHA256_MB_LANES];
+
+    /* the midstates after the padded keys are shared by all messages */
+    hmac_sha256_init(&ctx, key, key_length);
+
+    while (n) {
+        unsigned lanes = (n < SHA256_MB_LANES) ? n : SHA256_MB_LANES;
+
+        _mb(ctx.c_in.state, SHA256_INTERNAL_BLOCK_SIZE, data, len, digest,
+            lanes);
+        for (unsigned l = 0; l < lanes; l++) {
+            inner[l] = digest[l];
+            inner_len[l] = SHA256_DIGEST_LENGTH;
+        }
+        _mb(ctx.c_out.state, SHA256_INTERNAL_BLOCK_SIZE, inner, inner_len,
+            digest, lanes);
+
+        data += lanes;
+        len += lanes;
+        digest += lanes;
+        n -= lanes;
+    }
+
+    crypto_secure_wipe(&ctx, sizeof(ctx));
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_hashes_sha2xx_common
+ * @{
+ *
+ * @file
+ * @brief       SHA-224/256 compression using the ARMv8 Cryptography Extension
+ *
+ * Selected by the `hashes_sha256_armv8` pseudomodule. The target must be
+ * built with the extension enabled, e.g. with `-march=armv8-a+crypto`.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_HASHES_SHA256_ARMV8)
+
+#if !defined(__ARM_FEATURE_CRYPTO) && !defined(__ARM_FEATURE_SHA2)
+#error "hashes_sha256_armv8: build with the ARMv8 Cryptography Extension enabled"
+#endif
+
+#include <arm_neon.h>
+
+#include "hashes/sha2xx_common.h"
+
+void sha2xx_transform_blocks(uint32_t state[8], const void *data,
+                             size_t blocks)
+{
+    const uint8_t *block = data;
+    uint32x4_t abcd = vld1q_u32(&state[0]);
+    uint32x4_t efgh = vld1q_u32(&state[4]);
+
+    for (; blocks; blocks--) {
+        uint32x4_t abcd_save = abcd;
+        uint32x4_t efgh_save = efgh;
+        uint32x4_t w[4];
+
+        /* four rounds per iteration, w holds the last 16 schedule words */
+        for (unsigned i = 0; i < 16; i++) {
+            uint32x4_t wk, tmp;
+
+            if (i < 4) {
+                w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(block +
+                                                                16 * i)));
+            }
+            else {
+                w[i % 4] = vsha256su1q_u32(vsha256su0q_u32(w[i % 4],
+                                                           w[(i + 1) % 4]),
+                                           w[(i + 2) % 4], w[(i + 3) % 4]);
+            }
+
+            wk = vaddq_u32(w[i % 4], vld1q_u32(&K[4 * i]));
+            tmp = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, wk);
+            efgh = vsha256h2q_u32(efgh, tmp, wk);
+        }
+
+        abcd = vaddq_u32(abcd, abcd_save);
+        efgh = vaddq_u32(efgh, efgh_save);
+        block += 64;
+    }
+
+    vst1q_u32(&state[0], abcd);
+    vst1q_u32(&state[4], efgh);
+}
+
+#endif /* MODULE_HASHES_SHA256_ARMV8 */
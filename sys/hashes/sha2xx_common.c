@@ -50,6 +50,7 @@
 #include <assert.h>
 
 #include "hashes/sha2xx_common.h"
+#include "kernel_defines.h"
 
 
 #ifdef __BIG_ENDIAN__
@@ -97,6 +98,70 @@ static void be32enc_vect(void *dst_, const void *src_, size_t len)
 
 #endif /* __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__ */
 
+#if !IS_USED(MODULE_HASHES_SHA256_NI) && !IS_USED(MODULE_HASHES_SHA256_ARMV8) && \
+    !IS_USED(MODULE_HASHES_SHA256_PERIPH)
+
+#if IS_USED(MODULE_HASHES_SHA256_UNROLL)
+/*
+ * One round, with the roles of the working variables rotated by the caller
+ * instead of moving the values. W holds the last 16 words of the message
+ * schedule.
+ */
+#define ROUND(a, b, c, d, e, f, g, h, i)                                    \
+    do {                                                                    \
+        if ((i) >= 16) {                                                    \
+            W[(i) & 15] += s1(W[((i) - 2) & 15]) + W[((i) - 7) & 15] +     \
+                           s0(W[((i) - 15) & 15]);                          \
+        }                                                                   \
+        uint32_t t0 = h + S1(e) + Ch(e, f, g) + W[(i) & 15] + K[i];         \
+        d += t0;                                                            \
+        h = t0 + S0(a) + Maj(a, b, c);                                      \
+    } while (0)
+
+#define ROUNDS8(i)                                                          \
+    do {                                                                    \
+        ROUND(a, b, c, d, e, f, g, h, (i) + 0);                             \
+        ROUND(h, a, b, c, d, e, f, g, (i) + 1);                             \
+        ROUND(g, h, a, b, c, d, e, f, (i) + 2);                             \
+        ROUND(f, g, h, a, b, c, d, e, (i) + 3);                             \
+        ROUND(e, f, g, h, a, b, c, d, (i) + 4);                             \
+        ROUND(d, e, f, g, h, a, b, c, (i) + 5);                             \
+        ROUND(c, d, e, f, g, h, a, b, (i) + 6);                             \
+        ROUND(b, c, d, e, f, g, h, a, (i) + 7);                             \
+    } while (0)
+
+/*
+ * SHA256 block compression function, fully unrolled. Keeps the working
+ * variables in registers on CPUs with enough of them, like Cortex-M, and
+ * needs only 16 words of message schedule.
+ */
+static void sha2xx_transform(uint32_t *state, const unsigned char block[64])
+{
+    uint32_t W[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    be32dec_vect(W, block, 64);
+
+    ROUNDS8(0);
+    ROUNDS8(8);
+    ROUNDS8(16);
+    ROUNDS8(24);
+    ROUNDS8(32);
+    ROUNDS8(40);
+    ROUNDS8(48);
+    ROUNDS8(56);
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+#else /* !MODULE_HASHES_SHA256_UNROLL */
 /*
  * SHA256 block compression function.  The 256-bit state is transformed via
  * the 512-bit input block to produce a new state.
@@ -134,6 +199,19 @@ static void sha2xx_transform(uint32_t *state, const unsigned char block[64])
         state[i] += S[i];
     }
 }
+#endif /* MODULE_HASHES_SHA256_UNROLL */
+
+void sha2xx_transform_blocks(uint32_t state[8], const void *data,
+                             size_t blocks)
+{
+    const unsigned char *block = data;
+
+    for (; blocks; blocks--) {
+        sha2xx_transform(state, block);
+        block += 64;
+    }
+}
+#endif /* !MODULE_HASHES_SHA256_NI && !..._ARMV8 && !..._PERIPH */
 
 static unsigned char PAD[64] = {
     0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -191,15 +269,15 @@ void sha2xx_update(sha2xx_context_t *ctx, const void *data, size_t len)
     const unsigned char *src = data;
 
     memcpy(&ctx->buf[r], src, 64 - r);
-    sha2xx_transform(ctx->state, ctx->buf);
+    sha2xx_transform_blocks(ctx->state, ctx->buf, 1);
     src += 64 - r;
     len -= 64 - r;
 
-    /* Perform complete blocks */
-    while (len >= 64) {
-        sha2xx_transform(ctx->state, src);
-        src += 64;
-        len -= 64;
+    /* Perform complete blocks in one call, for the benefit of the backends */
+    if (len >= 64) {
+        sha2xx_transform_blocks(ctx->state, src, len / 64);
+        src += len & ~(size_t)63;
+        len &= 63;
     }
 
     /* Copy left over data into buffer */
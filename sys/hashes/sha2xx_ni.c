@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_hashes_sha2xx_common
+ * @{
+ *
+ * @file
+ * @brief       SHA-224/256 compression using the x86 SHA extensions
+ *
+ * The instructions are enabled per function, so the rest of the build does
+ * not depend on the CPU of the host. Selected by the `hashes_sha256_ni`
+ * pseudomodule.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_HASHES_SHA256_NI)
+
+#if !defined(__x86_64__) && !defined(__i386__)
+#error "hashes_sha256_ni: the SHA extensions are only available on x86"
+#endif
+
+#include <immintrin.h>
+
+#include "hashes/sha2xx_common.h"
+
+__attribute__((target("sha,sse4.1,ssse3")))
+void sha2xx_transform_blocks(uint32_t state[8], const void *data,
+                             size_t blocks)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                         0x0405060700010203ULL);
+    const uint8_t *block = data;
+    __m128i abef, cdgh, tmp;
+
+    /* the instructions keep the state as ABEF and CDGH */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]),
+                            0xb1);
+    cdgh = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]),
+                             0x1b);
+    abef = _mm_alignr_epi8(tmp, cdgh, 8);
+    cdgh = _mm_blend_epi16(cdgh, tmp, 0xf0);
+
+    for (; blocks; blocks--) {
+        __m128i abef_save = abef;
+        __m128i cdgh_save = cdgh;
+        __m128i w[4];
+
+        /* four rounds per iteration, w holds the last 16 schedule words */
+        for (unsigned i = 0; i < 16; i++) {
+            __m128i msg;
+
+            if (i < 4) {
+                w[i] = _mm_shuffle_epi8(
+                    _mm_loadu_si128((const __m128i *)(block + 16 * i)), bswap);
+            }
+            else {
+                w[i % 4] = _mm_sha256msg2_epu32(
+                    _mm_add_epi32(_mm_sha256msg1_epu32(w[i % 4],
+                                                       w[(i + 1) % 4]),
+                                  _mm_alignr_epi8(w[(i + 3) % 4],
+                                                  w[(i + 2) % 4], 4)),
+                    w[(i + 3) % 4]);
+            }
+
+            msg = _mm_add_epi32(w[i % 4],
+                                _mm_loadu_si128((const __m128i *)&K[4 * i]));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh,
+                                         _mm_shuffle_epi32(msg, 0x0e));
+        }
+
+        abef = _mm_add_epi32(abef, abef_save);
+        cdgh = _mm_add_epi32(cdgh, cdgh_save);
+        block += 64;
+    }
+
+    tmp = _mm_shuffle_epi32(abef, 0x1b);
+    cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, cdgh, 0xf0));
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(cdgh, tmp, 8));
+}
+
+#endif /* MODULE_HASHES_SHA256_NI */
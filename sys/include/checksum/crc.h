@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc Generic CRC
+ * @ingroup     sys_checksum
+ * @brief       Table driven CRC engine for CRCs of 8 to 32 bits
+ *
+ * A CRC is described by a @ref crc_t with the parameters of the CRC
+ * catalogue (width, polynomial, initial value, reflection and final XOR) and
+ * its lookup tables. The data is processed with slicing-by-8: eight tables of
+ * 256 entries each allow to process 8 bytes with one table lookup per byte
+ * and no dependency between the lookups. @ref CONFIG_CRC_SLICES trades speed
+ * for flash.
+ *
+ * The tables of the predefined CRCs are expanded at compile time from the
+ * CRC of each single bit of their input, so only the CRCs used by the
+ * application end up in flash. Tables for other polynomials are computed at
+ * run time with crc_table_init().
+ *
+ * CRC-32 and CRC-32C can be computed by the CPU with one of the
+ * pseudomodules:
+ *  - `checksum_crc32_pclmul`: carry-less multiplication on x86, for `native`
+ *    on a host CPU with PCLMULQDQ and SSE4.1
+ *  - `checksum_crc32_armv8`: CRC32 instructions of ARMv8-A/R, the target has
+ *    to be built with them enabled, e.g. `-march=armv8-a+crc`
+ *
+ * With `checksum_crc_periph`, the CPU implementation provides
+ * crc_periph_update() to use the CRC peripheral of the MCU for all CRCs it
+ * supports.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Generic CRC engine
+ */
+
+#ifndef CHECKSUM_CRC_H
+#define CHECKSUM_CRC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of lookup tables per CRC, 1, 4 or 8
+ *
+ * Each table has 256 32-bit entries, i.e. 1 KiB of flash. With n tables,
+ * n bytes are processed per step.
+ */
+#ifndef CONFIG_CRC_SLICES
+#define CONFIG_CRC_SLICES           (8U)
+#endif
+
+#if (CONFIG_CRC_SLICES != 1) && (CONFIG_CRC_SLICES != 4) && \
+    (CONFIG_CRC_SLICES != 8)
+#error "CONFIG_CRC_SLICES must be 1, 4 or 8"
+#endif
+
+/**
+ * @brief   Lookup tables of a CRC, see crc_table_init()
+ */
+typedef struct {
+    uint32_t t[CONFIG_CRC_SLICES][256];     /**< the tables */
+} crc_table_t;
+
+/**
+ * @brief   Processes a prefix of the data with CPU instructions
+ *
+ * @param[in,out] reg   CRC register, see crc_start()
+ * @param[in]     buf   data
+ * @param[in]     len   length of @p buf
+ *
+ * @return  number of bytes processed, the rest is done with the tables
+ */
+typedef size_t (*crc_accel_t)(uint32_t *reg, const uint8_t *buf, size_t len);
+
+/**
+ * @brief   Description of a CRC
+ */
+typedef struct {
+    const crc_table_t *table;       /**< lookup tables */
+    crc_accel_t accel;              /**< CPU implementation or NULL */
+    uint32_t poly;                  /**< polynomial, without the x^width
+                                         term and not reflected */
+    uint32_t init;                  /**< initial value, not reflected */
+    uint32_t xorout;                /**< value XORed to the final CRC */
+    uint8_t width;                  /**< width in bits, 8 to 32 */
+    bool reflected;                 /**< input and output are reflected */
+} crc_t;
+
+/**
+ * @brief   CRC-8/SMBUS: polynomial 0x07, initial value 0, not reflected
+ */
+extern const crc_t crc_8;
+
+/**
+ * @brief   CRC-16/SPI-FUJITSU: polynomial 0x1021, initial value 0x1d0f, not
+ *          reflected
+ *
+ * Gives the same results as @ref sys_checksum_crc16_ccitt.
+ */
+extern const crc_t crc_16_ccitt;
+
+/**
+ * @brief   CRC-32/ISO-HDLC: polynomial 0x04c11db7, as used by Ethernet, zlib
+ *          and PNG
+ */
+extern const crc_t crc_32;
+
+/**
+ * @brief   CRC-32C (Castagnoli): polynomial 0x1edc6f41, as used by iSCSI,
+ *          SCTP and ext4
+ */
+extern const crc_t crc_32c;
+
+/**
+ * @brief   Computes the lookup tables for a CRC
+ *
+ * Table k holds the CRC register after processing a byte followed by k zero
+ * bytes. Non-reflected CRCs are kept in the upper @p width bits of the
+ * register, reflected ones in the lower bits.
+ *
+ * @param[out] table        tables to fill
+ * @param[in]  poly         polynomial, without the x^width term and not
+ *                          reflected
+ * @param[in]  width        width of the CRC in bits, 8 to 32
+ * @param[in]  reflected    true for reflected CRCs
+ */
+void crc_table_init(crc_table_t *table, uint32_t poly, uint8_t width,
+                    bool reflected);
+
+/**
+ * @brief   Returns the initial CRC register for a CRC computation
+ *
+ * @param[in] crc   CRC
+ *
+ * @return  CRC register to pass to crc_update()
+ */
+uint32_t crc_start(const crc_t *crc);
+
+/**
+ * @brief   Processes data
+ *
+ * @param[in] crc   CRC
+ * @param[in] reg   CRC register from crc_start() or crc_update()
+ * @param[in] buf   data
+ * @param[in] len   length of @p buf
+ *
+ * @return  updated CRC register
+ */
+uint32_t crc_update(const crc_t *crc, uint32_t reg, const void *buf,
+                    size_t len);
+
+/**
+ * @brief   Returns the CRC from a CRC register
+ *
+ * @param[in] crc   CRC
+ * @param[in] reg   CRC register from crc_update()
+ *
+ * @return  CRC of all data passed to crc_update()
+ */
+uint32_t crc_finish(const crc_t *crc, uint32_t reg);
+
+/**
+ * @brief   Computes the CRC of a buffer
+ *
+ * @param[in] crc   CRC
+ * @param[in] buf   data
+ * @param[in] len   length of @p buf
+ *
+ * @return  CRC of @p buf
+ */
+uint32_t crc_calc(const crc_t *crc, const void *buf, size_t len);
+
+/**
+ * @brief   Processes data with the CRC peripheral of the MCU
+ *
+ * Provided by the CPU implementation with the `checksum_crc_periph`
+ * pseudomodule. It is called by crc_update() for each CRC and may process a
+ * prefix of the data, e.g. only whole words, or nothing if the peripheral
+ * does not support the CRC. It is called from thread context only.
+ *
+ * @param[in]     crc   CRC
+ * @param[in,out] reg   CRC register, see crc_table_init() for its layout
+ * @param[in]     buf   data in RAM or flash, possibly unaligned
+ * @param[in]     len   length of @p buf
+ *
+ * @return  number of bytes processed
+ */
+size_t crc_periph_update(const crc_t *crc, uint32_t *reg, const uint8_t *buf,
+                         size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHECKSUM_CRC_H */
+/** @} */
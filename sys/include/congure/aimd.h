@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_congure_aimd    CongURE AIMD implementation
+ * @ingroup     sys_congure
+ * @brief       Additive increase/multiplicative decrease (AIMD) congestion
+ *              control for @ref sys_congure
+ *
+ * The congestion window is increased by congure_aimd_consts_t::ai units
+ * every time a full congestion window worth of messages was acknowledged and
+ * reduced to congure_aimd_consts_t::md_percent percent of its current size
+ * when messages are reported lost, timed out, or marked with an ECN CE
+ * signal. To not react several times to the same congestion event, only
+ * reports for messages sent after the messages that triggered the last
+ * decrease can decrease the window again.
+ *
+ * The unit of the window is defined by the caller, e.g. bytes or number of
+ * fragments.
+ * @{
+ *
+ * @file
+ */
+#ifndef CONGURE_AIMD_H
+#define CONGURE_AIMD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "congure.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Constants for the AIMD congestion control
+ */
+typedef struct {
+    congure_wnd_size_t init_wnd;    /**< Initial congestion window */
+    congure_wnd_size_t min_wnd;     /**< Minimum congestion window */
+    congure_wnd_size_t max_wnd;     /**< Maximum congestion window */
+    /**
+     * @brief   Additive increase per fully acknowledged congestion window
+     */
+    congure_wnd_size_t ai;
+    /**
+     * @brief   Percentage of the congestion window that is kept on
+     *          congestion (multiplicative decrease)
+     *
+     * Must be less than 100.
+     */
+    uint8_t md_percent;
+} congure_aimd_consts_t;
+
+/**
+ * @brief   AIMD CongURE state object
+ *
+ * @extends congure_snd_t
+ */
+typedef struct {
+    congure_snd_t super;                    /**< see @ref congure_snd_t */
+    const congure_aimd_consts_t *consts;    /**< constants */
+    /**
+     * @brief   Units acknowledged since the last window increase
+     */
+    congure_wnd_size_t acked;
+    /**
+     * @brief   Send time in milliseconds of the newest message of the
+     *          congestion event that caused the last window decrease
+     */
+    ztimer_now_t recover;
+    bool in_recovery;                       /**< congure_aimd_snd_t::recover is valid */
+} congure_aimd_snd_t;
+
+/**
+ * @brief   Set up AIMD congestion control object
+ *
+ * @param[in] c         The AIMD congestion control object
+ * @param[in] consts    The constants to use for @p c. Must be valid for the
+ *                      whole life time of @p c.
+ */
+void congure_aimd_snd_setup(congure_aimd_snd_t *c,
+                            const congure_aimd_consts_t *consts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONGURE_AIMD_H */
+/** @} */
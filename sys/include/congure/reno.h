@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_congure_reno    CongURE Reno-like implementation
+ * @ingroup     sys_congure
+ * @brief       Reno-like congestion control for @ref sys_congure
+ *
+ * Implements slow start and congestion avoidance as in TCP Reno
+ * ([RFC 5681](https://tools.ietf.org/html/rfc5681)) for protocols that
+ * report loss explicitly (e.g. by selective acknowledgments) instead of via
+ * duplicate ACKs:
+ *
+ * - While the congestion window is below the slow start threshold, it grows
+ *   by the size of every acknowledged message.
+ * - Above the threshold it grows by congure_reno_consts_t::mss for every
+ *   fully acknowledged congestion window.
+ * - On reported loss or ECN CE the threshold is set to half the congestion
+ *   window (but at least congure_reno_consts_t::min_wnd) and the congestion
+ *   window to the new threshold (fast recovery).
+ * - On ACK timeout the threshold is halved as well, but the congestion
+ *   window falls back to congure_reno_consts_t::min_wnd (slow start).
+ *
+ * As with @ref sys_congure_aimd only messages sent after the messages that
+ * triggered the last reduction may reduce the window again.
+ * @{
+ *
+ * @file
+ */
+#ifndef CONGURE_RENO_H
+#define CONGURE_RENO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "congure.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Constants for the Reno-like congestion control
+ */
+typedef struct {
+    congure_wnd_size_t init_wnd;        /**< Initial congestion window */
+    congure_wnd_size_t min_wnd;         /**< Minimum (loss) window */
+    congure_wnd_size_t max_wnd;         /**< Maximum congestion window */
+    congure_wnd_size_t init_ssthresh;   /**< Initial slow start threshold */
+    /**
+     * @brief   Increase per fully acknowledged congestion window in
+     *          congestion avoidance
+     */
+    congure_wnd_size_t mss;
+} congure_reno_consts_t;
+
+/**
+ * @brief   Reno-like CongURE state object
+ *
+ * @extends congure_snd_t
+ */
+typedef struct {
+    congure_snd_t super;                    /**< see @ref congure_snd_t */
+    const congure_reno_consts_t *consts;    /**< constants */
+    congure_wnd_size_t ssthresh;            /**< Slow start threshold */
+    /**
+     * @brief   Units acknowledged since the last window increase in
+     *          congestion avoidance
+     */
+    congure_wnd_size_t acked;
+    /**
+     * @brief   Send time in milliseconds of the newest message of the
+     *          congestion event that caused the last window decrease
+     */
+    ztimer_now_t recover;
+    bool in_recovery;                       /**< congure_reno_snd_t::recover is valid */
+} congure_reno_snd_t;
+
+/**
+ * @brief   Set up Reno-like congestion control object
+ *
+ * @param[in] c         The Reno-like congestion control object
+ * @param[in] consts    The constants to use for @p c. Must be valid for the
+ *                      whole life time of @p c.
+ */
+void congure_reno_snd_setup(congure_reno_snd_t *c,
+                            const congure_reno_consts_t *consts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONGURE_RENO_H */
+/** @} */
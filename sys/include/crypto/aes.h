@@ -140,6 +140,41 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts consecutive blocks
+ *
+ * The key schedule is computed once for all blocks, which makes this
+ * considerably faster than calling aes_encrypt() for each block.
+ *
+ * @param       context     the cipher_context_t-struct to use for this
+ *                          encryption
+ * @param       in          the plaintext, @p blocks times the block size
+ * @param       out         buffer for the ciphertext, may be equal to @p in
+ * @param       blocks      number of blocks
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks);
+
+/**
+ * @brief   decrypts consecutive blocks
+ *
+ * @param       context     the cipher_context_t-struct to use for this
+ *                          decryption
+ * @param       in          the ciphertext, @p blocks times the block size
+ * @param       out         buffer for the plaintext, may be equal to @p in
+ * @param       blocks      number of blocks
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *in,
+                       uint8_t *out, size_t blocks);
+
 #ifdef __cplusplus
 }
 #endif
@@ -81,6 +81,22 @@ int chacha_init(chacha_ctx *ctx,
  */
 void chacha_keystream_bytes(chacha_ctx *ctx, void *x);
 
+/**
+ * @brief Generate the next blocks in the keystream.
+ *
+ * @details Same as calling chacha_keystream_bytes() @p blocks times, but
+ *          computes several blocks in parallel: 4 with SSE2 on x86 and NEON
+ *          on ARM, 2 interleaved blocks on other CPUs.
+ *
+ * @warning You need to re-initialize the context with a new nonce after 2^64
+ *          encrypted blocks, or the keystream will repeat!
+ *
+ * @param[in,out] ctx    The ChaCha context
+ * @param[out]    x      The blocks of the keystream (`64 * blocks` bytes).
+ * @param[in]     blocks Number of blocks
+ */
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x, size_t blocks);
+
 /**
  * @brief Encode or decode a block of data.
  *
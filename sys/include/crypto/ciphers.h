@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "kernel_defines.h"
 
@@ -103,6 +104,20 @@ typedef struct cipher_interface_st {
     /** @brief the decrypt function */
     int (*decrypt)(const cipher_context_t *ctx, const uint8_t *cipher_block,
                    uint8_t *plain_block);
+
+    /**
+     * @brief encrypt consecutive blocks, optional
+     *
+     * Lets an implementation amortize its setup over several blocks, e.g.
+     * the key schedule or a DMA transfer. If NULL, @ref encrypt is called
+     * for each block.
+     */
+    int (*encrypt_blocks)(const cipher_context_t *ctx, const uint8_t *in,
+                          uint8_t *out, size_t blocks);
+
+    /** @brief decrypt consecutive blocks, optional like @ref encrypt_blocks */
+    int (*decrypt_blocks)(const cipher_context_t *ctx, const uint8_t *in,
+                          uint8_t *out, size_t blocks);
 } cipher_interface_t;
 
 
@@ -186,6 +201,61 @@ int cipher_decrypt(const cipher_t *cipher, const uint8_t *input,
                    uint8_t *output);
 
 
+/**
+ * @brief Encrypt consecutive blocks of BLOCK_SIZE length
+ *
+ * Uses the multi-block function of the cipher if available, which is
+ * considerably faster than calling cipher_encrypt() for each block.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p blocks blocks of input data to encrypt
+ * @param output     pointer to allocated memory for @p blocks blocks of
+ *                   encrypted data, may be equal to @p input
+ * @param blocks     number of blocks
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+/**
+ * @brief Decrypt consecutive blocks of BLOCK_SIZE length
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p blocks blocks of input data to decrypt
+ * @param output     pointer to allocated memory for @p blocks blocks of
+ *                   decrypted data, may be equal to @p input
+ * @param blocks     number of blocks
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_decrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+/**
+ * @brief Generate counter mode key stream
+ *
+ * Encrypts @p blocks consecutive values of the counter with a single call to
+ * the multi-block function of the cipher, and increments the counter
+ * accordingly.
+ *
+ * @param cipher        Already initialized cipher struct
+ * @param nonce_counter nonce and counter, one block, incremented by
+ *                      @p blocks
+ * @param nonce_len     length of the nonce in @p nonce_counter, the
+ *                      remaining bytes are the counter
+ * @param stream        pointer to allocated memory for @p blocks blocks of
+ *                      key stream
+ * @param blocks        number of blocks
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_ctr_keystream(const cipher_t *cipher, uint8_t *nonce_counter,
+                         uint8_t nonce_len, uint8_t *stream, size_t blocks);
+
 /**
  * @brief Get block size of cipher
  * *
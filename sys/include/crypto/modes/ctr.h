@@ -26,6 +26,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Number of key stream blocks generated with one call to the cipher
+ *
+ * The key stream buffer is allocated on the stack.
+ */
+#ifndef CONFIG_CIPHER_CTR_STREAM_BLOCKS
+#define CONFIG_CIPHER_CTR_STREAM_BLOCKS     (4U)
+#endif
+
 /**
  * @brief Encrypt data of arbitrary length in counter mode.
  *
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file        gcm.h
+ * @brief       Galois/Counter Mode (GCM) of operation for block ciphers
+ *
+ * Implements GCM as specified in NIST SP 800-38D, as used by the AES-GCM
+ * cipher suites of TLS 1.3 and DTLS.
+ *
+ * The GHASH multiplication uses a 4-bit table computed from the key for each
+ * message. With the `crypto_aes_ni` or `crypto_aes_armv8` backend, it uses the
+ * carry-less multiplication instructions of the same instruction set
+ * extension instead (PCLMULQDQ or PMULL).
+ *
+ * @author      RIOT Developers
+ */
+
+#ifndef CRYPTO_MODES_GCM_H
+#define CRYPTO_MODES_GCM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "crypto/ciphers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name GCM error codes
+ * @{
+ */
+
+/**
+ * Returned if a nonce of bad length (empty) was used
+ */
+#define GCM_ERR_INVALID_NONCE_LENGTH        (-2)
+/**
+ * GCM only works with ciphers with a block size of 128 bit
+ */
+#define GCM_ERR_INVALID_BLOCK_LENGTH        (-3)
+/**
+ * Returned if the amount of input data cannot be handled by this implementation
+ */
+#define GCM_ERR_INVALID_DATA_LENGTH         (-3)
+/**
+ * Returned if a tag of bad length was requested (not 4, 8 or 12 to 16 bytes)
+ */
+#define GCM_ERR_INVALID_TAG_LENGTH          (-4)
+/**
+ * Returned if the authentication failed during decryption
+ */
+#define GCM_ERR_INVALID_TAG                 (-5)
+
+/** @} */
+
+/**
+ * @brief Block size required for the cipher
+ */
+#define GCM_BLOCK_SIZE                      (16U)
+
+/**
+ * @brief Recommended length of the nonce in bytes
+ *
+ * Other lengths are supported, but cost additional GHASH computations.
+ */
+#define GCM_NONCE_LEN                       (12U)
+
+/**
+ * @brief Maximum length of the tag in bytes
+ */
+#define GCM_TAG_MAX_LEN                     (16U)
+
+/**
+ * @brief Encrypt and authenticate data of arbitrary length in GCM mode.
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate in the tag
+ * @param auth_data_len    Length of additional data
+ * @param tag_len          Length of the appended tag (4, 8 or 12 to 16 bytes)
+ * @param nonce            Nonce for the encryption (must be unique)
+ * @param nonce_len        Length of the nonce in bytes, preferably
+ *                         @ref GCM_NONCE_LEN
+ * @param input            pointer to input data to encrypt
+ * @param input_len        length of the input data.
+ *                         input_len + tag_len must be smaller than INT32_MAX (2^31-1)
+ * @param output           pointer to allocated memory for encrypted data.
+ *                         The tag will be appended to the ciphertext.
+ *                         It has to be of size input_len + tag_len.
+ *                         May be equal to @p input.
+ * @return                 Length of the encrypted data (including the tag) or a (negative) error code
+ */
+int32_t cipher_encrypt_gcm(const cipher_t *cipher,
+                           const uint8_t *auth_data, size_t auth_data_len,
+                           uint8_t tag_len,
+                           const uint8_t *nonce, size_t nonce_len,
+                           const uint8_t *input, size_t input_len,
+                           uint8_t *output);
+
+/**
+ * @brief Decrypt and verify the authentication of GCM encrypted data.
+ *
+ * @param cipher           Already initialized cipher struct
+ * @param auth_data        Additional data to authenticate in the tag
+ * @param auth_data_len    Length of additional data
+ * @param tag_len          Length of the appended tag (4, 8 or 12 to 16 bytes)
+ * @param nonce            Nonce used for the encryption
+ * @param nonce_len        Length of the nonce in bytes
+ * @param input            pointer to the ciphertext with the tag appended
+ * @param input_len        length of the input data.
+ *                         input_len - tag_len must be smaller than INT32_MAX (2^31-1)
+ * @param output           pointer to allocated memory for the plaintext data.
+ *                         It has to be of size input_len - tag_len.
+ *                         May be equal to @p input.
+ *                         Will contain only zeroes, if the authentication fails.
+ * @return                 Length of the plaintext data or a (negative) error code
+ */
+int32_t cipher_decrypt_gcm(const cipher_t *cipher,
+                           const uint8_t *auth_data, size_t auth_data_len,
+                           uint8_t tag_len,
+                           const uint8_t *nonce, size_t nonce_len,
+                           const uint8_t *input, size_t input_len,
+                           uint8_t *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_MODES_GCM_H */
+/** @} */
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+/**
+ * @defgroup    sys_hashes_hkdf HKDF
+ * @ingroup     sys_hashes
+ * @brief       HKDF key derivation with HMAC-SHA-256 (RFC 5869)
+ * @{
+ *
+ * @file
+ * @brief       HKDF key derivation with HMAC-SHA-256 (RFC 5869)
+ *
+ * @author      RIOT Developers
+ *
+ * @}
+ */
+
+#ifndef HASHES_HKDF_H
+#define HASHES_HKDF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hashes/sha256.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of the pseudorandom key of HKDF-SHA-256
+ */
+#define HKDF_SHA256_PRK_SIZE    SHA256_DIGEST_LENGTH
+
+/**
+ * @brief   Maximum length of the output keying material of HKDF-SHA-256
+ */
+#define HKDF_SHA256_MAX_OKM_SIZE    (255U * SHA256_DIGEST_LENGTH)
+
+/**
+ * @brief Extracts a pseudorandom key from the input keying material
+ *
+ * @param[in]   salt        optional salt, may be NULL
+ * @param[in]   salt_len    length of @p salt, a missing salt is a string of
+ *                          SHA256_DIGEST_LENGTH zeros
+ * @param[in]   ikm         input keying material
+ * @param[in]   ikm_len     length of @p ikm
+ * @param[out]  prk         pseudorandom key, HKDF_SHA256_PRK_SIZE bytes
+ */
+void hkdf_sha256_extract(const void *salt, size_t salt_len,
+                         const void *ikm, size_t ikm_len,
+                         uint8_t *prk);
+
+/**
+ * @brief Expands a pseudorandom key into output keying material
+ *
+ * @param[in]   prk         pseudorandom key, e.g. from hkdf_sha256_extract()
+ * @param[in]   prk_len     length of @p prk, at least SHA256_DIGEST_LENGTH
+ * @param[in]   info        optional context information, may be NULL
+ * @param[in]   info_len    length of @p info
+ * @param[out]  okm         output keying material
+ * @param[in]   okm_len     length of @p okm
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p okm_len exceeds HKDF_SHA256_MAX_OKM_SIZE
+ */
+int hkdf_sha256_expand(const void *prk, size_t prk_len,
+                       const void *info, size_t info_len,
+                       uint8_t *okm, size_t okm_len);
+
+/**
+ * @brief Derives output keying material from input keying material, i.e.
+ *        hkdf_sha256_extract() followed by hkdf_sha256_expand()
+ *
+ * @param[in]   salt        optional salt, may be NULL
+ * @param[in]   salt_len    length of @p salt
+ * @param[in]   ikm         input keying material
+ * @param[in]   ikm_len     length of @p ikm
+ * @param[in]   info        optional context information, may be NULL
+ * @param[in]   info_len    length of @p info
+ * @param[out]  okm         output keying material
+ * @param[in]   okm_len     length of @p okm
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p okm_len exceeds HKDF_SHA256_MAX_OKM_SIZE
+ */
+int hkdf_sha256(const void *salt, size_t salt_len,
+                const void *ikm, size_t ikm_len,
+                const void *info, size_t info_len,
+                uint8_t *okm, size_t okm_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HASHES_HKDF_H */
@@ -52,6 +52,7 @@
 #include <stddef.h>
 
 #include "hashes/sha2xx_common.h"
+#include "kernel_defines.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -67,6 +68,25 @@ extern "C" {
  */
 #define SHA256_INTERNAL_BLOCK_SIZE (64)
 
+/**
+ * @brief   Number of messages sha256_mb() and hmac_sha256_mb() hash in
+ *          parallel
+ *
+ * 8 lanes with the `hashes_sha256_mb_avx2` pseudomodule on `native`, 4 lanes
+ * with SSE2 on x86 and NEON on ARM, otherwise the messages are hashed one
+ * after the other. The SHA instructions used by `hashes_sha256_ni` and
+ * `hashes_sha256_armv8` hash a single message faster than 4 SIMD lanes, so
+ * with these the messages are hashed one after the other as well.
+ */
+#if IS_USED(MODULE_HASHES_SHA256_MB_AVX2)
+#define SHA256_MB_LANES (8U)
+#elif (defined(__i386__) || defined(__x86_64__) || defined(__ARM_NEON)) && \
+    !IS_USED(MODULE_HASHES_SHA256_NI) && !IS_USED(MODULE_HASHES_SHA256_ARMV8)
+#define SHA256_MB_LANES (4U)
+#else
+#define SHA256_MB_LANES (1U)
+#endif
+
 /**
  * @brief Context for cipher operations based on sha256
  */
@@ -82,6 +102,20 @@ typedef struct {
     sha256_context_t c_out;
 } hmac_context_t;
 
+/**
+ * @brief Precomputed key for HMAC-SHA-256
+ *
+ * Holds the SHA-256 states after the inner and the outer key pad. Every HMAC
+ * with the same key starts from these states, which saves the compression of
+ * both key pads per HMAC, e.g. in the iterations of PBKDF2.
+ */
+typedef struct {
+    /** State after the inner key pad */
+    uint32_t in[8];
+    /** State after the outer key pad */
+    uint32_t out[8];
+} hmac_sha256_key_t;
+
 /**
  * @brief sha256-chain indexed element
  */
@@ -160,6 +194,40 @@ void hmac_sha256_update(hmac_context_t *ctx, const void *data, size_t len);
  */
 void hmac_sha256_final(hmac_context_t *ctx, void *digest);
 
+/**
+ * @brief Precomputes the key pads of an HMAC-SHA-256 key
+ *
+ * @param[out] pk           the precomputed key
+ * @param[in]  key          key used in the hmac-sha256 computation
+ * @param[in]  key_length   the size in bytes of the key
+ */
+void hmac_sha256_precompute(hmac_sha256_key_t *pk,
+                            const void *key, size_t key_length);
+
+/**
+ * @brief Initiates an HMAC calculation with a precomputed key
+ *
+ * Continue with hmac_sha256_update() and hmac_sha256_final() like after
+ * hmac_sha256_init().
+ *
+ * @param[out] ctx  hmac_context_t handle to use
+ * @param[in]  pk   the precomputed key
+ */
+void hmac_sha256_init_precomputed(hmac_context_t *ctx,
+                                  const hmac_sha256_key_t *pk);
+
+/**
+ * @brief Computes a hmac-sha256 with a precomputed key
+ *
+ * @param[in]  pk       the precomputed key
+ * @param[in]  data     pointer to the buffer to generate the hmac-sha256
+ * @param[in]  len      the length of the message in bytes
+ * @param[out] digest   the computed hmac-sha256,
+ *                      length MUST be SHA256_DIGEST_LENGTH
+ */
+void hmac_sha256_precomputed(const hmac_sha256_key_t *pk,
+                             const void *data, size_t len, void *digest);
+
 /**
  * @brief function to compute a hmac-sha256 from a given message
  *
@@ -176,6 +244,39 @@ void hmac_sha256_final(hmac_context_t *ctx, void *digest);
 const void *hmac_sha256(const void *key, size_t key_length,
                         const void *data, size_t len, void *digest);
 
+/**
+ * @brief Computes the SHA-256 of several independent messages
+ *
+ * The messages are hashed in groups of @ref SHA256_MB_LANES, one SIMD lane
+ * per message. This is considerably faster than calling sha256() for each
+ * message when many short messages of similar length are hashed.
+ *
+ * @param[in]  data     the messages
+ * @param[in]  len      the lengths of the messages
+ * @param[out] digest   buffers for the digests, SHA256_DIGEST_LENGTH bytes
+ *                      each
+ * @param[in]  n        number of messages
+ */
+void sha256_mb(const void *const data[], const size_t len[],
+               void *const digest[], size_t n);
+
+/**
+ * @brief Computes the HMAC-SHA-256 of several messages with the same key
+ *
+ * The key is processed once, the messages are hashed like with sha256_mb().
+ *
+ * @param[in]  key          key used in the hmac-sha256 computation
+ * @param[in]  key_length   the size in bytes of the key
+ * @param[in]  data         the messages
+ * @param[in]  len          the lengths of the messages
+ * @param[out] digest       buffers for the HMACs, SHA256_DIGEST_LENGTH bytes
+ *                          each
+ * @param[in]  n            number of messages
+ */
+void hmac_sha256_mb(const void *key, size_t key_length,
+                    const void *const data[], const size_t len[],
+                    void *const digest[], size_t n);
+
 /**
  * @brief function to produce a hash chain starting with a given seed element.
  *        The chain is computed by taking the sha256 from the seed,
@@ -103,6 +103,30 @@ static const uint32_t K[64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
+/**
+ * @brief SHA-224/256 block compression function
+ *
+ * Transforms @p state by @p blocks consecutive 64 byte blocks of @p data.
+ *
+ * The portable implementation can be replaced with one of these
+ * pseudomodules:
+ *  - `hashes_sha256_unroll`: fully unrolled C, faster on MCUs like Cortex-M
+ *    at the expense of flash
+ *  - `hashes_sha256_ni`: x86 SHA extensions, for `native` on a host CPU
+ *    supporting them
+ *  - `hashes_sha256_armv8`: ARMv8 Cryptography Extension, the target must be
+ *    built with it enabled, e.g. `-march=armv8-a+crypto`
+ *  - `hashes_sha256_periph`: hash peripheral of the MCU. The CPU
+ *    implementation has to provide this function. It is called from thread
+ *    context only, with @p data in RAM or flash, possibly unaligned.
+ *
+ * @param[in,out] state     hash state
+ * @param[in]     data      input blocks
+ * @param[in]     blocks    number of blocks
+ */
+void sha2xx_transform_blocks(uint32_t state[8], const void *data,
+                             size_t blocks);
+
 /**
  * @brief SHA-2XX initialization.  Begins a SHA-2XX operation.
  *
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_kvstore     Key-value store on MTD
+ * @ingroup     sys
+ * @brief       Wear-leveled key-value store for configuration and counters
+ *
+ * This module stores small values under string keys on an
+ * @ref drivers_mtd device. Unlike @ref sys_eepreg and @ref drivers_nvram, it
+ * never rewrites data in place: every update appends a new record, so
+ * frequently updated values like counters spread their writes over all
+ * sectors of the device.
+ *
+ * ## Log structure
+ *
+ * Records are appended to the current sector. When it is full, the store
+ * continues in the next sector, which is always kept erased. Once that leaves
+ * no erased sector, the records of the oldest sector that are still current
+ * are copied to the new sector, and the oldest sector is erased. All sectors
+ * are thus erased in turn, no matter which keys are updated. At least two
+ * sectors are needed.
+ *
+ * Each record carries a CRC-16-CCITT, each sector a sequence number. A record
+ * that was not completely programmed is ignored on the next mount, an
+ * interrupted garbage collection is completed. Records are only appended up
+ * to the size of the largest record before the end of a sector: this space
+ * takes the copy that is redone after a power loss during garbage collection.
+ * A sector has to take at least three records of the maximum size.
+ *
+ * ## RAM index
+ *
+ * @ref kvstore_init reads all records and builds a hash table in a
+ * caller-provided array, mapping the hash of each key to the address of its
+ * current record. A lookup thus takes a constant number of flash reads,
+ * independent of the number of keys or updates. The table needs one entry
+ * per key plus at least one free entry; a quarter of the entries free keeps
+ * the probe sequences short.
+ *
+ * ## Usage
+ *
+ * ```
+ * USEMODULE += kvstore
+ * ```
+ *
+ * ```
+ * static kvstore_t kv;
+ * static kvstore_entry_t index[32];
+ *
+ * kvstore_init(&kv, mtd, index, ARRAY_SIZE(index));
+ * kvstore_set(&kv, "boot_count", &count, sizeof(count));
+ * kvstore_get(&kv, "boot_count", &count, sizeof(count));
+ * ```
+ *
+ * To use the internal flash of the MCU, put the store on a
+ * @ref drivers_mtd_mapper region of a @ref drivers_mtd_flashpage device.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Key-value store interface
+ */
+
+#ifndef KVSTORE_H
+#define KVSTORE_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_kvstore_config     Key-value store compile configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Maximum length of a key, at most 254
+ */
+#ifndef CONFIG_KVSTORE_KEY_MAX
+#define CONFIG_KVSTORE_KEY_MAX      (32U)
+#endif
+
+/**
+ * @brief   Maximum size of a value in bytes
+ */
+#ifndef CONFIG_KVSTORE_VALUE_MAX
+#define CONFIG_KVSTORE_VALUE_MAX    (128U)
+#endif
+/** @} */
+
+/**
+ * @brief   Alignment of records on the device in bytes
+ *
+ * Must be a multiple of the write granularity of the device. The default
+ * covers the internal flash of most MCUs.
+ */
+#ifndef KVSTORE_ALIGN
+#define KVSTORE_ALIGN               (8U)
+#endif
+
+/**
+ * @brief   Entry of the RAM index
+ */
+typedef struct {
+    uint32_t hash;              /**< hash of the key */
+    uint32_t addr;              /**< address of the current record */
+} kvstore_entry_t;
+
+/**
+ * @brief   Key-value store descriptor
+ */
+typedef struct {
+    mtd_dev_t *mtd;             /**< backing MTD device */
+    kvstore_entry_t *index;     /**< RAM index */
+    uint32_t index_size;        /**< number of entries of @ref index */
+    uint32_t entries;           /**< number of keys */
+    uint32_t live;              /**< bytes of the current records */
+    uint32_t sector_size;       /**< size of a sector in bytes */
+    uint32_t oldest;            /**< sector with the oldest records */
+    uint32_t head;              /**< sector records are appended to */
+    uint32_t head_seq;          /**< sequence number of @ref head */
+    uint32_t pos;               /**< end of the records in @ref head */
+    uint32_t gc_runs;           /**< number of sectors collected */
+    mutex_t lock;               /**< guards the store */
+} kvstore_t;
+
+/**
+ * @brief   Mounts a key-value store and builds its index
+ *
+ * A device that does not contain a store is used as an empty store.
+ *
+ * @param[out] kv           store descriptor to initialize
+ * @param[in]  mtd          backing MTD device, with at least two sectors
+ * @param[in]  index        array for the RAM index
+ * @param[in]  index_size   number of entries of @p index, a power of two
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the device is too small or @p index_size is invalid
+ * @return  -ENOMEM if the device holds more keys than @p index can take
+ * @return  < 0 on error of the device
+ */
+int kvstore_init(kvstore_t *kv, mtd_dev_t *mtd, kvstore_entry_t *index,
+                 uint32_t index_size);
+
+/**
+ * @brief   Removes all keys
+ *
+ * @param[in] kv        a mounted store
+ *
+ * @return  0 on success
+ * @return  < 0 on error of the device
+ */
+int kvstore_format(kvstore_t *kv);
+
+/**
+ * @brief   Reads the value of a key
+ *
+ * @param[in]  kv       a mounted store
+ * @param[in]  key      key to look up
+ * @param[out] buf      buffer for the value
+ * @param[in]  len      size of @p buf
+ *
+ * @return  size of the value
+ * @return  -ENOENT if @p key is not set
+ * @return  -ENOBUFS if @p buf is too small
+ * @return  < 0 on error of the device
+ */
+ssize_t kvstore_get(kvstore_t *kv, const char *key, void *buf, size_t len);
+
+/**
+ * @brief   Sets the value of a key
+ *
+ * Nothing is written if the key already has this value.
+ *
+ * @param[in] kv        a mounted store
+ * @param[in] key       key, at most @ref CONFIG_KVSTORE_KEY_MAX characters
+ * @param[in] value     value
+ * @param[in] len       size of @p value, at most
+ *                      @ref CONFIG_KVSTORE_VALUE_MAX
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p key or @p len are invalid
+ * @return  -ENOMEM if the index is full
+ * @return  -ENOSPC if the device is full
+ * @return  < 0 on error of the device
+ */
+int kvstore_set(kvstore_t *kv, const char *key, const void *value, size_t len);
+
+/**
+ * @brief   Removes a key
+ *
+ * @param[in] kv        a mounted store
+ * @param[in] key       key to remove
+ *
+ * @return  0 on success
+ * @return  -ENOENT if @p key is not set
+ * @return  < 0 on error of the device
+ */
+int kvstore_delete(kvstore_t *kv, const char *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KVSTORE_H */
+/** @} */
@@ -121,6 +121,16 @@ extern "C" {
 #define CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER              (0U)
 #endif
 
+/**
+ * @brief   Number of flows the IPHC flow cache keeps the address compression
+ *          modes for
+ *
+ * @note    Only applicable with `gnrc_sixlowpan_iphc_cache` module
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE      (4U)
+#endif
+
 /**
  * @brief   Registration lifetime in minutes for the address registration option
  *
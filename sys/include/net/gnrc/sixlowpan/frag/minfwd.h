@@ -59,6 +59,36 @@ int gnrc_sixlowpan_frag_minfwd_forward(gnrc_pktsnip_t *pkt,
                                        gnrc_sixlowpan_frag_vrb_t *vrbe,
                                        unsigned page);
 
+/**
+ * @brief   Forwards a received fragment without copying it
+ *
+ * Other than gnrc_sixlowpan_frag_minfwd_forward() the fragmentation header of
+ * @p pkt is rewritten in place and its network interface header is reused for
+ * the next hop (see gnrc_sixlowpan_frag_vrb_netif_hdr()), so in the common
+ * case of an exclusively held fragment nothing is allocated from the packet
+ * buffer.
+ *
+ * @param[in] pkt       The fragment to forward as received, i.e. starting with
+ *                      its fragmentation header (either
+ *                      @ref sixlowpan_frag_t or @ref sixlowpan_frag_n_t) and
+ *                      followed by its network interface header. Is consumed
+ *                      by this function.
+ * @param[in] vrbe      Virtual reassembly buffer containing the forwarding
+ *                      information. Removed when datagram was completely
+ *                      forwarded.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ *
+ * @pre `vrbe != NULL`
+ * @pre `(pkt != NULL) && (pkt->size >= sizeof(sixlowpan_frag_t))`
+ *
+ * @return  0 on success.
+ * @return  -ENOMEM, when packet buffer is too full to prepare packet for
+ *          forwarding.
+ */
+int gnrc_sixlowpan_frag_minfwd_forward_in_place(gnrc_pktsnip_t *pkt,
+                                                gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                                unsigned page);
+
 /**
  * @brief   Fragments a packet with just the IPHC (and padding payload to get
  *          to 8 byte) as the first fragment
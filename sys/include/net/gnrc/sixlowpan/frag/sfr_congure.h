@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_sfr_congure Congestion control for SFR
+ * @ingroup     net_gnrc_sixlowpan_frag_sfr
+ * @brief       Congestion control for selective fragment recovery using
+ *              @ref sys_congure
+ *
+ * With module `gnrc_sixlowpan_frag_sfr_congure` the window of a datagram
+ * sent via selective fragment recovery is not fixed to
+ * @ref CONFIG_GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE but follows the congestion
+ * window of a @ref sys_congure object in units of fragments, bounded by
+ * @ref CONFIG_GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE and
+ * @ref CONFIG_GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE. Acknowledged fragments grow the
+ * window, fragments reported missing in an RFRAG ACK, ACK timeouts, and ECN
+ * echoes shrink it.
+ *
+ * The algorithm is selected with one of the following modules:
+ *
+ * - `gnrc_sixlowpan_frag_sfr_congure_aimd`: @ref sys_congure_aimd (default)
+ * - `gnrc_sixlowpan_frag_sfr_congure_reno`: @ref sys_congure_reno
+ *
+ * One CongURE object is allocated per fragmentation buffer entry, so the
+ * congestion state is kept over datagram retries, but not between
+ * datagrams.
+ * @{
+ *
+ * @file
+ * @brief   Congestion control for selective fragment recovery definitions
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE_H
+
+#include <stdint.h>
+
+#include "congure.h"
+#include "kernel_defines.h"
+#include "net/gnrc/sixlowpan/frag/fb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE) || defined(DOXYGEN)
+/**
+ * @brief   Get a free CongURE object of the selected algorithm
+ *
+ * @note    Provided by the algorithm selection module, e.g.
+ *          `gnrc_sixlowpan_frag_sfr_congure_aimd`.
+ *
+ * @return  A set-up, but uninitialized CongURE object.
+ * @return  NULL, if all CongURE objects are in use.
+ */
+congure_snd_t *gnrc_sixlowpan_frag_sfr_congure_snd_get(void);
+
+/**
+ * @brief   Set up congestion control for a datagram and apply its
+ *          congestion window to the window of @p fbuf
+ *
+ * The CongURE object of @p fbuf is only allocated and initialized if it does
+ * not already have one (e.g. on datagram retries). If no CongURE object is
+ * available @p fbuf keeps its static window.
+ *
+ * @param[in,out] fbuf  Fragmentation buffer entry of the datagram.
+ */
+void gnrc_sixlowpan_frag_sfr_congure_snd_init(gnrc_sixlowpan_frag_fb_t *fbuf);
+
+/**
+ * @brief   Report that a fragment of @p fbuf was sent
+ *
+ * @param[in] fbuf  Fragmentation buffer entry of the datagram.
+ */
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_frag_sent(
+        gnrc_sixlowpan_frag_fb_t *fbuf);
+
+/**
+ * @brief   Report that a fragment of @p fbuf was acknowledged
+ *
+ * @param[in] fbuf      Fragmentation buffer entry of the datagram.
+ * @param[in] msg       The acknowledged fragment. Only
+ *                      congure_snd_msg_t::send_time and
+ *                      congure_snd_msg_t::resends need to be set.
+ */
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_frag_acked(
+        gnrc_sixlowpan_frag_fb_t *fbuf, congure_snd_msg_t *msg);
+
+/**
+ * @brief   Report that fragments of @p fbuf are known to be lost
+ *
+ * @param[in] fbuf      Fragmentation buffer entry of the datagram.
+ * @param[in] msg       All lost fragments of one RFRAG ACK summarized as one
+ *                      message: congure_snd_msg_t::size is the number of lost
+ *                      fragments, congure_snd_msg_t::send_time the send time
+ *                      of the most recently sent of them.
+ */
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_lost(
+        gnrc_sixlowpan_frag_fb_t *fbuf, congure_snd_msg_t *msg);
+
+/**
+ * @brief   Report that the ACK for fragments of @p fbuf timed out
+ *
+ * @param[in] fbuf      Fragmentation buffer entry of the datagram.
+ * @param[in] msg       All timed out fragments summarized as one message, see
+ *                      gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_lost()
+ */
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_timeout(
+        gnrc_sixlowpan_frag_fb_t *fbuf, congure_snd_msg_t *msg);
+
+/**
+ * @brief   Report an ECN echo for @p fbuf
+ *
+ * @param[in] fbuf      Fragmentation buffer entry of the datagram.
+ * @param[in] time      Send time in milliseconds of the most recently sent
+ *                      fragment covered by the echoing RFRAG ACK.
+ */
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_ecn_ce(
+        gnrc_sixlowpan_frag_fb_t *fbuf, ztimer_now_t time);
+
+/**
+ * @brief   Release the CongURE object of @p fbuf
+ *
+ * @param[in,out] fbuf  Fragmentation buffer entry of the datagram.
+ */
+void gnrc_sixlowpan_frag_sfr_congure_snd_destroy(gnrc_sixlowpan_frag_fb_t *fbuf);
+#else   /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE) || defined(DOXYGEN) */
+static inline void gnrc_sixlowpan_frag_sfr_congure_snd_init(
+        gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    (void)fbuf;
+}
+
+static inline void gnrc_sixlowpan_frag_sfr_congure_snd_report_frag_sent(
+        gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    (void)fbuf;
+}
+
+static inline void gnrc_sixlowpan_frag_sfr_congure_snd_report_frag_acked(
+        gnrc_sixlowpan_frag_fb_t *fbuf, congure_snd_msg_t *msg)
+{
+    (void)fbuf;
+    (void)msg;
+}
+
+static inline void gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_lost(
+        gnrc_sixlowpan_frag_fb_t *fbuf, congure_snd_msg_t *msg)
+{
+    (void)fbuf;
+    (void)msg;
+}
+
+static inline void gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_timeout(
+        gnrc_sixlowpan_frag_fb_t *fbuf, congure_snd_msg_t *msg)
+{
+    (void)fbuf;
+    (void)msg;
+}
+
+static inline void gnrc_sixlowpan_frag_sfr_congure_snd_report_ecn_ce(
+        gnrc_sixlowpan_frag_fb_t *fbuf, ztimer_now_t time)
+{
+    (void)fbuf;
+    (void)time;
+}
+
+static inline void gnrc_sixlowpan_frag_sfr_congure_snd_destroy(
+        gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    (void)fbuf;
+}
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE) || defined(DOXYGEN) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE_H */
+/** @} */
@@ -23,8 +23,12 @@
 #include "bitfield.h"
 #include "clist.h"
 #include "evtimer_msg.h"
+#include "kernel_defines.h"
 #include "msg.h"
 #include "xtimer.h"
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE)
+#include "congure.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +59,15 @@ typedef struct gnrc_sixlowpan_frag_sfr_fb {
                                  *   fragments */
     uint8_t retrans;            /**< Datagram retransmissions */
     clist_node_t window;        /**< Sent fragments of the current window */
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE) || defined(DOXYGEN)
+    /**
+     * @brief   Congestion control for the datagram
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_sfr_congure`.
+     *          May be NULL, if no CongURE object was available.
+     */
+    congure_snd_t *congure;
+#endif
 } gnrc_sixlowpan_frag_sfr_fb_t;
 
 #ifdef __cplusplus
@@ -146,13 +146,53 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_reverse(
  *
  * @param[in] vrb   A VRB entry
  */
-static inline void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb)
-{
-    if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB)) {
-        gnrc_sixlowpan_frag_rb_base_rm(&vrb->super);
-    }
-    vrb->super.src_len = 0;
-}
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb);
+
+/**
+ * @brief   Restarts the timeout of a VRB entry
+ *
+ * Sets gnrc_sixlowpan_frag_rb_base_t::arrival of @p vrb to the current time.
+ * A removal scheduled with @ref gnrc_sixlowpan_frag_vrb_rm_delayed() is
+ * cancelled.
+ *
+ * @pre `!gnrc_sixlowpan_frag_vrb_entry_empty(vrb)`
+ *
+ * @param[in] vrb   A VRB entry
+ */
+void gnrc_sixlowpan_frag_vrb_refresh(gnrc_sixlowpan_frag_vrb_t *vrb);
+
+/**
+ * @brief   Removes an entry from the VRB after
+ *          @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER
+ *
+ * The entry is removed immediately if
+ * @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER is 0.
+ *
+ * @pre `!gnrc_sixlowpan_frag_vrb_entry_empty(vrb)`
+ *
+ * @param[in] vrb   A VRB entry
+ */
+void gnrc_sixlowpan_frag_vrb_rm_delayed(gnrc_sixlowpan_frag_vrb_t *vrb);
+
+/**
+ * @brief   Readdresses a received fragment to the next hop of a VRB entry
+ *
+ * The network interface header of @p pkt is rewritten in place to point to
+ * gnrc_sixlowpan_frag_rb_base_t::dst of @p vrbe via
+ * gnrc_sixlowpan_frag_vrb_t::out_netif, so forwarding a fragment does not
+ * require a new allocation from the packet buffer. Only if @p pkt does not
+ * have a network interface header that can be written to exclusively and is
+ * large enough for the next hop's address, a new one is allocated.
+ *
+ * @param[in] vrbe  A VRB entry. Must not be `NULL`.
+ * @param[in] pkt   A received fragment. Will be released on error.
+ *
+ * @return  @p pkt, preceded by its network interface header towards the next
+ *          hop.
+ * @return  NULL, if no network interface header could be allocated.
+ */
+gnrc_pktsnip_t *gnrc_sixlowpan_frag_vrb_netif_hdr(
+        const gnrc_sixlowpan_frag_vrb_t *vrbe, gnrc_pktsnip_t *pkt);
 
 /**
  * @brief   Determines if a VRB entry is empty
@@ -63,6 +63,22 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+/**
+ * @brief   Invalidates all entries of the IPHC flow cache
+ *
+ * With the `gnrc_sixlowpan_iphc_cache` module, the address compression modes
+ * and context identifiers chosen for a flow (source, destination, interface,
+ * link-layer destination) are cached, so that they do not need to be
+ * determined again for every packet of that flow. This needs to be called
+ * whenever an input of that decision besides the flow itself changes, i.e.
+ * when a compression context or the link-layer address of an interface is
+ * updated. @ref gnrc_sixlowpan_ctx_update() and @ref gnrc_netif take care of
+ * that already.
+ *
+ * @note    Only available with module `gnrc_sixlowpan_iphc_cache`.
+ */
+void gnrc_sixlowpan_iphc_cache_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,7 +65,8 @@ typedef struct ieee802154_radio_cipher_ops {
      * @param[in]       dev         Will be @ref ieee802154_sec_context_t::ieee802154_sec_dev_t
      * @param[in]       cipher      Output cipher blocks
      * @param[in, out]  iv          in: IV; out: computed MIC
-     * @param[in]       plain       Input plain blocks
+     * @param[in]       plain       Input plain blocks, may be equal to
+     *                              @p cipher
      * @param[in]       nblocks     Number of blocks
      */
     void (*cbc)(const ieee802154_sec_dev_t *dev,
@@ -78,13 +79,73 @@ typedef struct ieee802154_radio_cipher_ops {
      *
      * @param[in]       dev         Will be @ref ieee802154_sec_context_t::ieee802154_sec_dev_t
      * @param[out]      cipher      Output cipher blocks
-     * @param[in]       plain       Input plain blocks
+     * @param[in]       plain       Input plain blocks, may be equal to
+     *                              @p cipher
      * @param[in]       nblocks     Number of blocks
      */
     void (*ecb)(const ieee802154_sec_dev_t *dev,
                 uint8_t *cipher,
                 const uint8_t *plain,
                 uint8_t nblocks);
+    /**
+     * @brief   Function to secure a whole frame with CCM*
+     *
+     * For radios whose AES engine processes whole frames. If this is `NULL`
+     * or returns -IEEE802154_SEC_UNSUPORTED, the frame is secured in software
+     * with the @ref ieee802154_radio_cipher_ops_t::cbc and
+     * @ref ieee802154_radio_cipher_ops_t::ecb operations.
+     *
+     * @param[in]       dev             Will be @ref ieee802154_sec_context_t::ieee802154_sec_dev_t
+     * @param[in]       nonce           13 byte CCM* nonce
+     * @param[in]       security_level  One of IEEE802154_SEC_SCF_SECLEVEL_*
+     * @param[in]       a               Header and auxiliary header
+     * @param[in]       a_len           Length of @p a
+     * @param[in, out]  m               in: Plain payload; out: Payload,
+     *                                  encrypted if @p security_level
+     *                                  requires it
+     * @param[in]       m_len           Length of @p m
+     * @param[out]      mic             Encrypted MIC
+     * @param[in]       mic_size        Size of the MIC, 0 if
+     *                                  @p security_level has none
+     *
+     * @return  IEEE802154_SEC_OK on success
+     * @return  -IEEE802154_SEC_UNSUPORTED to fall back to software
+     */
+    int (*ccm_encrypt)(const ieee802154_sec_dev_t *dev,
+                       const uint8_t *nonce,
+                       uint8_t security_level,
+                       const uint8_t *a, uint16_t a_len,
+                       uint8_t *m, uint16_t m_len,
+                       uint8_t *mic, uint8_t mic_size);
+    /**
+     * @brief   Function to decrypt and check a whole frame with CCM*
+     *
+     * Counterpart of @ref ieee802154_radio_cipher_ops_t::ccm_encrypt, with
+     * the same fallback.
+     *
+     * @param[in]       dev             Will be @ref ieee802154_sec_context_t::ieee802154_sec_dev_t
+     * @param[in]       nonce           13 byte CCM* nonce
+     * @param[in]       security_level  One of IEEE802154_SEC_SCF_SECLEVEL_*
+     * @param[in]       a               Header and auxiliary header
+     * @param[in]       a_len           Length of @p a
+     * @param[in, out]  c               in: Received payload; out: Plain
+     *                                  payload
+     * @param[in]       c_len           Length of @p c
+     * @param[in, out]  mic             in: Received MIC; out: Decrypted MIC
+     * @param[in]       mic_size        Size of the MIC, 0 if
+     *                                  @p security_level has none
+     *
+     * @return  IEEE802154_SEC_OK on success
+     * @return  -IEEE802154_SEC_MAC_CHECK_FAILURE if the MIC does not match
+     * @return  -IEEE802154_SEC_UNSUPORTED to fall back to software, @p c and
+     *          @p mic must be left unchanged then
+     */
+    int (*ccm_decrypt)(const ieee802154_sec_dev_t *dev,
+                       const uint8_t *nonce,
+                       uint8_t security_level,
+                       const uint8_t *a, uint16_t a_len,
+                       uint8_t *c, uint16_t c_len,
+                       uint8_t *mic, uint8_t mic_size);
 } ieee802154_radio_cipher_ops_t;
 
 /**
@@ -126,6 +187,11 @@ struct ieee802154_sec_dev {
  */
 #define IEEE802154_SEC_MAX_AUX_HDR_LEN          (14U)
 
+/**
+ * @brief   Length of the CCM* nonce in bytes
+ */
+#define IEEE802154_SEC_NONCE_LENGTH             (13U)
+
 /**
  * @brief   Maximum Size of IEEE 802.15.4 MAC
  */
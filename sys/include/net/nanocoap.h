@@ -173,6 +173,10 @@ typedef struct __attribute__((packed)) {
 
 /**
  * @brief   CoAP option array entry
+ *
+ * The option array of a @ref coap_pkt_t is kept sorted by option number, so
+ * option lookups are done with a binary search instead of re-walking the
+ * options in the message.
  */
 typedef struct {
     uint16_t opt_num;           /**< full CoAP option number    */
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_recordlog   Record log on MTD
+ * @ingroup     sys
+ * @brief       Append-only circular log of records directly on an MTD device
+ *
+ * This module stores a stream of records, e.g. telemetry samples, on an
+ * @ref drivers_mtd device without a file system in between. Each record gets
+ * a sequence number and a CRC-16-CCITT over its header and payload. The
+ * sectors of the device are filled one after the other. Once the device is
+ * full, the sector with the oldest records is erased and reused.
+ *
+ * ## Write amplification
+ *
+ * Appended records are collected in a page buffer and a page is only
+ * programmed once it is full, so the flash sees page-sized programs and
+ * every byte is programmed once. @ref recordlog_flush programs the records
+ * still in the buffer, e.g. before going to sleep. A later flush of the same
+ * page only programs the bytes added since, so the device must allow to
+ * program the erased part of a page again (true for NOR flash and most
+ * internal flash with a write granularity up to @ref RECORDLOG_ALIGN).
+ *
+ * A sector is only erased when the log moves into it and it is not empty.
+ *
+ * ## Power loss
+ *
+ * Records that were not programmed yet are lost on power loss, all others
+ * are kept. A record that was only partly programmed fails its CRC and is
+ * ignored, the log continues in the next sector. An interrupted erase is
+ * detected as well, the sector is erased again before it is used.
+ *
+ * ## Recovery
+ *
+ * @ref recordlog_init only reads the first record of each sector to find the
+ * newest sector, and then the records of that sector to find the end of the
+ * log. Its duration thus depends on the number and size of the sectors, not
+ * on the number of records stored.
+ *
+ * ## Usage
+ *
+ * ```
+ * USEMODULE += recordlog
+ * ```
+ *
+ * ```
+ * static recordlog_t log;
+ * static uint8_t page_buf[MTD_PAGE_SIZE];
+ *
+ * recordlog_init(&log, mtd, page_buf);
+ * recordlog_append(&log, &sample, sizeof(sample), NULL);
+ *
+ * recordlog_iter_t iter;
+ * recordlog_iter_init(&log, &iter);
+ * while ((len = recordlog_iter_next(&log, &iter, buf, sizeof(buf), &seq)) > 0) {
+ *     ...
+ * }
+ * ```
+ *
+ * To use only a part of a device, put the log on a
+ * @ref drivers_mtd_mapper region.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Record log interface
+ */
+
+#ifndef RECORDLOG_H
+#define RECORDLOG_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Alignment of records on the device in bytes
+ *
+ * Must be at least the write granularity of the device.
+ */
+#ifndef RECORDLOG_ALIGN
+#define RECORDLOG_ALIGN     (4U)
+#endif
+
+/**
+ * @brief   Size of the header stored with each record in bytes
+ */
+#define RECORDLOG_HDR_SIZE  (8U)
+
+/**
+ * @brief   Record log descriptor
+ */
+typedef struct {
+    mtd_dev_t *mtd;             /**< backing MTD device */
+    uint8_t *page_buf;          /**< page containing the end of the log */
+    uint32_t sector_size;       /**< size of a sector in bytes */
+    uint32_t first_sector;      /**< sector with the oldest records */
+    uint32_t first_seq;         /**< sequence number of the oldest record */
+    uint32_t sector;            /**< sector records are appended to */
+    uint32_t pos;               /**< end of the log in @ref sector */
+    uint32_t flushed;           /**< bytes of the buffered page programmed */
+    uint32_t next_seq;          /**< sequence number of the next record */
+    mutex_t lock;               /**< guards the log */
+} recordlog_t;
+
+/**
+ * @brief   Record log iterator
+ */
+typedef struct {
+    uint32_t sector;            /**< sector of the next record */
+    uint32_t pos;               /**< offset of the next record in @ref sector */
+    uint32_t seq;               /**< sequence number of the next record */
+} recordlog_iter_t;
+
+/**
+ * @brief   Initializes a record log and recovers its state from the device
+ *
+ * A device that does not contain a log is used as an empty log. The sectors
+ * are erased on demand.
+ *
+ * @param[out] log      log descriptor to initialize
+ * @param[in]  mtd      backing MTD device, with at least two sectors
+ * @param[in]  page_buf buffer of `mtd->page_size` bytes
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the device is too small
+ * @return  < 0 on error of the device
+ */
+int recordlog_init(recordlog_t *log, mtd_dev_t *mtd, void *page_buf);
+
+/**
+ * @brief   Erases all records
+ *
+ * @param[in] log       an initialized log
+ *
+ * @return  0 on success
+ * @return  < 0 on error of the device
+ */
+int recordlog_erase(recordlog_t *log);
+
+/**
+ * @brief   Appends a record to the log
+ *
+ * The record may stay in RAM until its page is full, see
+ * @ref recordlog_flush.
+ *
+ * @param[in] log       an initialized log
+ * @param[in] data      record payload
+ * @param[in] len       size of @p data, at most
+ *                      sector size - @ref RECORDLOG_HDR_SIZE
+ * @param[out] seq      sequence number of the record, may be NULL
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the record does not fit into a sector
+ * @return  < 0 on error of the device
+ */
+int recordlog_append(recordlog_t *log, const void *data, size_t len,
+                     uint32_t *seq);
+
+/**
+ * @brief   Programs the records that are only in RAM
+ *
+ * @param[in] log       an initialized log
+ *
+ * @return  0 on success
+ * @return  < 0 on error of the device
+ */
+int recordlog_flush(recordlog_t *log);
+
+/**
+ * @brief   Starts an iteration at the oldest record of a log
+ *
+ * @param[in]  log      an initialized log
+ * @param[out] iter     iterator to initialize
+ */
+void recordlog_iter_init(recordlog_t *log, recordlog_iter_t *iter);
+
+/**
+ * @brief   Reads the next record of an iteration
+ *
+ * Records appended during the iteration are returned as well. If the
+ * sector of the next record was reused in the meantime, the iteration
+ * continues at the oldest record.
+ *
+ * @param[in]     log       an initialized log
+ * @param[in,out] iter      iterator
+ * @param[out]    buf       buffer for the payload
+ * @param[in]     len       size of @p buf
+ * @param[out]    seq       sequence number of the record, may be NULL
+ *
+ * @return  size of the record payload
+ * @return  0 after the last record
+ * @return  -ENOBUFS if @p buf is too small, the iterator is not advanced
+ * @return  -EIO if the log is corrupted
+ * @return  < 0 on error of the device
+ */
+ssize_t recordlog_iter_next(recordlog_t *log, recordlog_iter_t *iter,
+                            void *buf, size_t len, uint32_t *seq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RECORDLOG_H */
+/** @} */
@@ -50,6 +50,14 @@
  * fit into this and FLASHPAGE_SIZE must be a multiple of
  * RIOTBOOT_FLASHPAGE_BUFFER_SIZE
  *
+ * With the `riotboot_flashwrite_sha256` module, a SHA-256 digest of the image
+ * is computed while it is written, so the image can be verified with
+ * riotboot_flashwrite_streamed_sha256_check() instead of reading back the
+ * whole slot with riotboot_flashwrite_verify_sha256(). Each block is then
+ * compared with the flash right after programming it (see
+ * @ref CONFIG_RIOTBOOT_FLASHWRITE_READBACK), which ensures the digest also
+ * matches what ended up in flash.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  * @author      Koen Zandberg <koen@bergzand.net>
  *
@@ -63,8 +71,14 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+
+#include "kernel_defines.h"
 #include "riotboot/slot.h"
 #include "periph/flashpage.h"
+#if IS_USED(MODULE_RIOTBOOT_FLASHWRITE_SHA256) || DOXYGEN
+#include "hashes/sha256.h"
+#endif
 
 /**
  * @brief Enable/disable raw writes to flash
@@ -73,6 +87,20 @@ extern "C" {
 #define CONFIG_RIOTBOOT_FLASHWRITE_RAW  1
 #endif
 
+/**
+ * @brief Compare each block with the flash after programming it
+ *
+ * Enabled by default with the `riotboot_flashwrite_sha256` module. Pages
+ * written without @ref CONFIG_RIOTBOOT_FLASHWRITE_RAW are always verified.
+ */
+#ifndef CONFIG_RIOTBOOT_FLASHWRITE_READBACK
+#if IS_USED(MODULE_RIOTBOOT_FLASHWRITE_SHA256)
+#define CONFIG_RIOTBOOT_FLASHWRITE_READBACK 1
+#else
+#define CONFIG_RIOTBOOT_FLASHWRITE_READBACK 0
+#endif
+#endif
+
 /**
  * @brief Intermediate buffer size for firmware image data
  */
@@ -121,6 +149,9 @@ typedef struct {
     uint8_t RIOTBOOT_FLASHPAGE_BUFFER_ATTRS
         firstblock_buf[RIOTBOOT_FLASHPAGE_BUFFER_SIZE];
 #endif
+#if IS_USED(MODULE_RIOTBOOT_FLASHWRITE_SHA256) || DOXYGEN
+    sha256_context_t sha256;                /**< digest of the written image  */
+#endif
 } riotboot_flashwrite_t;
 
 /**
@@ -156,6 +187,10 @@ int riotboot_flashwrite_init_raw(riotboot_flashwrite_t *state, int target_slot,
  * ignore the slot until the magic number has been restored, e.g., through @ref
  * riotboot_flashwrite_finish().
  *
+ * With the `riotboot_flashwrite_sha256` module, the magic number is included
+ * in the digest of the image, as it will be in flash after
+ * riotboot_flashwrite_finish().
+ *
  * @param[in,out]   state       ptr to preallocated state structure
  * @param[in]       target_slot slot to write update into
  *
@@ -165,8 +200,12 @@ static inline int riotboot_flashwrite_init(riotboot_flashwrite_t *state,
                                            int target_slot)
 {
     /* initialize state, but skip "RIOT" */
-    return riotboot_flashwrite_init_raw(state, target_slot,
-                                        RIOTBOOT_FLASHWRITE_SKIPLEN);
+    int res = riotboot_flashwrite_init_raw(state, target_slot,
+                                           RIOTBOOT_FLASHWRITE_SKIPLEN);
+#if IS_USED(MODULE_RIOTBOOT_FLASHWRITE_SHA256)
+    sha256_update(&state->sha256, "RIOT", RIOTBOOT_FLASHWRITE_SKIPLEN);
+#endif
+    return res;
 }
 
 /**
@@ -273,6 +312,29 @@ size_t riotboot_flashwrite_slotsize(const riotboot_flashwrite_t *state);
 int riotboot_flashwrite_verify_sha256(const uint8_t *sha256_digest,
                                       size_t img_size, int target_slot);
 
+/**
+ * @brief       Verify the digest of an image against the digest computed
+ *              while writing it
+ *
+ * Unlike riotboot_flashwrite_verify_sha256(), this does not read back the
+ * slot. The digest covers the bytes passed to riotboot_flashwrite_putbytes(),
+ * preceded by the magic number if the update was initialized with
+ * riotboot_flashwrite_init(). The update can be continued afterwards.
+ *
+ * @note        Requires the `riotboot_flashwrite_sha256` module
+ *
+ * @param[in]   state           ptr to state struct
+ * @param[in]   sha256_digest   content of the image digest
+ * @param[in]   img_size        the size of the image
+ *
+ * @returns     -1 when @p img_size does not match the bytes written
+ * @returns     0 if the digest is valid
+ * @returns     1 if the digest is invalid
+ */
+int riotboot_flashwrite_streamed_sha256_check(
+    const riotboot_flashwrite_t *state, const uint8_t *sha256_digest,
+    size_t img_size);
+
 #ifdef __cplusplus
 }
 #endif
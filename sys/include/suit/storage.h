@@ -59,7 +59,9 @@
  * data and check the digest of the payload. @ref suit_storage_driver_t::read
  * must be implemented, providing piecewise reading of the data. @ref
  * suit_storage_driver_t::read_ptr is optional to implement, it can provide
- * direct read access on memory-mapped storage.
+ * direct read access on memory-mapped storage. Backends that compute the
+ * digest while the payload is written can implement
+ * @ref suit_storage_driver_t::verify_sha256 to skip reading back the payload.
  *
  * As the storage backend provides a mechanism to store persistent data,
  * functions are added to set and retrieve the manifest sequence number. While
@@ -82,7 +84,8 @@
  * 6.  At least one @ref suit_storage_driver_t::write calls to write the payload
  *     data.
  * 7.  @ref suit_storage_driver_t::finish to mark the end of the payload write.
- * 8.  @ref suit_storage_driver_t::read or @ref suit_storage_driver_t::read_ptr
+ * 8.  @ref suit_storage_driver_t::verify_sha256, or
+ *     @ref suit_storage_driver_t::read or @ref suit_storage_driver_t::read_ptr
  *     to read back the written payload. This to verify the digest of the
  *     payload with what is provided in the manifest.
  * 9.  @ref suit_storage_driver_t::install if the digest matches with what is
@@ -189,6 +192,24 @@ typedef struct suit_storage_driver {
     int (*read_ptr)(suit_storage_t *storage,
                     const uint8_t **buf, size_t *len);
 
+    /**
+     * @brief Verify the SHA-256 digest of the payload computed while it was
+     *        written
+     *
+     * @note Optional to implement
+     *
+     * @param[in]   storage     Storage context
+     * @param[in]   digest      Expected digest
+     * @param[in]   len         Expected length of the payload
+     *
+     * @returns     @ref SUIT_OK if the digest matches
+     * @returns     @ref SUIT_ERR_DIGEST_MISMATCH if it does not match
+     * @returns     @ref SUIT_ERR_NOT_SUPPORTED if no digest is available, the
+     *              payload must be read back
+     */
+    int (*verify_sha256)(suit_storage_t *storage, const uint8_t *digest,
+                         size_t len);
+
     /**
      * @brief Install the payload or mark the payload as valid
      *
@@ -376,6 +397,20 @@ static inline bool suit_storage_has_readptr(const suit_storage_t *storage)
     return (storage->driver->read_ptr);
 }
 
+/**
+ * @brief Check if the storage backend implements the @ref
+ * suit_storage_driver_t::verify_sha256 function
+ *
+ * @param[in]   storage     Storage context
+ *
+ * @returns     True if the function is implemented,
+ * @returns     False otherwise
+ */
+static inline bool suit_storage_has_verify_sha256(const suit_storage_t *storage)
+{
+    return (storage->driver->verify_sha256);
+}
+
 /**
  * @brief Check if the storage backend implements the @ref
  * suit_storage_driver_t::match_offset function
@@ -487,6 +522,25 @@ static inline int suit_storage_read_ptr(suit_storage_t *storage, const uint8_t
     return storage->driver->read_ptr(storage, buf, len);
 }
 
+/**
+ * @brief Verify the SHA-256 digest computed while writing the payload
+ *
+ * @note Optional to implement
+ *
+ * @param[in]   storage     Storage context
+ * @param[in]   digest      Expected digest
+ * @param[in]   len         Expected length of the payload
+ *
+ * @returns     @ref SUIT_OK if the digest matches
+ * @returns     @ref SUIT_ERR_DIGEST_MISMATCH if it does not match
+ * @returns     @ref SUIT_ERR_NOT_SUPPORTED if no digest is available
+ */
+static inline int suit_storage_verify_sha256(suit_storage_t *storage,
+                                             const uint8_t *digest, size_t len)
+{
+    return storage->driver->verify_sha256(storage, digest, len);
+}
+
 /**
  * @brief Install the payload or mark the payload as valid
  *
@@ -11,6 +11,15 @@
  * @ingroup     sys_suit_storage
  * @brief       SUIT riotboot firmware storage backend
  *
+ * The digest of the payload is computed while it is written, see
+ * `riotboot_flashwrite_sha256`, so it is not read back from flash for
+ * verification.
+ *
+ * With the `suit_storage_flashwrite_async` module, payload chunks are copied
+ * into one of two buffers and programmed by a separate thread, while the
+ * transport already receives the next chunks into the other buffer. This
+ * overlaps network transfer and flash programming.
+ *
  * @{
  *
  * @brief       riotboot Flashwrite storage backend functions for SUIT manifests
@@ -20,19 +29,59 @@
 #ifndef SUIT_STORAGE_FLASHWRITE_H
 #define SUIT_STORAGE_FLASHWRITE_H
 
+#include "kernel_defines.h"
+#include "mutex.h"
 #include "suit.h"
 #include "riotboot/flashwrite.h"
+#include "thread.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Size of each of the two buffers of `suit_storage_flashwrite_async`
+ */
+#ifndef CONFIG_SUIT_STORAGE_FLASHWRITE_BUF_SIZE
+#define CONFIG_SUIT_STORAGE_FLASHWRITE_BUF_SIZE (256U)
+#endif
+
+/**
+ * @brief Stack size of the `suit_storage_flashwrite_async` writer thread
+ */
+#ifndef SUIT_STORAGE_FLASHWRITE_STACKSIZE
+#define SUIT_STORAGE_FLASHWRITE_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief Priority of the `suit_storage_flashwrite_async` writer thread
+ *
+ * Lower than the SUIT worker, so the next chunk is requested before the
+ * previous one is programmed.
+ */
+#ifndef SUIT_STORAGE_FLASHWRITE_PRIO
+#define SUIT_STORAGE_FLASHWRITE_PRIO        (THREAD_PRIORITY_MAIN)
+#endif
+
 /**
  * @brief riotboot flashwrite SUIT storage context
  */
 typedef struct {
     suit_storage_t storage;       /**< parent struct */
     riotboot_flashwrite_t writer; /**< Riotboot flashwriter */
+#if IS_USED(MODULE_SUIT_STORAGE_FLASHWRITE_ASYNC) || DOXYGEN
+    /**
+     * @brief Buffers filled and programmed in turn
+     */
+    uint8_t buf[2][CONFIG_SUIT_STORAGE_FLASHWRITE_BUF_SIZE];
+    size_t fill_len;              /**< bytes in the buffer being filled */
+    size_t write_len;             /**< bytes in the buffer being programmed */
+    size_t offset;                /**< offset of the next payload chunk */
+    uint8_t fill;                 /**< index of the buffer being filled */
+    int error;                    /**< error of the writer thread */
+    mutex_t pending;              /**< unlocked to start the writer thread */
+    mutex_t idle;                 /**< locked while the writer thread runs */
+#endif
 } suit_storage_flashwrite_t;
 
 #ifdef __cplusplus
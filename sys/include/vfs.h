@@ -68,6 +68,7 @@
 
 #include "sched.h"
 #include "clist.h"
+#include "iolist.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -150,6 +151,17 @@ extern "C" {
 #define VFS_MAX_OPEN_FILES (16)
 #endif
 
+#ifndef VFS_MOUNT_LOOKUP_SIZE
+/**
+ * @brief Number of mount points in the lock-free lookup table
+ *
+ * Paths are resolved to the mount point without taking a lock as long as at
+ * most this many file systems are mounted, or if the matching mount point is
+ * longer than the mount points that did not fit into the table.
+ */
+#define VFS_MOUNT_LOOKUP_SIZE (4)
+#endif
+
 #ifndef VFS_DIR_BUFFER_SIZE
 /**
  * @brief Size of buffer space in vfs_DIR
@@ -440,6 +452,37 @@ struct vfs_file_ops {
      * @return <0 on error
      */
     ssize_t (*write) (vfs_file_t *filp, const void *src, size_t nbytes);
+
+    /**
+     * @brief Read bytes from an open file into a list of buffers
+     *
+     * Optional, @ref vfs_readv falls back to calling @c read for each buffer
+     * when this is NULL. A file system implements this if it can fill all
+     * buffers with less overhead, e.g. by taking its lock only once.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[in]  iolist   list of destination buffers
+     *
+     * @return number of bytes read on success
+     * @return <0 on error
+     */
+    ssize_t (*readv) (vfs_file_t *filp, const iolist_t *iolist);
+
+    /**
+     * @brief Write bytes from a list of buffers to an open file
+     *
+     * Optional, @ref vfs_writev falls back to calling @c write for each
+     * buffer when this is NULL. A file system implements this if it can
+     * write all buffers at once, e.g. so that a record made up of several
+     * buffers is not interleaved with writes from other threads.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[in]  iolist   list of source buffers
+     *
+     * @return number of bytes written on success
+     * @return <0 on error
+     */
+    ssize_t (*writev) (vfs_file_t *filp, const iolist_t *iolist);
 };
 
 /**
@@ -739,6 +782,75 @@ ssize_t vfs_read(int fd, void *dest, size_t count);
  */
 ssize_t vfs_write(int fd, const void *src, size_t count);
 
+/**
+ * @brief Read bytes from an open file into a list of buffers
+ *
+ * The buffers are filled in list order, like consecutive calls to
+ * @ref vfs_read with one call per list element. Elements with a zero length
+ * are skipped. Reading stops at the end of the file.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  iolist   list of destination buffers
+ *
+ * @return number of bytes read on success
+ * @return <0 on error, if nothing was read
+ */
+ssize_t vfs_readv(int fd, const iolist_t *iolist);
+
+/**
+ * @brief Write bytes from a list of buffers to an open file
+ *
+ * The buffers are written in list order, like consecutive calls to
+ * @ref vfs_write with one call per list element, but the file system may
+ * write them as one unit.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  iolist   list of source buffers
+ *
+ * @return number of bytes written on success
+ * @return <0 on error, if nothing was written
+ */
+ssize_t vfs_writev(int fd, const iolist_t *iolist);
+
+/**
+ * @brief Sink for the data streamed by @ref vfs_sendfile
+ *
+ * This is usually a thin wrapper around e.g. @c sock_tcp_write.
+ *
+ * @param[in]  arg      argument passed to @ref vfs_sendfile
+ * @param[in]  data     data read from the file
+ * @param[in]  len      number of bytes in @p data
+ *
+ * @return number of bytes consumed, may be less than @p len
+ * @return 0 to stop the transfer
+ * @return <0 on error
+ */
+typedef ssize_t (*vfs_sendfile_cb_t)(void *arg, const void *data, size_t len);
+
+/**
+ * @brief Stream data from an open file into a sink, e.g. a sock
+ *
+ * Reads up to @p count bytes from the current position of @p fd in chunks
+ * of up to @p buf_len bytes and hands each chunk to @p cb. Partially
+ * consumed chunks are resubmitted, so no data read from the file is lost.
+ * The file position is left after the last byte consumed by @p cb.
+ *
+ * The chunk buffer is provided by the caller. Its size is the trade-off
+ * between stack or static RAM usage and the number of file system calls.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  count    maximum number of bytes to send
+ * @param[in]  buf      chunk buffer
+ * @param[in]  buf_len  size of @p buf
+ * @param[in]  cb       sink for the data
+ * @param[in]  arg      argument passed to @p cb
+ *
+ * @return number of bytes consumed by @p cb
+ * @return <0 on error, if nothing was sent
+ */
+ssize_t vfs_sendfile(int fd, size_t count, void *buf, size_t buf_len,
+                     vfs_sendfile_cb_t cb, void *arg);
+
 /**
  * @brief Open a directory for reading with readdir
  *
@@ -0,0 +1,866 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_kvstore
+ * @{
+ *
+ * @file
+ * @brief       Key-value store implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "hashes.h"
+#include "kvstore.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define MIN(a, b) ((a) > (b) ? (b) : (a))
+
+#define ALIGN_UP(x)     (((x) + KVSTORE_ALIGN - 1) & ~(KVSTORE_ALIGN - 1))
+#define CHUNK_SIZE      ALIGN_UP(32U)
+
+#define SECTOR_MAGIC    (0x4b56)        /* "KV" */
+#define KEY_LEN_ERASED  (0xff)
+#define KEY_LEN_PADDING (0x00)          /* zeroed torn record, skipped in
+                                           steps of KVSTORE_ALIGN */
+#define FLAG_VALUE      (0xff)          /* record sets a value */
+#define FLAG_DELETED    (0xfe)          /* record removes the key */
+#define ADDR_EMPTY      (UINT32_MAX)    /* unused index entry */
+
+/* header at the start of every sector in use */
+typedef struct {
+    uint16_t magic;
+    uint16_t crc;                       /* CRC over magic and seq */
+    uint32_t seq;                       /* incremented per sector opened */
+} _sector_hdr_t;
+
+/* record header, followed by the key and the value */
+typedef struct {
+    uint8_t key_len;                    /* KEY_LEN_ERASED if erased */
+    uint8_t flags;                      /* FLAG_VALUE or FLAG_DELETED */
+    uint16_t val_len;
+    uint16_t crc;                       /* CRC over the fields above, key
+                                           and value */
+} _rec_t;
+
+/* collects data to program it in aligned chunks */
+typedef struct {
+    uint32_t addr;                      /* device address of buf */
+    uint32_t fill;
+    uint32_t buf[CHUNK_SIZE / sizeof(uint32_t)];
+} _writer_t;
+
+#define DATA_START      ALIGN_UP(sizeof(_sector_hdr_t))
+#define REC_MAX         _rec_size(CONFIG_KVSTORE_KEY_MAX, \
+                                  CONFIG_KVSTORE_VALUE_MAX)
+
+static_assert(CONFIG_KVSTORE_KEY_MAX < KEY_LEN_ERASED,
+              "CONFIG_KVSTORE_KEY_MAX must be less than 255");
+static_assert((KVSTORE_ALIGN & (KVSTORE_ALIGN - 1)) == 0,
+              "KVSTORE_ALIGN must be a power of two");
+
+static inline uint32_t _rec_size(uint32_t key_len, uint32_t val_len)
+{
+    return ALIGN_UP(sizeof(_rec_t) + key_len + val_len);
+}
+
+static inline uint32_t _next(const kvstore_t *kv, uint32_t sector)
+{
+    return (sector + 1) % kv->mtd->sector_count;
+}
+
+static inline bool _seq_before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+/* end of the records appended to a sector: the rest is reserved to redo the
+ * copy of a record torn by a power loss during garbage collection */
+static inline uint32_t _fill_limit(const kvstore_t *kv)
+{
+    return kv->sector_size - REC_MAX;
+}
+
+/* bytes that can always be stored, whatever the fragmentation */
+static inline uint32_t _capacity(const kvstore_t *kv)
+{
+    return (kv->mtd->sector_count - 1)
+           * (_fill_limit(kv) - DATA_START - REC_MAX);
+}
+
+static inline uint32_t _hash(const char *key, size_t key_len)
+{
+    return djb2_hash((const uint8_t *)key, key_len);
+}
+
+/* reads through an aligned buffer, as e.g. internal flash requires */
+static int _read(const kvstore_t *kv, uint32_t addr, void *dest, uint32_t len)
+{
+    uint32_t chunk[CHUNK_SIZE / sizeof(uint32_t)];
+    uint8_t *dst = dest;
+
+    while (len > 0) {
+        const uint32_t start = addr & ~(KVSTORE_ALIGN - 1);
+        const uint32_t off = addr - start;
+        const uint32_t n = MIN(len, CHUNK_SIZE - off);
+        int res = mtd_read(kv->mtd, chunk, start, ALIGN_UP(off + n));
+
+        if (res < 0) {
+            return res;
+        }
+        memcpy(dst, (uint8_t *)chunk + off, n);
+        dst += n;
+        addr += n;
+        len -= n;
+    }
+    return 0;
+}
+
+static int _program(const kvstore_t *kv, uint32_t addr, const void *src,
+                    uint32_t len)
+{
+    const uint32_t page_size = kv->mtd->page_size;
+
+    return mtd_write_page_raw(kv->mtd, src, addr / page_size,
+                              addr % page_size, len);
+}
+
+static int _put(const kvstore_t *kv, _writer_t *w, const void *data,
+                uint32_t len)
+{
+    const uint8_t *src = data;
+
+    while (len > 0) {
+        const uint32_t n = MIN(len, CHUNK_SIZE - w->fill);
+
+        memcpy((uint8_t *)w->buf + w->fill, src, n);
+        w->fill += n;
+        src += n;
+        len -= n;
+        if (w->fill == CHUNK_SIZE) {
+            int res = _program(kv, w->addr, w->buf, CHUNK_SIZE);
+            if (res < 0) {
+                return res;
+            }
+            w->addr += CHUNK_SIZE;
+            w->fill = 0;
+        }
+    }
+    return 0;
+}
+
+/* pads the remaining data to the alignment and programs it */
+static int _put_end(const kvstore_t *kv, _writer_t *w)
+{
+    const uint32_t len = ALIGN_UP(w->fill);
+
+    if (len == 0) {
+        return 0;
+    }
+    memset((uint8_t *)w->buf + w->fill, 0xff, len - w->fill);
+    return _program(kv, w->addr, w->buf, len);
+}
+
+/* clears all bits of [addr, addr + len), which is possible whatever was
+ * programmed there before */
+static int _zero(const kvstore_t *kv, uint32_t addr, uint32_t len)
+{
+    const uint32_t zero[CHUNK_SIZE / sizeof(uint32_t)] = { 0 };
+
+    while (len > 0) {
+        const uint32_t n = MIN(len, CHUNK_SIZE);
+        int res = _program(kv, addr, zero, n);
+
+        if (res < 0) {
+            return res;
+        }
+        addr += n;
+        len -= n;
+    }
+    return 0;
+}
+
+/* returns the end of the programmed bytes in [addr, end), addr if the range
+ * is erased */
+static int _programmed_end(const kvstore_t *kv, uint32_t addr, uint32_t end,
+                           uint32_t *last)
+{
+    uint8_t chunk[CHUNK_SIZE];
+
+    *last = addr;
+    while (addr < end) {
+        const uint32_t n = MIN(sizeof(chunk), end - addr);
+        int res = _read(kv, addr, chunk, n);
+
+        if (res < 0) {
+            return res;
+        }
+        for (unsigned i = 0; i < n; i++) {
+            if (chunk[i] != 0xff) {
+                *last = addr + i + 1;
+            }
+        }
+        addr += n;
+    }
+    return 0;
+}
+
+/* returns 1 and the sequence number if @p sector is in use */
+static int _read_sector_hdr(const kvstore_t *kv, uint32_t sector,
+                            uint32_t *seq)
+{
+    _sector_hdr_t hdr;
+    int res = _read(kv, sector * kv->sector_size, &hdr, sizeof(hdr));
+
+    if (res < 0) {
+        return res;
+    }
+    *seq = hdr.seq;
+    return (hdr.magic == SECTOR_MAGIC) &&
+           (hdr.crc == crc16_ccitt_calc((const void *)&hdr.seq,
+                                        sizeof(hdr.seq)));
+}
+
+/* bytes taken by the record at @p rec, including padding */
+static inline uint32_t _rec_span(const _rec_t *rec)
+{
+    if (rec->key_len == KEY_LEN_PADDING) {
+        return KVSTORE_ALIGN;
+    }
+    return _rec_size(rec->key_len, rec->val_len);
+}
+
+/* returns 1 if a plausible record header and its key, or padding, are at
+ * @p addr */
+static int _read_rec(const kvstore_t *kv, uint32_t addr, _rec_t *rec,
+                     char *key)
+{
+    const uint32_t off = addr % kv->sector_size;
+    uint8_t buf[sizeof(_rec_t) + CONFIG_KVSTORE_KEY_MAX];
+
+    if (off + sizeof(_rec_t) > kv->sector_size) {
+        return 0;
+    }
+
+    /* header and key with a single read */
+    int res = _read(kv, addr, buf,
+                    MIN(sizeof(buf), kv->sector_size - off));
+    if (res < 0) {
+        return res;
+    }
+    memcpy(rec, buf, sizeof(*rec));
+
+    if (rec->key_len == KEY_LEN_PADDING) {
+        return 1;
+    }
+    if ((rec->key_len > CONFIG_KVSTORE_KEY_MAX) || (rec->key_len > CONFIG_KVSTORE_KEY_MAX) ||
+        (rec->val_len > CONFIG_KVSTORE_VALUE_MAX) ||
+        ((rec->flags != FLAG_VALUE) && (rec->flags != FLAG_DELETED)) ||
+        (off + _rec_size(rec->key_len, rec->val_len) > kv->sector_size)) {
+        return 0;
+    }
+    memcpy(key, &buf[sizeof(*rec)], rec->key_len);
+    return 1;
+}
+
+static uint16_t _crc_start(const _rec_t *rec)
+{
+    return crc16_ccitt_calc((const void *)rec, offsetof(_rec_t, crc));
+}
+
+/* returns 1 if the value of the record at @p addr matches its CRC */
+static int _check(const kvstore_t *kv, uint32_t addr, const _rec_t *rec,
+                  const char *key)
+{
+    uint8_t chunk[CHUNK_SIZE];
+    uint16_t crc = crc16_ccitt_update(_crc_start(rec), (const void *)key,
+                                      rec->key_len);
+
+    addr += sizeof(*rec) + rec->key_len;
+    for (uint32_t done = 0; done < rec->val_len;) {
+        const uint32_t n = MIN(sizeof(chunk), rec->val_len - done);
+        int res = _read(kv, addr + done, chunk, n);
+
+        if (res < 0) {
+            return res;
+        }
+        crc = crc16_ccitt_update(crc, chunk, n);
+        done += n;
+    }
+    return crc == rec->crc;
+}
+
+/* returns 1 if the value at @p addr equals @p value */
+static int _equal(const kvstore_t *kv, uint32_t addr, const void *value,
+                  uint32_t len)
+{
+    uint8_t chunk[CHUNK_SIZE];
+    const uint8_t *v = value;
+
+    for (uint32_t done = 0; done < len;) {
+        const uint32_t n = MIN(sizeof(chunk), len - done);
+        int res = _read(kv, addr + done, chunk, n);
+
+        if (res < 0) {
+            return res;
+        }
+        if (memcmp(chunk, &v[done], n)) {
+            return 0;
+        }
+        done += n;
+    }
+    return 1;
+}
+
+/* returns the index entry of @p key and its record header */
+static int _find(const kvstore_t *kv, const char *key, size_t key_len,
+                 uint32_t hash, _rec_t *rec)
+{
+    const uint32_t mask = kv->index_size - 1;
+
+    for (uint32_t i = hash & mask; kv->index[i].addr != ADDR_EMPTY;
+         i = (i + 1) & mask) {
+        char k[CONFIG_KVSTORE_KEY_MAX];
+
+        if (kv->index[i].hash != hash) {
+            continue;
+        }
+        int res = _read_rec(kv, kv->index[i].addr, rec, k);
+        if (res < 0) {
+            return res;
+        }
+        if (res && (rec->key_len == key_len) && !memcmp(k, key, key_len)) {
+            return i;
+        }
+    }
+    return -ENOENT;
+}
+
+/* returns the index entry pointing to @p addr */
+static int _find_addr(const kvstore_t *kv, uint32_t hash, uint32_t addr)
+{
+    const uint32_t mask = kv->index_size - 1;
+
+    for (uint32_t i = hash & mask; kv->index[i].addr != ADDR_EMPTY;
+         i = (i + 1) & mask) {
+        if (kv->index[i].addr == addr) {
+            return i;
+        }
+    }
+    return -ENOENT;
+}
+
+static void _insert(kvstore_t *kv, uint32_t hash, uint32_t addr)
+{
+    const uint32_t mask = kv->index_size - 1;
+    uint32_t i = hash & mask;
+
+    while (kv->index[i].addr != ADDR_EMPTY) {
+        i = (i + 1) & mask;
+    }
+    kv->index[i].hash = hash;
+    kv->index[i].addr = addr;
+    kv->entries++;
+}
+
+static void _remove(kvstore_t *kv, uint32_t i)
+{
+    const uint32_t mask = kv->index_size - 1;
+
+    /* move entries up that would not be found across the gap otherwise */
+    for (uint32_t j = (i + 1) & mask; kv->index[j].addr != ADDR_EMPTY;
+         j = (j + 1) & mask) {
+        const uint32_t home = kv->index[j].hash & mask;
+
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            kv->index[i] = kv->index[j];
+            i = j;
+        }
+    }
+    kv->index[i].addr = ADDR_EMPTY;
+    kv->entries--;
+}
+
+/* updates the index with the record at @p addr */
+static int _apply(kvstore_t *kv, uint32_t addr, const _rec_t *rec,
+                  const char *key)
+{
+    const uint32_t hash = _hash(key, rec->key_len);
+    _rec_t old;
+    int i = _find(kv, key, rec->key_len, hash, &old);
+
+    if ((i < 0) && (i != -ENOENT)) {
+        return i;
+    }
+    if (i >= 0) {
+        kv->live -= _rec_size(old.key_len, old.val_len);
+        if (rec->flags == FLAG_DELETED) {
+            _remove(kv, i);
+            return 0;
+        }
+        kv->index[i].addr = addr;
+    }
+    else if (rec->flags == FLAG_DELETED) {
+        return 0;
+    }
+    else if (kv->entries + 1 >= kv->index_size) {
+        return -ENOMEM;
+    }
+    else {
+        _insert(kv, hash, addr);
+    }
+    kv->live += _rec_size(rec->key_len, rec->val_len);
+    return 0;
+}
+
+static int _write_rec(kvstore_t *kv, uint32_t addr, const char *key,
+                      size_t key_len, uint8_t flags, const void *value,
+                      size_t len)
+{
+    _rec_t rec = {
+        .key_len = key_len,
+        .flags = flags,
+        .val_len = len,
+    };
+    _writer_t w = {
+        .addr = addr,
+    };
+    int res;
+
+    rec.crc = crc16_ccitt_update(_crc_start(&rec), (const void *)key,
+                                 key_len);
+    rec.crc = crc16_ccitt_update(rec.crc, value, len);
+
+    if (((res = _put(kv, &w, &rec, sizeof(rec))) < 0) ||
+        ((res = _put(kv, &w, key, key_len)) < 0) ||
+        ((res = _put(kv, &w, value, len)) < 0)) {
+        return res;
+    }
+    return _put_end(kv, &w);
+}
+
+/* makes @p sector the head, erases it if it is not empty */
+static int _open(kvstore_t *kv, uint32_t sector)
+{
+    const uint32_t addr = sector * kv->sector_size;
+    _sector_hdr_t hdr = {
+        .magic = SECTOR_MAGIC,
+        .seq = kv->head_seq + 1,
+    };
+    _writer_t w = {
+        .addr = addr,
+    };
+    uint32_t last;
+    int res = _programmed_end(kv, addr, addr + kv->sector_size, &last);
+
+    if ((res == 0) && (last != addr)) {
+        DEBUG("kvstore: erase sector %" PRIu32 "\n", sector);
+        res = mtd_erase_sector(kv->mtd, sector, 1);
+    }
+    if (res < 0) {
+        return res;
+    }
+
+    hdr.crc = crc16_ccitt_calc((const void *)&hdr.seq, sizeof(hdr.seq));
+    if (((res = _put(kv, &w, &hdr, sizeof(hdr))) < 0) ||
+        ((res = _put_end(kv, &w)) < 0)) {
+        return res;
+    }
+
+    kv->head = sector;
+    kv->head_seq = hdr.seq;
+    kv->pos = DATA_START;
+    return 0;
+}
+
+/* moves the current records of the oldest sector to the head */
+static int _gc(kvstore_t *kv)
+{
+    const uint32_t base = kv->oldest * kv->sector_size;
+    uint32_t size;
+    int res;
+
+    DEBUG("kvstore: collect sector %" PRIu32 "\n", kv->oldest);
+    for (uint32_t off = DATA_START; off < kv->sector_size; off += size) {
+        char key[CONFIG_KVSTORE_KEY_MAX];
+        _rec_t rec;
+
+        res = _read_rec(kv, base + off, &rec, key);
+        if (res < 0) {
+            return res;
+        }
+        if (res == 0) {
+            break;
+        }
+
+        size = _rec_span(&rec);
+        /* deleted keys have no older records left after this sector */
+        if ((rec.key_len == KEY_LEN_PADDING) || (rec.flags == FLAG_DELETED)) {
+            continue;
+        }
+        int i = _find_addr(kv, _hash(key, rec.key_len), base + off);
+        if (i < 0) {
+            continue;
+        }
+
+        const uint32_t dest = kv->head * kv->sector_size + kv->pos;
+        if (kv->pos + size > kv->sector_size) {
+            return -ENOSPC;
+        }
+        for (uint32_t done = 0; done < size;) {
+            uint32_t chunk[CHUNK_SIZE / sizeof(uint32_t)];
+            const uint32_t n = MIN(sizeof(chunk), size - done);
+
+            /* on error, the copy is repeated on the next attempt: without
+             * an erased sector left, there is no other place to put it */
+            if (((res = _read(kv, base + off + done, chunk, n)) < 0) ||
+                ((res = _program(kv, dest + done, chunk, n)) < 0)) {
+                return res;
+            }
+            done += n;
+        }
+        kv->pos += size;
+        kv->index[i].addr = dest;
+    }
+
+    res = mtd_erase_sector(kv->mtd, kv->oldest, 1);
+    if (res < 0) {
+        return res;
+    }
+    kv->oldest = _next(kv, kv->oldest);
+    kv->gc_runs++;
+    return 0;
+}
+
+/* makes room for @p size bytes in the head */
+static int _alloc(kvstore_t *kv, uint32_t size)
+{
+    unsigned opened = 0;
+    int res;
+
+    while (1) {
+        /* keep a sector erased to move the records of the oldest one to */
+        if (_next(kv, kv->head) == kv->oldest) {
+            res = _gc(kv);
+            if (res < 0) {
+                return res;
+            }
+        }
+        if (kv->pos + size <= _fill_limit(kv)) {
+            return 0;
+        }
+        if (opened++ == kv->mtd->sector_count) {
+            return -ENOSPC;
+        }
+        res = _open(kv, _next(kv, kv->head));
+        if (res < 0) {
+            return res;
+        }
+    }
+}
+
+static void _clear_index(kvstore_t *kv)
+{
+    for (uint32_t i = 0; i < kv->index_size; i++) {
+        kv->index[i].addr = ADDR_EMPTY;
+    }
+    kv->entries = 0;
+    kv->live = 0;
+}
+
+/* loads the records of @p sector, returns the end of the valid ones */
+static int _load(kvstore_t *kv, uint32_t sector, uint32_t *end)
+{
+    const uint32_t base = sector * kv->sector_size;
+    uint32_t off = DATA_START;
+    int res = 0;
+
+    while (off < kv->sector_size) {
+        char key[CONFIG_KVSTORE_KEY_MAX];
+        _rec_t rec;
+
+        res = _read_rec(kv, base + off, &rec, key);
+        if ((res > 0) && (rec.key_len == KEY_LEN_PADDING)) {
+            off += _rec_span(&rec);
+            continue;
+        }
+        if (res > 0) {
+            res = _check(kv, base + off, &rec, key);
+        }
+        if (res > 0) {
+            res = _apply(kv, base + off, &rec, key);
+        }
+        else {
+            break;
+        }
+        if (res < 0) {
+            break;
+        }
+        off += _rec_span(&rec);
+    }
+    *end = off;
+    return (res < 0) ? res : 0;
+}
+
+int kvstore_init(kvstore_t *kv, mtd_dev_t *mtd, kvstore_entry_t *index,
+                 uint32_t index_size)
+{
+    int res = mtd_init(mtd);
+
+    if (res < 0) {
+        return res;
+    }
+
+    const uint32_t sector_size = mtd->pages_per_sector * mtd->page_size;
+    if ((mtd->sector_count < 2) || (sector_size % KVSTORE_ALIGN) ||
+        (sector_size < DATA_START + 3 * REC_MAX) ||
+        (index_size < 2) || (index_size & (index_size - 1))) {
+        return -EINVAL;
+    }
+
+    mutex_init(&kv->lock);
+    kv->mtd = mtd;
+    kv->index = index;
+    kv->index_size = index_size;
+    kv->sector_size = sector_size;
+    kv->gc_runs = 0;
+    _clear_index(kv);
+
+    /* the sectors in use follow the oldest one */
+    bool found = false;
+    uint32_t seq;
+
+    for (uint32_t s = 0; s < mtd->sector_count; s++) {
+        res = _read_sector_hdr(kv, s, &seq);
+        if (res < 0) {
+            return res;
+        }
+        if (res && (!found || _seq_before(seq, kv->head_seq))) {
+            kv->oldest = s;
+            kv->head_seq = seq;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        DEBUG("kvstore: no sectors in use\n");
+        kv->oldest = 0;
+        kv->head_seq = 0;
+        return _open(kv, 0);
+    }
+
+    uint32_t used = 0;
+    uint32_t s = kv->oldest;
+    uint32_t end;
+
+    do {
+        res = _load(kv, s, &end);
+        if (res < 0) {
+            return res;
+        }
+        kv->head = s;
+        kv->pos = end;
+        used++;
+        s = _next(kv, s);
+    } while ((used < mtd->sector_count) &&
+             (_read_sector_hdr(kv, s, &seq) > 0) &&
+             (seq == kv->head_seq + used));
+    kv->head_seq += used - 1;
+
+    /* anything but erased flash after the last record is a torn record */
+    const uint32_t base = kv->head * sector_size;
+    const bool gc_pending = (_next(kv, kv->head) == kv->oldest);
+    uint32_t last;
+
+    res = _programmed_end(kv, base + kv->pos, base + sector_size, &last);
+    if (res < 0) {
+        return res;
+    }
+    if ((last != base + kv->pos) && !gc_pending) {
+        DEBUG("kvstore: torn record in sector %" PRIu32 "\n", kv->head);
+        kv->pos = sector_size;
+    }
+    else if (last != base + kv->pos) {
+        /* the garbage collection was copying a record: turn what was
+         * programmed into padding and redo the copy after it, the space
+         * reserved by _fill_limit() takes it */
+        DEBUG("kvstore: torn copy in sector %" PRIu32 "\n", kv->head);
+        res = _zero(kv, base + kv->pos, ALIGN_UP(last - base) - kv->pos);
+        if (res < 0) {
+            return res;
+        }
+        kv->pos = ALIGN_UP(last - base);
+    }
+
+    DEBUG("kvstore: sectors %" PRIu32 "-%" PRIu32 ", %" PRIu32 " keys\n",
+          kv->oldest, kv->head, kv->entries);
+
+    /* complete an interrupted garbage collection */
+    if (gc_pending) {
+        return _gc(kv);
+    }
+    return 0;
+}
+
+int kvstore_format(kvstore_t *kv)
+{
+    mutex_lock(&kv->lock);
+    int res = mtd_erase_sector(kv->mtd, 0, kv->mtd->sector_count);
+
+    _clear_index(kv);
+    if (res == 0) {
+        kv->oldest = 0;
+        res = _open(kv, 0);
+    }
+    mutex_unlock(&kv->lock);
+
+    return res;
+}
+
+ssize_t kvstore_get(kvstore_t *kv, const char *key, void *buf, size_t len)
+{
+    const size_t key_len = strlen(key);
+    _rec_t rec;
+    ssize_t res;
+
+    mutex_lock(&kv->lock);
+    res = _find(kv, key, key_len, _hash(key, key_len), &rec);
+    if (res < 0) {
+        goto out;
+    }
+    if (rec.val_len > len) {
+        res = -ENOBUFS;
+        goto out;
+    }
+    res = _read(kv, kv->index[res].addr + sizeof(rec) + key_len, buf,
+                rec.val_len);
+    if (res == 0) {
+        res = rec.val_len;
+    }
+
+out:
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvstore_set(kvstore_t *kv, const char *key, const void *value, size_t len)
+{
+    const size_t key_len = strlen(key);
+    const uint32_t size = _rec_size(key_len, len);
+    const uint32_t hash = _hash(key, key_len);
+    uint32_t old_size = 0;
+    _rec_t rec;
+    int res;
+
+    if ((key_len == 0) || (key_len > CONFIG_KVSTORE_KEY_MAX) ||
+        (len > CONFIG_KVSTORE_VALUE_MAX)) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&kv->lock);
+    int i = _find(kv, key, key_len, hash, &rec);
+
+    if (i >= 0) {
+        if (rec.val_len == len) {
+            res = _equal(kv, kv->index[i].addr + sizeof(rec) + key_len,
+                         value, len);
+            if (res != 0) {
+                /* unchanged or error */
+                res = (res < 0) ? res : 0;
+                goto out;
+            }
+        }
+        old_size = _rec_size(rec.key_len, rec.val_len);
+    }
+    else if (i != -ENOENT) {
+        res = i;
+        goto out;
+    }
+    else if (kv->entries + 1 >= kv->index_size) {
+        res = -ENOMEM;
+        goto out;
+    }
+
+    if (kv->live - old_size + size > _capacity(kv)) {
+        res = -ENOSPC;
+        goto out;
+    }
+
+    res = _alloc(kv, size);
+    if (res < 0) {
+        goto out;
+    }
+
+    const uint32_t addr = kv->head * kv->sector_size + kv->pos;
+    res = _write_rec(kv, addr, key, key_len, FLAG_VALUE, value, len);
+    if (res < 0) {
+        /* continue after the partly programmed record in the next sector */
+        kv->pos = kv->sector_size;
+        goto out;
+    }
+    kv->pos += size;
+
+    /* garbage collection only moves records, i stays valid */
+    if (i >= 0) {
+        kv->index[i].addr = addr;
+    }
+    else {
+        _insert(kv, hash, addr);
+    }
+    kv->live += size - old_size;
+
+out:
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvstore_delete(kvstore_t *kv, const char *key)
+{
+    const size_t key_len = strlen(key);
+    const uint32_t size = _rec_size(key_len, 0);
+    _rec_t rec;
+    int res;
+
+    mutex_lock(&kv->lock);
+    int i = _find(kv, key, key_len, _hash(key, key_len), &rec);
+
+    if (i < 0) {
+        res = i;
+        goto out;
+    }
+
+    res = _alloc(kv, size);
+    if (res < 0) {
+        goto out;
+    }
+
+    const uint32_t addr = kv->head * kv->sector_size + kv->pos;
+    res = _write_rec(kv, addr, key, key_len, FLAG_DELETED, NULL, 0);
+    if (res < 0) {
+        kv->pos = kv->sector_size;
+        goto out;
+    }
+    kv->pos += size;
+
+    kv->live -= _rec_size(rec.key_len, rec.val_len);
+    _remove(kv, i);
+
+out:
+    mutex_unlock(&kv->lock);
+    return res;
+}
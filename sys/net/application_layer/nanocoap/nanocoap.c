@@ -118,6 +118,10 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
                 return -EBADMSG;
             }
             option_nr += option_delta;
+            if (option_nr > UINT16_MAX) {
+                DEBUG("nanocoap: option number overflow\n");
+                return -EBADMSG;
+            }
             DEBUG("option count=%u nr=%u len=%i\n", option_count, option_nr, option_len);
 
             if (option_delta) {
@@ -178,14 +182,25 @@ int coap_match_path(const coap_resource_t *resource, uint8_t *uri)
 
 uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
 {
+    /* Both coap_parse() and _add_opt_pkt() fill the option array in
+     * ascending option number order (CoAP encodes options as deltas), so
+     * a lower bound binary search finds the first matching entry. */
     const coap_optpos_t *optpos = pkt->options;
-    unsigned opt_count = pkt->options_len;
+    unsigned lo = 0;
+    unsigned hi = pkt->options_len;
 
-    while (opt_count--) {
-        if (optpos->opt_num == opt_num) {
-            return (uint8_t*)pkt->hdr + optpos->offset;
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        if (optpos[mid].opt_num < opt_num) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
         }
-        optpos++;
+    }
+
+    if ((lo < pkt->options_len) && (optpos[lo].opt_num == opt_num)) {
+        return (uint8_t*)pkt->hdr + optpos[lo].offset;
     }
     return NULL;
 }
@@ -35,6 +35,9 @@
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
 #include "net/gnrc/sixlowpan/frag/sfr.h"
 #endif /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) */
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+#include "net/gnrc/sixlowpan/iphc.h"
+#endif /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) */
 #include "net/netstats.h"
 #include "net/netstats/neighbor.h"
 #include "fmt.h"
@@ -1256,6 +1259,10 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     if (res > 0) {
         netif->l2addr_len = res;
     }
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+    /* compression modes derived from the old address are stale now */
+    gnrc_sixlowpan_iphc_cache_flush();
+#endif
 }
 
 static void _init_from_device(gnrc_netif_t *netif)
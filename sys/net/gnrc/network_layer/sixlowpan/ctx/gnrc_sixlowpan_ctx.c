@@ -17,6 +17,9 @@
 
 #include "mutex.h"
 #include "net/gnrc/sixlowpan/ctx.h"
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+#include "net/gnrc/sixlowpan/iphc.h"
+#endif
 #if IS_USED(MODULE_ZTIMER_MSEC)
 #include "ztimer.h"
 #include "timex.h"
@@ -131,6 +134,9 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
     _ctx_inval_times[id] = ltime + _current_minute();
 
     mutex_unlock(&_ctx_mutex);
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+    gnrc_sixlowpan_iphc_cache_flush();
+#endif
     return &(_ctxs[id]);
 }
 
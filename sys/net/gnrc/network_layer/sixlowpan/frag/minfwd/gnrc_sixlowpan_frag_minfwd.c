@@ -26,21 +26,29 @@
 #define ENABLE_DEBUG    0
 #include "debug.h"
 
-static gnrc_pktsnip_t *_netif_hdr_from_vrbe(const gnrc_sixlowpan_frag_vrb_t *vrbe)
+static inline bool _is_last_frag(const gnrc_sixlowpan_frag_vrb_t *vrbe)
 {
-    gnrc_pktsnip_t *res = gnrc_netif_hdr_build(NULL, 0, vrbe->super.dst,
-                                               vrbe->super.dst_len);
-    if (res == NULL) {
-        DEBUG("6lo minfwd: can't allocate netif header for forwarding.\n");
-        return NULL;
-    }
-    gnrc_netif_hdr_set_netif(res->data, vrbe->out_netif);
-    return res;
+    return (vrbe->super.current_size >= vrbe->super.datagram_size);
 }
 
-static inline bool _is_last_frag(const gnrc_sixlowpan_frag_vrb_t *vrbe)
+static int _send(gnrc_pktsnip_t *pkt, gnrc_sixlowpan_frag_vrb_t *vrbe,
+                 unsigned page)
 {
-    return (vrbe->super.current_size >= vrbe->super.datagram_size);
+    if ((pkt = gnrc_sixlowpan_frag_vrb_netif_hdr(vrbe, pkt)) == NULL) {
+        return -ENOMEM;
+    }
+    if (_is_last_frag(vrbe)) {
+        DEBUG("6lo minfwd: current_size (%u) >= datagram_size (%u)\n",
+              vrbe->super.current_size, vrbe->super.datagram_size);
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+    else {
+        gnrc_netif_hdr_t *netif_hdr = pkt->data;
+
+        netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
+    return 0;
 }
 
 int gnrc_sixlowpan_frag_minfwd_forward(gnrc_pktsnip_t *pkt,
@@ -66,24 +74,29 @@ int gnrc_sixlowpan_frag_minfwd_forward(gnrc_pktsnip_t *pkt,
     pkt = tmp;
     new = pkt->data;
     new->tag = byteorder_htons(vrbe->out_tag);
-    tmp = _netif_hdr_from_vrbe(vrbe);
-    if (tmp == NULL) {
+    return _send(pkt, vrbe, page);
+}
+
+int gnrc_sixlowpan_frag_minfwd_forward_in_place(gnrc_pktsnip_t *pkt,
+                                                gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                                unsigned page)
+{
+    gnrc_pktsnip_t *tmp;
+    sixlowpan_frag_t *frag;
+
+    assert(vrbe != NULL);
+    assert((pkt != NULL) && (pkt->size >= sizeof(sixlowpan_frag_t)));
+    /* only copies the fragment if someone else holds it as well */
+    if ((tmp = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        DEBUG("6lo minfwd: unable to get write access to fragment.\n");
         gnrc_pktbuf_release(pkt);
         return -ENOMEM;
     }
-    if (_is_last_frag(vrbe)) {
-        DEBUG("6lo minfwd: current_size (%u) >= datagram_size (%u)\n",
-              vrbe->super.current_size, vrbe->super.datagram_size);
-        gnrc_sixlowpan_frag_vrb_rm(vrbe);
-    }
-    else {
-        gnrc_netif_hdr_t *netif_hdr = tmp->data;
-
-        netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
-    }
-    pkt = gnrc_pkt_prepend(pkt, tmp);
-    gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
-    return 0;
+    pkt = tmp;
+    frag = pkt->data;
+    /* FRAG1 and FRAGN share the position of the tag */
+    frag->tag = byteorder_htons(vrbe->out_tag);
+    return _send(pkt, vrbe, page);
 }
 
 int gnrc_sixlowpan_frag_minfwd_frag_iphc(gnrc_pktsnip_t *pkt,
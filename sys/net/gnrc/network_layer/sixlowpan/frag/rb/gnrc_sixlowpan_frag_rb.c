@@ -68,6 +68,42 @@ static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 static xtimer_t _gc_timer;
 static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_FRAG_RB_GC_MSG };
 
+/* Reassembly buffer entries in use are indexed by (src, dst, tag) in a chained
+ * hash table and kept in queues ordered by their expiry, so neither fragment
+ * look-up nor garbage collection need to walk the whole buffer.
+ * Links are stored as `index + 1`, so a zero-initialized index is empty. */
+#define RBUF_NIL        (0U)
+#define RBUF_HASH_SIZE  (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
+
+typedef uint8_t _rbuf_idx_t;
+
+static_assert(CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE < UINT8_MAX,
+              "CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE must be less than 255");
+
+/* entries of a queue expire in the order they were appended */
+typedef struct {
+    _rbuf_idx_t head;   /**< entry to expire next */
+    _rbuf_idx_t tail;   /**< entry to expire last */
+} _rbuf_queue_t;
+
+static _rbuf_idx_t _hash_head[RBUF_HASH_SIZE];
+/* links hash chains for entries in use and the free list otherwise */
+static _rbuf_idx_t _hash_next[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+static _rbuf_idx_t _queue_prev[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+static _rbuf_idx_t _queue_next[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+/* entries in reassembly, expiring CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US
+ * after their last fragment */
+static _rbuf_queue_t _reass_queue;
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+/* completed entries, expiring CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER after
+ * their dispatch */
+static _rbuf_queue_t _del_queue;
+static bool _in_del_queue[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+#endif
+static _rbuf_idx_t _free_head;
+/* entries from this index on were not used since the last reset */
+static unsigned _rbuf_unused;
+
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
@@ -87,6 +123,25 @@ static int _rbuf_get(const void *src, size_t src_len,
 /* gets an entry only by link-layer information and tag */
 static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
                                                   uint16_t tag);
+/* gets the hash bucket for a (src, dst, tag) tuple */
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len,
+                           uint16_t tag);
+/* checks if an entry matches a (src, dst, tag) tuple */
+static inline bool _rbuf_match(const gnrc_sixlowpan_frag_rb_t *entry,
+                               const uint8_t *src, size_t src_len,
+                               const uint8_t *dst, size_t dst_len,
+                               uint16_t tag);
+/* takes an entry from the free list, returns -1 if there is none */
+static int _rbuf_alloc(void);
+/* puts an entry on the free list */
+static void _rbuf_free(unsigned idx);
+/* links an allocated entry into the hash table and the reassembly queue */
+static void _rbuf_link(unsigned idx);
+/* unlinks an entry from the hash table and its queue */
+static void _rbuf_unlink(unsigned idx);
+static void _rbuf_queue_append(_rbuf_queue_t *queue, unsigned idx);
+static void _rbuf_queue_remove(_rbuf_queue_t *queue, unsigned idx);
 /* internal add to repeat add when fragments overlapped */
 static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                      size_t offset, unsigned page);
@@ -102,8 +157,8 @@ enum {
 
 static bool _check_hdr(gnrc_pktsnip_t *hdr, unsigned page);
 static void _adapt_hdr(gnrc_pktsnip_t *hdr, unsigned page);
-static int _forward_frag(gnrc_pktsnip_t *pkt, size_t frag_hdr_size,
-                         gnrc_sixlowpan_frag_vrb_t *vrbe, unsigned page);
+static int _forward_frag(gnrc_pktsnip_t *pkt, gnrc_sixlowpan_frag_vrb_t *vrbe,
+                         unsigned page);
 static int _forward_uncomp(gnrc_pktsnip_t *pkt,
                            gnrc_sixlowpan_frag_rb_t *rbuf,
                            gnrc_sixlowpan_frag_vrb_t *vrbe,
@@ -188,21 +243,130 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
     const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
     const uint8_t src_len = netif_hdr->src_l2addr_len;
     const uint8_t dst_len = netif_hdr->dst_l2addr_len;
+    unsigned i = _hash_head[_rbuf_hash(src, src_len, dst, dst_len, tag)];
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
+    while (i != RBUF_NIL) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i - 1];
 
-        if ((e->pkt != NULL) && (e->super.tag == tag) &&
-            (e->super.src_len == src_len) &&
-            (e->super.dst_len == dst_len) &&
-            (memcmp(e->super.src, src, src_len) == 0) &&
-            (memcmp(e->super.dst, dst, dst_len) == 0)) {
+        if (_rbuf_match(e, src, src_len, dst, dst_len, tag)) {
             return e;
         }
+        i = _hash_next[i - 1];
     }
     return NULL;
 }
 
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len,
+                           uint16_t tag)
+{
+    /* tag differs most between datagrams, so start with it */
+    uint32_t hash = tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 33) ^ src[i];
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash * 33) ^ dst[i];
+    }
+    return hash % RBUF_HASH_SIZE;
+}
+
+static inline bool _rbuf_match(const gnrc_sixlowpan_frag_rb_t *entry,
+                               const uint8_t *src, size_t src_len,
+                               const uint8_t *dst, size_t dst_len,
+                               uint16_t tag)
+{
+    return (entry->super.tag == tag) &&
+           (entry->super.src_len == src_len) &&
+           (entry->super.dst_len == dst_len) &&
+           (memcmp(entry->super.src, src, src_len) == 0) &&
+           (memcmp(entry->super.dst, dst, dst_len) == 0);
+}
+
+static int _rbuf_alloc(void)
+{
+    if (_free_head != RBUF_NIL) {
+        unsigned idx = _free_head - 1;
+
+        _free_head = _hash_next[idx];
+        return idx;
+    }
+    if (_rbuf_unused < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE) {
+        return _rbuf_unused++;
+    }
+    return -1;
+}
+
+static void _rbuf_free(unsigned idx)
+{
+    _hash_next[idx] = _free_head;
+    _free_head = idx + 1;
+}
+
+static void _rbuf_queue_append(_rbuf_queue_t *queue, unsigned idx)
+{
+    _queue_next[idx] = RBUF_NIL;
+    _queue_prev[idx] = queue->tail;
+    if (queue->tail != RBUF_NIL) {
+        _queue_next[queue->tail - 1] = idx + 1;
+    }
+    else {
+        queue->head = idx + 1;
+    }
+    queue->tail = idx + 1;
+}
+
+static void _rbuf_queue_remove(_rbuf_queue_t *queue, unsigned idx)
+{
+    if (_queue_prev[idx] != RBUF_NIL) {
+        _queue_next[_queue_prev[idx] - 1] = _queue_next[idx];
+    }
+    else {
+        queue->head = _queue_next[idx];
+    }
+    if (_queue_next[idx] != RBUF_NIL) {
+        _queue_prev[_queue_next[idx] - 1] = _queue_prev[idx];
+    }
+    else {
+        queue->tail = _queue_prev[idx];
+    }
+}
+
+static void _rbuf_link(unsigned idx)
+{
+    gnrc_sixlowpan_frag_rb_base_t *e = &rbuf[idx].super;
+    unsigned bucket = _rbuf_hash(e->src, e->src_len, e->dst, e->dst_len,
+                                 e->tag);
+
+    _hash_next[idx] = _hash_head[bucket];
+    _hash_head[bucket] = idx + 1;
+    _rbuf_queue_append(&_reass_queue, idx);
+}
+
+static void _rbuf_unlink(unsigned idx)
+{
+    gnrc_sixlowpan_frag_rb_base_t *e = &rbuf[idx].super;
+    _rbuf_idx_t *ptr = &_hash_head[_rbuf_hash(e->src, e->src_len,
+                                              e->dst, e->dst_len, e->tag)];
+
+    while (*ptr != RBUF_NIL) {
+        if (*ptr == (idx + 1)) {
+            *ptr = _hash_next[idx];
+            break;
+        }
+        ptr = &_hash_next[*ptr - 1];
+    }
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+    if (_in_del_queue[idx]) {
+        _rbuf_queue_remove(&_del_queue, idx);
+        _in_del_queue[idx] = false;
+        return;
+    }
+#endif
+    _rbuf_queue_remove(&_reass_queue, idx);
+}
+
 #ifndef NDEBUG
 static bool _valid_offset(gnrc_pktsnip_t *pkt, size_t offset)
 {
@@ -354,8 +518,7 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         if (_rbuf_update_ints(entry.super, offset, frag_size)) {
             DEBUG("6lo rbuf minfwd: trying to forward fragment\n");
             entry.super->current_size += (uint16_t)frag_size;
-            if (_forward_frag(pkt, sizeof(sixlowpan_frag_n_t), entry.vrb,
-                              page) < 0) {
+            if (_forward_frag(pkt, entry.vrb, page) < 0) {
                 DEBUG("6lo rbuf minfwd: unable to forward fragment\n");
                 return RBUF_ADD_ERROR;
             }
@@ -444,7 +607,7 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                                     gnrc_netif_hdr_get_netif(netif_hdr),
                                     &tmp))) {
                         _adapt_hdr(&tmp, page);
-                        return _forward_uncomp(pkt, rbuf, vrbe, page);
+                        return _forward_uncomp(pkt, entry.rbuf, vrbe, page);
                     }
                 }
                 else if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) &&
@@ -553,30 +716,37 @@ static void _gc_pkt(gnrc_sixlowpan_frag_rb_t *rbuf)
     gnrc_pktbuf_release(rbuf->pkt);
 }
 
-void gnrc_sixlowpan_frag_rb_gc(void)
+static void _rbuf_queue_gc(_rbuf_queue_t *queue, uint32_t now_usec)
 {
-    uint32_t now_usec = xtimer_now_usec();
-    unsigned int i;
-
-    for (i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if (!gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i]) &&
-              ((now_usec - rbuf[i].super.arrival) >
-               CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)) {
-            DEBUG("6lo rfrag: entry (%s, ",
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+    /* queue is sorted by expiry, so stop at the first entry not timed out */
+    while (queue->head != RBUF_NIL) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[queue->head - 1];
 
-            _gc_pkt(&rbuf[i]);
-            gnrc_sixlowpan_frag_rb_remove(&(rbuf[i]));
+        if ((now_usec - e->super.arrival) <=
+            CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US) {
+            break;
         }
+        DEBUG("6lo rfrag: entry (%s, ",
+              gnrc_netif_addr_to_str(e->super.src, e->super.src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(e->super.dst, e->super.dst_len,
+                                     l2addr_str),
+              (unsigned)e->super.datagram_size, e->super.tag);
+        _gc_pkt(e);
+        gnrc_sixlowpan_frag_rb_remove(e);
     }
+}
+
+void gnrc_sixlowpan_frag_rb_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    /* since pkt occupies pktbuf, aggressivly collect garbage */
+    _rbuf_queue_gc(&_reass_queue, now_usec);
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+    _rbuf_queue_gc(&_del_queue, now_usec);
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
     gnrc_sixlowpan_frag_vrb_gc();
 #endif
@@ -593,62 +763,65 @@ static int _rbuf_get(const void *src, size_t src_len,
                      size_t size, uint16_t tag,
                      unsigned page)
 {
-    gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
+    gnrc_sixlowpan_frag_rb_t *res;
     uint32_t now_usec = xtimer_now_usec();
+    unsigned i = _hash_head[_rbuf_hash(src, src_len, dst, dst_len, tag)];
+    int idx;
 
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.tag == tag) &&
+    /* check first if entry already available */
+    while (i != RBUF_NIL) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i - 1];
+
+        if (_rbuf_match(e, src, src_len, dst, dst_len, tag) &&
             ((IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) &&
               /* not all SFR fragments carry the datagram size, so make 0 a
                * legal value to not compare datagram size */
-              ((size == 0) || (rbuf[i].super.datagram_size == size))) ||
+              ((size == 0) || (e->super.datagram_size == size))) ||
              (!IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) &&
-              (rbuf[i].super.datagram_size == size))) &&
-            (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
+              (e->super.datagram_size == size)))) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)e,
+                  gnrc_netif_addr_to_str(e->super.src, e->super.src_len,
                                          l2addr_str));
             DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
+                  gnrc_netif_addr_to_str(e->super.dst, e->super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+                  (unsigned)e->super.datagram_size, e->super.tag);
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
-            if (rbuf[i].super.current_size == 0) {
+            if (e->super.current_size == 0) {
                 /* ensure that only empty reassembly buffer entries and entries
                  * scheduled for deletion have `current_size == 0` */
                 DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
                 return -1;
             }
 #endif
-            rbuf[i].super.arrival = now_usec;
+            e->super.arrival = now_usec;
+            /* keep reassembly queue sorted by arrival */
+            _rbuf_queue_remove(&_reass_queue, i - 1);
+            _rbuf_queue_append(&_reass_queue, i - 1);
             _set_rbuf_timeout();
-            return i;
+            return i - 1;
         }
+        i = _hash_next[i - 1];
+    }
 
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
-            res = &(rbuf[i]);
-        }
+    /* entry not in buffer and no empty spot left */
+    if ((idx = _rbuf_alloc()) < 0) {
+        /* the oldest entry is at the head of one of the queues */
+        gnrc_sixlowpan_frag_rb_t *oldest = NULL;
 
-        /* remember oldest slot */
+        if (_reass_queue.head != RBUF_NIL) {
+            oldest = &rbuf[_reass_queue.head - 1];
+        }
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
         /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) ||
-            (oldest->super.arrival - rbuf[i].super.arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
+        if ((_del_queue.head != RBUF_NIL) &&
+            ((oldest == NULL) ||
+             ((oldest->super.arrival -
+               rbuf[_del_queue.head - 1].super.arrival) < UINT32_MAX / 2))) {
+            oldest = &rbuf[_del_queue.head - 1];
         }
-    }
-
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
+#endif
         assert(oldest != NULL);
-        /* if oldest is not empty, res must not be NULL (because otherwise
-         * oldest could have been picked as res) */
         assert(!gnrc_sixlowpan_frag_rb_entry_empty(oldest));
         if (!IS_ACTIVE(CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DO_NOT_OVERRIDE) ||
             ((now_usec - oldest->super.arrival) >
@@ -656,7 +829,8 @@ static int _rbuf_get(const void *src, size_t src_len,
             DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
             gnrc_pktbuf_release(oldest->pkt);
             gnrc_sixlowpan_frag_rb_remove(oldest);
-            res = oldest;
+            idx = _rbuf_alloc();
+            assert(idx >= 0);
 #if !IS_ACTIVE(CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DO_NOT_OVERRIDE) && \
     IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
             gnrc_sixlowpan_frag_stats_get()->rbuf_full++;
@@ -669,6 +843,7 @@ static int _rbuf_get(const void *src, size_t src_len,
             return -1;
         }
     }
+    res = &rbuf[idx];
 
     /* now we have an empty spot */
 
@@ -703,6 +878,7 @@ static int _rbuf_get(const void *src, size_t src_len,
     }
     if (res->pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+        _rbuf_free(idx);
         return -1;
     }
 
@@ -722,6 +898,7 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->offset_diff = 0U;
     memset(res->received, 0U, sizeof(res->received));
 #endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) */
+    _rbuf_link(idx);
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -733,7 +910,7 @@ static int _rbuf_get(const void *src, size_t src_len,
 
     _set_rbuf_timeout();
 
-    return res - &(rbuf[0]);
+    return idx;
 }
 
 #ifdef TEST_SUITES
@@ -748,6 +925,14 @@ void gnrc_sixlowpan_frag_rb_reset(void)
         }
     }
     memset(rbuf, 0, sizeof(rbuf));
+    memset(_hash_head, 0, sizeof(_hash_head));
+    memset(&_reass_queue, 0, sizeof(_reass_queue));
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+    memset(&_del_queue, 0, sizeof(_del_queue));
+    memset(_in_del_queue, 0, sizeof(_in_del_queue));
+#endif
+    _free_head = RBUF_NIL;
+    _rbuf_unused = 0;
 }
 
 const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
@@ -769,22 +954,45 @@ void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
     entry->datagram_size = 0;
 }
 
-static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
+void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *entry)
+{
+    assert(entry != NULL);
+    /* only entries in use are linked */
+    if (entry->pkt != NULL) {
+        unsigned idx = entry - &rbuf[0];
+
+        _rbuf_unlink(idx);
+        _rbuf_free(idx);
+    }
+    gnrc_sixlowpan_frag_rb_base_rm(&entry->super);
+    entry->pkt = NULL;
+}
+
+static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *entry)
 {
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0U
+        unsigned idx = entry - &rbuf[0];
+
         /* use garbage-collection to leave the entry for at least
          * CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER in the reassembly buffer by
          * setting the arrival time to
          * (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US - CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER)
          * microseconds in the past */
-        rbuf->super.arrival = xtimer_now_usec() -
-                              (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US -
-                               CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER);
+        entry->super.arrival = xtimer_now_usec() -
+                               (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US -
+                                CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER);
         /* reset current size to prevent late duplicates to trigger another
          * dispatch */
-        rbuf->super.current_size = 0;
+        entry->super.current_size = 0;
+        /* the entry now expires before those still in reassembly, so keep it
+         * in the queue sorted by deletion time instead */
+        if (!_in_del_queue[idx]) {
+            _rbuf_queue_remove(&_reass_queue, idx);
+            _rbuf_queue_append(&_del_queue, idx);
+            _in_del_queue[idx] = true;
+        }
 #else   /* CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER == 0U */
-        gnrc_sixlowpan_frag_rb_remove(rbuf);
+        gnrc_sixlowpan_frag_rb_remove(entry);
 #endif  /* CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER */
 }
 
@@ -881,27 +1089,15 @@ static void _adapt_hdr(gnrc_pktsnip_t *hdr, unsigned page)
     }
 }
 
-static int _forward_frag(gnrc_pktsnip_t *pkt, size_t frag_hdr_size,
-                         gnrc_sixlowpan_frag_vrb_t *vrbe, unsigned page)
+static int _forward_frag(gnrc_pktsnip_t *pkt, gnrc_sixlowpan_frag_vrb_t *vrbe,
+                         unsigned page)
 {
     int res = -ENOTSUP;
 
     if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD)) {
-        gnrc_pktsnip_t *frag = gnrc_pktbuf_mark(pkt, frag_hdr_size,
-                                                GNRC_NETTYPE_SIXLOWPAN);
-        if (frag == NULL) {
-            gnrc_pktbuf_release(pkt);
-            res = -ENOMEM;
-        }
-        else {
-            pkt = gnrc_pkt_delete(pkt, frag);
-            frag->next = NULL;
-            /* remove netif header */
-            gnrc_pktbuf_remove_snip(pkt, pkt->next);
-            res = gnrc_sixlowpan_frag_minfwd_forward(pkt, frag->data, vrbe,
-                                                     page);
-            gnrc_pktbuf_release(frag);
-        }
+        /* the fragmentation header is only relabeled, so forward the
+         * fragment as it was received */
+        res = gnrc_sixlowpan_frag_minfwd_forward_in_place(pkt, vrbe, page);
     }
     return res;
 }
@@ -912,8 +1108,7 @@ static int _forward_uncomp(gnrc_pktsnip_t *pkt,
                            unsigned page)
 {
     DEBUG("6lo rbuf minfwd: found route, trying to forward\n");
-    int res = _forward_frag(pkt, sizeof(sixlowpan_frag_t),
-                            vrbe, page);
+    int res = _forward_frag(pkt, vrbe, page);
 
     /* prevent intervals from being deleted (they are in the
      * VRB now) */
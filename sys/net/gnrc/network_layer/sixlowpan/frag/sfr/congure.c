@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "congure.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#include "net/gnrc/sixlowpan/frag/sfr_congure.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static void _update_window(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    congure_wnd_size_t cwnd = fbuf->sfr.congure->cwnd;
+
+    if (cwnd < CONFIG_GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE) {
+        cwnd = CONFIG_GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE;
+    }
+    else if (cwnd > CONFIG_GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE) {
+        cwnd = CONFIG_GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE;
+    }
+    if (fbuf->sfr.window_size != cwnd) {
+        DEBUG("6lo sfr congure: window of datagram %u: %u -> %u\n",
+              fbuf->tag, fbuf->sfr.window_size, cwnd);
+    }
+    fbuf->sfr.window_size = (uint8_t)cwnd;
+}
+
+static inline void _report_single(congure_snd_t *c, congure_snd_msg_t *msg,
+                                  void (*report)(congure_snd_t *,
+                                                 congure_snd_msg_t *))
+{
+    /* turn msg into a circular list of length one */
+    msg->super.next = &msg->super;
+    report(c, msg);
+}
+
+void gnrc_sixlowpan_frag_sfr_congure_snd_init(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    if (fbuf->sfr.congure == NULL) {
+        congure_snd_t *c = gnrc_sixlowpan_frag_sfr_congure_snd_get();
+
+        if (c == NULL) {
+            DEBUG("6lo sfr congure: no CongURE object left for datagram %u\n",
+                  fbuf->tag);
+            return;
+        }
+        c->driver->init(c, fbuf);
+        fbuf->sfr.congure = c;
+    }
+    _update_window(fbuf);
+}
+
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_frag_sent(
+        gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    congure_snd_t *c = fbuf->sfr.congure;
+
+    if (c != NULL) {
+        c->driver->report_msg_sent(c, 1U);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_frag_acked(
+        gnrc_sixlowpan_frag_fb_t *fbuf, congure_snd_msg_t *msg)
+{
+    congure_snd_t *c = fbuf->sfr.congure;
+
+    if (c != NULL) {
+        congure_snd_ack_t ack = {
+            .recv_time = xtimer_now_usec() / US_PER_MS,
+            .id = fbuf->tag,
+            .clean = 1U,
+        };
+
+        msg->size = 1U;
+        c->driver->report_msg_acked(c, msg, &ack);
+        _update_window(fbuf);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_lost(
+        gnrc_sixlowpan_frag_fb_t *fbuf, congure_snd_msg_t *msg)
+{
+    congure_snd_t *c = fbuf->sfr.congure;
+
+    if (c != NULL) {
+        _report_single(c, msg, c->driver->report_msgs_lost);
+        _update_window(fbuf);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_timeout(
+        gnrc_sixlowpan_frag_fb_t *fbuf, congure_snd_msg_t *msg)
+{
+    congure_snd_t *c = fbuf->sfr.congure;
+
+    if (c != NULL) {
+        _report_single(c, msg, c->driver->report_msgs_timeout);
+        _update_window(fbuf);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_congure_snd_report_ecn_ce(
+        gnrc_sixlowpan_frag_fb_t *fbuf, ztimer_now_t time)
+{
+    congure_snd_t *c = fbuf->sfr.congure;
+
+    if (c != NULL) {
+        c->driver->report_ecn_ce(c, time);
+        _update_window(fbuf);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_congure_snd_destroy(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    congure_snd_t *c = fbuf->sfr.congure;
+
+    if (c != NULL) {
+        /* mark object as free for gnrc_sixlowpan_frag_sfr_congure_snd_get() */
+        c->driver = NULL;
+        fbuf->sfr.congure = NULL;
+    }
+}
+
+/** @} */
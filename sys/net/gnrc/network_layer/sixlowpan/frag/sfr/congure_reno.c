@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "congure/reno.h"
+#include "net/gnrc/sixlowpan/config.h"
+
+#include "net/gnrc/sixlowpan/frag/sfr_congure.h"
+
+static const congure_reno_consts_t _consts = {
+    .init_wnd = CONFIG_GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE,
+    .min_wnd = CONFIG_GNRC_SIXLOWPAN_SFR_MIN_WIN_SIZE,
+    .max_wnd = CONFIG_GNRC_SIXLOWPAN_SFR_MAX_WIN_SIZE,
+    /* start in congestion avoidance, the initial window is already the
+     * optimal one */
+    .init_ssthresh = CONFIG_GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE,
+    .mss = 1U,              /* one fragment per acknowledged window */
+};
+
+static congure_reno_snd_t _congures[CONFIG_GNRC_SIXLOWPAN_FRAG_FB_SIZE];
+
+congure_snd_t *gnrc_sixlowpan_frag_sfr_congure_snd_get(void)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_FB_SIZE; i++) {
+        if (_congures[i].super.driver == NULL) {
+            congure_reno_snd_setup(&_congures[i], &_consts);
+            return &_congures[i].super;
+        }
+    }
+    return NULL;
+}
+
+/** @} */
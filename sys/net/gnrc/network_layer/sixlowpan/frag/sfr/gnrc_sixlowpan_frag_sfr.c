@@ -35,6 +35,7 @@
 #include "xtimer.h"
 
 #include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/gnrc/sixlowpan/frag/sfr_congure.h"
 
 #define ENABLE_DEBUG    0
 #include "debug.h"
@@ -125,6 +126,16 @@ static inline uint8_t _frag_seq(_frag_desc_t *frag);
  */
 static inline uint16_t _frag_size(_frag_desc_t *frag);
 
+/**
+ * @brief   Adds a fragment to a summary message for @ref sys_congure
+ *
+ * @param[in,out] msg   The summary message. Its size is incremented and its
+ *                      send time set to the newest one of all added fragments.
+ * @param[in] frag      The fragment to add.
+ */
+static inline void _congure_msg_add(congure_snd_msg_t *msg,
+                                    _frag_desc_t *frag);
+
 /**
  * @brief   Cleans up a fragmentation buffer entry and all state related to its
  *          datagram.
@@ -452,6 +463,8 @@ void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf)
     uint32_t next_arq_offset = fbuf->sfr.arq_timeout;
     bool reschedule_arq_timeout = false;
     int error_no = ETIMEDOUT;   /* assume time out for fbuf->pkt */
+    /* all fragments with timed out ACK request summarized as one message */
+    congure_snd_msg_t timed_out = { .size = 0 };
 
     DEBUG("6lo sfr: ARQ timeout for datagram %u\n", fbuf->tag);
     fbuf->sfr.arq_timeout_event.msg.content.ptr = NULL;
@@ -483,6 +496,7 @@ void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf)
             else if (_frag_ack_req(frag_desc)) {
                 /* for this fragment we requested an ACK which was not received
                  * yet. Try to resend it */
+                _congure_msg_add(&timed_out, frag_desc);
                 if ((frag_desc->retries++) < CONFIG_GNRC_SIXLOWPAN_SFR_FRAG_RETRIES) {
                     /* we have retries left for this fragment */
                     DEBUG("6lo sfr: %u retries left for fragment (tag: %u, "
@@ -517,6 +531,9 @@ void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf)
                     /* we are out of retries on the fragment level, but we
                      * might be able to retry the datagram if retries for the
                      * datagram are configured. */
+                    gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_timeout(
+                        fbuf, &timed_out
+                    );
                     _retry_datagram(fbuf);
                     return;
                 }
@@ -538,6 +555,10 @@ void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf)
         error_no = GNRC_NETERR_SUCCESS;
     }
     assert(fbuf->sfr.frags_sent == clist_count(&fbuf->sfr.window));
+    if (timed_out.size > 0) {
+        gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_timeout(fbuf,
+                                                                 &timed_out);
+    }
     if (reschedule_arq_timeout) {
         _sched_arq_timeout(fbuf, next_arq_offset);
         return;
@@ -790,6 +811,7 @@ static bool _send_fragment(gnrc_pktsnip_t *frag, gnrc_sixlowpan_frag_fb_t *fbuf,
         frag_desc->last_sent = _last_frame_sent;
         fbuf->sfr.cur_seq++;
         fbuf->sfr.frags_sent++;
+        gnrc_sixlowpan_frag_sfr_congure_snd_report_frag_sent(fbuf);
     }
     return res;
 }
@@ -1105,7 +1127,7 @@ static void _handle_nth_rfrag(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             gnrc_netif_hdr_get_src_addr(netif_hdr),
             netif_hdr->src_l2addr_len, hdr->base.tag)) != NULL) {
         entry->type = _VRB;
-        entry->entry.base->arrival = xtimer_now_usec();
+        gnrc_sixlowpan_frag_vrb_refresh(entry->entry.vrb);
         _forward_rfrag(pkt, entry, offset, page);
     }
     else {
@@ -1132,9 +1154,20 @@ static void _check_failed_frags(sixlowpan_sfr_ack_t *ack,
 {
     _frag_desc_t *frag_desc;
     clist_node_t not_received = { .next = NULL };
+    /* all fragments not received summarized as one message */
+    congure_snd_msg_t lost = { .size = 0 };
 
     DEBUG("6lo sfr: checking which fragments to resend for datagram %u\n",
           fbuf->tag);
+    if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE) &&
+        sixlowpan_sfr_ecn(&ack->base) &&
+        ((frag_desc = (_frag_desc_t *)clist_rpeek(&fbuf->sfr.window)) != NULL)) {
+        /* the reassembling endpoint echoes congestion experienced by the
+         * fragments in flight */
+        gnrc_sixlowpan_frag_sfr_congure_snd_report_ecn_ce(
+            fbuf, frag_desc->last_sent / US_PER_MS
+        );
+    }
     for (frag_desc = (_frag_desc_t *)clist_lpop(&fbuf->sfr.window);
          frag_desc != NULL;
          frag_desc = (_frag_desc_t *)clist_lpop(&fbuf->sfr.window)) {
@@ -1146,12 +1179,23 @@ static void _check_failed_frags(sixlowpan_sfr_ack_t *ack,
                   "for datagram %u was received\n", seq,
                   frag_desc->offset, _frag_size(frag_desc), fbuf->tag);
             fbuf->sfr.frags_sent--;
+            if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR_CONGURE)) {
+                congure_snd_msg_t acked = {
+                    .send_time = frag_desc->last_sent / US_PER_MS,
+                    .resends = frag_desc->retries,
+                };
+
+                gnrc_sixlowpan_frag_sfr_congure_snd_report_frag_acked(
+                    fbuf, &acked
+                );
+            }
             clist_rpush(&_frag_descs_free, &frag_desc->super);
         }
         else {
             DEBUG("6lo sfr: fragment %u (offset: %u, frag_size: %u) "
                   "for datagram %u was not received\n", seq,
                   frag_desc->offset, _frag_size(frag_desc), fbuf->tag);
+            _congure_msg_add(&lost, frag_desc);
             if ((frag_desc->retries++) < CONFIG_GNRC_SIXLOWPAN_SFR_FRAG_RETRIES) {
                 DEBUG("6lo sfr: %u retries left\n",
                       CONFIG_GNRC_SIXLOWPAN_SFR_FRAG_RETRIES -
@@ -1163,6 +1207,8 @@ static void _check_failed_frags(sixlowpan_sfr_ack_t *ack,
             else {
                 DEBUG("6lo sfr: no more retries for fragment %u\n", seq);
                 clist_rpush(&_frag_descs_free, &frag_desc->super);
+                gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_lost(fbuf,
+                                                                      &lost);
                 /* retry to resend whole datagram */
                 _retry_datagram(fbuf);
                 return;
@@ -1178,6 +1224,11 @@ static void _check_failed_frags(sixlowpan_sfr_ack_t *ack,
     }
     /* at least one fragment was not received */
     else {
+        if (lost.size > 0) {
+            /* adapt window before resending, so the last fragment in the
+             * window is determined correctly by _resend_frag() */
+            gnrc_sixlowpan_frag_sfr_congure_snd_report_frags_lost(fbuf, &lost);
+        }
         fbuf->sfr.window = not_received;
         assert(fbuf->sfr.frags_sent == clist_count(&fbuf->sfr.window));
         /* use _resend_failed_frag here instead of loop above, so
@@ -1231,11 +1282,26 @@ static inline uint16_t _frag_size(_frag_desc_t *frag)
     return (frag->ar_seq_fs & SIXLOWPAN_SFR_FRAG_SIZE_MASK);
 }
 
+static inline void _congure_msg_add(congure_snd_msg_t *msg,
+                                    _frag_desc_t *frag)
+{
+    ztimer_now_t send_time = frag->last_sent / US_PER_MS;
+
+    if ((msg->size == 0) || ((int32_t)(send_time - msg->send_time) > 0)) {
+        msg->send_time = send_time;
+    }
+    if (frag->retries > msg->resends) {
+        msg->resends = frag->retries;
+    }
+    msg->size++;
+}
+
 static void _clean_up_fbuf(gnrc_sixlowpan_frag_fb_t *fbuf, int error)
 {
     DEBUG("6lo sfr: removing fragmentation buffer entry for datagram %u\n",
           fbuf->tag);
     _clean_slate_datagram(fbuf);
+    gnrc_sixlowpan_frag_sfr_congure_snd_destroy(fbuf);
     gnrc_pktbuf_release_error(fbuf->pkt, error);
     fbuf->pkt = NULL;
 }
@@ -1273,6 +1339,8 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *netif,
     }
     fbuf->sfr.arq_timeout = CONFIG_GNRC_SIXLOWPAN_SFR_OPT_ARQ_TIMEOUT_MS;
     fbuf->sfr.window_size = CONFIG_GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE;
+    /* overrides window_size if congestion control is used */
+    gnrc_sixlowpan_frag_sfr_congure_snd_init(fbuf);
 
     frag = _build_frag_from_fbuf(pkt, fbuf, frag_size);
     if (frag == NULL) {
@@ -1567,19 +1635,12 @@ static void _handle_ack(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         }
         if ((unaligned_get_u32(hdr->bitmap) == _full_bitmap.u32) ||
             (unaligned_get_u32(hdr->bitmap) == _null_bitmap.u32)) {
-            if (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0) {
-                /* garbage-collect entry after CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER
-                 * microseconds */
-                vrbe->super.arrival = xtimer_now_usec() -
-                                      (CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US -
-                                       CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER);
-            }
-            else {
-                gnrc_sixlowpan_frag_vrb_rm(vrbe);
-            }
+            /* garbage-collect entry after CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER
+             * microseconds */
+            gnrc_sixlowpan_frag_vrb_rm_delayed(vrbe);
         }
         else {
-            vrbe->super.arrival = xtimer_now_usec();
+            gnrc_sixlowpan_frag_vrb_refresh(vrbe);
         }
     }
     else {
@@ -1615,11 +1676,7 @@ static void _handle_ack(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 static int _forward_rfrag(gnrc_pktsnip_t *pkt, _generic_rb_entry_t *entry,
                           uint16_t offset, unsigned page)
 {
-    gnrc_pktsnip_t *old, *new = gnrc_netif_hdr_build(
-            NULL, 0,
-            entry->entry.base->dst, entry->entry.base->dst_len
-        );
-    sixlowpan_sfr_rfrag_t *hdr;
+    sixlowpan_sfr_rfrag_t *hdr = pkt->data;
 
     assert(entry->type == _VRB);
     /* restrict out_tag to value space of SFR, so that later RFRAG ACK can find
@@ -1629,27 +1686,19 @@ static int _forward_rfrag(gnrc_pktsnip_t *pkt, _generic_rb_entry_t *entry,
           gnrc_netif_addr_to_str(entry->entry.base->dst,
                                  entry->entry.base->dst_len, addr_str),
           entry->entry.vrb->out_tag);
-    if (new == NULL) {
-        DEBUG("6lo sfr: Unable to forward fragment, "
-              "packet buffer full\n");
-        gnrc_pktbuf_release(pkt);
-        return -ENOMEM;
-    }
-
-    hdr = pkt->data;
-    old = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
-    if (old != NULL) {
-        /* remove original netif header */
-        gnrc_pktbuf_remove_snip(pkt, old);
-    }
     if (offset > 0) {
         offset += entry->entry.vrb->offset_diff;
     }
     sixlowpan_sfr_rfrag_set_offset(hdr, offset);
     hdr->base.tag = entry->entry.vrb->out_tag;
-    gnrc_netif_hdr_set_netif(new->data, entry->entry.vrb->out_netif);
-    new->next = pkt;
-    _send_frame(new, NULL, page);
+    /* reuses the netif header of the received fragment if possible */
+    if ((pkt = gnrc_sixlowpan_frag_vrb_netif_hdr(entry->entry.vrb,
+                                                 pkt)) == NULL) {
+        DEBUG("6lo sfr: Unable to forward fragment, "
+              "packet buffer full\n");
+        return -ENOMEM;
+    }
+    _send_frame(pkt, NULL, page);
     if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR_STATS)) {
         _stats.fragments_sent.forwarded++;
     }
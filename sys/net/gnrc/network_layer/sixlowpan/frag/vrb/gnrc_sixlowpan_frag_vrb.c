@@ -13,12 +13,17 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <assert.h>
+#include <stdint.h>
+
 #include "net/ieee802154.h"
 #ifdef MODULE_GNRC_IPV6_NIB
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/nib.h"
 #endif  /* MODULE_GNRC_IPV6_NIB */
 #include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
 #include "xtimer.h"
 
 #include "net/gnrc/sixlowpan/frag/fb.h"
@@ -37,6 +42,45 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 static char addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 #endif  /* MODULE_GNRC_IPV6_NIB */
 
+/* Entries in use are indexed in two chained hash tables: by (src, tag) for
+ * forwarding and by (dst, out_tag) for reverse look-ups, and kept in queues
+ * ordered by their expiry, so neither look-ups nor garbage collection need to
+ * walk the whole VRB per fragment.
+ * Links are stored as `index + 1`, so a zero-initialized index is empty. */
+#define VRB_NIL         (0U)
+#define VRB_HASH_SIZE   (CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE)
+
+typedef uint8_t _vrb_idx_t;
+
+static_assert(CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE < UINT8_MAX,
+              "CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE must be less than 255");
+
+/* entries of a queue expire in the order of their arrival */
+typedef struct {
+    _vrb_idx_t head;    /**< entry to expire next */
+    _vrb_idx_t tail;    /**< entry to expire last */
+} _vrb_queue_t;
+
+static _vrb_idx_t _fwd_head[VRB_HASH_SIZE];
+/* links forward hash chains for entries in use and the free list otherwise */
+static _vrb_idx_t _fwd_next[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static _vrb_idx_t _rev_head[VRB_HASH_SIZE];
+static _vrb_idx_t _rev_next[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static _vrb_idx_t _queue_prev[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static _vrb_idx_t _queue_next[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+/* entries in use, expiring CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US after
+ * their last fragment */
+static _vrb_queue_t _fwd_queue;
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+/* completed entries, expiring CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER after
+ * they were scheduled for removal */
+static _vrb_queue_t _del_queue;
+static bool _in_del_queue[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+#endif
+static _vrb_idx_t _free_head;
+/* entries from this index on were not used since the last reset */
+static unsigned _vrb_unused;
+
 static inline bool _equal_index(const gnrc_sixlowpan_frag_vrb_t *vrbe,
                                 const uint8_t *src, size_t src_len,
                                 unsigned tag)
@@ -46,6 +90,149 @@ static inline bool _equal_index(const gnrc_sixlowpan_frag_vrb_t *vrbe,
             (memcmp(vrbe->super.src, src, src_len) == 0));
 }
 
+static unsigned _hash(const uint8_t *addr, size_t addr_len, unsigned tag)
+{
+    uint32_t hash = tag;
+
+    for (unsigned i = 0; i < addr_len; i++) {
+        hash = (hash * 33) ^ addr[i];
+    }
+    return hash % VRB_HASH_SIZE;
+}
+
+static inline unsigned _fwd_hash(const gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    return _hash(vrbe->super.src, vrbe->super.src_len, vrbe->super.tag);
+}
+
+/* SFR restricts the out_tag to 8 bit after the entry was created, so only
+ * use those bits for the reverse look-up to keep the bucket stable */
+static inline unsigned _rev_hash(const gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    return _hash(vrbe->super.dst, vrbe->super.dst_len,
+                 vrbe->out_tag & UINT8_MAX);
+}
+
+static int _vrb_alloc(void)
+{
+    if (_free_head != VRB_NIL) {
+        unsigned idx = _free_head - 1;
+
+        _free_head = _fwd_next[idx];
+        return idx;
+    }
+    if (_vrb_unused < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE) {
+        return _vrb_unused++;
+    }
+    return -1;
+}
+
+/* inserts an entry into a queue after all entries that arrived before it */
+static void _vrb_queue_insert(_vrb_queue_t *queue, unsigned idx)
+{
+    const uint32_t arrival = _vrb[idx].super.arrival;
+    _vrb_idx_t prev = queue->tail;
+
+    /* entries are usually added and refreshed on arrival of a fragment, so
+     * this stops at the tail right away */
+    while ((prev != VRB_NIL) &&
+           ((int32_t)(_vrb[prev - 1].super.arrival - arrival) > 0)) {
+        prev = _queue_prev[prev - 1];
+    }
+    _queue_prev[idx] = prev;
+    if (prev != VRB_NIL) {
+        _queue_next[idx] = _queue_next[prev - 1];
+        _queue_next[prev - 1] = idx + 1;
+    }
+    else {
+        _queue_next[idx] = queue->head;
+        queue->head = idx + 1;
+    }
+    if (_queue_next[idx] != VRB_NIL) {
+        _queue_prev[_queue_next[idx] - 1] = idx + 1;
+    }
+    else {
+        queue->tail = idx + 1;
+    }
+}
+
+static void _vrb_queue_remove(_vrb_queue_t *queue, unsigned idx)
+{
+    if (_queue_prev[idx] != VRB_NIL) {
+        _queue_next[_queue_prev[idx] - 1] = _queue_next[idx];
+    }
+    else {
+        queue->head = _queue_next[idx];
+    }
+    if (_queue_next[idx] != VRB_NIL) {
+        _queue_prev[_queue_next[idx] - 1] = _queue_prev[idx];
+    }
+    else {
+        queue->tail = _queue_prev[idx];
+    }
+}
+
+/* removes an entry from the queue it is in */
+static void _vrb_dequeue(unsigned idx)
+{
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+    if (_in_del_queue[idx]) {
+        _vrb_queue_remove(&_del_queue, idx);
+        _in_del_queue[idx] = false;
+        return;
+    }
+#endif
+    _vrb_queue_remove(&_fwd_queue, idx);
+}
+
+static void _vrb_link(unsigned idx)
+{
+    unsigned bucket = _fwd_hash(&_vrb[idx]);
+
+    _fwd_next[idx] = _fwd_head[bucket];
+    _fwd_head[bucket] = idx + 1;
+    bucket = _rev_hash(&_vrb[idx]);
+    _rev_next[idx] = _rev_head[bucket];
+    _rev_head[bucket] = idx + 1;
+    _vrb_queue_insert(&_fwd_queue, idx);
+}
+
+static void _chain_remove(_vrb_idx_t *ptr, _vrb_idx_t *next, unsigned idx)
+{
+    while (*ptr != VRB_NIL) {
+        if (*ptr == (idx + 1)) {
+            *ptr = next[idx];
+            return;
+        }
+        ptr = &next[*ptr - 1];
+    }
+}
+
+static void _vrb_unlink(unsigned idx)
+{
+    _chain_remove(&_fwd_head[_fwd_hash(&_vrb[idx])], _fwd_next, idx);
+    _chain_remove(&_rev_head[_rev_hash(&_vrb[idx])], _rev_next, idx);
+    _vrb_dequeue(idx);
+    /* put entry on free list */
+    _fwd_next[idx] = _free_head;
+    _free_head = idx + 1;
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_vrb_lookup(const uint8_t *src,
+                                              size_t src_len, unsigned tag)
+{
+    unsigned i = _fwd_head[_hash(src, src_len, tag)];
+
+    while (i != VRB_NIL) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i - 1];
+
+        if (_equal_index(vrbe, src, src_len, tag)) {
+            return vrbe;
+        }
+        i = _fwd_next[i - 1];
+    }
+    return NULL;
+}
 
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
         const gnrc_sixlowpan_frag_rb_base_t *base,
@@ -57,59 +244,56 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
     assert(out_netif != NULL);
     assert(out_dst != NULL);
     assert(out_dst_len > 0);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *ptr = &_vrb[i];
-
-        if (gnrc_sixlowpan_frag_vrb_entry_empty(ptr) ||
-            _equal_index(ptr, base->src, base->src_len, base->tag)) {
-            vrbe = ptr;
-            if (gnrc_sixlowpan_frag_vrb_entry_empty(vrbe)) {
-                vrbe->super = *base;
-                vrbe->out_netif = out_netif;
-                memcpy(vrbe->super.dst, out_dst, out_dst_len);
-                vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
-                vrbe->super.dst_len = out_dst_len;
-                DEBUG("6lo vrb: creating entry (%s, ",
-                      gnrc_netif_addr_to_str(vrbe->super.src,
-                                             vrbe->super.src_len,
-                                             addr_str));
-                DEBUG("%s, %u, %u) => ",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str),
-                      (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
-                DEBUG("(%s, %u)\n",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str), vrbe->out_tag);
-            }
-            /* _equal_index() => append intervals of `base`, so they don't get
-             * lost. We use append, so we don't need to change base! */
-            else if (base->ints != NULL) {
-                gnrc_sixlowpan_frag_rb_int_t *tmp = vrbe->super.ints;
-
-                if (tmp != base->ints) {
-                    /* base->ints is not already vrbe->super.ints */
-                    if (tmp != NULL) {
-                        /* iterate before appending and check if `base->ints` is
-                         * not already part of list */
-                        while (tmp->next != NULL) {
-                            if (tmp == base->ints) {
-                                tmp = NULL;
-                                break;
-                            }
-                            tmp = tmp->next;
-                        }
-                        if (tmp != NULL) {
-                            tmp->next = base->ints;
-                        }
-                    }
-                    else {
-                        vrbe->super.ints = base->ints;
+    if ((vrbe = _vrb_lookup(base->src, base->src_len, base->tag)) == NULL) {
+        int idx = _vrb_alloc();
+
+        if (idx >= 0) {
+            vrbe = &_vrb[idx];
+            vrbe->super = *base;
+            vrbe->out_netif = out_netif;
+            memcpy(vrbe->super.dst, out_dst, out_dst_len);
+            vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
+            vrbe->super.dst_len = out_dst_len;
+            _vrb_link(idx);
+            DEBUG("6lo vrb: creating entry (%s, ",
+                  gnrc_netif_addr_to_str(vrbe->super.src,
+                                         vrbe->super.src_len,
+                                         addr_str));
+            DEBUG("%s, %u, %u) => ",
+                  gnrc_netif_addr_to_str(vrbe->super.dst,
+                                         vrbe->super.dst_len,
+                                         addr_str),
+                  (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
+            DEBUG("(%s, %u)\n",
+                  gnrc_netif_addr_to_str(vrbe->super.dst,
+                                         vrbe->super.dst_len,
+                                         addr_str), vrbe->out_tag);
+        }
+    }
+    /* _equal_index() => append intervals of `base`, so they don't get
+     * lost. We use append, so we don't need to change base! */
+    else if (base->ints != NULL) {
+        gnrc_sixlowpan_frag_rb_int_t *tmp = vrbe->super.ints;
+
+        if (tmp != base->ints) {
+            /* base->ints is not already vrbe->super.ints */
+            if (tmp != NULL) {
+                /* iterate before appending and check if `base->ints` is
+                 * not already part of list */
+                while (tmp->next != NULL) {
+                    if (tmp == base->ints) {
+                        tmp = NULL;
+                        break;
                     }
+                    tmp = tmp->next;
+                }
+                if (tmp != NULL) {
+                    tmp->next = base->ints;
                 }
             }
-            break;
+            else {
+                vrbe->super.ints = base->ints;
+            }
         }
     }
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
@@ -169,16 +353,14 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
 {
     DEBUG("6lo vrb: trying to get entry for (%s, %u)\n",
           gnrc_netif_addr_to_str(src, src_len, addr_str), src_tag);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i];
+    gnrc_sixlowpan_frag_vrb_t *vrbe = _vrb_lookup(src, src_len, src_tag);
 
-        if (_equal_index(vrbe, src, src_len, src_tag)) {
-            DEBUG("6lo vrb: got VRB to (%s, %u)\n",
-                  gnrc_netif_addr_to_str(vrbe->super.dst,
-                                         vrbe->super.dst_len,
-                                         addr_str), vrbe->out_tag);
-            return vrbe;
-        }
+    if (vrbe != NULL) {
+        DEBUG("6lo vrb: got VRB to (%s, %u)\n",
+              gnrc_netif_addr_to_str(vrbe->super.dst,
+                                     vrbe->super.dst_len,
+                                     addr_str), vrbe->out_tag);
+        return vrbe;
     }
     DEBUG("6lo vrb: no entry found\n");
     return NULL;
@@ -190,10 +372,13 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_reverse(
 {
     DEBUG("6lo vrb: trying to get entry for reverse label switching (%s, %u)\n",
           gnrc_netif_addr_to_str(src, src_len, addr_str), tag);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i];
+    unsigned i = _rev_head[_hash(src, src_len, tag & UINT8_MAX)];
+
+    while (i != VRB_NIL) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i - 1];
 
         if ((vrbe->out_tag == tag) && (vrbe->out_netif == netif) &&
+            (vrbe->super.dst_len == src_len) &&
             (memcmp(vrbe->super.dst, src, src_len) == 0)) {
             DEBUG("6lo vrb: got VRB entry from (%s, %u)\n",
                   gnrc_netif_addr_to_str(vrbe->super.src,
@@ -201,37 +386,143 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_reverse(
                                          addr_str), vrbe->super.tag);
             return vrbe;
         }
+        i = _rev_next[i - 1];
     }
     DEBUG("6lo vrb: no entry found\n");
     return NULL;
+}
+
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    assert((vrb >= _vrb) && (vrb < &_vrb[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE]));
+    if (gnrc_sixlowpan_frag_vrb_entry_empty(vrb)) {
+        return;
+    }
+    _vrb_unlink(vrb - _vrb);
+    if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB)) {
+        gnrc_sixlowpan_frag_rb_base_rm(&vrb->super);
+    }
+    vrb->super.src_len = 0;
+}
+
+void gnrc_sixlowpan_frag_vrb_refresh(gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    unsigned idx = vrb - _vrb;
 
+    assert((vrb >= _vrb) && (vrb < &_vrb[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE]));
+    assert(!gnrc_sixlowpan_frag_vrb_entry_empty(vrb));
+    vrb->super.arrival = xtimer_now_usec();
+    /* also cancels a scheduled removal */
+    _vrb_dequeue(idx);
+    _vrb_queue_insert(&_fwd_queue, idx);
 }
 
-void gnrc_sixlowpan_frag_vrb_gc(void)
+void gnrc_sixlowpan_frag_vrb_rm_delayed(gnrc_sixlowpan_frag_vrb_t *vrb)
 {
-    uint32_t now_usec = xtimer_now_usec();
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+    unsigned idx = vrb - _vrb;
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        if (!gnrc_sixlowpan_frag_vrb_entry_empty(&_vrb[i]) &&
-            (now_usec - _vrb[i].super.arrival) > CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US) {
-            DEBUG("6lo vrb: entry (%s, ",
-                  gnrc_netif_addr_to_str(_vrb[i].super.src,
-                                         _vrb[i].super.src_len,
-                                         addr_str));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(_vrb[i].super.dst,
-                                         _vrb[i].super.dst_len,
-                                         addr_str),
-                  (unsigned)_vrb[i].super.datagram_size, _vrb[i].super.tag);
-            gnrc_sixlowpan_frag_vrb_rm(&_vrb[i]);
+    assert((vrb >= _vrb) && (vrb < &_vrb[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE]));
+    assert(!gnrc_sixlowpan_frag_vrb_entry_empty(vrb));
+    /* use garbage-collection to leave the entry for
+     * CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER in the VRB by setting the
+     * arrival time to (CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US -
+     * CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER) microseconds in the past */
+    vrb->super.arrival = xtimer_now_usec() -
+                         (CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US -
+                          CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER);
+    /* the entry now expires before those still in use, so keep it in the
+     * queue sorted by deletion time instead */
+    _vrb_dequeue(idx);
+    _vrb_queue_insert(&_del_queue, idx);
+    _in_del_queue[idx] = true;
+#else
+    gnrc_sixlowpan_frag_vrb_rm(vrb);
+#endif
+}
+
+gnrc_pktsnip_t *gnrc_sixlowpan_frag_vrb_netif_hdr(
+        const gnrc_sixlowpan_frag_vrb_t *vrbe, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    size_t size;
+
+    assert(vrbe != NULL);
+    size = sizeof(gnrc_netif_hdr_t) + vrbe->super.dst_len;
+    if ((netif != NULL) && (netif->users == 1) && (netif->size >= size)) {
+        gnrc_netif_hdr_t *hdr = netif->data;
+
+        /* reuse header of received fragment, the addresses of the next hop
+         * fit in the space of the previous hop's */
+        pkt = gnrc_pkt_delete(pkt, netif);
+        gnrc_netif_hdr_init(hdr, 0, vrbe->super.dst_len);
+        gnrc_netif_hdr_set_dst_addr(hdr, vrbe->super.dst,
+                                    vrbe->super.dst_len);
+        /* shrinking is always possible */
+        gnrc_pktbuf_realloc_data(netif, size);
+    }
+    else {
+        if (netif != NULL) {
+            /* remove original netif header */
+            pkt = gnrc_pktbuf_remove_snip(pkt, netif);
+        }
+        netif = gnrc_netif_hdr_build(NULL, 0, vrbe->super.dst,
+                                     vrbe->super.dst_len);
+        if (netif == NULL) {
+            DEBUG("6lo vrb: can't allocate netif header for forwarding.\n");
+            gnrc_pktbuf_release(pkt);
+            return NULL;
         }
     }
+    gnrc_netif_hdr_set_netif(netif->data, vrbe->out_netif);
+    netif->next = NULL;
+    return gnrc_pkt_prepend(pkt, netif);
+}
+
+static void _vrb_queue_gc(_vrb_queue_t *queue, uint32_t now_usec)
+{
+    /* queue is sorted by expiry, so stop at the first entry not timed out */
+    while (queue->head != VRB_NIL) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[queue->head - 1];
+
+        if ((now_usec - vrbe->super.arrival) <=
+            CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US) {
+            break;
+        }
+        DEBUG("6lo vrb: entry (%s, ",
+              gnrc_netif_addr_to_str(vrbe->super.src, vrbe->super.src_len,
+                                     addr_str));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(vrbe->super.dst, vrbe->super.dst_len,
+                                     addr_str),
+              (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+}
+
+void gnrc_sixlowpan_frag_vrb_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    _vrb_queue_gc(&_fwd_queue, now_usec);
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+    _vrb_queue_gc(&_del_queue, now_usec);
+#endif
 }
 
 #ifdef TEST_SUITES
 void gnrc_sixlowpan_frag_vrb_reset(void)
 {
     memset(_vrb, 0, sizeof(_vrb));
+    memset(_fwd_head, 0, sizeof(_fwd_head));
+    memset(_rev_head, 0, sizeof(_rev_head));
+    memset(&_fwd_queue, 0, sizeof(_fwd_queue));
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+    memset(&_del_queue, 0, sizeof(_del_queue));
+    memset(_in_del_queue, 0, sizeof(_in_del_queue));
+#endif
+    _free_head = VRB_NIL;
+    _vrb_unused = 0;
 }
 #endif
 
@@ -18,7 +18,9 @@
 
 #include <stdbool.h>
 
+#include "bitarithm.h"
 #include "byteorder.h"
+#include "mutex.h"
 #include "net/ipv6/hdr.h"
 #include "net/ipv6/ext.h"
 #include "net/gnrc.h"
@@ -71,6 +73,7 @@
 #define IPHC_SAC_SAM_CTX_64         (0x50)
 #define IPHC_SAC_SAM_CTX_16         (0x60)
 #define IPHC_SAC_SAM_CTX_L2         (0x70)
+#define IPHC_SAC_SAM_MASK           (0x70)
 
 /* compression values for destination address */
 #define IPHC_M_DAC_DAM_U_FULL       (0x00)
@@ -86,6 +89,7 @@
 #define IPHC_M_DAC_DAM_M_32         (0x0a)
 #define IPHC_M_DAC_DAM_M_8          (0x0b)
 #define IPHC_M_DAC_DAM_M_UC_PREFIX  (0x0c)
+#define IPHC_M_DAC_DAM_MASK         (0x0f)
 
 #define NHC_ID_MASK                 (0xF8)
 #define NHC_UDP_ID                  (0xF0)
@@ -113,6 +117,35 @@
 #define NHC_IPV6_EXT_EID_MOB        (0x04 << 1)
 #define NHC_IPV6_EXT_EID_IPV6       (0x07 << 1)
 
+/**
+ * @brief   Address compression modes for an IPv6 header
+ */
+typedef struct {
+    uint8_t iphc2;      /**< SAC/SAM, M/DAC/DAM and CID flag of IPHC byte 2 */
+    uint8_t cid_ext;    /**< context identifier extension */
+    uint16_t ctxs;      /**< bitmap of the context IDs used for compression */
+} _addr_modes_t;
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+/**
+ * @brief   Flow cache entry
+ *
+ * @ref _cache_entry_t::iface is KERNEL_PID_UNDEF for unused entries.
+ */
+typedef struct {
+    ipv6_addr_t src;                                /**< source address */
+    ipv6_addr_t dst;                                /**< destination address */
+    uint8_t dst_l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /**< link-layer destination */
+    uint8_t dst_l2addr_len;                         /**< length of dst_l2addr */
+    kernel_pid_t iface;                             /**< interface */
+    _addr_modes_t modes;                            /**< cached modes */
+} _cache_entry_t;
+
+static _cache_entry_t _cache[CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static unsigned _cache_next;
+static mutex_t _cache_mutex = MUTEX_INIT;
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) */
+
 /* currently only used with forwarding output, remove guard if more debug info
  * is added */
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
@@ -132,7 +165,7 @@ static inline bool _is_rfrag(gnrc_pktsnip_t *sixlo)
 }
 
 static inline bool _context_overlaps_iid(gnrc_sixlowpan_ctx_t *ctx,
-                                         ipv6_addr_t *addr,
+                                         const ipv6_addr_t *addr,
                                          eui64_t *iid)
 {
     uint8_t byte_mask[] = {0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0x01};
@@ -1035,21 +1068,15 @@ static inline bool _compressible_nh(uint8_t nh)
     }
 }
 
-static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
-                                const gnrc_netif_hdr_t *netif_hdr,
-                                gnrc_netif_t *iface,
-                                uint8_t *iphc_hdr)
+static bool _iphc_addr_modes(const ipv6_hdr_t *ipv6_hdr,
+                             const gnrc_netif_hdr_t *netif_hdr,
+                             gnrc_netif_t *iface, _addr_modes_t *modes)
 {
     gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
-    bool addr_comp = false;
-    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
 
-    assert(iface != NULL);
-
-    /* set initial dispatch value*/
-    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
-    iphc_hdr[IPHC2_IDX] = 0;
+    modes->iphc2 = 0;
+    modes->cid_ext = 0;
+    modes->ctxs = 0;
 
     /* check for available contexts */
     if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
@@ -1071,89 +1098,25 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
     }
 
     /* if contexts available and both != 0 */
-    /* since this moves inline_pos we have to do this ahead*/
     if (((src_ctx != NULL) &&
             ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) ||
         ((dst_ctx != NULL) &&
             ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0))) {
         /* add context identifier extension */
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
-        iphc_hdr[CID_EXT_IDX] = 0;
-
-        /* move position to behind CID extension */
-        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
-    }
-
-    /* compress flow label and traffic class */
-    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
-        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
-            /* elide both traffic class and flow label */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
-        }
-        else {
-            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-        }
-    }
-    else {
-        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
-            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
-                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
-        }
-        else {
-            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
-        }
-
-        /* copy remaining bytes of flow label */
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
-        iphc_hdr[inline_pos++] = (uint8_t)(ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff);
-    }
-
-    /* check for compressible next header */
-    if (_compressible_nh(ipv6_hdr->nh)) {
-        iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
-    }
-    else {
-        iphc_hdr[inline_pos++] = ipv6_hdr->nh;
-    }
-
-    /* compress hop limit */
-    switch (ipv6_hdr->hl) {
-        case 1:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
-            break;
-
-        case 64:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
-            break;
-
-        case 255:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
-            break;
-
-        default:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
-            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
-            break;
+        modes->iphc2 |= SIXLOWPAN_IPHC2_CID_EXT;
     }
 
     if (ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_UNSPEC;
+        modes->iphc2 |= IPHC_SAC_SAM_UNSPEC;
     }
     else {
         if (src_ctx != NULL) {
-            /* stateful source address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_SAC;
+            uint8_t cid = src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK;
 
-            if (((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
-            }
+            /* stateful source address compression */
+            modes->iphc2 |= SIXLOWPAN_IPHC2_SAC;
+            modes->cid_ext |= (cid << 4);
+            modes->ctxs |= (1U << cid);
         }
 
         if ((src_ctx != NULL) || ipv6_addr_is_link_local(&(ipv6_hdr->src))) {
@@ -1164,46 +1127,31 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
             if (gnrc_netif_ipv6_get_iid(iface, &iid) < 0) {
                 DEBUG("6lo iphc: could not get interface's IID\n");
                 gnrc_netif_release(iface);
-                return 0;
+                return false;
             }
             gnrc_netif_release(iface);
 
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
                 _context_overlaps_iid(src_ctx, &ipv6_hdr->src, &iid)) {
                 /* 0 bits. The address is derived from link-layer address */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_L2;
-                addr_comp = true;
+                modes->iphc2 |= IPHC_SAC_SAM_L2;
             }
             else if ((byteorder_ntohl(ipv6_hdr->src.u32[2]) == 0x000000ff) &&
                      (byteorder_ntohs(ipv6_hdr->src.u16[6]) == 0xfe00)) {
                 /* 16 bits. The address is derived using 16 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_16;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
-                inline_pos += 2;
-                addr_comp = true;
+                modes->iphc2 |= IPHC_SAC_SAM_16;
             }
             else {
                 /* 64 bits. The address is derived using 64 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_64;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
-                inline_pos += 8;
-                addr_comp = true;
+                modes->iphc2 |= IPHC_SAC_SAM_64;
             }
         }
-
-        if (!addr_comp) {
-            /* full address is carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-            memcpy(iphc_hdr + inline_pos, &ipv6_hdr->src, 16);
-            inline_pos += 16;
-        }
+        /* else: full address is carried inline (IPHC_SAC_SAM_FULL) */
     }
 
-    addr_comp = false;
-
     /* M: Multicast compression */
     if (ipv6_addr_is_multicast(&(ipv6_hdr->dst))) {
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_M;
+        modes->iphc2 |= SIXLOWPAN_IPHC2_M;
 
         /* if multicast address is of format ffXX::XXXX:XXXX:XXXX */
         if ((ipv6_hdr->dst.u16[1].u16 == 0) &&
@@ -1215,28 +1163,18 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
                 (ipv6_hdr->dst.u16[6].u16 == 0) &&
                 (ipv6_hdr->dst.u8[14] == 0)) {
                 /* 8 bits. The address is derived using 8 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_8;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[15];
-                addr_comp = true;
+                modes->iphc2 |= IPHC_M_DAC_DAM_M_8;
             }
             /* if multicast address is of format ffXX::XX:XXXX */
             else if ((ipv6_hdr->dst.u16[5].u16 == 0) &&
                      (ipv6_hdr->dst.u8[12] == 0)) {
                 /* 32 bits. The address is derived using 32 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_32;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 13, 3);
-                inline_pos += 3;
-                addr_comp = true;
+                modes->iphc2 |= IPHC_M_DAC_DAM_M_32;
             }
             /* if multicast address is of format ffXX::XX:XXXX:XXXX */
             else if (ipv6_hdr->dst.u8[10] == 0) {
                 /* 48 bits. The address is derived using 48 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_48;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 11, 5);
-                inline_pos += 5;
-                addr_comp = true;
+                modes->iphc2 |= IPHC_M_DAC_DAM_M_48;
             }
         }
         /* try unicast prefix based compression */
@@ -1252,18 +1190,14 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
 
             if ((ctx != NULL) && (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) &&
                 (ctx->prefix_len == ipv6_hdr->dst.u8[3])) {
+                uint8_t cid = ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK;
+
                 /* Unicast prefix based IPv6 multicast address
                  * (https://tools.ietf.org/html/rfc3306) with given context
                  * for unicast prefix -> context based compression */
-                iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
-                if ((ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) {
-                    iphc_hdr[CID_EXT_IDX] |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
-                }
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[2];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
-                inline_pos += 4;
-                addr_comp = true;
+                modes->iphc2 |= SIXLOWPAN_IPHC2_DAC;
+                modes->cid_ext |= cid;
+                modes->ctxs |= (1U << cid);
             }
         }
     }
@@ -1272,49 +1206,297 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
         eui64_t iid;
 
         if (dst_ctx != NULL) {
-            /* stateful destination address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+            uint8_t cid = dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK;
 
-            if (((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
-            }
+            /* stateful destination address compression */
+            modes->iphc2 |= SIXLOWPAN_IPHC2_DAC;
+            modes->cid_ext |= cid;
+            modes->ctxs |= (1U << cid);
         }
 
         if (gnrc_netif_hdr_ipv6_iid_from_dst(iface, netif_hdr, &iid) < 0) {
             DEBUG("6lo iphc: could not get destination's IID\n");
-            return 0;
+            return false;
         }
 
         if ((ipv6_hdr->dst.u64[1].u64 == iid.uint64.u64) ||
             _context_overlaps_iid(dst_ctx, &(ipv6_hdr->dst), &iid)) {
             /* 0 bits. The address is derived using the link-layer address */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_L2;
-            addr_comp = true;
+            modes->iphc2 |= IPHC_M_DAC_DAM_U_L2;
         }
         else if ((byteorder_ntohl(ipv6_hdr->dst.u32[2]) == 0x000000ff) &&
                  (byteorder_ntohs(ipv6_hdr->dst.u16[6]) == 0xfe00)) {
             /* 16 bits. The address is derived using 16 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_16;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
-            inline_pos += 2;
-            addr_comp = true;
+            modes->iphc2 |= IPHC_M_DAC_DAM_U_16;
         }
         else {
             /* 64 bits. The address is derived using 64 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_64;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u8[8]), 8);
+            modes->iphc2 |= IPHC_M_DAC_DAM_U_64;
+        }
+    }
+    /* else: full destination address is carried inline
+     * (IPHC_M_DAC_DAM_U_FULL or IPHC_M_DAC_DAM_M_FULL) */
+
+    return true;
+}
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+static bool _cache_entry_match(const _cache_entry_t *entry,
+                               const ipv6_hdr_t *ipv6_hdr,
+                               const gnrc_netif_hdr_t *netif_hdr)
+{
+    return (entry->iface == netif_hdr->if_pid) &&
+           (entry->dst_l2addr_len == netif_hdr->dst_l2addr_len) &&
+           ipv6_addr_equal(&entry->dst, &ipv6_hdr->dst) &&
+           ipv6_addr_equal(&entry->src, &ipv6_hdr->src) &&
+           (memcmp(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                   entry->dst_l2addr_len) == 0);
+}
+
+static bool _cache_ctxs_valid(uint16_t ctxs)
+{
+    /* contexts may have timed out for compression since the entry was
+     * created, context updates flush the cache */
+    while (ctxs) {
+        uint8_t cid = bitarithm_lsb(ctxs);
+        gnrc_sixlowpan_ctx_t *ctx = gnrc_sixlowpan_ctx_lookup_id(cid);
+
+        if ((ctx == NULL) || !(ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
+            return false;
+        }
+        ctxs &= ~(1U << cid);
+    }
+    return true;
+}
+
+static bool _cache_get(const ipv6_hdr_t *ipv6_hdr,
+                       const gnrc_netif_hdr_t *netif_hdr,
+                       _addr_modes_t *modes)
+{
+    bool res = false;
+
+    mutex_lock(&_cache_mutex);
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        _cache_entry_t *entry = &_cache[i];
+
+        if (_cache_entry_match(entry, ipv6_hdr, netif_hdr)) {
+            if (_cache_ctxs_valid(entry->modes.ctxs)) {
+                *modes = entry->modes;
+                res = true;
+            }
+            else {
+                entry->iface = KERNEL_PID_UNDEF;
+            }
+            break;
+        }
+    }
+    mutex_unlock(&_cache_mutex);
+    return res;
+}
+
+static void _cache_add(const ipv6_hdr_t *ipv6_hdr,
+                       const gnrc_netif_hdr_t *netif_hdr,
+                       const _addr_modes_t *modes)
+{
+    if (netif_hdr->dst_l2addr_len > GNRC_NETIF_L2ADDR_MAXLEN) {
+        return;
+    }
+    mutex_lock(&_cache_mutex);
+    _cache_entry_t *entry = &_cache[_cache_next];
+
+    _cache_next = (_cache_next + 1) % CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+    entry->src = ipv6_hdr->src;
+    entry->dst = ipv6_hdr->dst;
+    memcpy(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    entry->dst_l2addr_len = netif_hdr->dst_l2addr_len;
+    entry->iface = netif_hdr->if_pid;
+    entry->modes = *modes;
+    mutex_unlock(&_cache_mutex);
+}
+
+void gnrc_sixlowpan_iphc_cache_flush(void)
+{
+    mutex_lock(&_cache_mutex);
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        _cache[i].iface = KERNEL_PID_UNDEF;
+    }
+    mutex_unlock(&_cache_mutex);
+}
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) */
+
+static uint16_t _iphc_src_inline(uint8_t iphc2, const ipv6_addr_t *src,
+                                 uint8_t *iphc_hdr, uint16_t inline_pos)
+{
+    if ((iphc2 & IPHC_SAC_SAM_MASK) == IPHC_SAC_SAM_UNSPEC) {
+        return inline_pos;
+    }
+    switch (iphc2 & IPHC_SAC_SAM_L2) {
+        case IPHC_SAC_SAM_FULL:
+            /* full address is carried inline */
+            memcpy(iphc_hdr + inline_pos, src, 16);
+            inline_pos += 16;
+            break;
+        case IPHC_SAC_SAM_64:
+            memcpy(iphc_hdr + inline_pos, src->u64 + 1, 8);
             inline_pos += 8;
-            addr_comp = true;
+            break;
+        case IPHC_SAC_SAM_16:
+            memcpy(iphc_hdr + inline_pos, src->u16 + 7, 2);
+            inline_pos += 2;
+            break;
+        default:
+            /* IPHC_SAC_SAM_L2: nothing carried inline */
+            break;
+    }
+    return inline_pos;
+}
+
+static uint16_t _iphc_dst_inline(uint8_t iphc2, const ipv6_addr_t *dst,
+                                 uint8_t *iphc_hdr, uint16_t inline_pos)
+{
+    switch (iphc2 & IPHC_M_DAC_DAM_MASK) {
+        case IPHC_M_DAC_DAM_U_64:
+        case IPHC_M_DAC_DAM_U_CTX_64:
+            memcpy(&(iphc_hdr[inline_pos]), &(dst->u8[8]), 8);
+            inline_pos += 8;
+            break;
+        case IPHC_M_DAC_DAM_U_16:
+        case IPHC_M_DAC_DAM_U_CTX_16:
+            memcpy(&(iphc_hdr[inline_pos]), &(dst->u16[7]), 2);
+            inline_pos += 2;
+            break;
+        case IPHC_M_DAC_DAM_U_L2:
+        case IPHC_M_DAC_DAM_U_CTX_L2:
+            break;
+        case IPHC_M_DAC_DAM_M_8:
+            iphc_hdr[inline_pos++] = dst->u8[15];
+            break;
+        case IPHC_M_DAC_DAM_M_32:
+            iphc_hdr[inline_pos++] = dst->u8[1];
+            memcpy(iphc_hdr + inline_pos, dst->u8 + 13, 3);
+            inline_pos += 3;
+            break;
+        case IPHC_M_DAC_DAM_M_48:
+            iphc_hdr[inline_pos++] = dst->u8[1];
+            memcpy(iphc_hdr + inline_pos, dst->u8 + 11, 5);
+            inline_pos += 5;
+            break;
+        case IPHC_M_DAC_DAM_M_UC_PREFIX:
+            iphc_hdr[inline_pos++] = dst->u8[1];
+            iphc_hdr[inline_pos++] = dst->u8[2];
+            memcpy(iphc_hdr + inline_pos, dst->u16 + 6, 4);
+            inline_pos += 4;
+            break;
+        default:
+            /* full destination address is carried inline */
+            memcpy(iphc_hdr + inline_pos, dst, 16);
+            inline_pos += 16;
+            break;
+    }
+    return inline_pos;
+}
+
+static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
+                                const gnrc_netif_hdr_t *netif_hdr,
+                                gnrc_netif_t *iface,
+                                uint8_t *iphc_hdr)
+{
+    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+    _addr_modes_t modes;
+
+    assert(iface != NULL);
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+    if (!_cache_get(ipv6_hdr, netif_hdr, &modes)) {
+        if (!_iphc_addr_modes(ipv6_hdr, netif_hdr, iface, &modes)) {
+            return 0;
         }
+        _cache_add(ipv6_hdr, netif_hdr, &modes);
+    }
+#else   /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) */
+    if (!_iphc_addr_modes(ipv6_hdr, netif_hdr, iface, &modes)) {
+        return 0;
     }
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) */
+
+    /* set initial dispatch value*/
+    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
+    iphc_hdr[IPHC2_IDX] = modes.iphc2;
 
-    if (!addr_comp) {
-        /* full destination address is carried inline */
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-        memcpy(iphc_hdr + inline_pos, &ipv6_hdr->dst, 16);
-        inline_pos += 16;
+    /* since this moves inline_pos we have to do this ahead*/
+    if (modes.iphc2 & SIXLOWPAN_IPHC2_CID_EXT) {
+        iphc_hdr[CID_EXT_IDX] = modes.cid_ext;
+
+        /* move position to behind CID extension */
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+
+    /* compress flow label and traffic class */
+    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
+        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
+            /* elide both traffic class and flow label */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
+        }
+        else {
+            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+        }
+    }
+    else {
+        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
+            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
+                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
+        }
+        else {
+            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
+        }
+
+        /* copy remaining bytes of flow label */
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
+        iphc_hdr[inline_pos++] = (uint8_t)(ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff);
+    }
+
+    /* check for compressible next header */
+    if (_compressible_nh(ipv6_hdr->nh)) {
+        iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
+    }
+    else {
+        iphc_hdr[inline_pos++] = ipv6_hdr->nh;
+    }
+
+    /* compress hop limit */
+    switch (ipv6_hdr->hl) {
+        case 1:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
+            break;
+
+        case 64:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
+            break;
+
+        case 255:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
+            break;
+
+        default:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
+            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
+            break;
     }
 
+    inline_pos = _iphc_src_inline(modes.iphc2, &ipv6_hdr->src, iphc_hdr,
+                                  inline_pos);
+    inline_pos = _iphc_dst_inline(modes.iphc2, &ipv6_hdr->dst, iphc_hdr,
+                                  inline_pos);
+
     return inline_pos;
 }
 
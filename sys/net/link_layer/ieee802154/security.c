@@ -26,9 +26,19 @@
 const ieee802154_radio_cipher_ops_t ieee802154_radio_cipher_ops = {
     .set_key = NULL,
     .ecb = NULL,
-    .cbc = NULL
+    .cbc = NULL,
+    .ccm_encrypt = NULL,
+    .ccm_decrypt = NULL
 };
 
+/**
+ * @brief   Number of blocks handed to the ECB and CBC operations at once
+ *
+ * Enough for most frames, so that the CBC-MAC and the key stream of a frame
+ * are each computed with one or two calls.
+ */
+#define SEC_BATCH_BLOCKS    (8U)
+
 static inline uint16_t _min(uint16_t a, uint16_t b)
 {
     return a < b ? a : b;
@@ -240,43 +250,40 @@ static uint8_t _set_aux_hdr(const ieee802154_sec_context_t *ctx,
 }
 
 /**
- * @brief   Construct the first block A0 for CTR
+ * @brief   Construct the 13 byte CCM* nonce
  */
-static inline void _init_ctr_A0(ieee802154_sec_ccm_block_t *A0,
-                                uint32_t frame_counter,
-                                uint8_t security_level,
-                                const uint8_t *src_address)
+static inline void _init_nonce(ieee802154_sec_ccm_nonce_t *nonce,
+                               uint32_t frame_counter,
+                               uint8_t security_level,
+                               const uint8_t *src_address)
 {
-    A0->flags = _ccm_flag(0, 2);
-    A0->nonce.frame_counter = htonl(frame_counter);
-    A0->nonce.security_level = security_level;
-    A0->counter = 0;
-    memcpy(A0->nonce.src_addr, src_address, IEEE802154_LONG_ADDRESS_LEN);
+    memcpy(nonce->src_addr, src_address, IEEE802154_LONG_ADDRESS_LEN);
+    nonce->frame_counter = htonl(frame_counter);
+    nonce->security_level = security_level;
 }
 
 /**
- * @brief   In CTR, the blocks Ai differ in a successive counter
+ * @brief   Construct the first block A0 for CTR
  */
-static inline void _advance_ctr_Ai(ieee802154_sec_ccm_block_t *Ai)
+static inline void _init_ctr_A0(ieee802154_sec_ccm_block_t *A0,
+                                const ieee802154_sec_ccm_nonce_t *nonce)
 {
-    Ai->counter = htons(ntohs(Ai->counter) + 1);
+    A0->flags = _ccm_flag(0, 2);
+    A0->nonce = *nonce;
+    A0->counter = 0;
 }
 
 /**
  * @brief   Construct the first block B0 for CBC-MAC
  */
 static inline void _init_cbc_B0(ieee802154_sec_ccm_block_t *B0,
-                                uint32_t frame_counter,
-                                uint8_t security_level,
+                                const ieee802154_sec_ccm_nonce_t *nonce,
                                 uint16_t m_len,
-                                uint8_t mic_size,
-                                const uint8_t *src_address)
+                                uint8_t mic_size)
 {
     B0->flags = _ccm_flag(mic_size, 2);
-    B0->nonce.frame_counter = htonl(frame_counter),
-    B0->nonce.security_level = security_level,
+    B0->nonce = *nonce;
     B0->counter = htons(m_len);
-    memcpy(B0->nonce.src_addr, src_address, IEEE802154_LONG_ADDRESS_LEN);
 }
 
 static const uint8_t *_get_encryption_key(const ieee802154_sec_context_t *ctx,
@@ -303,44 +310,74 @@ static const uint8_t *_get_decryption_key(const ieee802154_sec_context_t *ctx,
     return ctx->cipher.context.context;
 }
 
-/**
- * @brief   Perform ECB on one block of data and and add padding if necessary
- */
-static uint8_t _ecb(ieee802154_sec_context_t *ctx,
-                    uint8_t *tmp1, uint8_t *tmp2, uint8_t *data,
-                    const uint8_t *Ai, uint16_t size)
+static void _ecb(ieee802154_sec_context_t *ctx,
+                 uint8_t *cipher, const uint8_t *plain, uint8_t nblocks)
 {
-    uint16_t s = _min(IEEE802154_SEC_BLOCK_SIZE, size);
     if (ctx->dev.cipher_ops->ecb) {
-        ctx->dev.cipher_ops->ecb(&ctx->dev, tmp2, Ai, 1);
+        ctx->dev.cipher_ops->ecb(&ctx->dev, cipher, plain, nblocks);
     }
     else {
-        _sec_ecb(&ctx->dev, tmp2, Ai, 1);
+        _sec_ecb(&ctx->dev, cipher, plain, nblocks);
     }
-    memcpy(tmp1, data, s);
-    memset(tmp1 + s, 0, IEEE802154_SEC_BLOCK_SIZE - s);
-    _memxor(tmp1, tmp2, IEEE802154_SEC_BLOCK_SIZE);
-    memcpy(data, tmp1, s);
-    return s;
 }
 
 /**
- * @brief   Perform CBC on one block of data and add padding if necessary
+ * @brief   State of a CBC-MAC computation, which collects the input in
+ *          batches of blocks
  */
-static uint8_t _cbc_next(ieee802154_sec_context_t *ctx,
-                         uint8_t *last, uint8_t *tmp,
-                         const uint8_t *next, uint16_t size)
+typedef struct {
+    uint8_t buf[SEC_BATCH_BLOCKS * IEEE802154_SEC_BLOCK_SIZE];
+    uint8_t mic[IEEE802154_SEC_BLOCK_SIZE];
+    uint8_t len;
+} _cbc_mac_t;
+
+static void _cbc_mac_flush(ieee802154_sec_context_t *ctx, _cbc_mac_t *st)
 {
-    uint16_t s = _min(IEEE802154_SEC_BLOCK_SIZE, size);
-    memcpy(tmp, next, s);
-    memset(tmp + s, 0, IEEE802154_SEC_BLOCK_SIZE - s);
-    if (ctx->dev.cipher_ops->cbc){
-        ctx->dev.cipher_ops->cbc(&ctx->dev, last, last, tmp, 1);
+    uint8_t nblocks = st->len / IEEE802154_SEC_BLOCK_SIZE;
+
+    if (!nblocks) {
+        return;
+    }
+    if (ctx->dev.cipher_ops->cbc) {
+        ctx->dev.cipher_ops->cbc(&ctx->dev, st->buf, st->mic, st->buf, nblocks);
     }
     else {
-        _sec_cbc(&ctx->dev, last, last, tmp, 1);
+        _sec_cbc(&ctx->dev, st->buf, st->mic, st->buf, nblocks);
+    }
+    /* the last cipher block is the MIC so far, and the IV of the next batch */
+    memcpy(st->mic, &st->buf[st->len - IEEE802154_SEC_BLOCK_SIZE],
+           IEEE802154_SEC_BLOCK_SIZE);
+    st->len = 0;
+}
+
+static void _cbc_mac_update(ieee802154_sec_context_t *ctx, _cbc_mac_t *st,
+                            const void *data, uint16_t size)
+{
+    const uint8_t *in = data;
+
+    while (size) {
+        uint16_t s = _min(sizeof(st->buf) - st->len, size);
+        memcpy(&st->buf[st->len], in, s);
+        st->len += s;
+        in += s;
+        size -= s;
+        if (st->len == sizeof(st->buf)) {
+            _cbc_mac_flush(ctx, st);
+        }
+    }
+}
+
+/**
+ * @brief   Add zero padding up to the next block boundary
+ */
+static void _cbc_mac_pad(_cbc_mac_t *st)
+{
+    uint8_t rem = st->len % IEEE802154_SEC_BLOCK_SIZE;
+
+    if (rem) {
+        memset(&st->buf[st->len], 0, IEEE802154_SEC_BLOCK_SIZE - rem);
+        st->len += IEEE802154_SEC_BLOCK_SIZE - rem;
     }
-    return s;
 }
 
 static void _comp_mic(ieee802154_sec_context_t *ctx,
@@ -349,44 +386,110 @@ static void _comp_mic(ieee802154_sec_context_t *ctx,
                       const void *a, uint16_t a_len,
                       const void *m, uint16_t m_len)
 {
-    uint8_t tmp[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
-    uint16_t off;
-    memset(mic, 0, IEEE802154_SEC_MAX_MAC_SIZE);
-    _cbc_next(ctx, mic, tmp, (uint8_t *)B0, sizeof(*B0));
-    byteorder_htobebufs(tmp, a_len);
-    off = _min(sizeof(tmp) - sizeof(uint16_t), a_len);
-    memcpy(tmp + sizeof(uint16_t), a, off);
-    _cbc_next(ctx, mic, tmp, tmp, sizeof(uint16_t) + off);
-    for (;off < a_len;) {
-        off += _cbc_next(ctx, mic, tmp, &(((uint8_t *)a)[off]), a_len - off);
-    }
-    for (off = 0; off < m_len;) {
-        off += _cbc_next(ctx, mic, tmp, &(((uint8_t *)m)[off]), m_len - off);
-    }
+    _cbc_mac_t st = { .len = 0 };
+    uint8_t l_a[sizeof(uint16_t)];
+
+    memset(st.mic, 0, sizeof(st.mic));
+    _cbc_mac_update(ctx, &st, B0, sizeof(*B0));
+    byteorder_htobebufs(l_a, a_len);
+    _cbc_mac_update(ctx, &st, l_a, sizeof(l_a));
+    _cbc_mac_update(ctx, &st, a, a_len);
+    _cbc_mac_pad(&st);
+    _cbc_mac_update(ctx, &st, m, m_len);
+    _cbc_mac_pad(&st);
+    _cbc_mac_flush(ctx, &st);
+    memcpy(mic, st.mic, IEEE802154_SEC_MAX_MAC_SIZE);
 }
 
+/**
+ * @brief   En- or decrypt the MIC with the key stream block of A0 and the
+ *          payload with the blocks of A1, A2, ...
+ */
 static void _ctr(ieee802154_sec_context_t *ctx,
-                 ieee802154_sec_ccm_block_t *A0,
-                 const void *m, uint16_t m_len)
+                 const ieee802154_sec_ccm_nonce_t *nonce,
+                 uint8_t *mic, uint8_t mic_size,
+                 uint8_t *m, uint16_t m_len)
 {
-    uint8_t tmp1[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
-    uint8_t tmp2[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
+    uint8_t buf[SEC_BATCH_BLOCKS * IEEE802154_SEC_BLOCK_SIZE];
+    ieee802154_sec_ccm_block_t Ai;
+    uint16_t counter = mic_size ? 0 : 1;
+    uint16_t end = (m_len + IEEE802154_SEC_BLOCK_SIZE - 1) /
+                   IEEE802154_SEC_BLOCK_SIZE;
+
+    _init_ctr_A0(&Ai, nonce);
 
-    for (uint16_t off = 0; off < m_len;) {
-        _advance_ctr_Ai(A0);
-        off += _ecb(ctx, tmp1, tmp2,
-                    &(((uint8_t *)m)[off]), (uint8_t *)A0, m_len - off);
+    while (counter <= end) {
+        uint8_t nblocks = _min(SEC_BATCH_BLOCKS, end + 1 - counter);
+
+        for (uint8_t i = 0; i < nblocks; i++) {
+            Ai.counter = htons(counter + i);
+            memcpy(&buf[i * IEEE802154_SEC_BLOCK_SIZE], &Ai, sizeof(Ai));
+        }
+        _ecb(ctx, buf, buf, nblocks);
+
+        for (uint8_t i = 0; i < nblocks; i++, counter++) {
+            const uint8_t *s = &buf[i * IEEE802154_SEC_BLOCK_SIZE];
+
+            if (counter == 0) {
+                _memxor(mic, s, mic_size);
+            }
+            else {
+                uint16_t off = (counter - 1) * IEEE802154_SEC_BLOCK_SIZE;
+                _memxor(&m[off], s, _min(IEEE802154_SEC_BLOCK_SIZE,
+                                         m_len - off));
+            }
+        }
     }
 }
 
-static void _ctr_mic(ieee802154_sec_context_t *ctx,
-                     ieee802154_sec_ccm_block_t *A0,
-                     void *mic, uint8_t mic_size)
+/**
+ * @brief   Software CCM*, used if the device does not secure whole frames
+ */
+static int _ccm_encrypt(ieee802154_sec_context_t *ctx,
+                        const ieee802154_sec_ccm_nonce_t *nonce,
+                        uint8_t security_level,
+                        const uint8_t *a, uint16_t a_len,
+                        uint8_t *m, uint16_t m_len,
+                        uint8_t *mic, uint8_t mic_size)
 {
-    uint8_t tmp1[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
-    uint8_t tmp2[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
+    if (_req_mac(security_level)) {
+        ieee802154_sec_ccm_block_t B0;
+        uint8_t tmp_mic[IEEE802154_SEC_MAX_MAC_SIZE];
 
-    _ecb(ctx, tmp1, tmp2, mic, (uint8_t *)A0, mic_size);
+        _init_cbc_B0(&B0, nonce, m_len, mic_size);
+        _comp_mic(ctx, tmp_mic, &B0, a, a_len, m, m_len);
+        memcpy(mic, tmp_mic, mic_size);
+    }
+    /* encrypt MIC and payload */
+    if (!_req_encryption(security_level)) {
+        m_len = 0;
+    }
+    _ctr(ctx, nonce, mic, mic_size, m, m_len);
+    return IEEE802154_SEC_OK;
+}
+
+static int _ccm_decrypt(ieee802154_sec_context_t *ctx,
+                        const ieee802154_sec_ccm_nonce_t *nonce,
+                        uint8_t security_level,
+                        const uint8_t *a, uint16_t a_len,
+                        uint8_t *c, uint16_t c_len,
+                        uint8_t *mic, uint8_t mic_size)
+{
+    /* decrypt MIC and cipher */
+    _ctr(ctx, nonce, mic, mic_size,
+         c, _req_encryption(security_level) ? c_len : 0);
+    /* check MIC */
+    if (_req_mac(security_level)) {
+        ieee802154_sec_ccm_block_t B0;
+        uint8_t tmp_mic[IEEE802154_SEC_MAX_MAC_SIZE];
+
+        _init_cbc_B0(&B0, nonce, c_len, mic_size);
+        _comp_mic(ctx, tmp_mic, &B0, a, a_len, c, c_len);
+        if (memcmp(tmp_mic, mic, mic_size)) {
+            return -IEEE802154_SEC_MAC_CHECK_FAILURE;
+        }
+    }
+    return IEEE802154_SEC_OK;
 }
 
 void ieee802154_sec_init(ieee802154_sec_context_t *ctx)
@@ -444,21 +547,22 @@ int ieee802154_sec_encrypt_frame(ieee802154_sec_context_t *ctx,
     uint8_t *m = payload;
     uint16_t a_len = *header_size + aux_size;
     uint16_t m_len = payload_size;
-    ieee802154_sec_ccm_block_t ccm; /* Ai or Bi */
-
-    /* compute MIC */
-    if (_req_mac(ctx->security_level)) {
-        _init_cbc_B0(&ccm, ctx->frame_counter, ctx->security_level, m_len, *mic_size, src_address);
-        _comp_mic(ctx, mic, &ccm, a, a_len, m, m_len);
-
-        /* encrypt MIC */
-        _init_ctr_A0(&ccm, ctx->frame_counter, ctx->security_level, src_address);
-        _ctr_mic(ctx, &ccm, mic, *mic_size);
+    ieee802154_sec_ccm_nonce_t nonce;
+    int res = -IEEE802154_SEC_UNSUPORTED;
+
+    _init_nonce(&nonce, ctx->frame_counter, ctx->security_level, src_address);
+    if (ctx->dev.cipher_ops->ccm_encrypt) {
+        res = ctx->dev.cipher_ops->ccm_encrypt(&ctx->dev, (uint8_t *)&nonce,
+                                               ctx->security_level,
+                                               a, a_len, m, m_len,
+                                               mic, *mic_size);
+    }
+    if (res == -IEEE802154_SEC_UNSUPORTED) {
+        res = _ccm_encrypt(ctx, &nonce, ctx->security_level,
+                           a, a_len, m, m_len, mic, *mic_size);
     }
-    /* encrypt payload */
-    if (_req_encryption(ctx->security_level)) {
-        _init_ctr_A0(&ccm, ctx->frame_counter, ctx->security_level, src_address);
-        _ctr(ctx, &ccm, m, m_len);
+    if (res != IEEE802154_SEC_OK) {
+        return res;
     }
     *header_size += aux_size;
     ctx->frame_counter++;
@@ -510,7 +614,8 @@ int ieee802154_sec_decrypt_frame(ieee802154_sec_context_t *ctx,
     uint16_t a_len = *header_size + aux_size;
     uint16_t c_len = *payload_size;
     uint8_t *mac = *mic;
-    ieee802154_sec_ccm_block_t ccm; /* Ai or Bi */
+    ieee802154_sec_ccm_nonce_t nonce;
+    int res = -IEEE802154_SEC_UNSUPORTED;
 
     /* TODO:
        A better implementation would check if the received frame counter is
@@ -519,24 +624,19 @@ int ieee802154_sec_decrypt_frame(ieee802154_sec_context_t *ctx,
        But we do not store this information because we also do not have
        a proper key store, to avoid complexity on embedded devices. */
 
-    /* decrypt MIC */
-    if (mac_size) {
-        _init_ctr_A0(&ccm, frame_counter, security_level, src_address);
-        _ctr_mic(ctx, &ccm, mac, mac_size);
+    _init_nonce(&nonce, frame_counter, security_level, src_address);
+    if (ctx->dev.cipher_ops->ccm_decrypt) {
+        res = ctx->dev.cipher_ops->ccm_decrypt(&ctx->dev, (uint8_t *)&nonce,
+                                               security_level,
+                                               a, a_len, c, c_len,
+                                               mac, mac_size);
     }
-    /* decrypt cipher */
-    if (_req_encryption(security_level)) {
-        _init_ctr_A0(&ccm, frame_counter, security_level, src_address);
-        _ctr(ctx, &ccm, c, c_len);
+    if (res == -IEEE802154_SEC_UNSUPORTED) {
+        res = _ccm_decrypt(ctx, &nonce, security_level,
+                           a, a_len, c, c_len, mac, mac_size);
     }
-    /* check MIC */
-    if (_req_mac(security_level)) {
-        uint8_t tmp_mic[IEEE802154_SEC_MAX_MAC_SIZE];
-        _init_cbc_B0(&ccm, frame_counter, security_level, c_len, mac_size, src_address);
-        _comp_mic(ctx, tmp_mic, &ccm, a, a_len, c, c_len);
-        if (memcmp(tmp_mic, *mic, mac_size)) {
-            return -IEEE802154_SEC_MAC_CHECK_FAILURE;
-        }
+    if (res != IEEE802154_SEC_OK) {
+        return res;
     }
     *header_size += aux_size;
     return IEEE802154_SEC_OK;
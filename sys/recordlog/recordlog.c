@@ -0,0 +1,566 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_recordlog
+ * @{
+ *
+ * @file
+ * @brief       Record log implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "recordlog.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define MIN(a, b) ((a) > (b) ? (b) : (a))
+
+#define ALIGN_UP(x)     (((x) + RECORDLOG_ALIGN - 1) & ~(RECORDLOG_ALIGN - 1))
+#define ERASED_LEN      (0xffffU)
+#define CHUNK_SIZE      (32U)
+
+/* record header as stored on the device, followed by the payload */
+typedef struct {
+    uint16_t len;               /* payload size, ERASED_LEN if erased */
+    uint16_t crc;               /* CRC over seq, len and payload */
+    uint32_t seq;               /* sequence number */
+} _hdr_t;
+
+static_assert(sizeof(_hdr_t) == RECORDLOG_HDR_SIZE, "wrong header size");
+static_assert((RECORDLOG_ALIGN & (RECORDLOG_ALIGN - 1)) == 0,
+              "RECORDLOG_ALIGN must be a power of two");
+
+static inline bool _seq_before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+static inline uint32_t _first_page(const recordlog_t *log, uint32_t sector)
+{
+    return sector * log->mtd->pages_per_sector;
+}
+
+/* offset of the buffered page in the current sector */
+static inline uint32_t _buf_start(const recordlog_t *log)
+{
+    return log->pos - (log->pos % log->mtd->page_size);
+}
+
+static inline uint32_t _record_size(const _hdr_t *hdr)
+{
+    return ALIGN_UP(RECORDLOG_HDR_SIZE + hdr->len);
+}
+
+static uint16_t _crc_hdr(const _hdr_t *hdr)
+{
+    uint16_t crc = crc16_ccitt_calc((const void *)&hdr->seq, sizeof(hdr->seq));
+
+    return crc16_ccitt_update(crc, (const void *)&hdr->len, sizeof(hdr->len));
+}
+
+static bool _is_erased(const void *buf, size_t len)
+{
+    const uint8_t *b = buf;
+
+    for (size_t i = 0; i < len; i++) {
+        if (b[i] != 0xff) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* reads from the device as the log sees it, i.e. including the buffer */
+static int _read(const recordlog_t *log, uint32_t sector, uint32_t off,
+                 void *dest, uint32_t len)
+{
+    uint8_t *dst = dest;
+    uint32_t n;
+    int res;
+
+    if (sector == log->sector) {
+        const uint32_t start = _buf_start(log);
+
+        if (off < start) {
+            n = MIN(len, start - off);
+            res = mtd_read_page(log->mtd, dst, _first_page(log, sector), off, n);
+            if (res < 0) {
+                return res;
+            }
+            dst += n;
+            off += n;
+            len -= n;
+        }
+        if ((len > 0) && (off < start + log->mtd->page_size)) {
+            n = MIN(len, start + log->mtd->page_size - off);
+            memcpy(dst, &log->page_buf[off - start], n);
+            dst += n;
+            off += n;
+            len -= n;
+        }
+    }
+    if (len == 0) {
+        return 0;
+    }
+
+    res = mtd_read_page(log->mtd, dst, _first_page(log, sector), off, len);
+    return (res < 0) ? res : 0;
+}
+
+/* returns 1 if a record that fits into the sector starts at @p off */
+static int _read_hdr(const recordlog_t *log, uint32_t sector, uint32_t off,
+                     _hdr_t *hdr)
+{
+    if (off + RECORDLOG_HDR_SIZE > log->sector_size) {
+        return 0;
+    }
+
+    int res = _read(log, sector, off, hdr, sizeof(*hdr));
+    if (res < 0) {
+        return res;
+    }
+
+    return (hdr->len != ERASED_LEN) &&
+           (off + RECORDLOG_HDR_SIZE + hdr->len <= log->sector_size);
+}
+
+/* returns 1 if the payload of the record at @p off matches its CRC */
+static int _check(const recordlog_t *log, uint32_t sector, uint32_t off,
+                  const _hdr_t *hdr)
+{
+    uint8_t chunk[CHUNK_SIZE];
+    uint16_t crc = _crc_hdr(hdr);
+
+    off += RECORDLOG_HDR_SIZE;
+    for (uint32_t done = 0; done < hdr->len;) {
+        uint32_t n = MIN(sizeof(chunk), hdr->len - done);
+        int res = _read(log, sector, off + done, chunk, n);
+
+        if (res < 0) {
+            return res;
+        }
+        crc = crc16_ccitt_update(crc, chunk, n);
+        done += n;
+    }
+
+    return crc == hdr->crc;
+}
+
+/* returns 1 if a valid record starts at @p off */
+static int _read_record(const recordlog_t *log, uint32_t sector, uint32_t off,
+                        _hdr_t *hdr)
+{
+    int res = _read_hdr(log, sector, off, hdr);
+
+    return (res > 0) ? _check(log, sector, off, hdr) : res;
+}
+
+/* returns 1 if @p sector is erased from @p off on, uses the page buffer */
+static int _erased_from(recordlog_t *log, uint32_t sector, uint32_t off)
+{
+    const uint32_t page_size = log->mtd->page_size;
+
+    while (off < log->sector_size) {
+        uint32_t n = MIN(page_size - (off % page_size), log->sector_size - off);
+        int res = mtd_read_page(log->mtd, log->page_buf,
+                                _first_page(log, sector), off, n);
+
+        if (res < 0) {
+            return res;
+        }
+        if (!_is_erased(log->page_buf, n)) {
+            return 0;
+        }
+        off += n;
+    }
+    return 1;
+}
+
+/* programs the bytes of the buffered page at @p start up to @p fill */
+static int _program(recordlog_t *log, uint32_t start, uint32_t fill)
+{
+    if (fill == log->flushed) {
+        return 0;
+    }
+
+    int res = mtd_write_page_raw(log->mtd, &log->page_buf[log->flushed],
+                                 _first_page(log, log->sector)
+                                 + start / log->mtd->page_size,
+                                 log->flushed, fill - log->flushed);
+    if (res < 0) {
+        return res;
+    }
+    log->flushed = fill;
+    return 0;
+}
+
+/* makes @p sector the current sector, erases it if it is not empty */
+static int _enter(recordlog_t *log, uint32_t sector)
+{
+    int res = _erased_from(log, sector, 0);
+
+    if (res == 0) {
+        DEBUG("recordlog: erase sector %" PRIu32 "\n", sector);
+        res = mtd_erase_sector(log->mtd, sector, 1);
+    }
+    if (res < 0) {
+        return res;
+    }
+
+    memset(log->page_buf, 0xff, log->mtd->page_size);
+    log->sector = sector;
+    log->pos = 0;
+    log->flushed = 0;
+    return 0;
+}
+
+/* continues the log in the next sector, the current one is kept as it is */
+static void _abandon(recordlog_t *log)
+{
+    log->pos = log->sector_size;
+    log->flushed = 0;
+}
+
+static int _next_sector(recordlog_t *log)
+{
+    const uint32_t count = log->mtd->sector_count;
+    const uint32_t next = (log->sector + 1) % count;
+    int res = _program(log, _buf_start(log), log->pos - _buf_start(log));
+
+    if (res < 0) {
+        return res;
+    }
+
+    if (next == log->first_sector) {
+        /* the oldest records are dropped, find the ones after them */
+        log->first_sector = next;
+        log->first_seq = log->next_seq;
+        for (uint32_t s = (next + 1) % count; s != next; s = (s + 1) % count) {
+            _hdr_t hdr;
+
+            res = _read_record(log, s, 0, &hdr);
+            if (res < 0) {
+                return res;
+            }
+            if (res) {
+                log->first_sector = s;
+                log->first_seq = hdr.seq;
+                break;
+            }
+            if (s == log->sector) {
+                break;
+            }
+        }
+    }
+
+    res = _enter(log, next);
+    if (res < 0) {
+        _abandon(log);
+    }
+    return res;
+}
+
+/* copies @p len bytes of @p src to the log, NULL for padding */
+static int _put(recordlog_t *log, const void *src, uint32_t len)
+{
+    const uint32_t page_size = log->mtd->page_size;
+    const uint8_t *s = src;
+
+    while (len > 0) {
+        const uint32_t start = _buf_start(log);
+        const uint32_t fill = log->pos - start;
+        const uint32_t n = MIN(len, page_size - fill);
+
+        if (s != NULL) {
+            memcpy(&log->page_buf[fill], s, n);
+            s += n;
+        }
+        if (fill + n == page_size) {
+            int res = _program(log, start, page_size);
+            if (res < 0) {
+                _abandon(log);
+                return res;
+            }
+            memset(log->page_buf, 0xff, page_size);
+            log->flushed = 0;
+        }
+        log->pos += n;
+        len -= n;
+    }
+    return 0;
+}
+
+int recordlog_init(recordlog_t *log, mtd_dev_t *mtd, void *page_buf)
+{
+    int res = mtd_init(mtd);
+
+    if (res < 0) {
+        return res;
+    }
+    if ((mtd->sector_count < 2) ||
+        (mtd->page_size % RECORDLOG_ALIGN)) {
+        return -EINVAL;
+    }
+
+    mutex_init(&log->lock);
+    log->mtd = mtd;
+    log->page_buf = page_buf;
+    log->sector_size = mtd->pages_per_sector * mtd->page_size;
+    /* nothing is buffered yet */
+    log->sector = UINT32_MAX;
+
+    /* the first records of the sectors tell where the log starts and ends */
+    bool found = false;
+    uint32_t newest = 0;
+    uint32_t newest_seq = 0;
+
+    for (uint32_t s = 0; s < mtd->sector_count; s++) {
+        _hdr_t hdr;
+
+        res = _read_record(log, s, 0, &hdr);
+        if (res < 0) {
+            return res;
+        }
+        if (res == 0) {
+            continue;
+        }
+        if (!found || _seq_before(newest_seq, hdr.seq)) {
+            newest = s;
+            newest_seq = hdr.seq;
+        }
+        if (!found || _seq_before(hdr.seq, log->first_seq)) {
+            log->first_sector = s;
+            log->first_seq = hdr.seq;
+        }
+        found = true;
+    }
+
+    if (!found) {
+        DEBUG("recordlog: no records found\n");
+        log->first_sector = 0;
+        log->first_seq = 0;
+        log->next_seq = 0;
+        return _enter(log, 0);
+    }
+
+    /* the records of the newest sector tell where the log ends */
+    uint32_t pos = 0;
+    uint32_t seq = newest_seq;
+
+    while (pos < log->sector_size) {
+        _hdr_t hdr;
+
+        res = _read_record(log, newest, pos, &hdr);
+        if (res < 0) {
+            return res;
+        }
+        if (res == 0) {
+            break;
+        }
+        seq = hdr.seq + 1;
+        pos += _record_size(&hdr);
+    }
+    log->next_seq = seq;
+
+    /* anything but erased flash after the end is a torn record */
+    res = _erased_from(log, newest, pos);
+    if (res < 0) {
+        return res;
+    }
+
+    log->sector = newest;
+    log->pos = pos;
+    log->flushed = 0;
+    if (res == 0) {
+        DEBUG("recordlog: torn record in sector %" PRIu32 " at %" PRIu32 "\n",
+              newest, pos);
+        _abandon(log);
+        return 0;
+    }
+
+    /* continue the partly programmed page */
+    memset(log->page_buf, 0xff, mtd->page_size);
+    log->flushed = pos - _buf_start(log);
+    if (log->flushed > 0) {
+        res = mtd_read_page(mtd, log->page_buf, _first_page(log, newest),
+                            _buf_start(log), log->flushed);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    DEBUG("recordlog: sectors %" PRIu32 "-%" PRIu32 ", next seq %" PRIu32 "\n",
+          log->first_sector, newest, log->next_seq);
+    return 0;
+}
+
+int recordlog_erase(recordlog_t *log)
+{
+    mutex_lock(&log->lock);
+    int res = mtd_erase_sector(log->mtd, 0, log->mtd->sector_count);
+
+    if (res == 0) {
+        memset(log->page_buf, 0xff, log->mtd->page_size);
+        log->sector = 0;
+        log->pos = 0;
+        log->flushed = 0;
+    }
+    else {
+        /* force an erase check before the next record */
+        log->sector = log->mtd->sector_count - 1;
+        _abandon(log);
+    }
+    /* keep counting, so running iterations notice */
+    log->first_sector = 0;
+    log->first_seq = log->next_seq;
+    mutex_unlock(&log->lock);
+
+    return res;
+}
+
+int recordlog_append(recordlog_t *log, const void *data, size_t len,
+                     uint32_t *seq)
+{
+    _hdr_t hdr = {
+        .len = len,
+    };
+    const uint32_t size = _record_size(&hdr);
+    int res = 0;
+
+    if ((len >= ERASED_LEN) || (size > log->sector_size)) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&log->lock);
+    if (log->pos + size > log->sector_size) {
+        res = _next_sector(log);
+        if (res < 0) {
+            goto out;
+        }
+    }
+
+    hdr.seq = log->next_seq;
+    hdr.crc = crc16_ccitt_update(_crc_hdr(&hdr), data, len);
+
+    if (((res = _put(log, &hdr, sizeof(hdr))) < 0) ||
+        ((res = _put(log, data, len)) < 0) ||
+        ((res = _put(log, NULL, size - sizeof(hdr) - len)) < 0)) {
+        goto out;
+    }
+
+    if (seq) {
+        *seq = log->next_seq;
+    }
+    log->next_seq++;
+
+out:
+    mutex_unlock(&log->lock);
+    return res;
+}
+
+int recordlog_flush(recordlog_t *log)
+{
+    mutex_lock(&log->lock);
+    int res = _program(log, _buf_start(log), log->pos - _buf_start(log));
+    if (res < 0) {
+        _abandon(log);
+    }
+    mutex_unlock(&log->lock);
+
+    return res;
+}
+
+void recordlog_iter_init(recordlog_t *log, recordlog_iter_t *iter)
+{
+    mutex_lock(&log->lock);
+    iter->sector = log->first_sector;
+    iter->pos = 0;
+    iter->seq = log->first_seq;
+    mutex_unlock(&log->lock);
+}
+
+ssize_t recordlog_iter_next(recordlog_t *log, recordlog_iter_t *iter,
+                            void *buf, size_t len, uint32_t *seq)
+{
+    ssize_t res = 0;
+    uint32_t sectors = 0;
+
+    mutex_lock(&log->lock);
+    while (_seq_before(iter->seq, log->next_seq)) {
+        _hdr_t hdr;
+        int valid;
+
+        if (_seq_before(iter->seq, log->first_seq)) {
+            /* the sector of the next record was reused */
+            iter->sector = log->first_sector;
+            iter->pos = 0;
+            iter->seq = log->first_seq;
+            continue;
+        }
+
+        valid = _read_hdr(log, iter->sector, iter->pos, &hdr);
+        if (valid > 0) {
+            if (hdr.len <= len) {
+                valid = _read(log, iter->sector, iter->pos + sizeof(hdr),
+                              buf, hdr.len);
+                if (valid == 0) {
+                    valid = crc16_ccitt_update(_crc_hdr(&hdr), buf, hdr.len)
+                            == hdr.crc;
+                }
+            }
+            else {
+                valid = _check(log, iter->sector, iter->pos, &hdr);
+            }
+        }
+        if (valid < 0) {
+            res = valid;
+            break;
+        }
+
+        if (!valid) {
+            /* end of the sector or a torn record */
+            if ((iter->sector == log->sector) ||
+                (++sectors >= log->mtd->sector_count)) {
+                res = -EIO;
+                break;
+            }
+            iter->sector = (iter->sector + 1) % log->mtd->sector_count;
+            iter->pos = 0;
+            continue;
+        }
+
+        if (_seq_before(hdr.seq, iter->seq)) {
+            iter->pos += _record_size(&hdr);
+            continue;
+        }
+        if (hdr.len > len) {
+            res = -ENOBUFS;
+            break;
+        }
+
+        if (seq) {
+            *seq = hdr.seq;
+        }
+        iter->pos += _record_size(&hdr);
+        iter->seq = hdr.seq + 1;
+        res = hdr.len;
+        break;
+    }
+    mutex_unlock(&log->lock);
+
+    return res;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_riotboot_flashwrite
+ * @{
+ *
+ * @file
+ * @brief       Firmware update sha256 verification against the digest
+ *              computed while writing
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "log.h"
+#include "riotboot/flashwrite.h"
+
+int riotboot_flashwrite_streamed_sha256_check(
+    const riotboot_flashwrite_t *state, const uint8_t *sha256_digest,
+    size_t img_len)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+
+    if (img_len != state->offset) {
+        LOG_INFO("riotboot: streamed_sha256_check(): image size mismatch "
+                 "(%u != %u)\n", (unsigned)img_len, (unsigned)state->offset);
+        return -1;
+    }
+
+    /* finalize a copy, so the update can go on */
+    sha256_context_t sha256 = state->sha256;
+
+    sha256_final(&sha256, digest);
+
+    return memcmp(sha256_digest, digest, SHA256_DIGEST_LENGTH) != 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the MTD block cache statistics
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mtd_bcache.h"
+
+static void _print(unsigned idx, const mtd_bcache_t *cache)
+{
+    const mtd_bcache_stats_t *stats = &cache->stats;
+    uint32_t total = stats->hits + stats->misses;
+
+    printf("bcache%u (mtd %p):\n", idx, (void *)cache->parent);
+    printf("  %" PRIu32 " hits, %" PRIu32 " misses (%u %% hit rate), "
+           "%" PRIu32 " blocks bypassed\n",
+           stats->hits, stats->misses,
+           total ? (unsigned)((uint64_t)stats->hits * 100 / total) : 0,
+           stats->bypassed);
+    printf("  %" PRIu32 " blocks read ahead, %" PRIu32 " used, "
+           "%" PRIu32 " evictions, %" PRIu32 " device reads\n",
+           stats->readahead, stats->readahead_hits, stats->evictions,
+           stats->parent_reads);
+}
+
+int _mtd_bcache_handler(int argc, char **argv)
+{
+    const bool reset = (argc == 2);
+    unsigned idx = 0;
+
+    if ((argc > 2) || (reset && strcmp(argv[1], "reset"))) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+
+    for (mtd_bcache_t *cache = mtd_bcache_get_first(); cache != NULL;
+         cache = cache->next) {
+        if (reset) {
+            memset(&cache->stats, 0, sizeof(cache->stats));
+        }
+        else {
+            _print(idx++, cache);
+        }
+    }
+    if (!reset && (idx == 0)) {
+        puts("no block cache initialized");
+    }
+    return 0;
+}
@@ -413,6 +413,14 @@ static int _validate_payload(suit_component_t *component, const uint8_t *digest,
     uint8_t payload_digest[SHA256_DIGEST_LENGTH];
     suit_storage_t *storage = component->storage_backend;
 
+    if (suit_storage_has_verify_sha256(storage)) {
+        /* Digest computed while writing */
+        int res = suit_storage_verify_sha256(storage, digest, payload_size);
+        if (res != SUIT_ERR_NOT_SUPPORTED) {
+            return res;
+        }
+    }
+
     if (suit_storage_has_readptr(storage)) {
         /* Direct read possible */
         const uint8_t *payload = NULL;
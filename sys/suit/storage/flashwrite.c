@@ -34,6 +34,109 @@ static inline suit_storage_flashwrite_t *_get_fw(suit_storage_t *storage)
     return container_of(storage, suit_storage_flashwrite_t, storage);
 }
 
+#if IS_USED(MODULE_SUIT_STORAGE_FLASHWRITE_ASYNC)
+static char _stack[SUIT_STORAGE_FLASHWRITE_STACKSIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
+static void *_writer_thread(void *arg)
+{
+    suit_storage_flashwrite_t *fw = arg;
+
+    while (1) {
+        mutex_lock(&fw->pending);
+        /* the buffer not being filled is to be programmed */
+        if (!fw->error &&
+            riotboot_flashwrite_putbytes(&fw->writer, fw->buf[!fw->fill],
+                                         fw->write_len, true) < 0) {
+            fw->error = SUIT_ERR_STORAGE;
+        }
+        mutex_unlock(&fw->idle);
+    }
+
+    return NULL;
+}
+
+static int _wait_idle(suit_storage_flashwrite_t *fw)
+{
+    mutex_lock(&fw->idle);
+    mutex_unlock(&fw->idle);
+    return fw->error;
+}
+
+static int _submit(suit_storage_flashwrite_t *fw)
+{
+    /* wait until the other buffer is programmed, then swap the buffers */
+    mutex_lock(&fw->idle);
+    if (fw->error) {
+        mutex_unlock(&fw->idle);
+        return fw->error;
+    }
+    fw->write_len = fw->fill_len;
+    fw->fill = !fw->fill;
+    fw->fill_len = 0;
+    mutex_unlock(&fw->pending);
+    return SUIT_OK;
+}
+
+static int _putbytes(suit_storage_flashwrite_t *fw, const uint8_t *buf,
+                     size_t offset, size_t len)
+{
+    if (offset != fw->offset) {
+        LOG_ERROR("Unexpected offset: %u - expected: %u\n", (unsigned)offset,
+                  (unsigned)fw->offset);
+        return SUIT_ERR_STORAGE;
+    }
+    fw->offset += len;
+
+    while (len) {
+        size_t avail = CONFIG_SUIT_STORAGE_FLASHWRITE_BUF_SIZE - fw->fill_len;
+        size_t to_copy = len < avail ? len : avail;
+
+        memcpy(&fw->buf[fw->fill][fw->fill_len], buf, to_copy);
+        fw->fill_len += to_copy;
+        buf += to_copy;
+        len -= to_copy;
+
+        if (fw->fill_len == CONFIG_SUIT_STORAGE_FLASHWRITE_BUF_SIZE) {
+            int res = _submit(fw);
+            if (res < 0) {
+                return res;
+            }
+        }
+    }
+
+    return SUIT_OK;
+}
+
+static int _flush(suit_storage_flashwrite_t *fw)
+{
+    if (fw->fill_len && _submit(fw) < 0) {
+        return SUIT_ERR_STORAGE;
+    }
+    if (_wait_idle(fw) < 0) {
+        return SUIT_ERR_STORAGE;
+    }
+    return riotboot_flashwrite_flush(&fw->writer);
+}
+#else
+static int _putbytes(suit_storage_flashwrite_t *fw, const uint8_t *buf,
+                     size_t offset, size_t len)
+{
+    if (offset != fw->writer.offset) {
+        LOG_ERROR("Unexpected offset: %u - expected: %u\n", (unsigned)offset,
+                  (unsigned)fw->writer.offset);
+        return SUIT_ERR_STORAGE;
+    }
+
+    return riotboot_flashwrite_putbytes(&fw->writer, buf, len, 1);
+}
+
+static int _flush(suit_storage_flashwrite_t *fw)
+{
+    return riotboot_flashwrite_flush(&fw->writer);
+}
+#endif /* MODULE_SUIT_STORAGE_FLASHWRITE_ASYNC */
+
 static int _flashwrite_init(suit_storage_t *storage)
 {
     (void)storage;
@@ -52,6 +155,20 @@ static int _flashwrite_start(suit_storage_t *storage,
     suit_storage_flashwrite_t *fw = _get_fw(storage);
     int target_slot = riotboot_slot_other();
 
+#if IS_USED(MODULE_SUIT_STORAGE_FLASHWRITE_ASYNC)
+    if (_pid == KERNEL_PID_UNDEF) {
+        _pid = thread_create(_stack, sizeof(_stack),
+                             SUIT_STORAGE_FLASHWRITE_PRIO,
+                             THREAD_CREATE_STACKTEST, _writer_thread, fw,
+                             "suit_flashwrite");
+    }
+    /* an aborted update might still be programmed */
+    _wait_idle(fw);
+    fw->fill_len = 0;
+    fw->offset = RIOTBOOT_FLASHWRITE_SKIPLEN;
+    fw->error = 0;
+#endif
+
     return riotboot_flashwrite_init(&fw->writer, target_slot);
 }
 
@@ -72,13 +189,7 @@ static int _flashwrite_write(suit_storage_t *storage,
         len -= RIOTBOOT_FLASHWRITE_SKIPLEN;
     }
 
-    if (offset != fw->writer.offset) {
-        LOG_ERROR("Unexpected offset: %u - expected: %u\n", (unsigned)offset,
-                  (unsigned)fw->writer.offset);
-        return SUIT_ERR_STORAGE;
-    }
-
-    return riotboot_flashwrite_putbytes(&fw->writer, buf, len, 1);
+    return _putbytes(fw, buf, offset, len);
 }
 
 static int _flashwrite_finish(suit_storage_t *storage,
@@ -87,8 +198,7 @@ static int _flashwrite_finish(suit_storage_t *storage,
     (void)manifest;
     suit_storage_flashwrite_t *fw = _get_fw(storage);
 
-    return riotboot_flashwrite_flush(&fw->writer) <
-           0 ? SUIT_ERR_STORAGE : SUIT_OK;
+    return _flush(fw) < 0 ? SUIT_ERR_STORAGE : SUIT_OK;
 }
 
 static int _flashwrite_install(suit_storage_t *storage,
@@ -151,6 +261,23 @@ static int _flashwrite_read(suit_storage_t *storage, uint8_t *buf,
     return 0;
 }
 
+static int _flashwrite_verify_sha256(suit_storage_t *storage,
+                                     const uint8_t *digest, size_t len)
+{
+    suit_storage_flashwrite_t *fw = _get_fw(storage);
+
+    switch (riotboot_flashwrite_streamed_sha256_check(&fw->writer, digest,
+                                                      len)) {
+    case 0:
+        return SUIT_OK;
+    case 1:
+        return SUIT_ERR_DIGEST_MISMATCH;
+    default:
+        /* not all of the payload passed through the writer */
+        return SUIT_ERR_NOT_SUPPORTED;
+    }
+}
+
 static bool _flashwrite_has_location(const suit_storage_t *storage,
                                      const char *location)
 {
@@ -225,6 +352,7 @@ static const suit_storage_driver_t suit_storage_flashwrite_driver = {
     .write = _flashwrite_write,
     .finish = _flashwrite_finish,
     .read = _flashwrite_read,
+    .verify_sha256 = _flashwrite_verify_sha256,
     .install = _flashwrite_install,
     .has_location = _flashwrite_has_location,
     .set_active_location = _flashwrite_set_active_location,
@@ -238,4 +366,8 @@ suit_storage_flashwrite_t suit_storage_flashwrite = {
     .storage = {
         .driver = &suit_storage_flashwrite_driver,
     },
+#if IS_USED(MODULE_SUIT_STORAGE_FLASHWRITE_ASYNC)
+    .pending = MUTEX_INIT_LOCKED,
+    .idle = MUTEX_INIT,
+#endif
 };
@@ -24,6 +24,9 @@
 #include <unistd.h> /* for STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO */
 
 #include "vfs.h"
+#include "atomic_utils.h"
+#include "bitarithm.h"
+#include "irq.h"
 #include "mutex.h"
 #include "thread.h"
 #include "sched.h"
@@ -51,6 +54,15 @@
  */
 static vfs_file_t _vfs_open_files[VFS_MAX_OPEN_FILES];
 
+/**
+ * @internal
+ * @brief Bitmap of the used entries in _vfs_open_files
+ *
+ * Entries are claimed with atomic_fetch_or_u32(), so allocating and freeing a
+ * file descriptor needs no lock.
+ */
+static uint32_t _vfs_fd_used[(VFS_MAX_OPEN_FILES + 31) / 32];
+
 /**
  * @internal
  * @brief List handle for list of all currently mounted file systems
@@ -60,6 +72,45 @@ static vfs_file_t _vfs_open_files[VFS_MAX_OPEN_FILES];
  */
 static clist_node_t _vfs_mounts_list;
 
+/**
+ * @internal
+ * @brief Entry of the mount point lookup table
+ */
+typedef struct {
+    vfs_mount_t *mountp;        /**< the mount */
+    uint32_t hash;              /**< hash of the mount point */
+    size_t len;                 /**< length of the mount point */
+} _mount_lookup_entry_t;
+
+/**
+ * @internal
+ * @brief Snapshot of the mount points, longest first
+ */
+typedef struct {
+    _mount_lookup_entry_t entries[VFS_MOUNT_LOOKUP_SIZE];   /**< the mounts */
+    unsigned num;               /**< number of used entries */
+    /**
+     * @brief length of the longest mount point that did not fit into the
+     *        table, 0 if all mounts are in the table
+     */
+    size_t uncached_len;
+} _mount_lookup_t;
+
+/**
+ * @internal
+ * @brief Read-mostly mount point lookup tables
+ *
+ * Path lookups search `_mount_lookup[_mount_lookup_gen & 1]` without taking
+ * _mount_mutex. (Un)mounting prepares the other table and swaps the two by
+ * incrementing _mount_lookup_gen. The tables only hold static data, so a
+ * lookup racing with an update never dereferences a stale mount. Before a
+ * found mount is used, it is checked with interrupts disabled that the
+ * generation did not change, and its open_files counter is incremented, which
+ * keeps vfs_umount() from removing it.
+ */
+static _mount_lookup_t _mount_lookup[2];
+static uint32_t _mount_lookup_gen;
+
 /**
  * @internal
  * @brief Find an unused entry in the _vfs_open_files array and mark it as used
@@ -119,6 +170,28 @@ static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *moun
  */
 static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const char **rel_path);
 
+/**
+ * @internal
+ * @brief Build the next mount point lookup table from _vfs_mounts_list
+ *
+ * Must be called with _mount_mutex locked. The table is used by lookups
+ * after _mount_lookup_publish().
+ *
+ * @param[in]  exclude      mount not to include in the table, may be NULL
+ */
+static void _mount_lookup_prepare(const vfs_mount_t *exclude);
+
+/**
+ * @internal
+ * @brief Make the table built by _mount_lookup_prepare() the current one
+ *
+ * Must be called with _mount_mutex locked and interrupts disabled.
+ */
+static inline void _mount_lookup_publish(void)
+{
+    _mount_lookup_gen++;
+}
+
 /**
  * @internal
  * @brief Check that a given fd number is valid
@@ -131,7 +204,6 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
 static inline int _fd_is_valid(int fd);
 
 static mutex_t _mount_mutex = MUTEX_INIT;
-static mutex_t _open_mutex = MUTEX_INIT;
 
 int vfs_close(int fd)
 {
@@ -265,9 +337,7 @@ int vfs_open(const char *name, int flags, mode_t mode)
         DEBUG("vfs_open: no matching mount\n");
         return res;
     }
-    mutex_lock(&_open_mutex);
     int fd = _init_fd(VFS_ANY_FD, mountp->fs->f_op, mountp, flags, NULL);
-    mutex_unlock(&_open_mutex);
     if (fd < 0) {
         DEBUG("vfs_open: _init_fd: ERR %d!\n", fd);
         /* remember to decrement the open_files count */
@@ -334,6 +404,144 @@ ssize_t vfs_write(int fd, const void *src, size_t count)
     return filp->f_op->write(filp, src, count);
 }
 
+/* all buffers with data must be valid */
+static int _iolist_check(const iolist_t *iolist)
+{
+    for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+        if ((iol->iol_len != 0) && (iol->iol_base == NULL)) {
+            return -EFAULT;
+        }
+    }
+    return 0;
+}
+
+ssize_t vfs_readv(int fd, const iolist_t *iolist)
+{
+    DEBUG("vfs_readv: %d, %p\n", fd, (void *)iolist);
+    int res = _iolist_check(iolist);
+    if (res < 0) {
+        return res;
+    }
+    res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (((filp->flags & O_ACCMODE) != O_RDONLY) & ((filp->flags & O_ACCMODE) != O_RDWR)) {
+        /* File not open for reading */
+        return -EBADF;
+    }
+    if (filp->f_op->readv != NULL) {
+        return filp->f_op->readv(filp, iolist);
+    }
+    if (filp->f_op->read == NULL) {
+        /* driver does not implement read() */
+        return -EINVAL;
+    }
+    ssize_t total = 0;
+    for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+        if (iol->iol_len == 0) {
+            continue;
+        }
+        ssize_t len = filp->f_op->read(filp, iol->iol_base, iol->iol_len);
+        if (len < 0) {
+            /* report the data already read, the error shows up again on
+             * the next call */
+            return (total > 0) ? total : len;
+        }
+        total += len;
+        if ((size_t)len < iol->iol_len) {
+            /* end of file */
+            break;
+        }
+    }
+    return total;
+}
+
+ssize_t vfs_writev(int fd, const iolist_t *iolist)
+{
+    DEBUG_NOT_STDOUT(fd, "vfs_writev: %d, %p\n", fd, (void *)iolist);
+    int res = _iolist_check(iolist);
+    if (res < 0) {
+        return res;
+    }
+    res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (((filp->flags & O_ACCMODE) != O_WRONLY) & ((filp->flags & O_ACCMODE) != O_RDWR)) {
+        /* File not open for writing */
+        return -EBADF;
+    }
+    if (filp->f_op->writev != NULL) {
+        return filp->f_op->writev(filp, iolist);
+    }
+    if (filp->f_op->write == NULL) {
+        /* driver does not implement write() */
+        return -EINVAL;
+    }
+    ssize_t total = 0;
+    for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+        if (iol->iol_len == 0) {
+            continue;
+        }
+        ssize_t len = filp->f_op->write(filp, iol->iol_base, iol->iol_len);
+        if (len < 0) {
+            return (total > 0) ? total : len;
+        }
+        total += len;
+        if ((size_t)len < iol->iol_len) {
+            /* e.g. file system full */
+            break;
+        }
+    }
+    return total;
+}
+
+ssize_t vfs_sendfile(int fd, size_t count, void *buf, size_t buf_len,
+                     vfs_sendfile_cb_t cb, void *arg)
+{
+    DEBUG("vfs_sendfile: %d, %lu\n", fd, (unsigned long)count);
+    if (buf == NULL) {
+        return -EFAULT;
+    }
+    if ((buf_len == 0) || (cb == NULL)) {
+        return -EINVAL;
+    }
+    size_t sent = 0;
+    while (sent < count) {
+        size_t chunk = count - sent;
+        if (chunk > buf_len) {
+            chunk = buf_len;
+        }
+        ssize_t len = vfs_read(fd, buf, chunk);
+        if (len <= 0) {
+            /* end of file or error */
+            if ((len < 0) && (sent == 0)) {
+                return len;
+            }
+            break;
+        }
+        size_t done = 0;
+        while (done < (size_t)len) {
+            ssize_t res = cb(arg, (uint8_t *)buf + done, len - done);
+            if (res <= 0) {
+                /* leave the file position after the last byte consumed */
+                vfs_lseek(fd, (off_t)done - len, SEEK_CUR);
+                sent += done;
+                if ((res < 0) && (sent == 0)) {
+                    return res;
+                }
+                return sent;
+            }
+            done += ((size_t)res < len - done) ? (size_t)res : len - done;
+        }
+        sent += done;
+    }
+    return sent;
+}
+
 int vfs_opendir(vfs_DIR *dirp, const char *dirname)
 {
     DEBUG("vfs_opendir: %p, \"%s\"\n", (void *)dirp, dirname);
@@ -484,6 +692,10 @@ int vfs_mount(vfs_mount_t *mountp)
     }
     /* insert last in list */
     clist_rpush(&_vfs_mounts_list, &mountp->list_entry);
+    _mount_lookup_prepare(NULL);
+    unsigned state = irq_disable();
+    _mount_lookup_publish();
+    irq_restore(state);
     mutex_unlock(&_mount_mutex);
     DEBUG("vfs_mount: mount done\n");
     return 0;
@@ -507,16 +719,27 @@ int vfs_umount(vfs_mount_t *mountp)
         return -EINVAL;
     }
     DEBUG("vfs_umount: -> \"%s\" open=%d\n", mountp->mount_point, atomic_load(&mountp->open_files));
+    /* remove mountp from the lookup table in the same critical section as
+     * checking for open files, so no lookup can start using it afterwards */
+    _mount_lookup_prepare(mountp);
+    unsigned state = irq_disable();
     if (atomic_load(&mountp->open_files) > 0) {
+        irq_restore(state);
         mutex_unlock(&_mount_mutex);
         return -EBUSY;
     }
+    _mount_lookup_publish();
+    irq_restore(state);
     if (mountp->fs->fs_op != NULL) {
         if (mountp->fs->fs_op->umount != NULL) {
             int res = mountp->fs->fs_op->umount(mountp);
             if (res < 0) {
                 /* umount failed */
                 DEBUG("vfs_umount: ERR %d!\n", res);
+                _mount_lookup_prepare(NULL);
+                state = irq_disable();
+                _mount_lookup_publish();
+                irq_restore(state);
                 mutex_unlock(&_mount_mutex);
                 return res;
             }
@@ -767,9 +990,7 @@ int vfs_bind(int fd, int flags, const vfs_file_ops_t *f_op, void *private_data)
     if (f_op == NULL) {
         return -EINVAL;
     }
-    mutex_lock(&_open_mutex);
     fd = _init_fd(fd, f_op, NULL, flags, private_data);
-    mutex_unlock(&_open_mutex);
     if (fd < 0) {
         DEBUG("vfs_bind: _init_fd: ERR %d!\n", fd);
         return fd;
@@ -875,27 +1096,56 @@ const vfs_file_t *vfs_file_get(int fd)
     }
 }
 
-static inline int _allocate_fd(int fd)
+/* claims @p fd in _vfs_fd_used, returns true on success */
+static inline bool _claim_fd(int fd)
 {
-    if (fd < 0) {
-        for (fd = 0; fd < VFS_MAX_OPEN_FILES; ++fd) {
-            if ((fd == STDIN_FILENO) || (fd == STDOUT_FILENO) || (fd == STDERR_FILENO)) {
-                /* Do not auto-allocate the stdio file descriptor numbers to
-                 * avoid conflicts between normal file system users and stdio
-                 * drivers such as stdio_uart, stdio_rtt which need to be able
-                 * to bind to these specific file descriptor numbers. */
-                continue;
-            }
-            if (_vfs_open_files[fd].pid == KERNEL_PID_UNDEF) {
+    uint32_t mask = 1UL << (fd % 32);
+
+    return !(atomic_fetch_or_u32(&_vfs_fd_used[fd / 32], mask) & mask);
+}
+
+/* claims the lowest free, non-stdio fd, returns -ENFILE if there is none */
+static int _claim_any_fd(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_vfs_fd_used); i++) {
+        uint32_t free_fds = ~atomic_load_u32(&_vfs_fd_used[i]);
+        if (i == 0) {
+            /* Do not auto-allocate the stdio file descriptor numbers to
+             * avoid conflicts between normal file system users and stdio
+             * drivers such as stdio_uart, stdio_rtt which need to be able
+             * to bind to these specific file descriptor numbers. */
+            free_fds &= ~((1UL << STDIN_FILENO) | (1UL << STDOUT_FILENO) |
+                          (1UL << STDERR_FILENO));
+        }
+        while (free_fds) {
+            unsigned bit = bitarithm_lsb(free_fds);
+            int fd = i * 32 + bit;
+            if (fd >= VFS_MAX_OPEN_FILES) {
                 break;
             }
+            if (_claim_fd(fd)) {
+                return fd;
+            }
+            /* another thread was faster, try the next one */
+            free_fds &= ~(1UL << bit);
         }
     }
-    if (fd >= VFS_MAX_OPEN_FILES) {
-        /* The _vfs_open_files array is full */
+    return -ENFILE;
+}
+
+static inline int _allocate_fd(int fd)
+{
+    if (fd < 0) {
+        fd = _claim_any_fd();
+        if (fd < 0) {
+            /* The _vfs_open_files array is full */
+            return fd;
+        }
+    }
+    else if (fd >= VFS_MAX_OPEN_FILES) {
         return -ENFILE;
     }
-    else if (_vfs_open_files[fd].pid != KERNEL_PID_UNDEF) {
+    else if (!_claim_fd(fd)) {
         /* The desired fd is already in use */
         return -EEXIST;
     }
@@ -916,6 +1166,8 @@ static inline void _free_fd(int fd)
         atomic_fetch_sub(&_vfs_open_files[fd].mp->open_files, 1);
     }
     _vfs_open_files[fd].pid = KERNEL_PID_UNDEF;
+    /* release the entry last, it may be claimed again right away */
+    atomic_fetch_and_u32(&_vfs_fd_used[fd / 32], ~(1UL << (fd % 32)));
 }
 
 static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *mountp, int flags, void *private_data)
@@ -933,10 +1185,136 @@ static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *moun
     return fd;
 }
 
+/* FNV-1a, tells mount points apart without dereferencing the mounts */
+static uint32_t _path_hash(const char *path, size_t len)
+{
+    uint32_t hash = 2166136261UL;
+
+    while (len--) {
+        hash ^= (uint8_t)*(path++);
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static void _mount_lookup_prepare(const vfs_mount_t *exclude)
+{
+    _mount_lookup_t *table = &_mount_lookup[(_mount_lookup_gen + 1) & 1];
+
+    table->num = 0;
+    table->uncached_len = 0;
+
+    clist_node_t *node = _vfs_mounts_list.next;
+    if (node == NULL) {
+        /* list empty */
+        return;
+    }
+    do {
+        node = node->next;
+        vfs_mount_t *it = container_of(node, vfs_mount_t, list_entry);
+        if (it == exclude) {
+            continue;
+        }
+        size_t len = it->mount_point_len;
+        /* sorted by length, for equal mount points the one mounted last
+         * comes first, like in the list search of _find_mount() */
+        unsigned pos = table->num;
+        while ((pos > 0) && (table->entries[pos - 1].len <= len)) {
+            pos--;
+        }
+        if (pos == VFS_MOUNT_LOOKUP_SIZE) {
+            if (len > table->uncached_len) {
+                table->uncached_len = len;
+            }
+            continue;
+        }
+        if (table->num == VFS_MOUNT_LOOKUP_SIZE) {
+            /* the shortest mount point drops out of the table */
+            size_t dropped = table->entries[--table->num].len;
+            if (dropped > table->uncached_len) {
+                table->uncached_len = dropped;
+            }
+        }
+        memmove(&table->entries[pos + 1], &table->entries[pos],
+                (table->num - pos) * sizeof(table->entries[0]));
+        table->entries[pos].mountp = it;
+        table->entries[pos].hash = _path_hash(it->mount_point, len);
+        table->entries[pos].len = len;
+        table->num++;
+    } while (node != _vfs_mounts_list.next);
+}
+
+/**
+ * @brief Search the mount point lookup table without locking
+ *
+ * @return  offset of the relative path in @p name on success
+ * @return  -ENOENT if no mount point matches
+ * @return  -EAGAIN if _vfs_mounts_list must be searched
+ */
+static int _find_mount_lookup(vfs_mount_t **mountpp, const char *name, size_t name_len)
+{
+    uint32_t gen = atomic_load_u32(&_mount_lookup_gen);
+    const _mount_lookup_t *table = &_mount_lookup[gen & 1];
+    unsigned num = table->num;
+
+    if (num > VFS_MOUNT_LOOKUP_SIZE) {
+        /* torn read during an update */
+        return -EAGAIN;
+    }
+    for (unsigned i = 0; i < num; i++) {
+        _mount_lookup_entry_t entry = table->entries[i];
+        if (entry.len <= table->uncached_len) {
+            /* a mount point that is not in the table might match as well */
+            return -EAGAIN;
+        }
+        if (entry.len > name_len) {
+            continue;
+        }
+        if ((entry.len > 1) && (name[entry.len] != '/') && (name[entry.len] != '\0')) {
+            continue;
+        }
+        if (_path_hash(name, entry.len) != entry.hash) {
+            continue;
+        }
+        /* the entry is valid if the table was not swapped in the meantime */
+        unsigned state = irq_disable();
+        if (atomic_load_u32(&_mount_lookup_gen) != gen) {
+            irq_restore(state);
+            return -EAGAIN;
+        }
+        atomic_fetch_add(&entry.mountp->open_files, 1);
+        irq_restore(state);
+        if (strncmp(name, entry.mountp->mount_point, entry.len) != 0) {
+            /* hash collision */
+            atomic_fetch_sub(&entry.mountp->open_files, 1);
+            return -EAGAIN;
+        }
+        *mountpp = entry.mountp;
+        /* special case for mount_point == "/" */
+        return (entry.len > 1) ? (int)entry.len : 0;
+    }
+    if ((table->uncached_len > 0) || (atomic_load_u32(&_mount_lookup_gen) != gen)) {
+        return -EAGAIN;
+    }
+    return -ENOENT;
+}
+
 static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const char **rel_path)
 {
     size_t longest_match = 0;
     size_t name_len = strlen(name);
+
+    int res = _find_mount_lookup(mountpp, name, name_len);
+    if (res != -EAGAIN) {
+        if (res < 0) {
+            return res;
+        }
+        if (rel_path != NULL) {
+            *rel_path = name + res;
+        }
+        return 0;
+    }
+
     mutex_lock(&_mount_mutex);
 
     clist_node_t *node = _vfs_mounts_list.next;
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark for ChaCha20, Poly1305 and the
+ *              ChaCha20-Poly1305 AEAD
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/chacha.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/poly1305.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#ifndef BUF_SIZE
+#define BUF_SIZE        (1024U)
+#endif
+#ifndef RUNS
+#define RUNS            (64U)
+#endif
+
+#if defined(__i386__) || defined(__x86_64__)
+#define CHACHA_IMPL     "4 blocks, SSE2"
+#elif defined(__ARM_NEON)
+#define CHACHA_IMPL     "4 blocks, NEON"
+#else
+#define CHACHA_IMPL     "2 blocks, scalar"
+#endif
+
+#ifdef __SIZEOF_INT128__
+#define POLY1305_IMPL   "64-bit limbs"
+#else
+#define POLY1305_IMPL   "32-bit limbs"
+#endif
+
+static const uint8_t _key[CHACHA20POLY1305_KEY_BYTES] = { 1 };
+static const uint8_t _nonce[CHACHA20POLY1305_NONCE_BYTES] = { 2 };
+
+/* the decryption checks the tag and its output is compared with the input,
+ * so the benchmark fails if encryption and decryption disagree */
+static uint8_t _in[BUF_SIZE];
+static uint8_t _out[BUF_SIZE + CHACHA20POLY1305_TAG_BYTES];
+static uint8_t _plain[BUF_SIZE];
+
+static void _print(const char *name, uint32_t start)
+{
+    uint32_t time = xtimer_now_usec() - start;
+    uint32_t bytes = BUF_SIZE * RUNS;
+
+    printf("%-12s %8" PRIu32 " bytes in %8" PRIu32 " us, %8" PRIu32
+           " KiB/s\n", name, bytes, time,
+           (uint32_t)((uint64_t)bytes * 1000000 / 1024 / (time ? time : 1)));
+}
+
+static void _chacha(void)
+{
+    chacha_ctx ctx;
+    uint32_t start;
+
+    chacha_init(&ctx, 20, _key, sizeof(_key), _nonce);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS; i++) {
+        for (unsigned j = 0; j < BUF_SIZE; j += 64) {
+            chacha_keystream_bytes(&ctx, &_out[j]);
+        }
+    }
+    _print("chacha20 x1", start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS; i++) {
+        chacha_keystream_blocks(&ctx, _out, BUF_SIZE / 64);
+    }
+    _print("chacha20", start);
+}
+
+static void _poly1305(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        poly1305_auth(_out, _in, BUF_SIZE, _key);
+    }
+    _print("poly1305", start);
+}
+
+static int _aead(void)
+{
+    size_t len;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        chacha20poly1305_encrypt(_out, _in, BUF_SIZE, NULL, 0, _key, _nonce);
+    }
+    _print("aead encrypt", start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS; i++) {
+        if (!chacha20poly1305_decrypt(_out, sizeof(_out), _plain, &len, NULL,
+                                      0, _key, _nonce)) {
+            return -1;
+        }
+    }
+    _print("aead decrypt", start);
+
+    return memcmp(_plain, _in, sizeof(_in)) ? -1 : 0;
+}
+
+int main(void)
+{
+    printf("ChaCha20 (" CHACHA_IMPL "), Poly1305 (" POLY1305_IMPL "), "
+           "%u byte messages\n", BUF_SIZE);
+
+    _chacha();
+    _poly1305();
+    if (_aead()) {
+        puts("[FAILED]");
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
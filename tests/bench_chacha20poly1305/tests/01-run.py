@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+RESULT = r" +[0-9]+ bytes in +[0-9]+ us, +[0-9]+ KiB/s\r\n"
+
+
+def testfunc(child):
+    child.expect(r"ChaCha20 \(.+\), Poly1305 \(.+\), [0-9]+ byte messages\r\n")
+    for name in ("chacha20 x1", "chacha20", "poly1305", "aead encrypt",
+                 "aead decrypt"):
+        child.expect(name + RESULT)
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of the CRC implementations in sys/checksum
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "checksum/crc.h"
+#include "checksum/crc8.h"
+#include "checksum/crc16_ccitt.h"
+#include "checksum/ucrc16.h"
+#include "kernel_defines.h"
+#include "periph_conf.h"
+#include "xtimer.h"
+
+#ifndef BUF_SIZE
+#define BUF_SIZE        (1024U)
+#endif
+#ifndef BYTES_PER_SIZE
+#define BYTES_PER_SIZE  (64U * 1024U)
+#endif
+
+/**
+ * @brief   CPU clock in Hz to convert the times into cycles, 0 if unknown
+ */
+#ifndef BENCH_CPU_HZ
+#ifdef CLOCK_CORECLOCK
+#define BENCH_CPU_HZ    (CLOCK_CORECLOCK)
+#else
+#define BENCH_CPU_HZ    (0U)
+#endif
+#endif
+
+#if IS_USED(MODULE_CHECKSUM_CRC32_PCLMUL)
+#define CRC32_BACKEND   "pclmul"
+#elif IS_USED(MODULE_CHECKSUM_CRC32_ARMV8)
+#define CRC32_BACKEND   "armv8"
+#else
+#define CRC32_BACKEND   "table"
+#endif
+
+static uint8_t _buf[BUF_SIZE];
+
+static const size_t _sizes[] = { 16, 64, BUF_SIZE };
+
+static uint32_t _crc8(const uint8_t *buf, size_t len)
+{
+    return crc8(buf, len, 0x07, 0x00);
+}
+
+static uint32_t _ucrc16(const uint8_t *buf, size_t len)
+{
+    return ucrc16_calc_be(buf, len, UCRC16_CCITT_POLY_BE, 0x1d0f);
+}
+
+static uint32_t _crc16_ccitt(const uint8_t *buf, size_t len)
+{
+    return crc16_ccitt_calc(buf, len);
+}
+
+static uint32_t _crc_8(const uint8_t *buf, size_t len)
+{
+    return crc_calc(&crc_8, buf, len);
+}
+
+static uint32_t _crc_16_ccitt(const uint8_t *buf, size_t len)
+{
+    return crc_calc(&crc_16_ccitt, buf, len);
+}
+
+static uint32_t _crc_32(const uint8_t *buf, size_t len)
+{
+    return crc_calc(&crc_32, buf, len);
+}
+
+static uint32_t _crc_32c(const uint8_t *buf, size_t len)
+{
+    return crc_calc(&crc_32c, buf, len);
+}
+
+static const struct {
+    const char *name;
+    uint32_t (*calc)(const uint8_t *buf, size_t len);
+    uint32_t check;     /* CRC of "123456789" */
+} _impls[] = {
+    { "crc8", _crc8, 0xf4 },
+    { "ucrc16_calc_be", _ucrc16, 0xe5cc },
+    { "crc16_ccitt", _crc16_ccitt, 0xe5cc },
+    { "crc_8", _crc_8, 0xf4 },
+    { "crc_16_ccitt", _crc_16_ccitt, 0xe5cc },
+    { "crc_32", _crc_32, 0xcbf43926 },
+    { "crc_32c", _crc_32c, 0xe3069283 },
+};
+
+static void _run(unsigned impl, size_t size)
+{
+    unsigned runs = BYTES_PER_SIZE / size;
+    uint32_t start = xtimer_now_usec();
+    uint32_t time;
+
+    for (unsigned j = 0; j < runs; j++) {
+        _impls[impl].calc(_buf, size);
+    }
+    time = xtimer_now_usec() - start;
+    if (time == 0) {
+        time = 1;
+    }
+
+    printf("%15s %5u bytes: %8" PRIu32 " KiB/s", _impls[impl].name,
+           (unsigned)size,
+           (uint32_t)((uint64_t)runs * size * US_PER_SEC / 1024 / time));
+    if (BENCH_CPU_HZ) {
+        /* in thousandths of a byte per cycle */
+        uint64_t cycles = (uint64_t)time * BENCH_CPU_HZ / US_PER_SEC;
+        uint32_t bpc = (uint64_t)runs * size * 1000 / cycles;
+
+        printf(", %4" PRIu32 ".%03" PRIu32 " bytes/cycle", bpc / 1000,
+               bpc % 1000);
+    }
+    puts("");
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = i;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_impls); i++) {
+        if (_impls[i].calc((const uint8_t *)"123456789", 9) !=
+            _impls[i].check) {
+            printf("[FAILED] wrong CRC of %s\n", _impls[i].name);
+            return 1;
+        }
+    }
+    if (_crc_16_ccitt(_buf, sizeof(_buf)) != _crc16_ccitt(_buf, sizeof(_buf))) {
+        puts("[FAILED] crc_16_ccitt differs from crc16_ccitt");
+        return 1;
+    }
+
+    printf("CRC, %u tables, CRC-32 with " CRC32_BACKEND ", CPU clock %" PRIu32
+           " Hz\n", (unsigned)CONFIG_CRC_SLICES, (uint32_t)BENCH_CPU_HZ);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_impls); i++) {
+        for (unsigned s = 0; s < ARRAY_SIZE(_sizes); s++) {
+            _run(i, _sizes[s]);
+        }
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
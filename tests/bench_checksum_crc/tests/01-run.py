@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+IMPLS = ("crc8", "ucrc16_calc_be", "crc16_ccitt", "crc_8", "crc_16_ccitt",
+         "crc_32", "crc_32c")
+RESULT = r" bytes: +[0-9]+ KiB/s(, +[0-9]+\.[0-9]{3} bytes/cycle)?\r\n"
+
+
+def testfunc(child):
+    child.expect(r"CRC, [0-9] tables, CRC-32 with \w+, CPU clock [0-9]+ Hz\r\n")
+    for impl in IMPLS:
+        for size in (16, 64, 1024):
+            child.expect(r" *{} +{}".format(impl, size) + RESULT)
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Common definitions of the crypto provider benchmark
+ *
+ * Each provider adds its benchmarks to the `bench_crypto_xfa` cross file
+ * array with BENCH_CRYPTO(), main.c runs them grouped by primitive.
+ *
+ * @}
+ */
+
+#ifndef BENCH_CRYPTO_H
+#define BENCH_CRYPTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xfa.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the messages of the symmetric primitives in bytes
+ */
+#ifndef BENCH_CRYPTO_MSG_SIZE
+#define BENCH_CRYPTO_MSG_SIZE       (1024U)
+#endif
+
+/**
+ * @name    Names of the benchmarked primitives
+ * @{
+ */
+#define BENCH_AES128_CCM            "aes128-ccm"
+#define BENCH_CHACHA20_POLY1305     "chacha20-poly1305"
+#define BENCH_SHA256                "sha256"
+#define BENCH_ED25519_SIGN          "ed25519 sign"
+#define BENCH_ED25519_VERIFY        "ed25519 verify"
+#define BENCH_ECDSA_P256_SIGN       "ecdsa-p256 sign"
+#define BENCH_ECDSA_P256_VERIFY     "ecdsa-p256 verify"
+#define BENCH_X25519                "x25519"
+/** @} */
+
+#define BENCH_CCM_NONCE_LEN         (13U)   /**< AES-CCM nonce length */
+#define BENCH_CCM_TAG_LEN           (16U)   /**< AES-CCM tag length */
+#define BENCH_AEAD_NONCE_LEN        (12U)   /**< ChaCha20-Poly1305 nonce length */
+#define BENCH_AEAD_TAG_LEN          (16U)   /**< ChaCha20-Poly1305 tag length */
+
+/**
+ * @brief   A benchmark of one primitive of one provider
+ */
+typedef struct {
+    const char *primitive;  /**< one of the BENCH_* names above */
+    const char *provider;   /**< package or RIOT module */
+    /**
+     * @brief   Bytes processed per operation, 0 for public key operations
+     */
+    size_t msg_size;
+    /**
+     * @brief   Length of the output in @ref bench_crypto_out that has to be
+     *          equal for all providers, 0 if the output is not deterministic
+     */
+    size_t out_len;
+    int (*setup)(void);     /**< prepares keys, may be NULL */
+    int (*op)(void);        /**< one operation, returns < 0 on failure */
+} bench_crypto_t;
+
+/**
+ * @brief   Defines a benchmark and adds it to the cross file array
+ */
+#define BENCH_CRYPTO(name) \
+    static const bench_crypto_t name; \
+    XFA_ADD_PTR(bench_crypto_xfa, 0, name, &name); \
+    static const bench_crypto_t name
+
+/**
+ * @brief   Message of the symmetric primitives
+ */
+extern const uint8_t bench_crypto_msg[BENCH_CRYPTO_MSG_SIZE];
+
+/**
+ * @brief   Output buffer, large enough for a message and a tag
+ */
+extern uint8_t bench_crypto_out[BENCH_CRYPTO_MSG_SIZE + 16];
+
+extern const uint8_t bench_crypto_key[32];      /**< symmetric key */
+extern const uint8_t bench_crypto_nonce[13];    /**< AEAD nonce */
+
+/**
+ * @brief   Message hash signed by ECDSA, SHA-256 of @ref bench_crypto_msg
+ */
+extern const uint8_t bench_crypto_hash[32];
+
+extern const uint8_t bench_crypto_p256_priv[32];    /**< P-256 private key */
+extern const uint8_t bench_crypto_p256_pub[64];     /**< P-256 public key, x || y */
+
+/**
+ * @brief   Ed25519 secret key (seed), RFC 8032 section 7.1, test 1
+ */
+extern const uint8_t bench_crypto_ed25519_seed[32];
+
+/**
+ * @brief   X25519 private key of Alice, RFC 7748 section 6.1
+ */
+extern const uint8_t bench_crypto_x25519_priv[32];
+
+/**
+ * @brief   X25519 public key of Bob, RFC 7748 section 6.1
+ */
+extern const uint8_t bench_crypto_x25519_pub[32];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_CRYPTO_H */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmarks of the c25519 package
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_C25519)
+
+#include <string.h>
+
+#include "bench_crypto.h"
+#include "c25519.h"
+#include "edsign.h"
+
+static uint8_t _pub[EDSIGN_PUBLIC_KEY_SIZE];
+static uint8_t _sig[EDSIGN_SIGNATURE_SIZE];
+static uint8_t _exp[C25519_EXPONENT_SIZE];
+
+static int _ed25519_sign_setup(void)
+{
+    edsign_sec_to_pub(_pub, bench_crypto_ed25519_seed);
+    return 0;
+}
+
+static int _ed25519_sign(void)
+{
+    edsign_sign(bench_crypto_out, _pub, bench_crypto_ed25519_seed,
+                bench_crypto_hash, sizeof(bench_crypto_hash));
+    return 0;
+}
+
+BENCH_CRYPTO(_c25519_ed25519_sign) = {
+    .primitive = BENCH_ED25519_SIGN,
+    .provider = "c25519",
+    .out_len = EDSIGN_SIGNATURE_SIZE,
+    .setup = _ed25519_sign_setup,
+    .op = _ed25519_sign,
+};
+
+static int _ed25519_verify_setup(void)
+{
+    edsign_sec_to_pub(_pub, bench_crypto_ed25519_seed);
+    edsign_sign(_sig, _pub, bench_crypto_ed25519_seed, bench_crypto_hash,
+                sizeof(bench_crypto_hash));
+    return 0;
+}
+
+static int _ed25519_verify(void)
+{
+    return edsign_verify(_sig, _pub, bench_crypto_hash,
+                         sizeof(bench_crypto_hash)) ? 0 : -1;
+}
+
+BENCH_CRYPTO(_c25519_ed25519_verify) = {
+    .primitive = BENCH_ED25519_VERIFY,
+    .provider = "c25519",
+    .setup = _ed25519_verify_setup,
+    .op = _ed25519_verify,
+};
+
+static int _x25519_setup(void)
+{
+    memcpy(_exp, bench_crypto_x25519_priv, sizeof(_exp));
+    c25519_prepare(_exp);
+    return 0;
+}
+
+static int _x25519(void)
+{
+    c25519_smult(bench_crypto_out, bench_crypto_x25519_pub, _exp);
+    return 0;
+}
+
+BENCH_CRYPTO(_c25519_x25519) = {
+    .primitive = BENCH_X25519,
+    .provider = "c25519",
+    .out_len = 32,
+    .setup = _x25519_setup,
+    .op = _x25519,
+};
+
+#endif /* MODULE_C25519 */
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmarks of the HACL* package
+ *
+ * Only X25519 of the NaCl API of HACL* is one of the compared primitives.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_HACL)
+
+#include <haclnacl.h>
+
+#include "bench_crypto.h"
+
+static int _x25519(void)
+{
+    return crypto_scalarmult(bench_crypto_out, bench_crypto_x25519_priv,
+                             bench_crypto_x25519_pub) == 0 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_hacl_x25519) = {
+    .primitive = BENCH_X25519,
+    .provider = "hacl",
+    .out_len = 32,
+    .op = _x25519,
+};
+
+#endif /* MODULE_HACL */
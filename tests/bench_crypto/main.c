@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of the crypto providers: sys/crypto, sys/hashes
+ *              and the crypto packages
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bench_crypto.h"
+#include "kernel_defines.h"
+#include "periph_conf.h"
+#include "xtimer.h"
+
+/**
+ * @brief   Minimum time each benchmark runs
+ */
+#ifndef BENCH_CRYPTO_MIN_TIME_US
+#define BENCH_CRYPTO_MIN_TIME_US    (500U * US_PER_MS)
+#endif
+
+/**
+ * @brief   CPU clock in Hz to convert the times into cycles, 0 if unknown
+ */
+#ifndef BENCH_CRYPTO_CPU_HZ
+#ifdef CLOCK_CORECLOCK
+#define BENCH_CRYPTO_CPU_HZ         (CLOCK_CORECLOCK)
+#else
+#define BENCH_CRYPTO_CPU_HZ         (0U)
+#endif
+#endif
+
+XFA_INIT_CONST(const bench_crypto_t *, bench_crypto_xfa);
+
+const uint8_t bench_crypto_msg[BENCH_CRYPTO_MSG_SIZE] = { 0x5a };
+uint8_t bench_crypto_out[BENCH_CRYPTO_MSG_SIZE + 16];
+
+const uint8_t bench_crypto_key[32] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+};
+const uint8_t bench_crypto_nonce[13] = {
+    0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43,
+    0x44, 0x45, 0x46, 0x47, 0x48,
+};
+/* SHA-256 of bench_crypto_msg with the default BENCH_CRYPTO_MSG_SIZE */
+const uint8_t bench_crypto_hash[32] = {
+    0x81, 0xe1, 0x19, 0x2a, 0x66, 0xa3, 0x04, 0xc8,
+    0x15, 0x41, 0x7f, 0x48, 0xbc, 0xa1, 0x14, 0x8f,
+    0x6e, 0x67, 0x19, 0x43, 0x16, 0xad, 0xea, 0xc3,
+    0x36, 0x41, 0xf9, 0xb7, 0x5d, 0xb3, 0xc2, 0x48,
+};
+const uint8_t bench_crypto_p256_priv[32] = {
+    0x9b, 0x4c, 0x4b, 0xa0, 0xb7, 0xb1, 0x25, 0x23,
+    0x9c, 0x09, 0x85, 0x4f, 0x9a, 0x21, 0xb4, 0x14,
+    0x70, 0xe0, 0xce, 0x21, 0x25, 0x00, 0xa5, 0x62,
+    0x34, 0xa4, 0x25, 0xf0, 0x0f, 0x00, 0xeb, 0xe7,
+};
+const uint8_t bench_crypto_p256_pub[64] = {
+    0x54, 0x3e, 0x98, 0xf8, 0x14, 0x55, 0x08, 0x13,
+    0xb5, 0x1a, 0x1d, 0x02, 0x02, 0xd7, 0x0e, 0xab,
+    0xa0, 0x98, 0x74, 0x61, 0x91, 0x12, 0x3d, 0x96,
+    0x50, 0xfa, 0xd5, 0x94, 0xa2, 0x86, 0xa8, 0xb0,
+    0xd0, 0x7b, 0xda, 0x36, 0xba, 0x8e, 0xd3, 0x9a,
+    0xa0, 0x16, 0x11, 0x0e, 0x1b, 0x6e, 0x81, 0x13,
+    0xd7, 0xf4, 0x23, 0xa1, 0xb2, 0x9b, 0xaf, 0xf6,
+    0x6b, 0xc4, 0x2a, 0xdf, 0xbd, 0xe4, 0x61, 0x5c,
+};
+const uint8_t bench_crypto_ed25519_seed[32] = {
+    0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60,
+    0xba, 0x84, 0x4a, 0xf4, 0x92, 0xec, 0x2c, 0xc4,
+    0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32, 0x69, 0x19,
+    0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60,
+};
+const uint8_t bench_crypto_x25519_priv[32] = {
+    0x77, 0x07, 0x6d, 0x0a, 0x73, 0x18, 0xa5, 0x7d,
+    0x3c, 0x16, 0xc1, 0x72, 0x51, 0xb2, 0x66, 0x45,
+    0xdf, 0x4c, 0x2f, 0x87, 0xeb, 0xc0, 0x99, 0x2a,
+    0xb1, 0x77, 0xfb, 0xa5, 0x1d, 0xb9, 0x2c, 0x2a,
+};
+const uint8_t bench_crypto_x25519_pub[32] = {
+    0xde, 0x9e, 0xdb, 0x7d, 0x7b, 0x7d, 0xc1, 0xb4,
+    0xd3, 0x5b, 0x61, 0xc2, 0xec, 0xe4, 0x35, 0x37,
+    0x3f, 0x83, 0x43, 0xc8, 0x5b, 0x78, 0x67, 0x4d,
+    0xad, 0xfc, 0x7e, 0x14, 0x6f, 0x88, 0x2b, 0x4f,
+};
+
+static const char *const _primitives[] = {
+    BENCH_AES128_CCM,
+    BENCH_CHACHA20_POLY1305,
+    BENCH_SHA256,
+    BENCH_ED25519_SIGN,
+    BENCH_ED25519_VERIFY,
+    BENCH_ECDSA_P256_SIGN,
+    BENCH_ECDSA_P256_VERIFY,
+    BENCH_X25519,
+};
+
+/* output of the first provider of a primitive, the others must match it */
+static uint8_t _ref[sizeof(bench_crypto_out)];
+static bool _have_ref;
+
+static void _fixed(char *buf, size_t size, uint64_t val, unsigned decimals)
+{
+    if (decimals == 2) {
+        snprintf(buf, size, "%" PRIu32 ".%02" PRIu32,
+                 (uint32_t)(val / 100), (uint32_t)(val % 100));
+    }
+    else {
+        snprintf(buf, size, "%" PRIu32 ".%" PRIu32,
+                 (uint32_t)(val / 10), (uint32_t)(val % 10));
+    }
+}
+
+static int _run(const volatile bench_crypto_t *b)
+{
+    char ops[16];
+    char cycles[16] = "-";
+    char cpb[16] = "-";
+    uint32_t runs = 0;
+    uint32_t time;
+    uint32_t start;
+
+    if (b->setup && b->setup() < 0) {
+        printf("%s of %s: setup failed\n", b->primitive, b->provider);
+        return -1;
+    }
+
+    start = xtimer_now_usec();
+    do {
+        if (b->op() < 0) {
+            printf("%s of %s failed\n", b->primitive, b->provider);
+            return -1;
+        }
+        runs++;
+        time = xtimer_now_usec() - start;
+    } while (time < BENCH_CRYPTO_MIN_TIME_US);
+
+    if (b->out_len) {
+        if (!_have_ref) {
+            memcpy(_ref, bench_crypto_out, b->out_len);
+            _have_ref = true;
+        }
+        else if (memcmp(_ref, bench_crypto_out, b->out_len)) {
+            printf("%s of %s differs from the first provider\n",
+                   b->primitive, b->provider);
+            return -1;
+        }
+    }
+
+    _fixed(ops, sizeof(ops), (uint64_t)runs * 100 * US_PER_SEC / time, 2);
+    if (BENCH_CRYPTO_CPU_HZ) {
+        uint64_t total = (uint64_t)time * BENCH_CRYPTO_CPU_HZ / US_PER_SEC;
+
+        snprintf(cycles, sizeof(cycles), "%" PRIu32, (uint32_t)(total / runs));
+        if (b->msg_size) {
+            _fixed(cpb, sizeof(cpb), total * 10 / runs / b->msg_size, 1);
+        }
+    }
+    printf("%-18s %-12s %12s %12s %12s\n", b->primitive, b->provider, ops,
+           cycles, cpb);
+
+    return 0;
+}
+
+int main(void)
+{
+    unsigned n = XFA_LEN(const bench_crypto_t *, bench_crypto_xfa);
+
+    printf("%u byte messages, CPU clock %" PRIu32 " Hz\n",
+           BENCH_CRYPTO_MSG_SIZE, (uint32_t)BENCH_CRYPTO_CPU_HZ);
+    printf("%-18s %-12s %12s %12s %12s\n", "primitive", "provider", "ops/s",
+           "cycles/op", "cycles/byte");
+
+    for (unsigned p = 0; p < ARRAY_SIZE(_primitives); p++) {
+        _have_ref = false;
+        for (unsigned i = 0; i < n; i++) {
+            const volatile bench_crypto_t *b = bench_crypto_xfa[i];
+
+            if (strcmp(b->primitive, _primitives[p])) {
+                continue;
+            }
+            if (_run(b) < 0) {
+                puts("[FAILED]");
+                return 1;
+            }
+        }
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmarks of the micro-ecc package
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_MICRO_ECC)
+
+#include "bench_crypto.h"
+#include "hashes/sha256.h"
+#include "uECC.h"
+
+typedef struct {
+    uECC_HashContext uECC;
+    sha256_context_t ctx;
+} _hash_ctx_t;
+
+static uint8_t _tmp[2 * SHA256_DIGEST_LENGTH + SHA256_INTERNAL_BLOCK_SIZE];
+static uint8_t _sig[64];
+
+static void _init_sha256(const uECC_HashContext *base)
+{
+    sha256_init(&((_hash_ctx_t *)base)->ctx);
+}
+
+static void _update_sha256(const uECC_HashContext *base,
+                           const uint8_t *message, unsigned message_size)
+{
+    sha256_update(&((_hash_ctx_t *)base)->ctx, message, message_size);
+}
+
+static void _finish_sha256(const uECC_HashContext *base, uint8_t *hash_result)
+{
+    sha256_final(&((_hash_ctx_t *)base)->ctx, hash_result);
+}
+
+/* without an RNG, micro-ecc only signs deterministically (RFC 6979) */
+static int _ecdsa_sign(void)
+{
+    _hash_ctx_t ctx = {
+        .uECC = {
+            .init_hash = _init_sha256,
+            .update_hash = _update_sha256,
+            .finish_hash = _finish_sha256,
+            .block_size = SHA256_INTERNAL_BLOCK_SIZE,
+            .result_size = SHA256_DIGEST_LENGTH,
+            .tmp = _tmp,
+        },
+    };
+
+    return uECC_sign_deterministic(bench_crypto_p256_priv, bench_crypto_hash,
+                                   sizeof(bench_crypto_hash), &ctx.uECC,
+                                   _sig, uECC_secp256r1()) == 1 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_micro_ecc_ecdsa_sign) = {
+    .primitive = BENCH_ECDSA_P256_SIGN,
+    .provider = "micro-ecc",
+    .op = _ecdsa_sign,
+};
+
+static int _ecdsa_verify(void)
+{
+    return uECC_verify(bench_crypto_p256_pub, bench_crypto_hash,
+                       sizeof(bench_crypto_hash), _sig,
+                       uECC_secp256r1()) == 1 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_micro_ecc_ecdsa_verify) = {
+    .primitive = BENCH_ECDSA_P256_VERIFY,
+    .provider = "micro-ecc",
+    .setup = _ecdsa_sign,
+    .op = _ecdsa_verify,
+};
+
+#endif /* MODULE_MICRO_ECC */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmarks of the Monocypher package
+ *
+ * The AEAD of Monocypher, crypto_lock(), uses XChaCha20. To compare the
+ * same primitive, the RFC 8439 construction is built from the IETF ChaCha20
+ * and the Poly1305 of Monocypher.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_MONOCYPHER)
+
+#include <string.h>
+
+#include "bench_crypto.h"
+#include "byteorder.h"
+#include "monocypher.h"
+#if IS_USED(MODULE_MONOCYPHER_OPTIONAL)
+#include "monocypher-ed25519.h"
+#endif
+
+static int _chacha20poly1305(void)
+{
+    static const uint8_t zero[64];
+    crypto_poly1305_ctx ctx;
+    uint8_t block[64];
+    uint8_t lengths[16];
+    size_t pad = (16 - BENCH_CRYPTO_MSG_SIZE % 16) % 16;
+
+    /* the first key stream block is the Poly1305 key */
+    crypto_ietf_chacha20(block, zero, sizeof(block), bench_crypto_key,
+                         bench_crypto_nonce);
+    crypto_ietf_chacha20_ctr(bench_crypto_out, bench_crypto_msg,
+                             BENCH_CRYPTO_MSG_SIZE, bench_crypto_key,
+                             bench_crypto_nonce, 1);
+
+    /* no additional data */
+    byteorder_htolebufll(lengths, 0);
+    byteorder_htolebufll(&lengths[8], BENCH_CRYPTO_MSG_SIZE);
+    crypto_poly1305_init(&ctx, block);
+    crypto_poly1305_update(&ctx, bench_crypto_out, BENCH_CRYPTO_MSG_SIZE);
+    crypto_poly1305_update(&ctx, zero, pad);
+    crypto_poly1305_update(&ctx, lengths, sizeof(lengths));
+    crypto_poly1305_final(&ctx, &bench_crypto_out[BENCH_CRYPTO_MSG_SIZE]);
+    crypto_wipe(block, sizeof(block));
+    return 0;
+}
+
+BENCH_CRYPTO(_monocypher_chacha20poly1305) = {
+    .primitive = BENCH_CHACHA20_POLY1305,
+    .provider = "monocypher",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = BENCH_CRYPTO_MSG_SIZE + BENCH_AEAD_TAG_LEN,
+    .op = _chacha20poly1305,
+};
+
+#if IS_USED(MODULE_MONOCYPHER_OPTIONAL)
+static uint8_t _pub[32];
+static uint8_t _sig[64];
+
+static int _ed25519_sign_setup(void)
+{
+    crypto_ed25519_public_key(_pub, bench_crypto_ed25519_seed);
+    return 0;
+}
+
+static int _ed25519_sign(void)
+{
+    crypto_ed25519_sign(bench_crypto_out, bench_crypto_ed25519_seed, _pub,
+                        bench_crypto_hash, sizeof(bench_crypto_hash));
+    return 0;
+}
+
+BENCH_CRYPTO(_monocypher_ed25519_sign) = {
+    .primitive = BENCH_ED25519_SIGN,
+    .provider = "monocypher",
+    .out_len = sizeof(_sig),
+    .setup = _ed25519_sign_setup,
+    .op = _ed25519_sign,
+};
+
+static int _ed25519_verify_setup(void)
+{
+    crypto_ed25519_public_key(_pub, bench_crypto_ed25519_seed);
+    crypto_ed25519_sign(_sig, bench_crypto_ed25519_seed, _pub,
+                        bench_crypto_hash, sizeof(bench_crypto_hash));
+    return 0;
+}
+
+static int _ed25519_verify(void)
+{
+    return crypto_ed25519_check(_sig, _pub, bench_crypto_hash,
+                                sizeof(bench_crypto_hash)) == 0 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_monocypher_ed25519_verify) = {
+    .primitive = BENCH_ED25519_VERIFY,
+    .provider = "monocypher",
+    .setup = _ed25519_verify_setup,
+    .op = _ed25519_verify,
+};
+#endif /* MODULE_MONOCYPHER_OPTIONAL */
+
+static int _x25519(void)
+{
+    crypto_x25519(bench_crypto_out, bench_crypto_x25519_priv,
+                  bench_crypto_x25519_pub);
+    return 0;
+}
+
+BENCH_CRYPTO(_monocypher_x25519) = {
+    .primitive = BENCH_X25519,
+    .provider = "monocypher",
+    .out_len = 32,
+    .op = _x25519,
+};
+
+#endif /* MODULE_MONOCYPHER */
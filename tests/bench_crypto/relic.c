@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmarks of the RELIC package
+ *
+ * The Makefile configures RELIC for 256-bit prime fields, so that NIST P-256
+ * is available.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_RELIC)
+
+#include <stdbool.h>
+
+#include "bench_crypto.h"
+#include "relic.h"
+
+static bn_t _d;
+static bn_t _r;
+static bn_t _s;
+static ec_t _q;
+
+static int _init(void)
+{
+    static bool initialized;
+
+    if (initialized) {
+        return 0;
+    }
+    if (core_init() != STS_OK) {
+        return -1;
+    }
+    initialized = true;
+    return 0;
+}
+
+static int _sha256(void)
+{
+    md_map_sh256(bench_crypto_out, bench_crypto_msg, BENCH_CRYPTO_MSG_SIZE);
+    return 0;
+}
+
+BENCH_CRYPTO(_relic_sha256) = {
+    .primitive = BENCH_SHA256,
+    .provider = "relic",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = 32,
+    .setup = _init,
+    .op = _sha256,
+};
+
+static int _ecdsa_setup(void)
+{
+    static bool have_key;
+
+    if (_init() < 0) {
+        return -1;
+    }
+    if (have_key) {
+        return 0;
+    }
+    ep_param_set(NIST_P256);
+    bn_null(_d);
+    bn_null(_r);
+    bn_null(_s);
+    ec_null(_q);
+    bn_new(_d);
+    bn_new(_r);
+    bn_new(_s);
+    ec_new(_q);
+    if (cp_ecdsa_gen(_d, _q) != STS_OK) {
+        return -1;
+    }
+    have_key = true;
+    return 0;
+}
+
+static int _ecdsa_sign(void)
+{
+    /* the message is a hash already */
+    return cp_ecdsa_sig(_r, _s, (uint8_t *)bench_crypto_hash,
+                        sizeof(bench_crypto_hash), 1, _d) == STS_OK ? 0 : -1;
+}
+
+BENCH_CRYPTO(_relic_ecdsa_sign) = {
+    .primitive = BENCH_ECDSA_P256_SIGN,
+    .provider = "relic",
+    .setup = _ecdsa_setup,
+    .op = _ecdsa_sign,
+};
+
+static int _ecdsa_verify_setup(void)
+{
+    if (_ecdsa_setup() < 0) {
+        return -1;
+    }
+    return _ecdsa_sign();
+}
+
+static int _ecdsa_verify(void)
+{
+    return cp_ecdsa_ver(_r, _s, (uint8_t *)bench_crypto_hash,
+                        sizeof(bench_crypto_hash), 1, _q) == 1 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_relic_ecdsa_verify) = {
+    .primitive = BENCH_ECDSA_P256_VERIFY,
+    .provider = "relic",
+    .setup = _ecdsa_verify_setup,
+    .op = _ecdsa_verify,
+};
+
+#endif /* MODULE_RELIC */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmarks of sys/crypto and sys/hashes
+ *
+ * @}
+ */
+
+#include "bench_crypto.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/ccm.h"
+#include "hashes/sha256.h"
+
+static cipher_t _cipher;
+
+static int _aes_ccm_setup(void)
+{
+    return cipher_init(&_cipher, CIPHER_AES, bench_crypto_key, 16) < 0 ? -1 : 0;
+}
+
+static int _aes_ccm(void)
+{
+    return cipher_encrypt_ccm(&_cipher, NULL, 0, BENCH_CCM_TAG_LEN, 2,
+                              bench_crypto_nonce, BENCH_CCM_NONCE_LEN,
+                              bench_crypto_msg, BENCH_CRYPTO_MSG_SIZE,
+                              bench_crypto_out) < 0 ? -1 : 0;
+}
+
+BENCH_CRYPTO(_riot_aes_ccm) = {
+    .primitive = BENCH_AES128_CCM,
+    .provider = "sys/crypto",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = BENCH_CRYPTO_MSG_SIZE + BENCH_CCM_TAG_LEN,
+    .setup = _aes_ccm_setup,
+    .op = _aes_ccm,
+};
+
+static int _chacha20poly1305(void)
+{
+    chacha20poly1305_encrypt(bench_crypto_out, bench_crypto_msg,
+                             BENCH_CRYPTO_MSG_SIZE, NULL, 0, bench_crypto_key,
+                             bench_crypto_nonce);
+    return 0;
+}
+
+BENCH_CRYPTO(_riot_chacha20poly1305) = {
+    .primitive = BENCH_CHACHA20_POLY1305,
+    .provider = "sys/crypto",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = BENCH_CRYPTO_MSG_SIZE + BENCH_AEAD_TAG_LEN,
+    .op = _chacha20poly1305,
+};
+
+static int _sha256(void)
+{
+    sha256(bench_crypto_msg, BENCH_CRYPTO_MSG_SIZE, bench_crypto_out);
+    return 0;
+}
+
+BENCH_CRYPTO(_riot_sha256) = {
+    .primitive = BENCH_SHA256,
+    .provider = "sys/hashes",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = SHA256_DIGEST_LENGTH,
+    .op = _sha256,
+};
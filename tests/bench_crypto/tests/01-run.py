@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+ROW = r"{} +{} +[0-9]+\.[0-9]{{2}} +(-|[0-9]+) +(-|[0-9]+\.[0-9])\r\n"
+
+
+def testfunc(child):
+    child.expect(r"[0-9]+ byte messages, CPU clock [0-9]+ Hz\r\n")
+    child.expect(r"primitive +provider +ops/s +cycles/op +cycles/byte\r\n")
+    # sys/crypto and sys/hashes are always benchmarked
+    child.expect(ROW.format("aes128-ccm", "sys/crypto"))
+    child.expect(ROW.format("chacha20-poly1305", "sys/crypto"))
+    child.expect(ROW.format("sha256", "sys/hashes"))
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=300))
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmarks of the tinycrypt package
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_TINYCRYPT)
+
+#include <string.h>
+
+#include "bench_crypto.h"
+#include "random.h"
+#include "tinycrypt/aes.h"
+#include "tinycrypt/ccm_mode.h"
+#include "tinycrypt/constants.h"
+#include "tinycrypt/ecc.h"
+#include "tinycrypt/ecc_dsa.h"
+#include "tinycrypt/sha256.h"
+
+static struct tc_aes_key_sched_struct _sched;
+static struct tc_ccm_mode_struct _ccm;
+static uint8_t _nonce[BENCH_CCM_NONCE_LEN];
+static uint8_t _sig[64];
+
+static int _aes_ccm_setup(void)
+{
+    /* tc_ccm_config() keeps a pointer to the nonce */
+    memcpy(_nonce, bench_crypto_nonce, sizeof(_nonce));
+    if (tc_aes128_set_encrypt_key(&_sched, bench_crypto_key) !=
+        TC_CRYPTO_SUCCESS) {
+        return -1;
+    }
+    return tc_ccm_config(&_ccm, &_sched, _nonce, sizeof(_nonce),
+                         BENCH_CCM_TAG_LEN) == TC_CRYPTO_SUCCESS ? 0 : -1;
+}
+
+static int _aes_ccm(void)
+{
+    return tc_ccm_generation_encryption(bench_crypto_out,
+                                        sizeof(bench_crypto_out), NULL, 0,
+                                        bench_crypto_msg,
+                                        BENCH_CRYPTO_MSG_SIZE,
+                                        &_ccm) == TC_CRYPTO_SUCCESS ? 0 : -1;
+}
+
+BENCH_CRYPTO(_tinycrypt_aes_ccm) = {
+    .primitive = BENCH_AES128_CCM,
+    .provider = "tinycrypt",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = BENCH_CRYPTO_MSG_SIZE + BENCH_CCM_TAG_LEN,
+    .setup = _aes_ccm_setup,
+    .op = _aes_ccm,
+};
+
+static int _sha256(void)
+{
+    struct tc_sha256_state_struct s;
+
+    tc_sha256_init(&s);
+    tc_sha256_update(&s, bench_crypto_msg, BENCH_CRYPTO_MSG_SIZE);
+    tc_sha256_final(bench_crypto_out, &s);
+    return 0;
+}
+
+BENCH_CRYPTO(_tinycrypt_sha256) = {
+    .primitive = BENCH_SHA256,
+    .provider = "tinycrypt",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = TC_SHA256_DIGEST_SIZE,
+    .op = _sha256,
+};
+
+/* tinycrypt is built without its platform specific RNG */
+static int _rng(uint8_t *dest, unsigned size)
+{
+    random_bytes(dest, size);
+    return 1;
+}
+
+static int _ecdsa_sign_setup(void)
+{
+    uECC_set_rng(_rng);
+    return 0;
+}
+
+static int _ecdsa_sign(void)
+{
+    return uECC_sign(bench_crypto_p256_priv, bench_crypto_hash,
+                     sizeof(bench_crypto_hash), _sig,
+                     uECC_secp256r1()) == TC_CRYPTO_SUCCESS ? 0 : -1;
+}
+
+BENCH_CRYPTO(_tinycrypt_ecdsa_sign) = {
+    .primitive = BENCH_ECDSA_P256_SIGN,
+    .provider = "tinycrypt",
+    .setup = _ecdsa_sign_setup,
+    .op = _ecdsa_sign,
+};
+
+static int _ecdsa_verify_setup(void)
+{
+    _ecdsa_sign_setup();
+    return _ecdsa_sign();
+}
+
+static int _ecdsa_verify(void)
+{
+    return uECC_verify(bench_crypto_p256_pub, bench_crypto_hash,
+                       sizeof(bench_crypto_hash), _sig,
+                       uECC_secp256r1()) == TC_CRYPTO_SUCCESS ? 0 : -1;
+}
+
+BENCH_CRYPTO(_tinycrypt_ecdsa_verify) = {
+    .primitive = BENCH_ECDSA_P256_VERIFY,
+    .provider = "tinycrypt",
+    .setup = _ecdsa_verify_setup,
+    .op = _ecdsa_verify,
+};
+
+#endif /* MODULE_TINYCRYPT */
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmarks of wolfCrypt, the crypto library of the wolfSSL
+ *              package
+ *
+ * The Ed25519 and ECDSA keys are generated with the wolfCrypt RNG.
+ *
+ * @}
+ */
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_WOLFCRYPT)
+
+#include <stdbool.h>
+
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/aes.h>
+#include <wolfssl/wolfcrypt/chacha20_poly1305.h>
+#include <wolfssl/wolfcrypt/curve25519.h>
+#include <wolfssl/wolfcrypt/ecc.h>
+#include <wolfssl/wolfcrypt/ed25519.h>
+#include <wolfssl/wolfcrypt/random.h>
+#include <wolfssl/wolfcrypt/sha256.h>
+
+#include "bench_crypto.h"
+
+#if IS_USED(MODULE_WOLFCRYPT_ED25519) || IS_USED(MODULE_WOLFCRYPT_ECC)
+static WC_RNG _rng;
+/* DER encoded ECDSA signatures take up to 72 bytes */
+static byte _sig[72];
+static word32 _sig_len;
+
+static int _init_rng(void)
+{
+    static bool initialized;
+
+    if (initialized) {
+        return 0;
+    }
+    if (wc_InitRng(&_rng) != 0) {
+        return -1;
+    }
+    initialized = true;
+    return 0;
+}
+#endif
+
+#if IS_USED(MODULE_WOLFCRYPT_AES)
+static Aes _aes;
+
+static int _aes_ccm_setup(void)
+{
+    return wc_AesCcmSetKey(&_aes, bench_crypto_key, 16) == 0 ? 0 : -1;
+}
+
+static int _aes_ccm(void)
+{
+    return wc_AesCcmEncrypt(&_aes, bench_crypto_out, bench_crypto_msg,
+                            BENCH_CRYPTO_MSG_SIZE, bench_crypto_nonce,
+                            BENCH_CCM_NONCE_LEN,
+                            &bench_crypto_out[BENCH_CRYPTO_MSG_SIZE],
+                            BENCH_CCM_TAG_LEN, NULL, 0) == 0 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_wolfssl_aes_ccm) = {
+    .primitive = BENCH_AES128_CCM,
+    .provider = "wolfssl",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = BENCH_CRYPTO_MSG_SIZE + BENCH_CCM_TAG_LEN,
+    .setup = _aes_ccm_setup,
+    .op = _aes_ccm,
+};
+#endif /* MODULE_WOLFCRYPT_AES */
+
+#if IS_USED(MODULE_WOLFCRYPT_CHACHA20_POLY1305)
+static int _chacha20poly1305(void)
+{
+    return wc_ChaCha20Poly1305_Encrypt(bench_crypto_key, bench_crypto_nonce,
+                                       NULL, 0, bench_crypto_msg,
+                                       BENCH_CRYPTO_MSG_SIZE,
+                                       bench_crypto_out,
+                                       &bench_crypto_out[BENCH_CRYPTO_MSG_SIZE])
+           == 0 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_wolfssl_chacha20poly1305) = {
+    .primitive = BENCH_CHACHA20_POLY1305,
+    .provider = "wolfssl",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = BENCH_CRYPTO_MSG_SIZE + BENCH_AEAD_TAG_LEN,
+    .op = _chacha20poly1305,
+};
+#endif /* MODULE_WOLFCRYPT_CHACHA20_POLY1305 */
+
+static int _sha256(void)
+{
+    wc_Sha256 sha;
+
+    if (wc_InitSha256(&sha) != 0 ||
+        wc_Sha256Update(&sha, bench_crypto_msg, BENCH_CRYPTO_MSG_SIZE) != 0 ||
+        wc_Sha256Final(&sha, bench_crypto_out) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+BENCH_CRYPTO(_wolfssl_sha256) = {
+    .primitive = BENCH_SHA256,
+    .provider = "wolfssl",
+    .msg_size = BENCH_CRYPTO_MSG_SIZE,
+    .out_len = WC_SHA256_DIGEST_SIZE,
+    .op = _sha256,
+};
+
+#if IS_USED(MODULE_WOLFCRYPT_ED25519)
+static ed25519_key _ed25519;
+
+static int _ed25519_setup(void)
+{
+    static bool have_key;
+
+    if (have_key) {
+        return 0;
+    }
+    if (_init_rng() < 0 || wc_ed25519_init(&_ed25519) != 0 ||
+        wc_ed25519_make_key(&_rng, ED25519_KEY_SIZE, &_ed25519) != 0) {
+        return -1;
+    }
+    have_key = true;
+    return 0;
+}
+
+static int _ed25519_sign(void)
+{
+    _sig_len = sizeof(_sig);
+    return wc_ed25519_sign_msg(bench_crypto_hash, sizeof(bench_crypto_hash),
+                               _sig, &_sig_len, &_ed25519) == 0 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_wolfssl_ed25519_sign) = {
+    .primitive = BENCH_ED25519_SIGN,
+    .provider = "wolfssl",
+    .setup = _ed25519_setup,
+    .op = _ed25519_sign,
+};
+
+static int _ed25519_verify_setup(void)
+{
+    if (_ed25519_setup() < 0) {
+        return -1;
+    }
+    return _ed25519_sign();
+}
+
+static int _ed25519_verify(void)
+{
+    int valid = 0;
+
+    if (wc_ed25519_verify_msg(_sig, _sig_len, bench_crypto_hash,
+                              sizeof(bench_crypto_hash), &valid,
+                              &_ed25519) != 0) {
+        return -1;
+    }
+    return valid ? 0 : -1;
+}
+
+BENCH_CRYPTO(_wolfssl_ed25519_verify) = {
+    .primitive = BENCH_ED25519_VERIFY,
+    .provider = "wolfssl",
+    .setup = _ed25519_verify_setup,
+    .op = _ed25519_verify,
+};
+#endif /* MODULE_WOLFCRYPT_ED25519 */
+
+#if IS_USED(MODULE_WOLFCRYPT_ECC)
+static ecc_key _ecc;
+
+static int _ecdsa_setup(void)
+{
+    static bool have_key;
+
+    if (have_key) {
+        return 0;
+    }
+    if (_init_rng() < 0 || wc_ecc_init(&_ecc) != 0 ||
+        wc_ecc_make_key(&_rng, 32, &_ecc) != 0) {
+        return -1;
+    }
+    have_key = true;
+    return 0;
+}
+
+static int _ecdsa_sign(void)
+{
+    _sig_len = sizeof(_sig);
+    return wc_ecc_sign_hash(bench_crypto_hash, sizeof(bench_crypto_hash),
+                            _sig, &_sig_len, &_rng, &_ecc) == 0 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_wolfssl_ecdsa_sign) = {
+    .primitive = BENCH_ECDSA_P256_SIGN,
+    .provider = "wolfssl",
+    .setup = _ecdsa_setup,
+    .op = _ecdsa_sign,
+};
+
+static int _ecdsa_verify_setup(void)
+{
+    if (_ecdsa_setup() < 0) {
+        return -1;
+    }
+    return _ecdsa_sign();
+}
+
+static int _ecdsa_verify(void)
+{
+    int valid = 0;
+
+    if (wc_ecc_verify_hash(_sig, _sig_len, bench_crypto_hash,
+                           sizeof(bench_crypto_hash), &valid, &_ecc) != 0) {
+        return -1;
+    }
+    return valid ? 0 : -1;
+}
+
+BENCH_CRYPTO(_wolfssl_ecdsa_verify) = {
+    .primitive = BENCH_ECDSA_P256_VERIFY,
+    .provider = "wolfssl",
+    .setup = _ecdsa_verify_setup,
+    .op = _ecdsa_verify,
+};
+#endif /* MODULE_WOLFCRYPT_ECC */
+
+#if IS_USED(MODULE_WOLFCRYPT_CURVE25519)
+static curve25519_key _x25519_priv;
+static curve25519_key _x25519_pub;
+
+static int _x25519_setup(void)
+{
+    wc_curve25519_init(&_x25519_priv);
+    wc_curve25519_init(&_x25519_pub);
+    if (wc_curve25519_import_private_ex(bench_crypto_x25519_priv, 32,
+                                        &_x25519_priv,
+                                        EC25519_LITTLE_ENDIAN) != 0 ||
+        wc_curve25519_import_public_ex(bench_crypto_x25519_pub, 32,
+                                       &_x25519_pub,
+                                       EC25519_LITTLE_ENDIAN) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static int _x25519(void)
+{
+    word32 len = 32;
+
+    return wc_curve25519_shared_secret_ex(&_x25519_priv, &_x25519_pub,
+                                          bench_crypto_out, &len,
+                                          EC25519_LITTLE_ENDIAN) == 0 ? 0 : -1;
+}
+
+BENCH_CRYPTO(_wolfssl_x25519) = {
+    .primitive = BENCH_X25519,
+    .provider = "wolfssl",
+    .out_len = 32,
+    .setup = _x25519_setup,
+    .op = _x25519,
+};
+#endif /* MODULE_WOLFCRYPT_CURVE25519 */
+
+#endif /* MODULE_WOLFCRYPT */
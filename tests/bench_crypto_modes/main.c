@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark for the block cipher modes
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ecb.h"
+#include "crypto/modes/gcm.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#ifndef BUF_SIZE
+#define BUF_SIZE        (1024U)
+#endif
+#ifndef RUNS
+#define RUNS            (64U)
+#endif
+
+#define MAC_LEN         (8U)
+#define TAG_LEN         (16U)
+
+#if IS_USED(MODULE_CRYPTO_AES_NI)
+#define BACKEND         "AES-NI"
+#elif IS_USED(MODULE_CRYPTO_AES_ARMV8)
+#define BACKEND         "ARMv8-CE"
+#elif IS_USED(MODULE_CRYPTO_AES_CT)
+#define BACKEND         "constant-time"
+#else
+#define BACKEND         "T-table"
+#endif
+
+static const uint8_t _key[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+};
+static const uint8_t _nonce[13] = { 0 };
+
+static uint8_t _in[BUF_SIZE];
+static uint8_t _out[BUF_SIZE + TAG_LEN];
+static cipher_t _cipher;
+
+static void _print(const char *name, uint32_t start)
+{
+    uint32_t time = xtimer_now_usec() - start;
+    uint32_t bytes = BUF_SIZE * RUNS;
+
+    printf("%-12s %8" PRIu32 " bytes in %8" PRIu32 " us, %8" PRIu32
+           " KiB/s\n", name, bytes, time,
+           (uint32_t)((uint64_t)bytes * 1000000 / 1024 / (time ? time : 1)));
+}
+
+static int _ecb(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        if (cipher_encrypt_ecb(&_cipher, _in, BUF_SIZE, _out) < 0) {
+            return -1;
+        }
+    }
+    _print("ecb", start);
+    return 0;
+}
+
+static int _cbc(void)
+{
+    uint8_t iv[16] = { 0 };
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        if (cipher_encrypt_cbc(&_cipher, iv, _in, BUF_SIZE, _out) < 0) {
+            return -1;
+        }
+    }
+    _print("cbc encrypt", start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS; i++) {
+        if (cipher_decrypt_cbc(&_cipher, iv, _in, BUF_SIZE, _out) < 0) {
+            return -1;
+        }
+    }
+    _print("cbc decrypt", start);
+    return 0;
+}
+
+static int _ctr(void)
+{
+    uint8_t ctr[16] = { 0 };
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        if (cipher_encrypt_ctr(&_cipher, ctr, 8, _in, BUF_SIZE, _out) < 0) {
+            return -1;
+        }
+    }
+    _print("ctr", start);
+    return 0;
+}
+
+static int _ccm(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        if (cipher_encrypt_ccm(&_cipher, NULL, 0, MAC_LEN, 2, _nonce,
+                               sizeof(_nonce), _in, BUF_SIZE, _out) < 0) {
+            return -1;
+        }
+    }
+    _print("ccm", start);
+    return 0;
+}
+
+static int _gcm(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        if (cipher_encrypt_gcm(&_cipher, NULL, 0, TAG_LEN, _nonce,
+                               GCM_NONCE_LEN, _in, BUF_SIZE, _out) < 0) {
+            return -1;
+        }
+    }
+    _print("gcm encrypt", start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS; i++) {
+        if (cipher_decrypt_gcm(&_cipher, NULL, 0, TAG_LEN, _nonce,
+                               GCM_NONCE_LEN, _out, BUF_SIZE + TAG_LEN,
+                               _in) < 0) {
+            return -1;
+        }
+    }
+    _print("gcm decrypt", start);
+    return 0;
+}
+
+int main(void)
+{
+    memset(_in, 0x5a, sizeof(_in));
+    cipher_init(&_cipher, CIPHER_AES, _key, sizeof(_key));
+
+    printf("AES-128 (" BACKEND "), %u byte messages\n", BUF_SIZE);
+
+    if (_ecb() < 0 || _cbc() < 0 || _ctr() < 0 || _ccm() < 0 ||
+        _gcm() < 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Builds this application for every given fragment forwarding scheme, runs a
+line of instances of it connected via `zep_dispatch`, statically routes between
+both ends and prints the goodput of datagrams sent from the first to the last
+node for each scheme.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+import pexpect
+
+APPDIR = os.path.dirname(os.path.realpath(__file__))
+RIOTBASE = os.environ.get("RIOTBASE",
+                          os.path.realpath(os.path.join(APPDIR, "..", "..")))
+ZEP_DISPATCH_DIR = os.path.join(RIOTBASE, "dist", "tools", "zep_dispatch")
+ZEP_DISPATCH = os.path.join(ZEP_DISPATCH_DIR, "bin", "zep_dispatch")
+ZEP_PORT = 17754
+PROMPT = "> "
+PREFIX = "2001:db8::"
+
+
+def build(impl):
+    env = dict(os.environ, BOARD="native", FWD_IMPL=impl,
+               BINDIRBASE=os.path.join(APPDIR, "bin", impl))
+    subprocess.run(["make", "-C", APPDIR, "all"], env=env, check=True,
+                   stdout=subprocess.DEVNULL)
+    return os.path.join(APPDIR, "bin", impl, "native",
+                        "tests_bench_gnrc_sixlowpan_frag_fwd.elf")
+
+
+def write_topology(nodes, fobj):
+    # a line: every node only hears its direct neighbors
+    for i in range(nodes - 1):
+        fobj.write("n{}\tn{}\n".format(i, i + 1))
+    fobj.flush()
+
+
+def cmd(node, line):
+    node.sendline(line)
+    node.expect_exact(PROMPT)
+    return node.before
+
+
+class Node:
+    def __init__(self, elf, num):
+        self.num = num
+        self.term = pexpect.spawn(elf, ["-z", "[::1]:{}".format(ZEP_PORT)],
+                                  encoding="utf-8", timeout=10)
+        self.term.expect_exact("Fragment forwarding:")
+        self.term.expect_exact(PROMPT)
+        out = cmd(self.term, "ifconfig")
+        self.iface = re.search(r"Iface\s+(\d+)", out).group(1)
+        self.l2addr = re.search(r"Long HWaddr: ([0-9A-Fa-f:]+)",
+                                out).group(1)
+        self.ll_addr = re.search(r"inet6 addr: (fe80:[0-9a-f:]+)",
+                                 out).group(1)
+        self.addr = "{}{:x}".format(PREFIX, num + 1)
+
+    def configure(self, nodes):
+        cmd(self.term, "ifconfig {} add {}/128".format(self.iface, self.addr))
+        neighbors = {}
+        if self.num > 0:
+            neighbors["left"] = nodes[self.num - 1]
+        if (self.num + 1) < len(nodes):
+            neighbors["right"] = nodes[self.num + 1]
+        for neighbor in neighbors.values():
+            cmd(self.term, "nib neigh add {} {} {}".format(
+                self.iface, neighbor.ll_addr, neighbor.l2addr))
+        for other in nodes:
+            if other.num == self.num:
+                continue
+            next_hop = neighbors["left" if other.num < self.num else "right"]
+            cmd(self.term, "nib route add {} {}/128 {}".format(
+                self.iface, other.addr, next_hop.ll_addr))
+
+    def terminate(self):
+        self.term.terminate(force=True)
+
+
+def run(impl, elf, args):
+    with tempfile.NamedTemporaryFile("w", suffix=".topo") as topo:
+        write_topology(args.hops + 1, topo)
+        dispatch = subprocess.Popen([ZEP_DISPATCH, "-t", topo.name,
+                                     "::1", str(ZEP_PORT)],
+                                    stdout=subprocess.DEVNULL)
+        nodes = []
+        try:
+            # order matters: nodes are bound to the topology in order of
+            # their first frame sent
+            for i in range(args.hops + 1):
+                nodes.append(Node(elf, i))
+            for node in nodes:
+                node.configure(nodes)
+            sender, receiver = nodes[0], nodes[-1]
+            sender.term.sendline("bench {} {} {} {}".format(
+                receiver.addr, args.size, args.count, args.window))
+            sender.term.expect(r"(\{\"impl\":.*\"goodput_bps\":\d+\})",
+                               timeout=args.count * 6)
+            res = json.loads(sender.term.match.group(1))
+            # statistics of the forwarder next to the sender
+            if len(nodes) > 2:
+                nodes[1].term.sendline("fwd_stats")
+                nodes[1].term.expect(r"(\{\"impl\":.*\})")
+                res["forwarder"] = json.loads(nodes[1].term.match.group(1))
+            return res
+        finally:
+            for node in nodes:
+                node.terminate()
+            dispatch.terminate()
+            dispatch.wait()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-H", "--hops", type=int, default=3,
+                        help="number of hops between sender and receiver")
+    parser.add_argument("-n", "--count", type=int, default=100,
+                        help="number of datagrams to send")
+    parser.add_argument("-l", "--size", type=int, default=1000,
+                        help="UDP payload size of the datagrams")
+    parser.add_argument("-w", "--window", type=int, default=1,
+                        help="number of datagrams in flight")
+    parser.add_argument("impls", nargs="*",
+                        default=["reass", "minfwd", "sfr"],
+                        help="fragment forwarding schemes to compare")
+    args = parser.parse_args()
+
+    if args.hops < 1:
+        parser.error("at least one hop is required")
+    subprocess.run(["make", "-C", ZEP_DISPATCH_DIR], check=True,
+                   stdout=subprocess.DEVNULL)
+    results = [run(impl, build(impl), args) for impl in args.impls]
+    columns = ["impl", "completed", "time_us", "goodput_bps"]
+    print(" | ".join(columns + ["forwarder"]))
+    for res in results:
+        print(" | ".join([str(res[col]) for col in columns] +
+                         [json.dumps(res.get("forwarder", {}))]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Goodput of 6LoWPAN fragment forwarding over a multi-hop ZEP
+ *              topology
+ *
+ * Every node runs a UDP server on port 61616 that answers each received
+ * datagram with its 4-byte sequence number. The `bench` command sends
+ * datagrams that need to be fragmented to such a server, keeping up to a
+ * given number of them in flight, and measures the time until all answers
+ * arrived.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/sixlowpan/frag/stats.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define BENCH_PORT              (61616U)
+/* IPv6 minimum MTU - IPv6 header - UDP header */
+#define BENCH_PAYLOAD_MAX       (1232U)
+#define BENCH_TIMEOUT_MS        (5000U)
+#define MAIN_QUEUE_SIZE         (8U)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _server_buf[BENCH_PAYLOAD_MAX];
+static uint8_t _bench_buf[BENCH_PAYLOAD_MAX];
+
+static void *_server(void *arg)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+
+    (void)arg;
+    local.port = BENCH_PORT;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("Unable to create server sock");
+        return NULL;
+    }
+    while (1) {
+        sock_udp_ep_t remote;
+        ssize_t res = sock_udp_recv(&sock, _server_buf, sizeof(_server_buf),
+                                    SOCK_NO_TIMEOUT, &remote);
+
+        if (res >= (ssize_t)sizeof(uint32_t)) {
+            /* echo sequence number only, so the answer is not fragmented */
+            sock_udp_send(&sock, _server_buf, sizeof(uint32_t), &remote);
+        }
+    }
+    return NULL;
+}
+
+static int _bench(int argc, char **argv)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = BENCH_PORT };
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    unsigned size, count, window = 1, completed = 0;
+    uint32_t start, duration, sent = 0;
+    sock_udp_t sock;
+
+    if (argc < 4) {
+        printf("usage: %s <addr> <size> <count> [<window>]\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, argv[1]) == NULL) {
+        printf("Unable to parse address %s\n", argv[1]);
+        return 1;
+    }
+    size = atoi(argv[2]);
+    count = atoi(argv[3]);
+    if (argc > 4) {
+        window = atoi(argv[4]);
+    }
+    if ((size < sizeof(uint32_t)) || (size > BENCH_PAYLOAD_MAX)) {
+        printf("size must be between %u and %u\n", (unsigned)sizeof(uint32_t),
+               BENCH_PAYLOAD_MAX);
+        return 1;
+    }
+    if (window == 0) {
+        puts("window must be at least 1");
+        return 1;
+    }
+    if (netif == NULL) {
+        puts("No network interface found");
+        return 1;
+    }
+    remote.netif = netif->pid;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("Unable to create sock");
+        return 1;
+    }
+    start = xtimer_now_usec();
+    while (completed < count) {
+        uint32_t ack;
+        ssize_t res;
+
+        /* answers are not guaranteed, so only the number of outstanding
+         * datagrams limits the window */
+        while ((sent < count) && ((sent - completed) < window)) {
+            memset(_bench_buf, (uint8_t)sent, size);
+            memcpy(_bench_buf, &sent, sizeof(sent));
+            if (sock_udp_send(&sock, _bench_buf, size, &remote) < 0) {
+                break;
+            }
+            sent++;
+        }
+        res = sock_udp_recv(&sock, &ack, sizeof(ack),
+                            BENCH_TIMEOUT_MS * US_PER_MS, NULL);
+        if (res == -ETIMEDOUT) {
+            break;
+        }
+        if ((res == sizeof(ack)) && (ack < sent)) {
+            completed++;
+        }
+    }
+    duration = xtimer_now_usec() - start;
+    sock_udp_close(&sock);
+    printf("{\"impl\":\"%s\",\"size\":%u,\"count\":%u,\"window\":%u,"
+           "\"completed\":%u,\"time_us\":%lu,\"goodput_bps\":%lu}\n",
+           FWD_IMPL, size, count, window, completed, (unsigned long)duration,
+           (unsigned long)(((uint64_t)completed * size * 8U * US_PER_SEC) /
+                           (duration ? duration : 1U)));
+    return 0;
+}
+
+static int _fwd_stats(int argc, char **argv)
+{
+    gnrc_sixlowpan_frag_stats_t *stats = gnrc_sixlowpan_frag_stats_get();
+
+    (void)argc;
+    (void)argv;
+    printf("{\"impl\":\"%s\",\"rbuf_full\":%u,\"frag_full\":%u,"
+           "\"datagrams\":%u,\"fragments\":%u", FWD_IMPL,
+           stats->rbuf_full, stats->frag_full, stats->datagrams,
+           stats->fragments);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    printf(",\"vrb_full\":%u", stats->vrb_full);
+#endif
+    puts("}");
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "bench", "send datagrams to a bench server and measure goodput",
+      _bench },
+    { "fwd_stats", "print fragmentation statistics as JSON", _fwd_stats },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _server, NULL, "bench_server");
+    printf("Fragment forwarding: %s\n", FWD_IMPL);
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Builds this application for every given SFR congestion control algorithm,
+runs two instances of it connected via a lossy `zep_dispatch` topology and
+prints the datagram completion times and retransmissions for each algorithm.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+import pexpect
+
+APPDIR = os.path.dirname(os.path.realpath(__file__))
+RIOTBASE = os.environ.get("RIOTBASE",
+                          os.path.realpath(os.path.join(APPDIR, "..", "..")))
+ZEP_DISPATCH_DIR = os.path.join(RIOTBASE, "dist", "tools", "zep_dispatch")
+ZEP_DISPATCH = os.path.join(ZEP_DISPATCH_DIR, "bin", "zep_dispatch")
+ZEP_PORT = 17754
+PROMPT = "> "
+
+
+def build(algorithm):
+    env = dict(os.environ, BOARD="native", CONGURE_IMPL=algorithm,
+               BINDIRBASE=os.path.join(APPDIR, "bin", algorithm))
+    subprocess.run(["make", "-C", APPDIR, "all"], env=env, check=True,
+                   stdout=subprocess.DEVNULL)
+    return os.path.join(APPDIR, "bin", algorithm, "native",
+                        "tests_bench_gnrc_sixlowpan_frag_sfr_congure.elf")
+
+
+def spawn_node(elf):
+    node = pexpect.spawn(elf, ["-z", "[::1]:{}".format(ZEP_PORT)],
+                         encoding="utf-8", timeout=10)
+    node.expect_exact("SFR congestion control:")
+    node.expect_exact(PROMPT)
+    return node
+
+
+def link_local_addr(node):
+    node.sendline("ifconfig")
+    node.expect(r"inet6 addr: (fe80:[0-9a-f:]+)\s+scope: link")
+    addr = node.match.group(1)
+    node.expect_exact(PROMPT)
+    return addr
+
+
+def run(algorithm, elf, args):
+    dispatch = subprocess.Popen([ZEP_DISPATCH, "-t", args.topology,
+                                 "-s", str(args.seed), "::1", str(ZEP_PORT)],
+                                stdout=subprocess.DEVNULL)
+    nodes = []
+    try:
+        # order matters: nodes are bound to the topology in order of their
+        # first frame sent
+        nodes.append(spawn_node(elf))
+        nodes.append(spawn_node(elf))
+        sender, receiver = nodes
+        addr = link_local_addr(receiver)
+        sender.sendline("bench {} {} {} {}".format(addr, args.size, args.count,
+                                                  args.timeout))
+        sender.expect(r"(\{\"algorithm\":.*\})",
+                      timeout=args.count * (args.timeout / 1000 + 1))
+        return json.loads(sender.match.group(1))
+    finally:
+        for node in nodes:
+            node.terminate(force=True)
+        dispatch.terminate()
+        dispatch.wait()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-t", "--topology",
+                        default=os.path.join(APPDIR, "lossy.topo"),
+                        help="zep_dispatch topology file")
+    parser.add_argument("-s", "--seed", type=int, default=1,
+                        help="seed for the packet loss of zep_dispatch")
+    parser.add_argument("-n", "--count", type=int, default=50,
+                        help="number of datagrams to send")
+    parser.add_argument("-l", "--size", type=int, default=1000,
+                        help="UDP payload size of the datagrams")
+    parser.add_argument("-w", "--timeout", type=int, default=5000,
+                        help="timeout for a datagram in ms")
+    parser.add_argument("algorithms", nargs="*",
+                        default=["none", "aimd", "reno"],
+                        help="congestion control algorithms to compare")
+    args = parser.parse_args()
+
+    subprocess.run(["make", "-C", ZEP_DISPATCH_DIR], check=True,
+                   stdout=subprocess.DEVNULL)
+    results = [run(alg, build(alg), args) for alg in args.algorithms]
+    columns = ["algorithm", "completed", "time_min_us", "time_avg_us",
+               "time_max_us", "fragments", "resends_nack", "resends_timeout",
+               "datagram_resends", "aborts"]
+    print(" | ".join(columns))
+    for res in results:
+        print(" | ".join(str(res[col]) for col in columns))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
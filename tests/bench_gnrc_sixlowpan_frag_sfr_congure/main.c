@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Datagram completion time of selective fragment recovery with
+ *              different congestion control algorithms over a lossy ZEP link
+ *
+ * Every node runs a UDP server on port 61616 that answers each received
+ * datagram with its 4-byte sequence number. The `bench` command sends
+ * datagrams that need to be fragmented one after another to such a server and
+ * measures the time until the answer arrived.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define BENCH_PORT              (61616U)
+/* IPv6 minimum MTU - IPv6 header - UDP header */
+#define BENCH_PAYLOAD_MAX       (1232U)
+#define BENCH_TIMEOUT_MS        (5000U)
+#define MAIN_QUEUE_SIZE         (8U)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _server_buf[BENCH_PAYLOAD_MAX];
+static uint8_t _bench_buf[BENCH_PAYLOAD_MAX];
+
+static void *_server(void *arg)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+
+    (void)arg;
+    local.port = BENCH_PORT;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("Unable to create server sock");
+        return NULL;
+    }
+    while (1) {
+        sock_udp_ep_t remote;
+        ssize_t res = sock_udp_recv(&sock, _server_buf, sizeof(_server_buf),
+                                    SOCK_NO_TIMEOUT, &remote);
+
+        if (res >= (ssize_t)sizeof(uint32_t)) {
+            /* echo sequence number only, so the answer is not fragmented */
+            sock_udp_send(&sock, _server_buf, sizeof(uint32_t), &remote);
+        }
+    }
+    return NULL;
+}
+
+static int _wait_for_ack(sock_udp_t *sock, uint32_t seq, uint32_t timeout_us)
+{
+    uint32_t start = xtimer_now_usec();
+
+    while (1) {
+        uint32_t elapsed = xtimer_now_usec() - start;
+        uint32_t ack;
+        ssize_t res;
+
+        if (elapsed >= timeout_us) {
+            return -ETIMEDOUT;
+        }
+        res = sock_udp_recv(sock, &ack, sizeof(ack), timeout_us - elapsed,
+                            NULL);
+        if (res == -ETIMEDOUT) {
+            return res;
+        }
+        if ((res == sizeof(ack)) && (ack == seq)) {
+            return 0;
+        }
+        /* ignore late answers to previous datagrams */
+    }
+}
+
+static int _bench(int argc, char **argv)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = BENCH_PORT };
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    gnrc_sixlowpan_frag_sfr_stats_t before, after;
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    uint32_t timeout_ms = BENCH_TIMEOUT_MS;
+    uint32_t min = UINT32_MAX, max = 0;
+    uint64_t sum = 0;
+    unsigned size, count, completed = 0;
+    sock_udp_t sock;
+
+    if (argc < 4) {
+        printf("usage: %s <addr> <size> <count> [<timeout in ms>]\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, argv[1]) == NULL) {
+        printf("Unable to parse address %s\n", argv[1]);
+        return 1;
+    }
+    size = atoi(argv[2]);
+    count = atoi(argv[3]);
+    if (argc > 4) {
+        timeout_ms = atoi(argv[4]);
+    }
+    if ((size < sizeof(uint32_t)) || (size > BENCH_PAYLOAD_MAX)) {
+        printf("size must be between %u and %u\n", (unsigned)sizeof(uint32_t),
+               BENCH_PAYLOAD_MAX);
+        return 1;
+    }
+    if (netif == NULL) {
+        puts("No network interface found");
+        return 1;
+    }
+    remote.netif = netif->pid;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("Unable to create sock");
+        return 1;
+    }
+    gnrc_sixlowpan_frag_sfr_stats_get(&before);
+    for (uint32_t seq = 0; seq < count; seq++) {
+        uint32_t start, duration;
+
+        memset(_bench_buf, (uint8_t)seq, size);
+        memcpy(_bench_buf, &seq, sizeof(seq));
+        start = xtimer_now_usec();
+        if (sock_udp_send(&sock, _bench_buf, size, &remote) < 0) {
+            continue;
+        }
+        if (_wait_for_ack(&sock, seq, timeout_ms * US_PER_MS) < 0) {
+            continue;
+        }
+        duration = xtimer_now_usec() - start;
+        completed++;
+        sum += duration;
+        if (duration < min) {
+            min = duration;
+        }
+        if (duration > max) {
+            max = duration;
+        }
+    }
+    gnrc_sixlowpan_frag_sfr_stats_get(&after);
+    sock_udp_close(&sock);
+    printf("{\"algorithm\":\"%s\",\"size\":%u,\"count\":%u,\"completed\":%u,"
+           "\"time_min_us\":%lu,\"time_avg_us\":%lu,\"time_max_us\":%lu,"
+           "\"fragments\":%lu,\"resends_nack\":%lu,\"resends_timeout\":%lu,"
+           "\"datagram_resends\":%lu,\"aborts\":%lu}\n",
+           CONGURE_IMPL, size, count, completed,
+           (unsigned long)(completed ? min : 0),
+           (unsigned long)(completed ? (sum / completed) : 0),
+           (unsigned long)max,
+           (unsigned long)(after.fragments_sent.usual -
+                           before.fragments_sent.usual),
+           (unsigned long)(after.fragment_resends.by_nack -
+                           before.fragment_resends.by_nack),
+           (unsigned long)(after.fragment_resends.by_timeout -
+                           before.fragment_resends.by_timeout),
+           (unsigned long)(after.datagram_resends - before.datagram_resends),
+           (unsigned long)(after.fragments_sent.aborts -
+                           before.fragments_sent.aborts));
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "bench", "send datagrams to a bench server and measure completion time",
+      _bench },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _server, NULL, "bench_server");
+    printf("SFR congestion control: %s\n", CONGURE_IMPL);
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
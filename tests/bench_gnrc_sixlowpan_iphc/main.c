@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for the IPHC encoder of GNRC's 6LoWPAN layer
+ *
+ * A synthetic UDP flow is compressed and handed to a mocked IEEE 802.15.4
+ * interface, so the calls per second reported are encoded packets per second.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+#include "net/l2util.h"
+#include "net/netdev_test.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define TEST_SRC_L2         { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_DST_L2         { 0x5a, 0x9d, 0x93, 0x86, 0x22, 0x08, 0x65, 0x79 }
+#define TEST_PREFIX         { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00 }
+#define TEST_PREFIX_LEN     (64U)
+#define TEST_PORT           (5683U)
+#define TEST_PAYLOAD_LEN    (32U)
+
+static const uint8_t _src_l2[] = TEST_SRC_L2;
+static const uint8_t _dst_l2[] = TEST_DST_L2;
+static const uint8_t _payload[TEST_PAYLOAD_LEN] = { 0 };
+
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _mock_dev;
+static gnrc_netif_t _netif;
+
+static unsigned _sent;
+static uint8_t _frame[IEEE802154_FRAME_LEN_MAX];
+static size_t _frame_len;
+
+static ipv6_addr_t _ll_src, _ll_dst;
+static ipv6_addr_t _global_src, _global_dst;
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    _frame_len = 0;
+    for (const iolist_t *ptr = iolist; ptr != NULL; ptr = ptr->iol_next) {
+        if ((_frame_len + ptr->iol_len) <= sizeof(_frame)) {
+            memcpy(&_frame[_frame_len], ptr->iol_base, ptr->iol_len);
+        }
+        _frame_len += ptr->iol_len;
+    }
+    _sent++;
+    return _frame_len;
+}
+
+static void _send_udp(const ipv6_addr_t *src, const ipv6_addr_t *dst)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                          GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return;
+    }
+    hdr = gnrc_udp_hdr_build(pkt, TEST_PORT, TEST_PORT);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    pkt = hdr;
+    hdr = gnrc_ipv6_hdr_build(pkt, src, dst);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ((ipv6_hdr_t *)hdr->data)->nh = PROTNUM_UDP;
+    ((ipv6_hdr_t *)hdr->data)->hl = 64;
+    pkt = hdr;
+    hdr = gnrc_netif_hdr_build(NULL, 0, _dst_l2, sizeof(_dst_l2));
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    gnrc_netif_hdr_set_netif(hdr->data, &_netif);
+    hdr->next = pkt;
+    gnrc_sixlowpan_iphc_send(hdr, NULL, 0);
+}
+
+static void _send_udp_flushed(const ipv6_addr_t *src, const ipv6_addr_t *dst)
+{
+    gnrc_sixlowpan_iphc_cache_flush();
+    _send_udp(src, dst);
+}
+
+/* checks that the frame compressed from the flow cache is the same as the one
+ * compressed from scratch */
+static bool _check_flow(const char *name, const ipv6_addr_t *src,
+                        const ipv6_addr_t *dst)
+{
+    uint8_t cold[sizeof(_frame)];
+    size_t cold_len;
+
+    _send_udp_flushed(src, dst);
+    memcpy(cold, _frame, sizeof(cold));
+    cold_len = _frame_len;
+    _send_udp(src, dst);
+    /* skip sequence number at index 2 of the IEEE 802.15.4 header */
+    if ((cold_len == 0) || (cold_len != _frame_len) ||
+        (memcmp(cold, _frame, 2) != 0) ||
+        (memcmp(&cold[3], &_frame[3], cold_len - 3) != 0)) {
+        printf("%s: cached compression differs\n", name);
+        return false;
+    }
+    printf("%s: %u byte frame\n", name, (unsigned)cold_len);
+    return true;
+}
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(gnrc_nettype_t));
+    (void)netdev;
+
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_netdev_max_pdu_size(netdev_t *netdev, void *value,
+                                    size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = IEEE802154_FRAME_LEN_MAX;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_src_l2);
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len >= sizeof(_src_l2));
+    memcpy(value, _src_l2, sizeof(_src_l2));
+    return sizeof(_src_l2);
+}
+
+static void _init_mock_netif(void)
+{
+    netdev_test_setup(&_mock_dev, NULL);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_DEVICE_TYPE,
+                           _get_netdev_device_type);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_PROTO,
+                           _get_netdev_proto);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_MAX_PDU_SIZE,
+                           _get_netdev_max_pdu_size);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_SRC_LEN,
+                           _get_netdev_src_len);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_ADDRESS_LONG,
+                           _get_netdev_addr_long);
+    netdev_test_set_send_cb(&_mock_dev, _send);
+    gnrc_netif_ieee802154_create(&_netif, _mock_netif_stack,
+                                 THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+                                 "mock_netif", (netdev_t *)&_mock_dev);
+    thread_yield_higher();
+}
+
+static void _init_addrs(void)
+{
+    static const uint8_t prefix[] = TEST_PREFIX;
+    eui64_t iid;
+
+    expect(l2util_ipv6_iid_from_addr(NETDEV_TYPE_IEEE802154, _src_l2,
+                                     sizeof(_src_l2), &iid) > 0);
+    ipv6_addr_set_link_local_prefix(&_ll_src);
+    ipv6_addr_set_aiid(&_ll_src, iid.uint8);
+    memcpy(&_global_src, prefix, sizeof(prefix));
+    ipv6_addr_set_aiid(&_global_src, iid.uint8);
+
+    expect(l2util_ipv6_iid_from_addr(NETDEV_TYPE_IEEE802154, _dst_l2,
+                                     sizeof(_dst_l2), &iid) > 0);
+    ipv6_addr_set_link_local_prefix(&_ll_dst);
+    ipv6_addr_set_aiid(&_ll_dst, iid.uint8);
+    memcpy(&_global_dst, prefix, sizeof(prefix));
+    ipv6_addr_set_aiid(&_global_dst, iid.uint8);
+
+    expect(gnrc_sixlowpan_ctx_update(0, &_global_src, TEST_PREFIX_LEN,
+                                     UINT16_MAX, true) != NULL);
+}
+
+int main(void)
+{
+    puts("6LoWPAN IPHC encoding benchmark\n");
+
+    _init_mock_netif();
+    _init_addrs();
+
+    if (!_check_flow("link-local flow", &_ll_src, &_ll_dst) ||
+        !_check_flow("context flow", &_global_src, &_global_dst)) {
+        puts("[FAILURE]");
+        return 1;
+    }
+    puts("");
+
+    _sent = 0;
+    BENCHMARK_FUNC("link-local flow, flow cache", BENCH_RUNS,
+                   _send_udp(&_ll_src, &_ll_dst));
+    BENCHMARK_FUNC("link-local flow, flushed cache", BENCH_RUNS,
+                   _send_udp_flushed(&_ll_src, &_ll_dst));
+    BENCHMARK_FUNC("context flow, flow cache", BENCH_RUNS,
+                   _send_udp(&_global_src, &_global_dst));
+    BENCHMARK_FUNC("context flow, flushed cache", BENCH_RUNS,
+                   _send_udp_flushed(&_global_src, &_global_dst));
+    printf("\n%u packets encoded\n", _sent);
+
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+
+
+def testfunc(child):
+    child.expect_exact("6LoWPAN IPHC encoding benchmark")
+    child.expect(r"link-local flow: \d+ byte frame")
+    child.expect(r"context flow: \d+ byte frame")
+    for flow in ["link-local flow", "context flow"]:
+        child.expect(BENCHMARK_REGEXP.format(func=flow + ", flow cache"),
+                     timeout=TIMEOUT)
+        child.expect(BENCHMARK_REGEXP.format(func=flow + ", flushed cache"),
+                     timeout=TIMEOUT)
+    child.expect(r"\d+ packets encoded")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
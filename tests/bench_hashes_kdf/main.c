@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       PBKDF2 and HKDF benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/hkdf.h"
+#include "hashes/pbkdf2.h"
+#include "hashes/sha256.h"
+#include "xtimer.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS      (4096U)
+#endif
+#ifndef HKDF_RUNS
+#define HKDF_RUNS       (1000U)
+#endif
+
+static const char _password[] = "password";
+static const char _salt[] = "salt";
+static const char _info[] = "bench_hashes_kdf";
+
+/* PBKDF2 with a full hmac_sha256() per iteration, i.e. compressing both key
+ * pads again for each iteration */
+static void _pbkdf2_ref(const uint8_t *password, size_t password_len,
+                        const uint8_t *salt, size_t salt_len,
+                        unsigned iterations, uint8_t *output)
+{
+    hmac_context_t ctx;
+    uint8_t u[SHA256_DIGEST_LENGTH];
+
+    hmac_sha256_init(&ctx, password, password_len);
+    hmac_sha256_update(&ctx, salt, salt_len);
+    hmac_sha256_update(&ctx, "\x00\x00\x00\x01", 4);
+    hmac_sha256_final(&ctx, u);
+    memcpy(output, u, sizeof(u));
+
+    while (--iterations) {
+        hmac_sha256(password, password_len, u, sizeof(u), u);
+        for (unsigned i = 0; i < sizeof(u); i++) {
+            output[i] ^= u[i];
+        }
+    }
+}
+
+static void _print(const char *name, unsigned ops, const char *unit,
+                   uint32_t time)
+{
+    if (time == 0) {
+        time = 1;
+    }
+    printf("%15s: %8u %s in %8" PRIu32 " us, %8" PRIu32 " %s/s\n",
+           name, ops, unit, time, (uint32_t)((uint64_t)ops * 1000000 / time),
+           unit);
+}
+
+int main(void)
+{
+    uint8_t key[PBKDF2_KEY_SIZE];
+    uint8_t ref[PBKDF2_KEY_SIZE];
+    uint8_t okm[2 * SHA256_DIGEST_LENGTH];
+    uint32_t start;
+
+    puts("PBKDF2-HMAC-SHA-256 and HKDF-SHA-256");
+
+    start = xtimer_now_usec();
+    _pbkdf2_ref((const uint8_t *)_password, strlen(_password),
+                (const uint8_t *)_salt, strlen(_salt), ITERATIONS, ref);
+    _print("hmac_sha256", ITERATIONS, "iter", xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    pbkdf2_sha256((const uint8_t *)_password, strlen(_password),
+                  (const uint8_t *)_salt, strlen(_salt), ITERATIONS, key);
+    _print("pbkdf2_sha256", ITERATIONS, "iter", xtimer_now_usec() - start);
+
+    if (memcmp(key, ref, sizeof(key))) {
+        puts("[FAILED] pbkdf2_sha256() differs from the reference");
+        return 1;
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < HKDF_RUNS; i++) {
+        hkdf_sha256(_salt, strlen(_salt), _password, strlen(_password),
+                    _info, strlen(_info), okm, sizeof(okm));
+    }
+    _print("hkdf_sha256", HKDF_RUNS, "ops", xtimer_now_usec() - start);
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
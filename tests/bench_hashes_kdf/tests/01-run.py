@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+RESULT = r": +[0-9]+ {0} in +[0-9]+ us, +[0-9]+ {0}/s\r\n"
+
+
+def testfunc(child):
+    child.expect_exact("PBKDF2-HMAC-SHA-256 and HKDF-SHA-256\r\n")
+    child.expect(r" *hmac_sha256" + RESULT.format("iter"))
+    child.expect(r" *pbkdf2_sha256" + RESULT.format("iter"))
+    child.expect(r" *hkdf_sha256" + RESULT.format("ops"))
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SHA-256 benchmark over several message sizes and of the
+ *              multi-buffer API
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#ifndef BUF_SIZE
+#define BUF_SIZE        (1024U)
+#endif
+#ifndef BYTES_PER_SIZE
+#define BYTES_PER_SIZE  (64U * 1024U)
+#endif
+
+#if IS_USED(MODULE_HASHES_SHA256_NI)
+#define BACKEND         "SHA-NI"
+#elif IS_USED(MODULE_HASHES_SHA256_ARMV8)
+#define BACKEND         "ARMv8-CE"
+#elif IS_USED(MODULE_HASHES_SHA256_PERIPH)
+#define BACKEND         "peripheral"
+#elif IS_USED(MODULE_HASHES_SHA256_UNROLL)
+#define BACKEND         "unrolled"
+#else
+#define BACKEND         "loop"
+#endif
+
+/* the digest of the first message, independent of the backend */
+static const uint8_t _expected[SHA256_DIGEST_LENGTH] = {
+    0xbe, 0x45, 0xcb, 0x26, 0x05, 0xbf, 0x36, 0xbe,
+    0xbd, 0xe6, 0x84, 0x84, 0x1a, 0x28, 0xf0, 0xfd,
+    0x43, 0xc6, 0x98, 0x50, 0xa3, 0xdc, 0xe5, 0xfe,
+    0xdb, 0xa6, 0x99, 0x28, 0xee, 0x3a, 0x89, 0x91,
+};
+
+/* number and size of the messages hashed per multi-buffer call */
+#define MB_MSGS         (BUF_SIZE / MB_MSG_SIZE)
+#define MB_MSG_SIZE     (64U)
+
+static const size_t _sizes[] = { 16, 64, 256, BUF_SIZE };
+
+static uint8_t _buf[BUF_SIZE];
+
+static const void *_mb_data[MB_MSGS];
+static size_t _mb_len[MB_MSGS];
+static void *_mb_digest[MB_MSGS];
+static uint8_t _mb_digests[MB_MSGS][SHA256_DIGEST_LENGTH];
+
+static const char _key[] = "bench_hashes_sha256";
+
+static void _print_msgs(const char *name, unsigned msgs, uint32_t time)
+{
+    if (time == 0) {
+        time = 1;
+    }
+    printf("%15s: %8u msgs in %8" PRIu32 " us, %8" PRIu32 " msgs/s\n",
+           name, msgs, time, (uint32_t)((uint64_t)msgs * 1000000 / time));
+}
+
+static int _mb(void)
+{
+    unsigned runs = BYTES_PER_SIZE / BUF_SIZE;
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    uint32_t start;
+
+    for (unsigned i = 0; i < MB_MSGS; i++) {
+        _mb_data[i] = &_buf[i * MB_MSG_SIZE];
+        _mb_len[i] = MB_MSG_SIZE;
+        _mb_digest[i] = _mb_digests[i];
+    }
+
+    /* the batches have to give the same digests as single calls */
+    sha256_mb(_mb_data, _mb_len, _mb_digest, MB_MSGS);
+    sha256(_mb_data[MB_MSGS - 1], MB_MSG_SIZE, digest);
+    if (memcmp(digest, _mb_digests[MB_MSGS - 1], sizeof(digest))) {
+        puts("[FAILED] wrong sha256_mb() digest");
+        return 1;
+    }
+    hmac_sha256_mb(_key, sizeof(_key), _mb_data, _mb_len, _mb_digest,
+                   MB_MSGS);
+    hmac_sha256(_key, sizeof(_key), _mb_data[MB_MSGS - 1], MB_MSG_SIZE,
+                digest);
+    if (memcmp(digest, _mb_digests[MB_MSGS - 1], sizeof(digest))) {
+        puts("[FAILED] wrong hmac_sha256_mb() digest");
+        return 1;
+    }
+
+    printf("%u byte messages, %u lanes\n", MB_MSG_SIZE, SHA256_MB_LANES);
+
+    start = xtimer_now_usec();
+    for (unsigned j = 0; j < runs; j++) {
+        for (unsigned i = 0; i < MB_MSGS; i++) {
+            sha256(_mb_data[i], MB_MSG_SIZE, _mb_digests[i]);
+        }
+    }
+    _print_msgs("sha256", runs * MB_MSGS, xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned j = 0; j < runs; j++) {
+        sha256_mb(_mb_data, _mb_len, _mb_digest, MB_MSGS);
+    }
+    _print_msgs("sha256_mb", runs * MB_MSGS, xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned j = 0; j < runs; j++) {
+        for (unsigned i = 0; i < MB_MSGS; i++) {
+            hmac_sha256(_key, sizeof(_key), _mb_data[i], MB_MSG_SIZE,
+                        _mb_digests[i]);
+        }
+    }
+    _print_msgs("hmac_sha256", runs * MB_MSGS, xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned j = 0; j < runs; j++) {
+        hmac_sha256_mb(_key, sizeof(_key), _mb_data, _mb_len, _mb_digest,
+                       MB_MSGS);
+    }
+    _print_msgs("hmac_sha256_mb", runs * MB_MSGS, xtimer_now_usec() - start);
+
+    return 0;
+}
+
+int main(void)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = i;
+    }
+
+    sha256(_buf, _sizes[0], digest);
+    if (memcmp(digest, _expected, sizeof(digest))) {
+        puts("[FAILED] wrong digest");
+        return 1;
+    }
+
+    printf("SHA-256 (" BACKEND ")\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        size_t size = _sizes[i];
+        unsigned runs = BYTES_PER_SIZE / size;
+        uint32_t start = xtimer_now_usec();
+        uint32_t time;
+
+        for (unsigned j = 0; j < runs; j++) {
+            sha256(_buf, size, digest);
+        }
+        time = xtimer_now_usec() - start;
+        if (time == 0) {
+            time = 1;
+        }
+
+        printf("%5u bytes: %8u msgs in %8" PRIu32 " us, %8" PRIu32
+               " KiB/s, %8" PRIu32 " msgs/s\n",
+               (unsigned)size, runs, time,
+               (uint32_t)((uint64_t)runs * size * 1000000 / 1024 / time),
+               (uint32_t)((uint64_t)runs * 1000000 / time));
+    }
+
+    if (_mb()) {
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+MB_RESULT = r": +[0-9]+ msgs in +[0-9]+ us, +[0-9]+ msgs/s\r\n"
+RESULT = r" bytes: +[0-9]+ msgs in +[0-9]+ us, +[0-9]+ KiB/s, +[0-9]+ msgs/s\r\n"
+
+
+def testfunc(child):
+    child.expect(r"SHA-256 \(.+\)\r\n")
+    for size in (16, 64, 256, 1024):
+        child.expect(r" *{}".format(size) + RESULT)
+    child.expect(r"64 byte messages, [0-9]+ lanes\r\n")
+    for name in ("sha256", "sha256_mb", "hmac_sha256", "hmac_sha256_mb"):
+        child.expect(r" *{}".format(name) + MB_RESULT)
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
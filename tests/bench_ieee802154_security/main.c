@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Per-frame latency of IEEE 802.15.4 link layer security
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/ieee802154.h"
+#include "net/ieee802154_security.h"
+#include "xtimer.h"
+
+#ifndef RUNS
+#define RUNS            (1000U)
+#endif
+
+/* data frame, PAN ID compression, short destination, long source address */
+#define HEADER_SIZE     (15U)
+
+/* the largest payload still fits into a frame with a 5 byte auxiliary
+ * header, an 8 byte MIC and the FCS */
+static const uint16_t _payload_sizes[] = { 16, 32, 64, 96 };
+
+static const uint8_t _src[IEEE802154_LONG_ADDRESS_LEN] = {
+    0x02, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77
+};
+
+static ieee802154_sec_context_t _tx;
+static ieee802154_sec_context_t _rx;
+
+static uint8_t _frame[IEEE802154_FRAME_LEN_MAX];
+static uint8_t _payload[IEEE802154_FRAME_LEN_MAX];
+static uint8_t _mic[IEEE802154_SEC_MAX_MAC_SIZE];
+static uint8_t _plain[IEEE802154_FRAME_LEN_MAX];
+
+static int _bench(uint16_t payload_size)
+{
+    const uint8_t header[HEADER_SIZE] = {
+        IEEE802154_FCF_TYPE_DATA | IEEE802154_FCF_SECURITY_EN |
+        IEEE802154_FCF_PAN_COMP,
+        IEEE802154_FCF_DST_ADDR_SHORT | IEEE802154_FCF_SRC_ADDR_LONG,
+    };
+    uint32_t enc = 0;
+    uint32_t dec = 0;
+
+    for (unsigned i = 0; i < payload_size; i++) {
+        _plain[i] = i;
+    }
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        uint8_t header_size = HEADER_SIZE;
+        uint8_t *payload;
+        uint16_t size;
+        uint8_t *mic;
+        uint8_t mic_size;
+        uint32_t start;
+
+        memcpy(_frame, header, sizeof(header));
+        memcpy(_payload, _plain, payload_size);
+
+        start = xtimer_now_usec();
+        if (ieee802154_sec_encrypt_frame(&_tx, _frame, &header_size,
+                                         _payload, payload_size,
+                                         _mic, &mic_size,
+                                         _src) != IEEE802154_SEC_OK) {
+            return -1;
+        }
+        enc += xtimer_now_usec() - start;
+
+        /* assemble the frame behind the auxiliary header */
+        memcpy(&_frame[header_size], _payload, payload_size);
+        memcpy(&_frame[header_size + payload_size], _mic, mic_size);
+
+        uint16_t frame_size = header_size + payload_size + mic_size;
+        header_size = HEADER_SIZE;
+
+        start = xtimer_now_usec();
+        if (ieee802154_sec_decrypt_frame(&_rx, frame_size, _frame,
+                                         &header_size, &payload, &size,
+                                         &mic, &mic_size,
+                                         _src) != IEEE802154_SEC_OK) {
+            return -1;
+        }
+        dec += xtimer_now_usec() - start;
+
+        if (size != payload_size || memcmp(payload, _plain, size)) {
+            return -1;
+        }
+    }
+
+    printf("%3u byte payload: encrypt %6" PRIu32 " ns/frame, "
+           "decrypt %6" PRIu32 " ns/frame\n", payload_size,
+           (uint32_t)((uint64_t)enc * 1000 / RUNS),
+           (uint32_t)((uint64_t)dec * 1000 / RUNS));
+
+    return 0;
+}
+
+int main(void)
+{
+    ieee802154_sec_init(&_tx);
+    ieee802154_sec_init(&_rx);
+
+    printf("AES-CCM* ENC-MIC-64, %s, %u frames\n",
+           _tx.dev.cipher_ops->ccm_encrypt ? "frame offload" : "software",
+           RUNS);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_payload_sizes); i++) {
+        if (_bench(_payload_sizes[i])) {
+            puts("[FAILED]");
+            return 1;
+        }
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
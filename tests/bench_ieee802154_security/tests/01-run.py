@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"AES-CCM\* ENC-MIC-64, (software|frame offload), "
+                 r"[0-9]+ frames\r\n")
+    for size in (16, 32, 64, 96):
+        child.expect(r" *{} byte payload: encrypt +[0-9]+ ns/frame, "
+                     r"decrypt +[0-9]+ ns/frame\r\n".format(size))
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
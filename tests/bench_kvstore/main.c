@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for the key-value store
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kvstore.h"
+#include "mtd.h"
+#include "mtd_native.h"
+#include "xtimer.h"
+
+#define SECTORS         (8U)
+#define CONFIG_KEYS     (16U)
+#define CONFIG_SIZE     (16U)
+#ifndef UPDATES
+#define UPDATES         (2000U)
+#endif
+#ifndef GETS
+#define GETS            (5000U)
+#endif
+
+/* a SPI NOR flash at 40 MHz */
+static const mtd_native_timing_t _timing = {
+    .cmd_us = 50,
+    .page_read_us = 52,
+    .page_program_us = 700,
+    .sector_erase_us = 45000,
+};
+
+/* no waiting while the store is formatted */
+static const mtd_native_timing_t _no_timing = { 0 };
+
+static mtd_native_dev_t _flash = {
+    .dev = {
+        .driver = &native_flash_driver,
+        .sector_count = SECTORS,
+        .pages_per_sector = 16,
+        .page_size = 256,
+    },
+    .fname = "kvstore.img",
+    .timing = &_no_timing,
+};
+
+static kvstore_t _kv;
+static kvstore_entry_t _index[32];
+static unsigned _errors;
+
+static void _key(char *key, size_t len, unsigned i)
+{
+    snprintf(key, len, "cfg%02u", i);
+}
+
+static void _print(const char *name, unsigned ops, uint32_t time)
+{
+    printf("%-10s %5u ops in %8u us, %6u ops/s, %5u pages read, "
+           "%5u pages programmed, %3u sectors erased\n",
+           name, ops, (unsigned)time,
+           (unsigned)((uint64_t)ops * US_PER_SEC / time),
+           (unsigned)_flash.stats.pages_read,
+           (unsigned)_flash.stats.pages_programmed,
+           (unsigned)_flash.stats.sectors_erased);
+}
+
+static void _populate(void)
+{
+    uint8_t value[CONFIG_SIZE];
+    char key[8];
+
+    for (unsigned i = 0; i < CONFIG_KEYS; i++) {
+        _key(key, sizeof(key), i);
+        memset(value, i, sizeof(value));
+        if (kvstore_set(&_kv, key, value, sizeof(value)) < 0) {
+            _errors++;
+        }
+    }
+}
+
+static void _bench_set(const char *name, bool change)
+{
+    mtd_native_stats_reset(&_flash);
+    uint32_t start = xtimer_now_usec();
+    for (uint32_t i = 0; i < UPDATES; i++) {
+        uint32_t val = change ? i : UPDATES - 1;
+
+        if (kvstore_set(&_kv, "boot_count", &val, sizeof(val)) < 0) {
+            _errors++;
+            break;
+        }
+    }
+    _print(name, UPDATES, xtimer_now_usec() - start);
+}
+
+static void _bench_get(void)
+{
+    uint8_t value[CONFIG_SIZE];
+    char key[8];
+
+    mtd_native_stats_reset(&_flash);
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < GETS; i++) {
+        _key(key, sizeof(key), i % CONFIG_KEYS);
+        if ((kvstore_get(&_kv, key, value, sizeof(value)) != sizeof(value)) ||
+            (value[0] != i % CONFIG_KEYS)) {
+            _errors++;
+            break;
+        }
+    }
+    _print("get", GETS, xtimer_now_usec() - start);
+}
+
+static void _bench_mount(void)
+{
+    uint32_t val = 0;
+
+    mtd_native_stats_reset(&_flash);
+    uint32_t start = xtimer_now_usec();
+    int res = kvstore_init(&_kv, &_flash.dev, _index, ARRAY_SIZE(_index));
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("mount: %8u us, %5u pages read, %u keys\n", (unsigned)time,
+           (unsigned)_flash.stats.pages_read, (unsigned)_kv.entries);
+    if ((res < 0) ||
+        (kvstore_get(&_kv, "boot_count", &val, sizeof(val)) < 0) ||
+        (val != UPDATES - 1) || (_kv.entries != CONFIG_KEYS + 1)) {
+        puts("mount failed");
+        _errors++;
+    }
+}
+
+int main(void)
+{
+    if ((kvstore_init(&_kv, &_flash.dev, _index, ARRAY_SIZE(_index)) < 0) ||
+        (kvstore_format(&_kv) < 0)) {
+        puts("kvstore_init failed");
+        return 1;
+    }
+    _populate();
+    _flash.timing = &_timing;
+
+    _bench_set("set", true);
+    printf("%-10s %u sectors collected\n", "", (unsigned)_kv.gc_runs);
+    _bench_set("set same", false);
+    _bench_get();
+    _bench_mount();
+
+    uint32_t min = UINT32_MAX, max = 0;
+    for (unsigned s = 0; s < SECTORS; s++) {
+        uint32_t count = mtd_native_erase_count(&_flash, s);
+
+        min = (count < min) ? count : min;
+        max = (count > max) ? count : max;
+    }
+    printf("erase count per sector: min %u, max %u\n", (unsigned)min,
+           (unsigned)max);
+    if (max - min > 1) {
+        puts("uneven wear");
+        _errors++;
+    }
+
+    if (_errors) {
+        printf("%u errors\n", _errors);
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
+/** @} */
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+RESULT = (r" +[0-9]+ ops in +[0-9]+ us, +[0-9]+ ops/s, +[0-9]+ pages read, "
+          r"+[0-9]+ pages programmed, +[0-9]+ sectors erased\r\n")
+
+
+def testfunc(child):
+    child.expect(r"set" + RESULT)
+    child.expect(r" +[0-9]+ sectors collected\r\n")
+    child.expect(r"set same" + RESULT)
+    child.expect(r"get" + RESULT)
+    child.expect(r"mount: +[0-9]+ us, +[0-9]+ pages read, [0-9]+ keys\r\n")
+    child.expect(r"erase count per sector: min [0-9]+, max [0-9]+\r\n")
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for littlefs2 with and without the MTD block cache
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "fs/littlefs2_fs.h"
+#include "mtd.h"
+#include "mtd_bcache.h"
+#include "mtd_native.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define DIRS            (4U)
+#define FILES_PER_DIR   (8U)
+#define FILE_SIZE       (1024U)
+#define BIG_FILE_SIZE   (64U * 1024)
+#define WALKS           (5U)
+
+/* a SPI NOR flash at 40 MHz */
+static const mtd_native_timing_t _timing = {
+    .cmd_us = 50,
+    .page_read_us = 52,
+    .page_program_us = 700,
+    .sector_erase_us = 45000,
+};
+
+/* no waiting while the file system is populated */
+static const mtd_native_timing_t _no_timing = { 0 };
+
+static mtd_native_dev_t _flash = {
+    .dev = {
+        .driver = &native_flash_driver,
+        .sector_count = 256,
+        .pages_per_sector = 16,
+        .page_size = 256,
+    },
+    .fname = "bcache.img",
+    .timing = &_no_timing,
+};
+
+static mtd_bcache_t _bcache = MTD_BCACHE_INIT(&_flash.dev);
+
+static littlefs2_desc_t _lfs_desc;
+
+static vfs_mount_t _mount = {
+    .fs = &littlefs2_file_system,
+    .mount_point = "/lfs",
+    .private_data = &_lfs_desc,
+};
+
+static uint8_t _buf[1024];
+static unsigned _errors;
+
+static int _write_file(const char *path, size_t size)
+{
+    int fd = vfs_open(path, O_CREAT | O_TRUNC | O_WRONLY, 0);
+
+    if (fd < 0) {
+        return fd;
+    }
+    for (size_t done = 0; done < size; done += sizeof(_buf)) {
+        memset(_buf, done / sizeof(_buf), sizeof(_buf));
+        if (vfs_write(fd, _buf, sizeof(_buf)) != (ssize_t)sizeof(_buf)) {
+            vfs_close(fd);
+            return -EIO;
+        }
+    }
+    return vfs_close(fd);
+}
+
+static int _populate(void)
+{
+    char path[32];
+    int res;
+
+    _lfs_desc.dev = &_flash.dev;
+    res = vfs_format(&_mount);
+    if (res == 0) {
+        res = vfs_mount(&_mount);
+    }
+    for (unsigned d = 0; (res == 0) && (d < DIRS); d++) {
+        snprintf(path, sizeof(path), "/lfs/dir%u", d);
+        res = vfs_mkdir(path, 0);
+        for (unsigned f = 0; (res == 0) && (f < FILES_PER_DIR); f++) {
+            snprintf(path, sizeof(path), "/lfs/dir%u/file%u", d, f);
+            res = _write_file(path, FILE_SIZE);
+        }
+    }
+    if (res == 0) {
+        res = _write_file("/lfs/big", BIG_FILE_SIZE);
+    }
+    vfs_umount(&_mount);
+    return res;
+}
+
+/* stats every file of every directory */
+static int _walk(void)
+{
+    vfs_DIR top, dir;
+    vfs_dirent_t top_entry, entry;
+    struct stat st;
+    char path[sizeof("/lfs//") + 2 * VFS_NAME_MAX];
+    unsigned files = 0;
+
+    if (vfs_opendir(&top, "/lfs") < 0) {
+        return -1;
+    }
+    while (vfs_readdir(&top, &top_entry) > 0) {
+        if ((top_entry.d_name[0] == '.') ||
+            strncmp(top_entry.d_name, "dir", 3)) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "/lfs/%s", top_entry.d_name);
+        if (vfs_opendir(&dir, path) < 0) {
+            break;
+        }
+        while (vfs_readdir(&dir, &entry) > 0) {
+            if (entry.d_name[0] == '.') {
+                continue;
+            }
+            snprintf(path, sizeof(path), "/lfs/%s/%s", top_entry.d_name,
+                     entry.d_name);
+            if ((vfs_stat(path, &st) == 0) && (st.st_size == FILE_SIZE)) {
+                files++;
+            }
+        }
+        vfs_closedir(&dir);
+    }
+    vfs_closedir(&top);
+    return (files == DIRS * FILES_PER_DIR) ? 0 : -1;
+}
+
+static int _read_big(void)
+{
+    size_t size = 0;
+    ssize_t len;
+    int fd = vfs_open("/lfs/big", O_RDONLY, 0);
+
+    if (fd < 0) {
+        return fd;
+    }
+    while ((len = vfs_read(fd, _buf, sizeof(_buf))) > 0) {
+        if (_buf[0] != ((size / sizeof(_buf)) & 0xff)) {
+            break;
+        }
+        size += len;
+    }
+    vfs_close(fd);
+    return (size == BIG_FILE_SIZE) ? 0 : -1;
+}
+
+static void _bench(const char *name, mtd_dev_t *dev, bool walk)
+{
+    uint32_t start;
+    int res;
+
+    _lfs_desc.dev = dev;
+    if (vfs_mount(&_mount) < 0) {
+        printf("%s: mount failed\n", name);
+        _errors++;
+        return;
+    }
+
+    mtd_native_stats_reset(&_flash);
+    start = xtimer_now_usec();
+    if (walk) {
+        res = 0;
+        for (unsigned i = 0; (res == 0) && (i < WALKS); i++) {
+            res = _walk();
+        }
+    }
+    else {
+        res = _read_big();
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("%-9s %s: %5u cmds, %5u pages read, %7u us\n",
+           walk ? "dir walk" : "seq read", name,
+           (unsigned)_flash.stats.commands, (unsigned)_flash.stats.pages_read,
+           (unsigned)time);
+    if (res < 0) {
+        printf("%s: FAILED\n", name);
+        _errors++;
+    }
+    vfs_umount(&_mount);
+}
+
+int main(void)
+{
+    if (mtd_init(&_bcache.mtd) < 0) {
+        puts("mtd_init failed");
+        return 1;
+    }
+    if (_populate() < 0) {
+        puts("populating the file system failed");
+        return 1;
+    }
+    _flash.timing = &_timing;
+
+    for (unsigned i = 0; i < 2; i++) {
+        bool walk = (i == 0);
+        uint32_t commands;
+
+        _bench("direct", &_flash.dev, walk);
+        commands = _flash.stats.commands;
+
+        mtd_bcache_invalidate(&_bcache);
+        memset(&_bcache.stats, 0, sizeof(_bcache.stats));
+        _bench("bcache", &_bcache.mtd, walk);
+        printf("%-9s bcache: %u hits, %u misses, %u blocks read ahead\n",
+               "", (unsigned)_bcache.stats.hits,
+               (unsigned)_bcache.stats.misses,
+               (unsigned)_bcache.stats.readahead);
+
+        if (_flash.stats.commands >= commands) {
+            puts("no MTD commands saved");
+            _errors++;
+        }
+    }
+
+    if (_errors) {
+        printf("%u errors\n", _errors);
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
+/** @} */
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+RESULT = r" +[0-9]+ cmds, +[0-9]+ pages read, +[0-9]+ us\r\n"
+
+
+def testfunc(child):
+    for name in ("dir walk", "seq read"):
+        child.expect(name + r" +direct:" + RESULT)
+        child.expect(name + r" +bcache:" + RESULT)
+        child.expect(r"bcache: [0-9]+ hits, [0-9]+ misses, "
+                     r"[0-9]+ blocks read ahead\r\n")
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
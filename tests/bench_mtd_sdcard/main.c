@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for single- vs. multi-block SD card transfers
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mtd.h"
+#include "mtd_native.h"
+#include "xtimer.h"
+
+#ifndef BENCH_CMD_US
+#define BENCH_CMD_US            (1000U)
+#endif
+#ifndef BENCH_BLOCK_READ_US
+#define BENCH_BLOCK_READ_US     (420U)  /* 512 bytes at 10 MHz SPI */
+#endif
+#ifndef BENCH_BLOCK_WRITE_US
+#define BENCH_BLOCK_WRITE_US    (600U)
+#endif
+
+#define BLOCK_SIZE      (512U)
+#define BLOCK_NUM       (1024U)
+#define REGION_BLOCKS   (256U)
+#define MULTI_BLOCKS    (16U)
+
+static const mtd_native_timing_t _timing = {
+    .cmd_us = BENCH_CMD_US,
+    .page_read_us = BENCH_BLOCK_READ_US,
+    .page_program_us = BENCH_BLOCK_WRITE_US,
+};
+
+static mtd_native_dev_t _sdcard = {
+    .dev = {
+        .driver = &native_sdcard_driver,
+        .sector_count = BLOCK_NUM,
+        .pages_per_sector = 1,
+        .page_size = BLOCK_SIZE,
+    },
+    .fname = "sdcard.img",
+    .timing = &_timing,
+};
+
+static uint8_t _buf[MULTI_BLOCKS * BLOCK_SIZE];
+static uint32_t _rnd_state;
+
+/* deterministic xorshift, so runs are comparable */
+static uint32_t _rnd(void)
+{
+    _rnd_state ^= _rnd_state << 13;
+    _rnd_state ^= _rnd_state >> 17;
+    _rnd_state ^= _rnd_state << 5;
+    return _rnd_state;
+}
+
+/* the content only depends on the block, random writes keep it valid */
+static void _fill(uint32_t block, unsigned num)
+{
+    for (unsigned i = 0; i < num * BLOCK_SIZE; i++) {
+        _buf[i] = block + i / BLOCK_SIZE + i * 7;
+    }
+}
+
+static int _bench(const char *name, bool write, bool random, unsigned bpc)
+{
+    mtd_dev_t *mtd = &_sdcard.dev;
+    uint32_t start, time;
+
+    _rnd_state = 0x2545f491;
+    mtd_native_stats_reset(&_sdcard);
+
+    start = xtimer_now_usec();
+    for (uint32_t done = 0; done < REGION_BLOCKS; done += bpc) {
+        uint32_t block = random ? _rnd() % (REGION_BLOCKS - bpc + 1) : done;
+        int res;
+
+        if (write) {
+            _fill(block, bpc);
+            res = mtd_write_page_raw(mtd, _buf, block, 0, bpc * BLOCK_SIZE);
+        }
+        else {
+            res = mtd_read_page(mtd, _buf, block, 0, bpc * BLOCK_SIZE);
+        }
+        if (res < 0) {
+            printf("%s %2u blk/cmd: error %d\n", name, bpc, res);
+            return res;
+        }
+    }
+    time = xtimer_now_usec() - start;
+
+    printf("%s %2u blk/cmd: %5u cmds, %5u KiB/s\n", name, bpc,
+           (unsigned)_sdcard.stats.commands,
+           (unsigned)((uint64_t)REGION_BLOCKS * BLOCK_SIZE * US_PER_SEC
+                      / 1024 / time));
+    return 0;
+}
+
+static int _verify(void)
+{
+    static uint8_t expected[BLOCK_SIZE];
+
+    for (uint32_t block = 0; block < REGION_BLOCKS; block++) {
+        _fill(block, 1);
+        memcpy(expected, _buf, sizeof(expected));
+        if ((mtd_read_page(&_sdcard.dev, _buf, block, 0, BLOCK_SIZE) < 0) ||
+            memcmp(expected, _buf, sizeof(expected))) {
+            printf("verify: block %u FAILED\n", (unsigned)block);
+            return -1;
+        }
+    }
+    puts("verify: OK");
+    return 0;
+}
+
+int main(void)
+{
+    static const struct {
+        const char *name;
+        bool write;
+        bool random;
+    } runs[] = {
+        { "seq write", true, false },
+        { "seq read ", false, false },
+        { "rnd write", true, true },
+        { "rnd read ", false, true },
+    };
+    int res;
+
+    res = mtd_init(&_sdcard.dev);
+    if (res < 0) {
+        printf("mtd_init: error %d\n", res);
+        return 1;
+    }
+    /* sub-block transfers are not supported by the card */
+    if (mtd_write_page_raw(&_sdcard.dev, _buf, 0, 1, 1) != -ENOTSUP) {
+        puts("partial block write not rejected");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(runs); i++) {
+        if ((_bench(runs[i].name, runs[i].write, runs[i].random, 1) < 0) ||
+            (_bench(runs[i].name, runs[i].write, runs[i].random,
+                    MULTI_BLOCKS) < 0)) {
+            return 1;
+        }
+    }
+    if (_verify() < 0) {
+        return 1;
+    }
+
+    mtd_power(&_sdcard.dev, MTD_POWER_DOWN);
+    puts("[SUCCESS]");
+    return 0;
+}
+/** @} */
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for op in ("seq write", "seq read", "rnd write", "rnd read"):
+        for bpc in (1, 16):
+            child.expect(r"{} +{} blk/cmd: +[0-9]+ cmds, +[0-9]+ KiB/s\r\n"
+                         .format(op, bpc))
+    child.expect_exact("verify: OK\r\n")
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for nanocoap message parsing and option lookup
+ *
+ * The messages below are taken from captures of typical CoAP traffic: a
+ * resource discovery request, a resource directory registration, an observe
+ * request for a sensor and a block-wise firmware upload.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "kernel_defines.h"
+#include "net/nanocoap.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100UL * 1000UL)
+#endif
+
+/* CON GET /.well-known/core */
+static const uint8_t _req_wkc[] = {
+    0x42, 0x01, 0x1a, 0x2b, 0x5e, 0x01, 0xbb, 0x2e, 0x77, 0x65, 0x6c, 0x6c,
+    0x2d, 0x6b, 0x6e, 0x6f, 0x77, 0x6e, 0x04, 0x63, 0x6f, 0x72, 0x65
+};
+
+/* CON POST /rd?ep=riot-7a2c0f11&lt=300&lwm2m=1.1&b=U, link-format payload */
+static const uint8_t _req_rd[] = {
+    0x44, 0x02, 0x1a, 0x2c, 0x7d, 0x34, 0x11, 0x02, 0xb2, 0x72, 0x64, 0x11,
+    0x28, 0x3d, 0x03, 0x65, 0x70, 0x3d, 0x72, 0x69, 0x6f, 0x74, 0x2d, 0x37,
+    0x61, 0x32, 0x63, 0x30, 0x66, 0x31, 0x31, 0x06, 0x6c, 0x74, 0x3d, 0x33,
+    0x30, 0x30, 0x09, 0x6c, 0x77, 0x6d, 0x32, 0x6d, 0x3d, 0x31, 0x2e, 0x31,
+    0x03, 0x62, 0x3d, 0x55, 0xff, 0x3c, 0x2f, 0x31, 0x2f, 0x30, 0x3e, 0x2c,
+    0x3c, 0x2f, 0x33, 0x2f, 0x30, 0x3e, 0x2c, 0x3c, 0x2f, 0x33, 0x33, 0x30,
+    0x33, 0x2f, 0x30, 0x3e
+};
+
+/* CON GET coap://node42.example/sensors/temp, Observe: 0, Accept: CBOR,
+ * Block2: 0/0/1024 */
+static const uint8_t _req_obs[] = {
+    0x46, 0x01, 0x1a, 0x2d, 0x91, 0xe4, 0x0c, 0x55, 0xa0, 0x01, 0x3d, 0x01,
+    0x6e, 0x6f, 0x64, 0x65, 0x34, 0x32, 0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70,
+    0x6c, 0x65, 0x30, 0x57, 0x73, 0x65, 0x6e, 0x73, 0x6f, 0x72, 0x73, 0x04,
+    0x74, 0x65, 0x6d, 0x70, 0x61, 0x3c, 0x61, 0x06
+};
+
+/* CON PUT /fw/slot1, Content-Format: octet-stream, Block1: 3/1/1024,
+ * Size1: 65536 */
+static const uint8_t _req_blk[] = {
+    0x42, 0x03, 0x1a, 0x2e, 0x33, 0x02, 0xb2, 0x66, 0x77, 0x05, 0x73, 0x6c,
+    0x6f, 0x74, 0x31, 0x11, 0x2a, 0xd1, 0x02, 0x3e, 0xd3, 0x14, 0x01, 0x00,
+    0x00, 0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+    0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
+    0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+typedef struct {
+    const char *name;
+    const uint8_t *data;
+    size_t len;
+    unsigned options;   /**< expected number of indexed options */
+} capture_t;
+
+static const capture_t _captures[] = {
+    { "well-known/core", _req_wkc, sizeof(_req_wkc), 1 },
+    { "rd register", _req_rd, sizeof(_req_rd), 3 },
+    { "observe", _req_obs, sizeof(_req_obs), 5 },
+    { "block1 put", _req_blk, sizeof(_req_blk), 4 },
+};
+
+/* coap_parse() works on a mutable buffer */
+static uint8_t _buf[128];
+static coap_pkt_t _pkt;
+static uint8_t _uri[CONFIG_NANOCOAP_URI_MAX];
+
+/* Typical set of option queries made by a request handler */
+static void _lookup(coap_pkt_t *pkt)
+{
+    uint32_t value;
+
+    coap_get_uri_path(pkt, _uri);
+    coap_get_content_type(pkt);
+    coap_opt_get_uint(pkt, COAP_OPT_ACCEPT, &value);
+    coap_opt_get_uint(pkt, COAP_OPT_OBSERVE, &value);
+    coap_opt_get_uint(pkt, COAP_OPT_BLOCK1, &value);
+    coap_opt_get_uint(pkt, COAP_OPT_BLOCK2, &value);
+}
+
+static void _parse_lookup(size_t len)
+{
+    coap_parse(&_pkt, _buf, len);
+    _lookup(&_pkt);
+}
+
+int main(void)
+{
+    puts("nanocoap parse and option lookup benchmark\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_captures); i++) {
+        const capture_t *cap = &_captures[i];
+
+        memcpy(_buf, cap->data, cap->len);
+        if ((coap_parse(&_pkt, _buf, cap->len) != 0) ||
+            (_pkt.options_len != cap->options)) {
+            printf("%s: parsing failed\n", cap->name);
+            puts("[FAILURE]");
+            return 1;
+        }
+
+        printf("%s (%u bytes, %u options):\n", cap->name,
+               (unsigned)cap->len, (unsigned)_pkt.options_len);
+        BENCHMARK_FUNC("parse", BENCH_RUNS,
+                       coap_parse(&_pkt, _buf, cap->len));
+        BENCHMARK_FUNC("lookup", BENCH_RUNS, _lookup(&_pkt));
+        BENCHMARK_FUNC("parse+lookup", BENCH_RUNS, _parse_lookup(cap->len));
+        puts("");
+    }
+
+    puts("[SUCCESS]");
+    return 0;
+}
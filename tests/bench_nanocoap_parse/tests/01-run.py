@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+CAPTURES = ["well-known/core", "rd register", "observe", "block1 put"]
+
+
+def testfunc(child):
+    child.expect_exact("nanocoap parse and option lookup benchmark")
+    for capture in CAPTURES:
+        child.expect(r"{} \(\d+ bytes, \d+ options\):".format(capture))
+        child.expect(BENCHMARK_REGEXP.format(func="parse"))
+        child.expect(BENCHMARK_REGEXP.format(func="lookup"))
+        child.expect(BENCHMARK_REGEXP.format(func=r"parse\+lookup"))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
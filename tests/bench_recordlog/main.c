@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for appending to and recovering a record log
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mtd.h"
+#include "mtd_native.h"
+#include "recordlog.h"
+#include "xtimer.h"
+
+#define PAGE_SIZE       (256U)
+#define RECORD_SIZE     (32U)
+#ifndef RECORDS
+#define RECORDS         (10000U)
+#endif
+#ifndef RECORDS_SYNC
+#define RECORDS_SYNC    (1000U)
+#endif
+
+/* a SPI NOR flash at 40 MHz */
+static const mtd_native_timing_t _timing = {
+    .cmd_us = 50,
+    .page_read_us = 52,
+    .page_program_us = 700,
+    .sector_erase_us = 45000,
+};
+
+/* no waiting while the log is reset */
+static const mtd_native_timing_t _no_timing = { 0 };
+
+static mtd_native_dev_t _flash = {
+    .dev = {
+        .driver = &native_flash_driver,
+        .sector_count = 64,
+        .pages_per_sector = 16,
+        .page_size = PAGE_SIZE,
+    },
+    .fname = "recordlog.img",
+    .timing = &_no_timing,
+};
+
+static recordlog_t _log;
+static uint8_t _page_buf[PAGE_SIZE];
+static unsigned _errors;
+
+static void _print_stats(const char *name, unsigned records, uint32_t time)
+{
+    const mtd_native_stats_t *stats = &_flash.stats;
+    /* bytes programmed per payload byte, in percent */
+    unsigned amp = (uint64_t)stats->pages_programmed * PAGE_SIZE * 100
+                   / (records * RECORD_SIZE);
+
+    printf("%-8s %5u records in %8u us, %6u records/s, "
+           "%5u pages programmed, %3u sectors erased, "
+           "write amplification %u.%02u\n",
+           name, records, (unsigned)time,
+           (unsigned)((uint64_t)records * US_PER_SEC / time),
+           (unsigned)stats->pages_programmed, (unsigned)stats->sectors_erased,
+           amp / 100, amp % 100);
+}
+
+static void _append(const char *name, unsigned records, bool sync)
+{
+    uint8_t rec[RECORD_SIZE];
+
+    _flash.timing = &_no_timing;
+    if (recordlog_erase(&_log) < 0) {
+        printf("%s: erase failed\n", name);
+        _errors++;
+        return;
+    }
+    _flash.timing = &_timing;
+
+    mtd_native_stats_reset(&_flash);
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < records; i++) {
+        memset(rec, i, sizeof(rec));
+        if ((recordlog_append(&_log, rec, sizeof(rec), NULL) < 0) ||
+            (sync && (recordlog_flush(&_log) < 0))) {
+            printf("%s: append failed\n", name);
+            _errors++;
+            return;
+        }
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    _print_stats(name, records, time);
+}
+
+static void _recover(void)
+{
+    mtd_native_stats_reset(&_flash);
+    uint32_t start = xtimer_now_usec();
+    int res = recordlog_init(&_log, &_flash.dev, _page_buf);
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("recovery: %8u us, %5u cmds, %5u pages read\n", (unsigned)time,
+           (unsigned)_flash.stats.commands, (unsigned)_flash.stats.pages_read);
+    if (res < 0) {
+        puts("recovery failed");
+        _errors++;
+    }
+}
+
+static void _iterate(void)
+{
+    recordlog_iter_t iter;
+    uint8_t rec[RECORD_SIZE];
+    uint32_t seq, expected = _log.first_seq;
+    unsigned records = 0;
+    ssize_t len;
+
+    mtd_native_stats_reset(&_flash);
+    uint32_t start = xtimer_now_usec();
+    recordlog_iter_init(&_log, &iter);
+    while ((len = recordlog_iter_next(&_log, &iter, rec, sizeof(rec),
+                                      &seq)) > 0) {
+        if ((len != sizeof(rec)) || (seq != expected++) ||
+            (rec[0] != (seq & 0xff))) {
+            break;
+        }
+        records++;
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("iterate: %5u records in %8u us, %5u pages read\n", records,
+           (unsigned)time, (unsigned)_flash.stats.pages_read);
+    if ((len != 0) || (expected != _log.next_seq)) {
+        puts("iteration failed");
+        _errors++;
+    }
+}
+
+int main(void)
+{
+    if (recordlog_init(&_log, &_flash.dev, _page_buf) < 0) {
+        puts("recordlog_init failed");
+        return 1;
+    }
+
+    /* a flush after every record, as without batching */
+    _append("sync", RECORDS_SYNC, true);
+    _append("batched", RECORDS, false);
+    if (recordlog_flush(&_log) < 0) {
+        _errors++;
+    }
+
+    _recover();
+    _iterate();
+
+    if (_errors) {
+        printf("%u errors\n", _errors);
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
+/** @} */
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+APPEND = (r" +[0-9]+ records in +[0-9]+ us, +[0-9]+ records/s, "
+          r"+[0-9]+ pages programmed, +[0-9]+ sectors erased, "
+          r"write amplification [0-9]+\.[0-9]+\r\n")
+
+
+def testfunc(child):
+    child.expect(r"sync" + APPEND)
+    child.expect(r"batched" + APPEND)
+    child.expect(r"recovery: +[0-9]+ us, +[0-9]+ cmds, +[0-9]+ pages read\r\n")
+    child.expect(r"iterate: +[0-9]+ records in +[0-9]+ us, "
+                 r"+[0-9]+ pages read\r\n")
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
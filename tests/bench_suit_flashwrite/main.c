@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for firmware updates through the SUIT flashwrite
+ *              storage
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "riotboot/flashwrite.h"
+#include "riotboot/slot.h"
+#include "suit/storage.h"
+#include "xtimer.h"
+
+/* CoAP block size used by the SUIT transport */
+#define CHUNK_SIZE      (64U)
+#ifndef IMAGE_SIZE
+#define IMAGE_SIZE      (64U * 1024)
+#endif
+#ifndef RX_DELAY_US
+#define RX_DELAY_US     (2000U)
+#endif
+
+static uint8_t _chunk[CHUNK_SIZE];
+static uint8_t _digest[SHA256_DIGEST_LENGTH];
+
+static void _fill_chunk(size_t offset)
+{
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        size_t pos = offset + i;
+        _chunk[i] = (uint8_t)(pos * 31 + (pos >> 8));
+    }
+    if (offset == 0) {
+        /* payload starts with the riotboot magic number */
+        memcpy(_chunk, "RIOT", 4);
+    }
+}
+
+int main(void)
+{
+    suit_storage_t *storage = suit_storage_find_by_id("");
+    size_t img_size = IMAGE_SIZE;
+    sha256_context_t sha256;
+
+    if (img_size > riotboot_slot_size(riotboot_slot_other())) {
+        img_size = riotboot_slot_size(riotboot_slot_other()) / 2;
+    }
+    img_size -= img_size % CHUNK_SIZE;
+
+    printf("image of %u bytes, %u byte chunks, %u us per chunk received\n",
+           (unsigned)img_size, CHUNK_SIZE, (unsigned)RX_DELAY_US);
+
+    sha256_init(&sha256);
+    for (size_t offset = 0; offset < img_size; offset += CHUNK_SIZE) {
+        _fill_chunk(offset);
+        sha256_update(&sha256, _chunk, CHUNK_SIZE);
+    }
+    sha256_final(&sha256, _digest);
+
+    uint32_t start = xtimer_now_usec();
+
+    if (suit_storage_start(storage, NULL, img_size) < 0) {
+        puts("[FAILED] start");
+        return 1;
+    }
+    for (size_t offset = 0; offset < img_size; offset += CHUNK_SIZE) {
+        /* wait for the next block to arrive */
+        xtimer_usleep(RX_DELAY_US);
+        _fill_chunk(offset);
+        if (suit_storage_write(storage, NULL, _chunk, offset,
+                               CHUNK_SIZE) < 0) {
+            puts("[FAILED] write");
+            return 1;
+        }
+    }
+    if (suit_storage_finish(storage, NULL) < 0) {
+        puts("[FAILED] finish");
+        return 1;
+    }
+
+    uint32_t written = xtimer_now_usec();
+    uint32_t rx = (img_size / CHUNK_SIZE) * RX_DELAY_US;
+
+    printf("%-12s %8u us, %8u us receiving, %8u us not overlapped\n",
+           IS_USED(MODULE_SUIT_STORAGE_FLASHWRITE_ASYNC) ? "write async"
+                                                         : "write",
+           (unsigned)(written - start), (unsigned)rx,
+           (unsigned)(written - start - rx));
+
+    start = xtimer_now_usec();
+    int res = suit_storage_verify_sha256(storage, _digest, img_size);
+    printf("%-12s %8u us\n", "verify", (unsigned)(xtimer_now_usec() - start));
+    if (res != SUIT_OK) {
+        puts("[FAILED] digest computed while writing");
+        return 1;
+    }
+
+    start = xtimer_now_usec();
+    res = riotboot_flashwrite_verify_sha256(_digest, img_size,
+                                            riotboot_slot_other());
+    printf("%-12s %8u us\n", "readback", (unsigned)(xtimer_now_usec() - start));
+    if (res != 0) {
+        puts("[FAILED] digest of the slot");
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"image of [0-9]+ bytes, [0-9]+ byte chunks, "
+                 r"[0-9]+ us per chunk received\r\n")
+    child.expect(r"write( async)? +[0-9]+ us, +[0-9]+ us receiving, "
+                 r"+[0-9]+ us not overlapped\r\n")
+    child.expect(r"verify +[0-9]+ us\r\n")
+    child.expect(r"readback +[0-9]+ us\r\n")
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
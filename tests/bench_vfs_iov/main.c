@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for vfs_readv(), vfs_writev() and vfs_sendfile()
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "fs/littlefs2_fs.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RECORDS
+#define BENCH_RECORDS       (512U)
+#endif
+
+/* a log record made up of three buffers, as assembled by e.g. a logger */
+#define PAYLOAD_LEN         (48U)
+
+typedef struct {
+    uint32_t seq;
+    uint16_t len;
+    uint16_t type;
+} record_hdr_t;
+
+#define RECORD_LEN          (sizeof(record_hdr_t) + PAYLOAD_LEN + sizeof(uint32_t))
+#define FILE_LEN            (BENCH_RECORDS * RECORD_LEN)
+
+/* maximum amount of data a sock accepts per call, e.g. one TCP segment */
+#define SINK_MSS            (536U)
+
+static littlefs2_desc_t _lfs_desc;
+
+static vfs_mount_t _mount = {
+    .fs = &littlefs2_file_system,
+    .mount_point = "/lfs",
+    .private_data = &_lfs_desc,
+};
+
+static record_hdr_t _hdr;
+static uint8_t _payload[PAYLOAD_LEN];
+static uint32_t _crc;
+
+static iolist_t _iol_crc = { .iol_base = &_crc, .iol_len = sizeof(_crc) };
+static iolist_t _iol_payload = { .iol_next = &_iol_crc, .iol_base = _payload,
+                                 .iol_len = sizeof(_payload) };
+static iolist_t _iol_hdr = { .iol_next = &_iol_payload, .iol_base = &_hdr,
+                             .iol_len = sizeof(_hdr) };
+
+static uint8_t _chunk[1024];
+static unsigned _errors;
+
+static uint32_t _sum(const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    uint32_t sum = 0;
+
+    while (len--) {
+        sum = (sum << 1) + (sum >> 31) + *p++;
+    }
+    return sum;
+}
+
+static void _make_record(uint32_t seq)
+{
+    _hdr.seq = seq;
+    _hdr.len = PAYLOAD_LEN;
+    _hdr.type = 1;
+    for (unsigned i = 0; i < PAYLOAD_LEN; i++) {
+        _payload[i] = seq + i;
+    }
+    _crc = _sum(&_hdr, sizeof(_hdr)) ^ _sum(_payload, sizeof(_payload));
+}
+
+static bool _check_record(uint32_t seq)
+{
+    return (_hdr.seq == seq) && (_hdr.len == PAYLOAD_LEN) &&
+           (_crc == (_sum(&_hdr, sizeof(_hdr)) ^
+                     _sum(_payload, sizeof(_payload))));
+}
+
+static void _result(const char *name, uint32_t start, size_t bytes)
+{
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("%-26s %6u bytes in %7u us, %6u KiB/s\n", name, (unsigned)bytes,
+           (unsigned)time,
+           (unsigned)((uint64_t)bytes * US_PER_SEC / 1024 / (time ? time : 1)));
+}
+
+/* one call per record buffer, or all buffers of a record at once */
+static void _bench_write(const char *path, bool vectored)
+{
+    int fd = vfs_open(path, O_CREAT | O_TRUNC | O_WRONLY, 0);
+    size_t bytes = 0;
+
+    if (fd < 0) {
+        printf("open %s: error %d\n", path, fd);
+        _errors++;
+        return;
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (uint32_t seq = 0; seq < BENCH_RECORDS; seq++) {
+        ssize_t res;
+
+        _make_record(seq);
+        if (vectored) {
+            res = vfs_writev(fd, &_iol_hdr);
+        }
+        else {
+            res = 0;
+            for (const iolist_t *iol = &_iol_hdr; iol; iol = iol->iol_next) {
+                ssize_t len = vfs_write(fd, iol->iol_base, iol->iol_len);
+                if (len < 0) {
+                    res = len;
+                    break;
+                }
+                res += len;
+            }
+        }
+        if (res != (ssize_t)RECORD_LEN) {
+            _errors++;
+            break;
+        }
+        bytes += res;
+    }
+    /* include flushing the last block in the measurement */
+    vfs_close(fd);
+    _result(vectored ? "write, 1 writev/record" : "write, 3 write/record",
+            start, bytes);
+}
+
+static void _bench_read(const char *path, bool vectored)
+{
+    int fd = vfs_open(path, O_RDONLY, 0);
+    size_t bytes = 0;
+
+    if (fd < 0) {
+        printf("open %s: error %d\n", path, fd);
+        _errors++;
+        return;
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (uint32_t seq = 0; seq < BENCH_RECORDS; seq++) {
+        ssize_t res;
+
+        if (vectored) {
+            res = vfs_readv(fd, &_iol_hdr);
+        }
+        else {
+            res = 0;
+            for (const iolist_t *iol = &_iol_hdr; iol; iol = iol->iol_next) {
+                ssize_t len = vfs_read(fd, iol->iol_base, iol->iol_len);
+                if (len < 0) {
+                    res = len;
+                    break;
+                }
+                res += len;
+            }
+        }
+        if ((res != (ssize_t)RECORD_LEN) || !_check_record(seq)) {
+            printf("record %u: corrupted\n", (unsigned)seq);
+            _errors++;
+            break;
+        }
+        bytes += res;
+    }
+    _result(vectored ? "read,  1 readv/record" : "read,  3 read/record",
+            start, bytes);
+    vfs_close(fd);
+}
+
+typedef struct {
+    size_t bytes;
+    unsigned calls;
+    uint32_t sum;
+} sink_t;
+
+/* stands in for sock_tcp_write(), which may accept less than offered */
+static ssize_t _sink(void *arg, const void *data, size_t len)
+{
+    sink_t *sink = arg;
+
+    if (len > SINK_MSS) {
+        len = SINK_MSS;
+    }
+    sink->sum += _sum(data, len);
+    sink->bytes += len;
+    sink->calls++;
+    return len;
+}
+
+static void _bench_sendfile(const char *path, size_t chunk_len)
+{
+    static uint32_t expected_sum;
+    sink_t sink = { 0 };
+    char name[32];
+    int fd = vfs_open(path, O_RDONLY, 0);
+
+    if (fd < 0) {
+        printf("open %s: error %d\n", path, fd);
+        _errors++;
+        return;
+    }
+
+    uint32_t start = xtimer_now_usec();
+    ssize_t res = vfs_sendfile(fd, SIZE_MAX, _chunk, chunk_len, _sink, &sink);
+    snprintf(name, sizeof(name), "sendfile, %4u B chunks", (unsigned)chunk_len);
+    _result(name, start, sink.bytes);
+    vfs_close(fd);
+
+    if (expected_sum == 0) {
+        expected_sum = sink.sum;
+    }
+    if ((res != (ssize_t)FILE_LEN) || (sink.bytes != FILE_LEN) ||
+        (sink.sum != expected_sum)) {
+        printf("sendfile: %d bytes, %u calls, sum mismatch %d\n", (int)res,
+               sink.calls, sink.sum != expected_sum);
+        _errors++;
+    }
+}
+
+int main(void)
+{
+    int res;
+
+    _lfs_desc.dev = MTD_0;
+    res = vfs_format(&_mount);
+    if (res == 0) {
+        res = vfs_mount(&_mount);
+    }
+    if (res < 0) {
+        printf("littlefs2: error %d\n", res);
+        return 1;
+    }
+
+    _bench_write("/lfs/a.log", false);
+    _bench_write("/lfs/b.log", true);
+    _bench_read("/lfs/a.log", false);
+    _bench_read("/lfs/b.log", true);
+    _bench_sendfile("/lfs/b.log", 64);
+    _bench_sendfile("/lfs/b.log", sizeof(_chunk));
+
+    vfs_umount(&_mount);
+
+    if (_errors) {
+        printf("%u errors\n", _errors);
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
+/** @} */
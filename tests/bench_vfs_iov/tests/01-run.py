@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 RIOT Developers
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+RESULT = r" +[0-9]+ bytes in +[0-9]+ us, +[0-9]+ KiB/s\r\n"
+
+
+def testfunc(child):
+    for name in ("write, 3 write/record", "write, 1 writev/record",
+                 "read,  3 read/record", "read,  1 readv/record",
+                 "sendfile,   64 B chunks", "sendfile, 1024 B chunks"):
+        child.expect(name + RESULT)
+    child.expect_exact("[SUCCESS]\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
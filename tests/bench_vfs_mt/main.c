@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for concurrent vfs_open(), vfs_stat() and
+ *              vfs_close() calls
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#include "atomic_utils.h"
+#include "fs/constfs.h"
+#include "mutex.h"
+#include "thread.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS    (2000U)
+#endif
+
+#define WORKERS_MAX         (4U)
+
+static const uint8_t _data[] = "log line";
+
+static const constfs_file_t _files[] = {
+    {
+        .path = "/log.txt",
+        .data = _data,
+        .size = sizeof(_data),
+    },
+};
+
+static const constfs_t _fs_data = {
+    .files = _files,
+    .nfiles = ARRAY_SIZE(_files),
+};
+
+/* a few mount points, as in an application with several storage devices */
+static vfs_mount_t _mounts[] = {
+    { .mount_point = "/const", .fs = &constfs_file_system,
+      .private_data = (void *)&_fs_data },
+    { .mount_point = "/sd", .fs = &constfs_file_system,
+      .private_data = (void *)&_fs_data },
+    { .mount_point = "/sd/logs", .fs = &constfs_file_system,
+      .private_data = (void *)&_fs_data },
+    { .mount_point = "/nvm", .fs = &constfs_file_system,
+      .private_data = (void *)&_fs_data },
+};
+
+static char _stacks[WORKERS_MAX][THREAD_STACKSIZE_DEFAULT];
+static mutex_t _done[WORKERS_MAX];
+static uint32_t _errors;
+
+static void *_worker(void *arg)
+{
+    mutex_t *done = arg;
+    struct stat st;
+
+    for (unsigned i = 0; i < BENCH_ITERATIONS; i++) {
+        int fd = vfs_open("/sd/logs/log.txt", O_RDONLY, 0);
+
+        if ((fd < 0) || (vfs_stat("/nvm/log.txt", &st) < 0) ||
+            (vfs_close(fd) < 0)) {
+            atomic_fetch_add_u32(&_errors, 1);
+        }
+        /* let the other workers run in between */
+        thread_yield();
+    }
+    mutex_unlock(done);
+    return NULL;
+}
+
+static void _bench(unsigned workers)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < workers; i++) {
+        mutex_init(&_done[i]);
+        mutex_lock(&_done[i]);
+        thread_create(_stacks[i], sizeof(_stacks[i]), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                      _worker, &_done[i], "vfs_worker");
+    }
+    for (unsigned i = 0; i < workers; i++) {
+        mutex_lock(&_done[i]);
+    }
+
+    uint32_t time = xtimer_now_usec() - start;
+    /* open, stat and close per iteration */
+    unsigned ops = workers * BENCH_ITERATIONS * 3;
+
+    printf("%u thread(s): %6u ops in %7u us, %7u ops/s\n", workers, ops,
+           (unsigned)time, (unsigned)((uint64_t)ops * US_PER_SEC / time));
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_mounts); i++) {
+        if (vfs_mount(&_mounts[i]) < 0) {
+            puts("vfs_mount failed");
+            return 1;
+        }
+    }
+
+    _bench(1);
+    _bench(WORKERS_MAX);
+
+    if (_errors) {
+        printf("%u errors\n", (unsigned)_errors);
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
+/** @} */
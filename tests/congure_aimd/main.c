@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the CongURE AIMD implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "clist.h"
+#include "congure/aimd.h"
+#include "embUnit.h"
+#include "kernel_defines.h"
+
+#define INIT_WND        (8U)
+#define MIN_WND         (1U)
+#define MAX_WND         (12U)
+#define AI              (2U)
+#define MD_PERCENT      (50U)
+
+static const congure_aimd_consts_t _consts = {
+    .init_wnd = INIT_WND,
+    .min_wnd = MIN_WND,
+    .max_wnd = MAX_WND,
+    .ai = AI,
+    .md_percent = MD_PERCENT,
+};
+
+static congure_aimd_snd_t _c;
+static congure_snd_msg_t _msgs[4];
+static congure_snd_ack_t _ack;
+
+static void _set_up(void)
+{
+    memset(&_c, 0, sizeof(_c));
+    memset(_msgs, 0, sizeof(_msgs));
+    memset(&_ack, 0, sizeof(_ack));
+    congure_aimd_snd_setup(&_c, &_consts);
+    _c.super.driver->init(&_c.super, NULL);
+}
+
+/* acknowledges a message of @p size units */
+static void _ack_msg(congure_wnd_size_t size)
+{
+    _msgs[0].size = size;
+    _c.super.driver->report_msg_acked(&_c.super, &_msgs[0], &_ack);
+}
+
+/* builds the list of lost messages reported to the driver from
+ * @p send_times */
+static congure_snd_msg_t *_msg_list(const ztimer_now_t *send_times,
+                                    unsigned num)
+{
+    clist_node_t list = { .next = NULL };
+
+    for (unsigned i = 0; i < num; i++) {
+        _msgs[i].send_time = send_times[i];
+        _msgs[i].size = 1;
+        clist_rpush(&list, &_msgs[i].super);
+    }
+    return (congure_snd_msg_t *)list.next;
+}
+
+static void test_congure_aimd_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(INIT_WND, _c.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(-1,
+        _c.super.driver->inter_msg_interval(&_c.super, 1));
+}
+
+static void test_congure_aimd_increase(void)
+{
+    /* one additive increase per fully acknowledged window */
+    for (unsigned i = 0; i < (INIT_WND - 1); i++) {
+        _ack_msg(1);
+    }
+    TEST_ASSERT_EQUAL_INT(INIT_WND, _c.super.cwnd);
+    _ack_msg(1);
+    TEST_ASSERT_EQUAL_INT(INIT_WND + AI, _c.super.cwnd);
+
+    /* the next increase needs the larger window acknowledged */
+    _ack_msg(INIT_WND);
+    TEST_ASSERT_EQUAL_INT(INIT_WND + AI, _c.super.cwnd);
+    _ack_msg(AI);
+    TEST_ASSERT_EQUAL_INT(MAX_WND, _c.super.cwnd);
+
+    /* and never beyond the maximum */
+    _ack_msg(MAX_WND);
+    TEST_ASSERT_EQUAL_INT(MAX_WND, _c.super.cwnd);
+}
+
+static void test_congure_aimd_lost(void)
+{
+    static const ztimer_now_t event1[] = { 100, 120, 110 };
+    static const ztimer_now_t event1_late[] = { 115 };
+    static const ztimer_now_t event2[] = { 121 };
+
+    /* the newest message of the event is remembered */
+    _c.super.driver->report_msgs_lost(&_c.super,
+                                      _msg_list(event1, ARRAY_SIZE(event1)));
+    TEST_ASSERT_EQUAL_INT((INIT_WND * MD_PERCENT) / 100, _c.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(120, _c.recover);
+
+    /* more losses of the same congestion event do not decrease again */
+    _c.super.driver->report_msgs_lost(&_c.super,
+                                      _msg_list(event1_late,
+                                                ARRAY_SIZE(event1_late)));
+    TEST_ASSERT_EQUAL_INT((INIT_WND * MD_PERCENT) / 100, _c.super.cwnd);
+
+    /* a loss of a message sent later is a new event */
+    _c.super.driver->report_msgs_lost(&_c.super,
+                                      _msg_list(event2, ARRAY_SIZE(event2)));
+    TEST_ASSERT_EQUAL_INT((INIT_WND * MD_PERCENT * MD_PERCENT) / 10000,
+                          _c.super.cwnd);
+}
+
+static void test_congure_aimd_timeout(void)
+{
+    static const ztimer_now_t event1[] = { 100 };
+    static const ztimer_now_t event2[] = { 200 };
+    static const ztimer_now_t event3[] = { 300 };
+    static const ztimer_now_t event4[] = { 400 };
+
+    /* timeouts are handled like losses */
+    _c.super.driver->report_msgs_timeout(&_c.super,
+                                         _msg_list(event1,
+                                                   ARRAY_SIZE(event1)));
+    TEST_ASSERT_EQUAL_INT((INIT_WND * MD_PERCENT) / 100, _c.super.cwnd);
+    _c.super.driver->report_msgs_timeout(&_c.super,
+                                         _msg_list(event1,
+                                                   ARRAY_SIZE(event1)));
+    TEST_ASSERT_EQUAL_INT((INIT_WND * MD_PERCENT) / 100, _c.super.cwnd);
+
+    /* the window does not drop below the minimum */
+    _c.super.driver->report_msgs_timeout(&_c.super,
+                                         _msg_list(event2,
+                                                   ARRAY_SIZE(event2)));
+    _c.super.driver->report_msgs_timeout(&_c.super,
+                                         _msg_list(event3,
+                                                   ARRAY_SIZE(event3)));
+    _c.super.driver->report_msgs_timeout(&_c.super,
+                                         _msg_list(event4,
+                                                   ARRAY_SIZE(event4)));
+    TEST_ASSERT_EQUAL_INT(MIN_WND, _c.super.cwnd);
+
+    /* an empty report does not change anything */
+    _c.super.driver->report_msgs_timeout(&_c.super, NULL);
+    TEST_ASSERT_EQUAL_INT(MIN_WND, _c.super.cwnd);
+}
+
+static void test_congure_aimd_ecn_ce(void)
+{
+    /* partially acknowledged window is reset on decrease */
+    _ack_msg(INIT_WND - 1);
+    _c.super.driver->report_ecn_ce(&_c.super, 50);
+    TEST_ASSERT_EQUAL_INT((INIT_WND * MD_PERCENT) / 100, _c.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(0, _c.acked);
+
+    /* CE for messages sent before the decrease belongs to the same event */
+    _c.super.driver->report_ecn_ce(&_c.super, 50);
+    _c.super.driver->report_ecn_ce(&_c.super, 20);
+    TEST_ASSERT_EQUAL_INT((INIT_WND * MD_PERCENT) / 100, _c.super.cwnd);
+
+    _c.super.driver->report_ecn_ce(&_c.super, 51);
+    TEST_ASSERT_EQUAL_INT((INIT_WND * MD_PERCENT * MD_PERCENT) / 10000,
+                          _c.super.cwnd);
+}
+
+static Test *tests_congure_aimd(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_congure_aimd_init),
+        new_TestFixture(test_congure_aimd_increase),
+        new_TestFixture(test_congure_aimd_lost),
+        new_TestFixture(test_congure_aimd_timeout),
+        new_TestFixture(test_congure_aimd_ecn_ce),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, _set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_congure_aimd());
+    TESTS_END();
+    return 0;
+}
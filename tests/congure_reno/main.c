@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the CongURE Reno-like implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "clist.h"
+#include "congure/reno.h"
+#include "embUnit.h"
+#include "kernel_defines.h"
+
+#define INIT_WND        (2U)
+#define MIN_WND         (1U)
+#define MAX_WND         (12U)
+#define INIT_SSTHRESH   (8U)
+#define MSS             (1U)
+
+static const congure_reno_consts_t _consts = {
+    .init_wnd = INIT_WND,
+    .min_wnd = MIN_WND,
+    .max_wnd = MAX_WND,
+    .init_ssthresh = INIT_SSTHRESH,
+    .mss = MSS,
+};
+
+static congure_reno_snd_t _c;
+static congure_snd_msg_t _msgs[4];
+static congure_snd_ack_t _ack;
+
+static void _set_up(void)
+{
+    memset(&_c, 0, sizeof(_c));
+    memset(_msgs, 0, sizeof(_msgs));
+    memset(&_ack, 0, sizeof(_ack));
+    congure_reno_snd_setup(&_c, &_consts);
+    _c.super.driver->init(&_c.super, NULL);
+}
+
+/* acknowledges a message of @p size units */
+static void _ack_msg(congure_wnd_size_t size)
+{
+    _msgs[0].size = size;
+    _c.super.driver->report_msg_acked(&_c.super, &_msgs[0], &_ack);
+}
+
+/* builds the list of lost messages reported to the driver from
+ * @p send_times */
+static congure_snd_msg_t *_msg_list(const ztimer_now_t *send_times,
+                                    unsigned num)
+{
+    clist_node_t list = { .next = NULL };
+
+    for (unsigned i = 0; i < num; i++) {
+        _msgs[i].send_time = send_times[i];
+        _msgs[i].size = 1;
+        clist_rpush(&list, &_msgs[i].super);
+    }
+    return (congure_snd_msg_t *)list.next;
+}
+
+/* grows the window in slow start up to the initial threshold */
+static void _slow_start(void)
+{
+    _ack_msg(INIT_SSTHRESH - INIT_WND);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH, _c.super.cwnd);
+}
+
+static void test_congure_reno_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(INIT_WND, _c.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH, _c.ssthresh);
+    TEST_ASSERT_EQUAL_INT(-1,
+        _c.super.driver->inter_msg_interval(&_c.super, 1));
+}
+
+static void test_congure_reno_slow_start(void)
+{
+    /* the window grows by every acknowledged unit */
+    _ack_msg(1);
+    TEST_ASSERT_EQUAL_INT(INIT_WND + 1, _c.super.cwnd);
+    _ack_msg(2);
+    TEST_ASSERT_EQUAL_INT(INIT_WND + 3, _c.super.cwnd);
+    _ack_msg(INIT_SSTHRESH - (INIT_WND + 3));
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH, _c.super.cwnd);
+}
+
+static void test_congure_reno_congestion_avoidance(void)
+{
+    _slow_start();
+
+    /* at the threshold the window grows by MSS per acknowledged window */
+    _ack_msg(INIT_SSTHRESH - 1);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH, _c.super.cwnd);
+    _ack_msg(1);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH + MSS, _c.super.cwnd);
+    _ack_msg(INIT_SSTHRESH);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH + MSS, _c.super.cwnd);
+    _ack_msg(MSS);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH + (2 * MSS), _c.super.cwnd);
+}
+
+static void test_congure_reno_lost(void)
+{
+    static const ztimer_now_t event1[] = { 100, 130, 120 };
+    static const ztimer_now_t event1_late[] = { 125 };
+    static const ztimer_now_t event2[] = { 131 };
+
+    _slow_start();
+
+    /* fast recovery: threshold and window are halved */
+    _c.super.driver->report_msgs_lost(&_c.super,
+                                      _msg_list(event1, ARRAY_SIZE(event1)));
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.ssthresh);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(130, _c.recover);
+
+    /* more losses of the same congestion event do not decrease again */
+    _c.super.driver->report_msgs_lost(&_c.super,
+                                      _msg_list(event1_late,
+                                                ARRAY_SIZE(event1_late)));
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.super.cwnd);
+
+    /* the window continues in congestion avoidance */
+    _ack_msg(INIT_SSTHRESH / 2);
+    TEST_ASSERT_EQUAL_INT((INIT_SSTHRESH / 2) + MSS, _c.super.cwnd);
+
+    /* a loss of a message sent later is a new event */
+    _c.super.driver->report_msgs_lost(&_c.super,
+                                      _msg_list(event2, ARRAY_SIZE(event2)));
+    TEST_ASSERT_EQUAL_INT(((INIT_SSTHRESH / 2) + MSS) / 2, _c.ssthresh);
+    TEST_ASSERT_EQUAL_INT(((INIT_SSTHRESH / 2) + MSS) / 2, _c.super.cwnd);
+}
+
+static void test_congure_reno_timeout(void)
+{
+    static const ztimer_now_t event1[] = { 100 };
+    static const ztimer_now_t event1_lost[] = { 90 };
+
+    _slow_start();
+
+    /* the window falls back to the loss window */
+    _c.super.driver->report_msgs_timeout(&_c.super,
+                                         _msg_list(event1,
+                                                   ARRAY_SIZE(event1)));
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.ssthresh);
+    TEST_ASSERT_EQUAL_INT(MIN_WND, _c.super.cwnd);
+
+    /* neither repeated timeouts nor losses of the same event change it */
+    _c.super.driver->report_msgs_timeout(&_c.super,
+                                         _msg_list(event1,
+                                                   ARRAY_SIZE(event1)));
+    _c.super.driver->report_msgs_lost(&_c.super,
+                                      _msg_list(event1_lost,
+                                                ARRAY_SIZE(event1_lost)));
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.ssthresh);
+    TEST_ASSERT_EQUAL_INT(MIN_WND, _c.super.cwnd);
+
+    /* slow start up to the new threshold */
+    _ack_msg(1);
+    TEST_ASSERT_EQUAL_INT(MIN_WND + 1, _c.super.cwnd);
+    _ack_msg((INIT_SSTHRESH / 2) - (MIN_WND + 1));
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.super.cwnd);
+    _ack_msg(1);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.super.cwnd);
+
+    /* an empty report does not change anything */
+    _c.super.driver->report_msgs_timeout(&_c.super, NULL);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.super.cwnd);
+}
+
+static void test_congure_reno_ecn_ce(void)
+{
+    _slow_start();
+
+    _c.super.driver->report_ecn_ce(&_c.super, 50);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.ssthresh);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.super.cwnd);
+
+    /* CE for messages sent before the decrease belongs to the same event */
+    _c.super.driver->report_ecn_ce(&_c.super, 50);
+    _c.super.driver->report_ecn_ce(&_c.super, 20);
+    TEST_ASSERT_EQUAL_INT(INIT_SSTHRESH / 2, _c.super.cwnd);
+
+    /* the threshold does not drop below the minimum window */
+    _c.super.driver->report_ecn_ce(&_c.super, 51);
+    _c.super.driver->report_ecn_ce(&_c.super, 52);
+    _c.super.driver->report_ecn_ce(&_c.super, 53);
+    TEST_ASSERT_EQUAL_INT(MIN_WND, _c.ssthresh);
+    TEST_ASSERT_EQUAL_INT(MIN_WND, _c.super.cwnd);
+}
+
+static Test *tests_congure_reno(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_congure_reno_init),
+        new_TestFixture(test_congure_reno_slow_start),
+        new_TestFixture(test_congure_reno_congestion_avoidance),
+        new_TestFixture(test_congure_reno_lost),
+        new_TestFixture(test_congure_reno_timeout),
+        new_TestFixture(test_congure_reno_ecn_ce),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, _set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_congure_reno());
+    TESTS_END();
+    return 0;
+}
@@ -0,0 +1,563 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the commands sdcard_spi sends for multi-block transfers
+ *
+ * The SPI and GPIO functions called by the driver are wrapped at link time
+ * and drive an emulated SDHC card, which records every command it receives.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "checksum/ucrc16.h"
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "periph/gpio.h"
+#include "periph/spi.h"
+#include "sdcard_spi.h"
+#include "sdcard_spi_internal.h"
+
+#define CARD_BLOCKS         (16U)
+#define CARD_MAX_CMDS       (16U)
+
+#define PIN_CS              GPIO_PIN(0, 0)
+#define PIN_CLK             GPIO_PIN(0, 1)
+#define PIN_MOSI            GPIO_PIN(0, 2)
+#define PIN_MISO            GPIO_PIN(0, 3)
+
+#define R1_ILLEGAL_CMD      (SD_R1_RESPONSE_ILLEGAL_CMD_ERROR)
+#define DATA_ACCEPTED       (0x05)
+#define DATA_CRC_ERROR      (0x0b)
+
+typedef enum {
+    CARD_CMD,           /**< waits for a command */
+    CARD_READ,          /**< sends the data blocks of CMD17/CMD18 */
+    CARD_WRITE,         /**< receives the data blocks of CMD24/CMD25 */
+} card_state_t;
+
+typedef struct {
+    uint8_t idx;
+    uint32_t arg;
+} card_cmd_t;
+
+static const sdcard_spi_params_t _params = {
+    .spi_dev = SPI_DEV(0),
+    .cs = PIN_CS,
+    .clk = PIN_CLK,
+    .mosi = PIN_MOSI,
+    .miso = PIN_MISO,
+    .power = GPIO_UNDEF,
+    .power_act_high = true,
+};
+
+static struct {
+    card_state_t state;
+    bool idle;                  /* in idle state until ACMD41 */
+    bool app_cmd;               /* the previous command was CMD55 */
+    bool refuse_acmd23;         /* reject the pre-erase hint */
+    bool multi;                 /* CMD18 or CMD25 */
+    bool receiving;             /* a data block is received */
+    uint32_t block;             /* next block to read or write */
+    uint8_t cmd[6];
+    unsigned cmd_len;
+    uint8_t in[SD_HC_BLOCK_SIZE + 2];
+    unsigned in_len;
+    uint8_t out[SD_HC_BLOCK_SIZE + 8];
+    unsigned out_len;
+    unsigned out_pos;
+    card_cmd_t cmds[CARD_MAX_CMDS];
+    unsigned cmds_num;
+    unsigned stop_tokens;
+    uint8_t mem[CARD_BLOCKS][SD_HC_BLOCK_SIZE];
+} _card;
+
+/* levels of the pins and the bit-banged byte of the init sequence */
+static struct {
+    bool cs;
+    bool clk;
+    bool mosi;
+    unsigned bits;
+    uint8_t in;
+    uint8_t out;
+} _pins;
+
+static sdcard_spi_t _dev;
+static uint8_t _buf[3 * SD_HC_BLOCK_SIZE];
+
+static uint8_t _crc7(const uint8_t *data, unsigned len)
+{
+    uint8_t crc = 0;
+
+    for (unsigned i = 0; i < len; i++) {
+        uint8_t d = data[i];
+        for (unsigned j = 0; j < 8; j++) {
+            crc <<= 1;
+            if ((d ^ crc) & 0x80) {
+                crc ^= 0x09;
+            }
+            d <<= 1;
+        }
+    }
+    return (crc << 1) | 1;
+}
+
+static void _queue(uint8_t byte)
+{
+    if (_card.out_pos == _card.out_len) {
+        _card.out_pos = 0;
+        _card.out_len = 0;
+    }
+    _card.out[_card.out_len++] = byte;
+}
+
+/* queues a data packet after the access time of the card */
+static void _queue_data(const uint8_t *data, unsigned len)
+{
+    uint16_t crc = ucrc16_calc_be(data, len, UCRC16_CCITT_POLY_BE, 0);
+
+    _queue(SD_CARD_DUMMY_BYTE);
+    _queue(SD_DATA_TOKEN_CMD_17_18_24);
+    for (unsigned i = 0; i < len; i++) {
+        _queue(data[i]);
+    }
+    _queue(crc >> 8);
+    _queue(crc & 0xff);
+}
+
+static void _queue_read_block(void)
+{
+    if (_card.block < CARD_BLOCKS) {
+        _queue_data(_card.mem[_card.block++], SD_HC_BLOCK_SIZE);
+    }
+}
+
+static void _card_cmd(void)
+{
+    uint8_t idx = _card.cmd[0] & 0x3f;
+    uint32_t arg = ((uint32_t)_card.cmd[1] << 24) |
+                   ((uint32_t)_card.cmd[2] << 16) |
+                   ((uint32_t)_card.cmd[3] << 8) | _card.cmd[4];
+    bool app_cmd = _card.app_cmd;
+    bool illegal = false;
+
+    if (_card.cmds_num < CARD_MAX_CMDS) {
+        _card.cmds[_card.cmds_num++] = (card_cmd_t){ .idx = idx, .arg = arg };
+    }
+    _card.app_cmd = false;
+
+    switch (idx) {
+    case SD_CMD_0:
+        _card.idle = true;
+        break;
+    case SD_CMD_55:
+        _card.app_cmd = true;
+        break;
+    case SD_CMD_41:
+        _card.idle = !app_cmd;
+        break;
+    case SD_CMD_23:
+        illegal = !app_cmd || _card.refuse_acmd23;
+        break;
+    case SD_CMD_17:
+    case SD_CMD_18:
+        _card.state = CARD_READ;
+        _card.multi = (idx == SD_CMD_18);
+        _card.block = arg;
+        break;
+    case SD_CMD_24:
+    case SD_CMD_25:
+        _card.state = CARD_WRITE;
+        _card.multi = (idx == SD_CMD_25);
+        _card.receiving = false;
+        _card.block = arg;
+        break;
+    case SD_CMD_8:
+    case SD_CMD_9:
+    case SD_CMD_10:
+    case SD_CMD_12:
+    case SD_CMD_16:
+    case SD_CMD_58:
+    case SD_CMD_59:
+        break;
+    default:
+        illegal = true;
+        break;
+    }
+
+    /* one byte of response time, then R1 and the rest of the response */
+    _queue(SD_CARD_DUMMY_BYTE);
+    _queue((_card.idle ? SD_R1_RESPONSE_IN_IDLE_STATE : 0) |
+           (illegal ? R1_ILLEGAL_CMD : 0));
+
+    if (idx == SD_CMD_8) {
+        /* R7: voltage accepted and check pattern */
+        _queue(0);
+        _queue(0);
+        _queue((arg >> 8) & 0x0f);
+        _queue(arg & 0xff);
+    }
+    else if (idx == SD_CMD_58) {
+        /* R3: powered up SDHC card with 3.2-3.3 V */
+        _queue(0xc0);
+        _queue(0x10);
+        _queue(0);
+        _queue(0);
+    }
+    else if ((idx == SD_CMD_9) || (idx == SD_CMD_10)) {
+        uint8_t reg[SD_SIZE_OF_CID_AND_CSD_REG] = { 0 };
+
+        if (idx == SD_CMD_9) {
+            reg[0] = SD_CSD_V2 << 6;
+        }
+        reg[sizeof(reg) - 1] = _crc7(reg, sizeof(reg) - 1);
+        _queue_data(reg, sizeof(reg));
+    }
+    else if (_card.state == CARD_READ) {
+        _queue_read_block();
+    }
+}
+
+static void _card_write(uint8_t in)
+{
+    if (!_card.receiving) {
+        if (_card.multi && (in == SD_DATA_TOKEN_CMD_25_STOP)) {
+            _card.stop_tokens++;
+            _card.state = CARD_CMD;
+            /* busy for some bytes after a byte of response time */
+            _queue(SD_CARD_DUMMY_BYTE);
+            _queue(0);
+            _queue(0);
+        }
+        else if (in == (_card.multi ? SD_DATA_TOKEN_CMD_25
+                                    : SD_DATA_TOKEN_CMD_17_18_24)) {
+            _card.receiving = true;
+            _card.in_len = 0;
+        }
+        return;
+    }
+
+    _card.in[_card.in_len++] = in;
+    if (_card.in_len < sizeof(_card.in)) {
+        return;
+    }
+
+    _card.receiving = false;
+    uint16_t crc = ucrc16_calc_be(_card.in, SD_HC_BLOCK_SIZE,
+                                  UCRC16_CCITT_POLY_BE, 0);
+    if ((_card.in[SD_HC_BLOCK_SIZE] != (crc >> 8)) ||
+        (_card.in[SD_HC_BLOCK_SIZE + 1] != (crc & 0xff))) {
+        _queue(DATA_CRC_ERROR);
+        return;
+    }
+    if (_card.block < CARD_BLOCKS) {
+        memcpy(_card.mem[_card.block++], _card.in, SD_HC_BLOCK_SIZE);
+    }
+    /* data response, then busy while programming */
+    _queue(DATA_ACCEPTED);
+    _queue(0);
+    _queue(0);
+    if (!_card.multi) {
+        _card.state = CARD_CMD;
+    }
+}
+
+/* one byte of the full duplex transfer */
+static uint8_t _card_out(void)
+{
+    if ((_card.out_pos == _card.out_len) && (_card.state == CARD_READ) &&
+        _card.multi) {
+        _queue_read_block();
+    }
+    if (_card.out_pos < _card.out_len) {
+        return _card.out[_card.out_pos++];
+    }
+    return SD_CARD_DUMMY_BYTE;
+}
+
+static void _card_in(uint8_t in)
+{
+    if (_card.state == CARD_WRITE) {
+        _card_write(in);
+        return;
+    }
+    if ((_card.cmd_len == 0) && ((in & 0xc0) != SD_CMD_PREFIX_MASK)) {
+        return;
+    }
+    if (_card.state == CARD_READ) {
+        /* a command, i.e. CMD12, stops sending data */
+        _card.state = CARD_CMD;
+        _card.out_pos = 0;
+        _card.out_len = 0;
+    }
+    _card.cmd[_card.cmd_len++] = in;
+    if (_card.cmd_len == sizeof(_card.cmd)) {
+        _card.cmd_len = 0;
+        _card_cmd();
+    }
+}
+
+int __wrap_gpio_init(gpio_t pin, gpio_mode_t mode)
+{
+    (void)pin;
+    (void)mode;
+    return 0;
+}
+
+int __wrap_gpio_read(gpio_t pin)
+{
+    if (pin == PIN_MISO) {
+        return (_pins.out >> (7 - _pins.bits)) & 1;
+    }
+    return 0;
+}
+
+void __wrap_gpio_write(gpio_t pin, int value)
+{
+    if (pin == PIN_CS) {
+        _pins.cs = value;
+    }
+    else if (pin == PIN_MOSI) {
+        _pins.mosi = value;
+    }
+    else if ((pin == PIN_CLK) && (_pins.clk != !!value)) {
+        _pins.clk = value;
+        if (_pins.cs) {
+            /* the power up clocks are sent with the card deselected */
+            return;
+        }
+        if (value) {
+            /* the card shifts out on the first rising edge of each byte */
+            if (_pins.bits == 0) {
+                _pins.out = _card_out();
+            }
+            _pins.in = (_pins.in << 1) | _pins.mosi;
+        }
+        else if (++_pins.bits == 8) {
+            _pins.bits = 0;
+            _card_in(_pins.in);
+        }
+    }
+}
+
+void __wrap_gpio_set(gpio_t pin)
+{
+    __wrap_gpio_write(pin, 1);
+}
+
+void __wrap_gpio_clear(gpio_t pin)
+{
+    __wrap_gpio_write(pin, 0);
+}
+
+int __wrap_spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
+{
+    (void)bus;
+    (void)cs;
+    (void)mode;
+    (void)clk;
+    return SPI_OK;
+}
+
+void __wrap_spi_release(spi_t bus)
+{
+    (void)bus;
+}
+
+void __wrap_spi_init_pins(spi_t bus)
+{
+    (void)bus;
+}
+
+uint8_t __wrap_spi_transfer_byte(spi_t bus, spi_cs_t cs, bool cont,
+                                 uint8_t out)
+{
+    (void)bus;
+    (void)cs;
+    (void)cont;
+
+    if (_pins.cs) {
+        return SD_CARD_DUMMY_BYTE;
+    }
+    uint8_t in = _card_out();
+    _card_in(out);
+    return in;
+}
+
+static void _set_up(void)
+{
+    memset(&_card, 0, sizeof(_card));
+    memset(&_pins, 0, sizeof(_pins));
+    memset(&_dev, 0, sizeof(_dev));
+    _pins.cs = true;
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = i * 7;
+    }
+}
+
+/* initializes the card and forgets the commands of the init sequence */
+static void _init_card(void)
+{
+    TEST_ASSERT_EQUAL_INT(SDCARD_SPI_OK, sdcard_spi_init(&_dev, &_params));
+    _card.cmds_num = 0;
+}
+
+static void _assert_cmds(const card_cmd_t *cmds, unsigned num)
+{
+    TEST_ASSERT_EQUAL_INT(num, _card.cmds_num);
+    for (unsigned i = 0; i < num; i++) {
+        TEST_ASSERT_EQUAL_INT(cmds[i].idx, _card.cmds[i].idx);
+        TEST_ASSERT_EQUAL_INT(cmds[i].arg, _card.cmds[i].arg);
+    }
+}
+
+static void test_sdcard_spi_init(void)
+{
+    static const card_cmd_t cmds[] = {
+        { SD_CMD_0, 0 },
+        { SD_CMD_59, SD_CMD_59_ARG_EN },
+        { SD_CMD_8, (SD_CMD_8_VHS_2_7_V_TO_3_6_V << 8) | SD_CMD_8_CHECK_PATTERN },
+        { SD_CMD_55, 0 },
+        { SD_CMD_41, SD_ACMD_41_ARG_HC },
+        { SD_CMD_58, 0 },
+        { SD_CMD_10, 0 },
+        { SD_CMD_9, 0 },
+    };
+
+    TEST_ASSERT_EQUAL_INT(SDCARD_SPI_OK, sdcard_spi_init(&_dev, &_params));
+    TEST_ASSERT_EQUAL_INT(SD_V2, _dev.card_type);
+    TEST_ASSERT(_dev.use_block_addr);
+    _assert_cmds(cmds, ARRAY_SIZE(cmds));
+}
+
+static void test_sdcard_spi_write_single(void)
+{
+    static const card_cmd_t cmds[] = {
+        { SD_CMD_24, 5 },
+    };
+    sd_rw_response_t state = SD_RW_RX_TX_ERROR;
+
+    _init_card();
+    TEST_ASSERT_EQUAL_INT(1, sdcard_spi_write_blocks(&_dev, 5, _buf,
+                                                     SD_HC_BLOCK_SIZE, 1,
+                                                     &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    _assert_cmds(cmds, ARRAY_SIZE(cmds));
+    TEST_ASSERT_EQUAL_INT(0, _card.stop_tokens);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_card.mem[5], _buf, SD_HC_BLOCK_SIZE));
+}
+
+static void test_sdcard_spi_write_multi(void)
+{
+    /* ACMD23 announces the blocks to pre-erase, CMD25 writes them */
+    static const card_cmd_t cmds[] = {
+        { SD_CMD_55, 0 },
+        { SD_CMD_23, 3 },
+        { SD_CMD_25, 5 },
+    };
+    sd_rw_response_t state = SD_RW_RX_TX_ERROR;
+
+    _init_card();
+    TEST_ASSERT_EQUAL_INT(3, sdcard_spi_write_blocks(&_dev, 5, _buf,
+                                                     SD_HC_BLOCK_SIZE, 3,
+                                                     &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    _assert_cmds(cmds, ARRAY_SIZE(cmds));
+    TEST_ASSERT_EQUAL_INT(1, _card.stop_tokens);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_card.mem[5], _buf, sizeof(_buf)));
+}
+
+static void test_sdcard_spi_write_multi_no_hint(void)
+{
+    /* a card refusing the pre-erase hint is written without it */
+    static const card_cmd_t cmds[] = {
+        { SD_CMD_55, 0 },
+        { SD_CMD_23, 2 },
+        { SD_CMD_25, 9 },
+    };
+    sd_rw_response_t state = SD_RW_RX_TX_ERROR;
+
+    _init_card();
+    _card.refuse_acmd23 = true;
+    TEST_ASSERT_EQUAL_INT(2, sdcard_spi_write_blocks(&_dev, 9, _buf,
+                                                     SD_HC_BLOCK_SIZE, 2,
+                                                     &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    _assert_cmds(cmds, ARRAY_SIZE(cmds));
+    TEST_ASSERT_EQUAL_INT(1, _card.stop_tokens);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_card.mem[9], _buf,
+                                    2 * SD_HC_BLOCK_SIZE));
+}
+
+static void test_sdcard_spi_read_single(void)
+{
+    static const card_cmd_t cmds[] = {
+        { SD_CMD_17, 2 },
+    };
+    sd_rw_response_t state = SD_RW_RX_TX_ERROR;
+
+    _init_card();
+    memcpy(_card.mem[2], _buf, SD_HC_BLOCK_SIZE);
+    memset(_buf, 0, sizeof(_buf));
+    TEST_ASSERT_EQUAL_INT(1, sdcard_spi_read_blocks(&_dev, 2, _buf,
+                                                    SD_HC_BLOCK_SIZE, 1,
+                                                    &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    _assert_cmds(cmds, ARRAY_SIZE(cmds));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_card.mem[2], _buf, SD_HC_BLOCK_SIZE));
+}
+
+static void test_sdcard_spi_read_multi(void)
+{
+    /* CMD18 reads all blocks, CMD12 stops the transmission */
+    static const card_cmd_t cmds[] = {
+        { SD_CMD_18, 2 },
+        { SD_CMD_12, 0 },
+    };
+    sd_rw_response_t state = SD_RW_RX_TX_ERROR;
+
+    _init_card();
+    memcpy(_card.mem[2], _buf, sizeof(_buf));
+    memset(_buf, 0, sizeof(_buf));
+    TEST_ASSERT_EQUAL_INT(3, sdcard_spi_read_blocks(&_dev, 2, _buf,
+                                                    SD_HC_BLOCK_SIZE, 3,
+                                                    &state));
+    TEST_ASSERT_EQUAL_INT(SD_RW_OK, state);
+    _assert_cmds(cmds, ARRAY_SIZE(cmds));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_card.mem[2], _buf, sizeof(_buf)));
+}
+
+static Test *tests_sdcard_spi(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sdcard_spi_init),
+        new_TestFixture(test_sdcard_spi_write_single),
+        new_TestFixture(test_sdcard_spi_write_multi),
+        new_TestFixture(test_sdcard_spi_write_multi_no_hint),
+        new_TestFixture(test_sdcard_spi_read_single),
+        new_TestFixture(test_sdcard_spi_read_multi),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, _set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_sdcard_spi());
+    TESTS_END();
+    return 0;
+}
@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stress test for the 6LoWPAN reassembly buffer replaying
+ *              interleaved fragments of many senders.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+
+#define TEST_SENDERS            (64U)
+#define TEST_NETIF_HDR_SRC      { 0xb3, 0x47, 0x60, 0x49, \
+                                  0x78, 0xfe, 0x95, 0x00 }
+#define TEST_NETIF_HDR_DST      { 0xa4, 0xf2, 0xd2, 0xc9, \
+                                  0x13, 0xb9, 0xbb, 0x25 }
+#define TEST_NETIF_IFACE        (9)
+#define TEST_TAG                (0x690e)
+#define TEST_PAGE               (0)
+#define TEST_RECEIVE_TIMEOUT    (100U)
+#define TEST_FRAG_PAYLOAD_SIZE  (32U)
+#define TEST_FRAGS              (3U)
+#define TEST_DATAGRAM_SIZE      (TEST_FRAGS * TEST_FRAG_PAYLOAD_SIZE)
+#ifdef MODULE_GNRC_IPV6
+#define TEST_DATAGRAM_NETTYPE   (GNRC_NETTYPE_IPV6)
+#else  /* MODULE_GNRC_IPV6 */
+#define TEST_DATAGRAM_NETTYPE   (GNRC_NETTYPE_UNDEF)
+#endif /* MODULE_GNRC_IPV6 */
+
+static const uint8_t _test_netif_hdr_src[] = TEST_NETIF_HDR_SRC;
+static const uint8_t _test_netif_hdr_dst[] = TEST_NETIF_HDR_DST;
+static struct {
+    gnrc_netif_hdr_t hdr;
+    uint8_t src[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+    uint8_t dst[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+} _test_netif_hdr;
+
+/* large enough to hold a reassembled datagram of every sender */
+static msg_t _msg_queue[TEST_SENDERS];
+
+static inline uint8_t _payload_byte(unsigned sender, unsigned pos)
+{
+    return (uint8_t)(sender ^ (pos * 7));
+}
+
+static void _set_sender(unsigned sender)
+{
+    uint8_t src[sizeof(_test_netif_hdr_src)];
+
+    memcpy(src, _test_netif_hdr_src, sizeof(src));
+    src[sizeof(src) - 1] = sender;
+    gnrc_netif_hdr_set_src_addr(&_test_netif_hdr.hdr, src, sizeof(src));
+}
+
+static uint16_t _tag(unsigned sender)
+{
+    /* spread tags, but let some senders share one */
+    return TEST_TAG + (sender % (TEST_SENDERS / 4));
+}
+
+static gnrc_pktsnip_t *_build_fragment(unsigned sender, uint16_t tag,
+                                       unsigned frag)
+{
+    size_t hdr_size = (frag == 0) ? sizeof(sixlowpan_frag_t) + 1
+                                  : sizeof(sixlowpan_frag_n_t);
+    unsigned offset = frag * TEST_FRAG_PAYLOAD_SIZE;
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
+                                          hdr_size + TEST_FRAG_PAYLOAD_SIZE,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    uint8_t *payload;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    if (frag == 0) {
+        sixlowpan_frag_t *hdr = pkt->data;
+
+        hdr->disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        hdr->tag = byteorder_htons(tag);
+        payload = (uint8_t *)(hdr + 1);
+        *(payload++) = SIXLOWPAN_UNCOMP;
+    }
+    else {
+        sixlowpan_frag_n_t *hdr = pkt->data;
+
+        hdr->disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->tag = byteorder_htons(tag);
+        hdr->offset = offset / 8;
+        payload = (uint8_t *)(hdr + 1);
+    }
+    for (unsigned i = 0; i < TEST_FRAG_PAYLOAD_SIZE; i++) {
+        payload[i] = _payload_byte(sender, offset + i);
+    }
+    return pkt;
+}
+
+static gnrc_sixlowpan_frag_rb_t *_add_fragment(unsigned sender, unsigned frag)
+{
+    gnrc_pktsnip_t *pkt = _build_fragment(sender, _tag(sender), frag);
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    _set_sender(sender);
+    return gnrc_sixlowpan_frag_rb_add(&_test_netif_hdr.hdr, pkt,
+                                      frag * TEST_FRAG_PAYLOAD_SIZE,
+                                      TEST_PAGE);
+}
+
+static bool _sender_exists(unsigned sender)
+{
+    _set_sender(sender);
+    return gnrc_sixlowpan_frag_rb_exists(&_test_netif_hdr.hdr, _tag(sender));
+}
+
+static unsigned _rbuf_used(void)
+{
+    const gnrc_sixlowpan_frag_rb_t *rbuf = gnrc_sixlowpan_frag_rb_array();
+    unsigned used = 0;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if (!gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
+            used++;
+        }
+    }
+    return used;
+}
+
+static void _release_all(void)
+{
+    const gnrc_sixlowpan_frag_rb_t *rbuf = gnrc_sixlowpan_frag_rb_array();
+
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if (!gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
+            gnrc_sixlowpan_frag_rb_t *entry = (gnrc_sixlowpan_frag_rb_t *)&rbuf[i];
+
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
+            /* datagram was already dispatched, only entry is left over */
+            if (entry->super.current_size == 0) {
+                gnrc_sixlowpan_frag_rb_remove(entry);
+                continue;
+            }
+#endif
+            gnrc_pktbuf_release(entry->pkt);
+            gnrc_sixlowpan_frag_rb_remove(entry);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, _rbuf_used());
+    TEST_ASSERT(gnrc_sixlowpan_frag_rb_ints_empty());
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void _fill_rbuf(void)
+{
+    for (unsigned s = 0; s < TEST_SENDERS; s++) {
+        TEST_ASSERT_NOT_NULL(_add_fragment(s, 0));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_SENDERS, _rbuf_used());
+}
+
+static void _set_up(void)
+{
+    gnrc_sixlowpan_frag_rb_reset();
+    gnrc_pktbuf_init();
+    gnrc_netif_hdr_init(&_test_netif_hdr.hdr,
+                        GNRC_NETIF_HDR_L2ADDR_MAX_LEN,
+                        GNRC_NETIF_HDR_L2ADDR_MAX_LEN);
+    _test_netif_hdr.hdr.if_pid = TEST_NETIF_IFACE;
+    gnrc_netif_hdr_set_dst_addr(&_test_netif_hdr.hdr,
+                                (uint8_t *)_test_netif_hdr_dst,
+                                sizeof(_test_netif_hdr_dst));
+}
+
+static void test_rbuf_stress__interleaved(void)
+{
+    uint8_t seen[TEST_SENDERS] = { 0 };
+    unsigned completed = 0;
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL,
+            thread_getpid()
+        );
+
+    gnrc_netreg_register(TEST_DATAGRAM_NETTYPE, &reg);
+    for (unsigned round = 0; round < TEST_FRAGS; round++) {
+        for (unsigned i = 0; i < TEST_SENDERS; i++) {
+            /* shuffle senders and let each start with a different fragment */
+            unsigned sender = (i * 37 + round) % TEST_SENDERS;
+            unsigned frag = (sender + round) % TEST_FRAGS;
+            gnrc_sixlowpan_frag_rb_t *entry = _add_fragment(sender, frag);
+            int res;
+
+            TEST_ASSERT_NOT_NULL(entry);
+            TEST_ASSERT_EQUAL_INT(sender, entry->super.src[7]);
+            res = gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+                    entry, &_test_netif_hdr.hdr
+                );
+            if (round < (TEST_FRAGS - 1)) {
+                TEST_ASSERT_EQUAL_INT(0, res);
+            }
+            else {
+                TEST_ASSERT(res > 0);
+                completed++;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_SENDERS, completed);
+    for (unsigned i = 0; i < TEST_SENDERS; i++) {
+        msg_t msg;
+        gnrc_pktsnip_t *datagram;
+        gnrc_netif_hdr_t *netif_hdr;
+        unsigned sender;
+
+        TEST_ASSERT_MESSAGE(
+                xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) >= 0,
+                "Receiving reassembled datagram timed out"
+            );
+        TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV, msg.type);
+        datagram = msg.content.ptr;
+        TEST_ASSERT_NOT_NULL(datagram);
+        TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, datagram->size);
+        TEST_ASSERT_NOT_NULL(datagram->next);
+        netif_hdr = datagram->next->data;
+        sender = gnrc_netif_hdr_get_src_addr(netif_hdr)[7];
+        TEST_ASSERT(sender < TEST_SENDERS);
+        TEST_ASSERT_EQUAL_INT(0, seen[sender]);
+        seen[sender] = 1;
+        for (unsigned j = 0; j < TEST_DATAGRAM_SIZE; j++) {
+            TEST_ASSERT_EQUAL_INT(_payload_byte(sender, j),
+                                  ((uint8_t *)datagram->data)[j]);
+        }
+        gnrc_pktbuf_release(datagram);
+    }
+    gnrc_netreg_unregister(TEST_DATAGRAM_NETTYPE, &reg);
+    /* with CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER entries linger */
+    _release_all();
+}
+
+static void test_rbuf_stress__lookup(void)
+{
+    _fill_rbuf();
+    for (unsigned s = 0; s < TEST_SENDERS; s++) {
+        gnrc_sixlowpan_frag_rb_t *entry;
+
+        _set_sender(s);
+        entry = gnrc_sixlowpan_frag_rb_get_by_datagram(&_test_netif_hdr.hdr,
+                                                       _tag(s));
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_EQUAL_INT(s, entry->super.src[7]);
+        TEST_ASSERT_EQUAL_INT(_tag(s), entry->super.tag);
+        /* tag of another sender must not match */
+        TEST_ASSERT(!gnrc_sixlowpan_frag_rb_exists(&_test_netif_hdr.hdr,
+                                                   _tag(s) + 1));
+    }
+    /* remove every other sender and check the rest is still found */
+    for (unsigned s = 0; s < TEST_SENDERS; s += 2) {
+        _set_sender(s);
+        gnrc_sixlowpan_frag_rb_rm_by_datagram(&_test_netif_hdr.hdr, _tag(s));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_SENDERS / 2, _rbuf_used());
+    for (unsigned s = 0; s < TEST_SENDERS; s++) {
+        TEST_ASSERT_EQUAL_INT(s & 1, _sender_exists(s));
+    }
+    /* freed entries can be reused */
+    for (unsigned s = 0; s < TEST_SENDERS; s += 2) {
+        TEST_ASSERT_NOT_NULL(_add_fragment(s, 1));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_SENDERS, _rbuf_used());
+    _release_all();
+}
+
+static void test_rbuf_stress__full_rbuf(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (IS_ACTIVE(CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DO_NOT_OVERRIDE) ||
+        (TEST_SENDERS < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)) {
+        /* oldest entry is not replaced when reassembly buffer is full */
+        return;
+    }
+    _fill_rbuf();
+    /* refresh the oldest sender, so the second one becomes the oldest */
+    TEST_ASSERT_NOT_NULL(_add_fragment(0, 1));
+    /* reuse sender 0 with another tag to not run out of senders */
+    TEST_ASSERT_NOT_NULL((pkt = _build_fragment(0, TEST_TAG - 1, 0)));
+    _set_sender(0);
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_rb_add(&_test_netif_hdr.hdr, pkt,
+                                                    0, TEST_PAGE));
+    TEST_ASSERT_EQUAL_INT(TEST_SENDERS, _rbuf_used());
+    TEST_ASSERT(_sender_exists(0));
+    TEST_ASSERT(!_sender_exists(1));
+    for (unsigned s = 2; s < TEST_SENDERS; s++) {
+        TEST_ASSERT(_sender_exists(s));
+    }
+    _release_all();
+}
+
+static void test_rbuf_stress__gc(void)
+{
+    const gnrc_sixlowpan_frag_rb_t *rbuf = gnrc_sixlowpan_frag_rb_array();
+
+    _fill_rbuf();
+    /* let the first half of the senders time out */
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        gnrc_sixlowpan_frag_rb_t *entry = (gnrc_sixlowpan_frag_rb_t *)&rbuf[i];
+
+        if (!gnrc_sixlowpan_frag_rb_entry_empty(entry) &&
+            (entry->super.src[7] < (TEST_SENDERS / 2))) {
+            entry->super.arrival -= CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US + 1;
+        }
+    }
+    gnrc_sixlowpan_frag_rb_gc();
+    TEST_ASSERT_EQUAL_INT(TEST_SENDERS / 2, _rbuf_used());
+    for (unsigned s = 0; s < TEST_SENDERS; s++) {
+        TEST_ASSERT_EQUAL_INT(s >= (TEST_SENDERS / 2), _sender_exists(s));
+    }
+    _release_all();
+}
+
+static void run_unittests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rbuf_stress__interleaved),
+        new_TestFixture(test_rbuf_stress__lookup),
+        new_TestFixture(test_rbuf_stress__full_rbuf),
+        new_TestFixture(test_rbuf_stress__gc),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlo_frag_rb_stress_tests, _set_up, NULL, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&sixlo_frag_rb_stress_tests);
+    TESTS_END();
+}
+
+int main(void)
+{
+    msg_init_queue(_msg_queue, TEST_SENDERS);
+    run_unittests();
+    return 0;
+}
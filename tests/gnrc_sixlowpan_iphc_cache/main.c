@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the invalidation of the IPHC flow cache
+ *
+ * A flow is compressed twice, before and after an input of the address
+ * compression besides the flow itself changed. The second frame must reflect
+ * the change instead of the cached compression modes.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+#include "net/ieee802154.h"
+#include "net/l2util.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+
+#define TEST_SRC_L2         { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_SRC_L2_NEW     { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x7a }
+#define TEST_DST_L2         { 0x5a, 0x9d, 0x93, 0x86, 0x22, 0x08, 0x65, 0x79 }
+#define TEST_PREFIX         { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00 }
+#define TEST_PREFIX_OTHER   { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01 }
+#define TEST_PREFIX_LEN     (64U)
+#define TEST_PORT           (5683U)
+#define TEST_PAYLOAD_LEN    (8U)
+
+/* SAM values of IPHC byte 2 */
+#define SAM_FULL            (0x00)
+#define SAM_64              (0x10)
+#define SAM_L2              (0x30)
+
+static const uint8_t _src_l2[] = TEST_SRC_L2;
+static const uint8_t _dst_l2[] = TEST_DST_L2;
+static const uint8_t _payload[TEST_PAYLOAD_LEN] = { 0 };
+
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _mock_dev;
+static gnrc_netif_t _netif;
+static uint8_t _mock_l2[sizeof(_src_l2)];
+
+static uint8_t _frame[IEEE802154_FRAME_LEN_MAX];
+static size_t _frame_len;
+
+static ipv6_addr_t _ll_src, _ll_dst;
+static ipv6_addr_t _global_src, _global_dst;
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    _frame_len = 0;
+    for (const iolist_t *ptr = iolist; ptr != NULL; ptr = ptr->iol_next) {
+        if ((_frame_len + ptr->iol_len) <= sizeof(_frame)) {
+            memcpy(&_frame[_frame_len], ptr->iol_base, ptr->iol_len);
+        }
+        _frame_len += ptr->iol_len;
+    }
+    return _frame_len;
+}
+
+/* compresses a UDP packet from @p src to @p dst and stores IPHC byte 2 of
+ * the frame sent in @p iphc2 */
+static void _send_udp(const ipv6_addr_t *src, const ipv6_addr_t *dst,
+                      uint8_t *iphc2)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+    size_t mhr_len;
+
+    _frame_len = 0;
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                          GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_udp_hdr_build(pkt, TEST_PORT, TEST_PORT);
+    TEST_ASSERT_NOT_NULL(hdr);
+    pkt = hdr;
+    hdr = gnrc_ipv6_hdr_build(pkt, src, dst);
+    TEST_ASSERT_NOT_NULL(hdr);
+    ((ipv6_hdr_t *)hdr->data)->nh = PROTNUM_UDP;
+    ((ipv6_hdr_t *)hdr->data)->hl = 64;
+    pkt = hdr;
+    hdr = gnrc_netif_hdr_build(NULL, 0, _dst_l2, sizeof(_dst_l2));
+    TEST_ASSERT_NOT_NULL(hdr);
+    gnrc_netif_hdr_set_netif(hdr->data, &_netif);
+    hdr->next = pkt;
+    gnrc_sixlowpan_iphc_send(hdr, NULL, 0);
+
+    /* the interface thread has a higher priority, so the frame is sent */
+    mhr_len = ieee802154_get_frame_hdr_len(_frame);
+    TEST_ASSERT(mhr_len > 0);
+    TEST_ASSERT((mhr_len + SIXLOWPAN_IPHC_HDR_LEN) < _frame_len);
+    TEST_ASSERT(sixlowpan_iphc_is(&_frame[mhr_len]));
+    *iphc2 = _frame[mhr_len + 1];
+}
+
+static void _set_l2addr(const uint8_t *addr)
+{
+    expect(gnrc_netapi_set(_netif.pid, NETOPT_ADDRESS_LONG, 0, addr,
+                           sizeof(_mock_l2)) == sizeof(_mock_l2));
+}
+
+static void _set_up(void)
+{
+    static const uint8_t prefix[] = TEST_PREFIX;
+    ipv6_addr_t ctx_prefix = IPV6_ADDR_UNSPECIFIED;
+
+    _set_l2addr(_src_l2);
+    memcpy(&ctx_prefix, prefix, sizeof(prefix));
+    expect(gnrc_sixlowpan_ctx_update(0, &ctx_prefix, TEST_PREFIX_LEN,
+                                     UINT16_MAX, true) != NULL);
+}
+
+static void test_gnrc_sixlowpan_iphc_cache__ctx_update(void)
+{
+    static const uint8_t other[] = TEST_PREFIX_OTHER;
+    ipv6_addr_t ctx_prefix = IPV6_ADDR_UNSPECIFIED;
+    uint8_t iphc2;
+
+    /* source prefix from context 0, IID from the link-layer address */
+    _send_udp(&_global_src, &_global_dst, &iphc2);
+    TEST_ASSERT(iphc2 & SIXLOWPAN_IPHC2_SAC);
+    TEST_ASSERT_EQUAL_INT(SAM_L2, iphc2 & SIXLOWPAN_IPHC2_SAM);
+    /* served from the cache */
+    _send_udp(&_global_src, &_global_dst, &iphc2);
+    TEST_ASSERT(iphc2 & SIXLOWPAN_IPHC2_SAC);
+
+    /* context 0 does not match the source any more */
+    memcpy(&ctx_prefix, other, sizeof(other));
+    expect(gnrc_sixlowpan_ctx_update(0, &ctx_prefix, TEST_PREFIX_LEN,
+                                     UINT16_MAX, true) != NULL);
+    _send_udp(&_global_src, &_global_dst, &iphc2);
+    TEST_ASSERT(!(iphc2 & SIXLOWPAN_IPHC2_SAC));
+    TEST_ASSERT_EQUAL_INT(SAM_FULL, iphc2 & SIXLOWPAN_IPHC2_SAM);
+}
+
+static void test_gnrc_sixlowpan_iphc_cache__ctx_no_comp(void)
+{
+    static const uint8_t prefix[] = TEST_PREFIX;
+    ipv6_addr_t ctx_prefix = IPV6_ADDR_UNSPECIFIED;
+    uint8_t iphc2;
+
+    _send_udp(&_global_src, &_global_dst, &iphc2);
+    TEST_ASSERT(iphc2 & SIXLOWPAN_IPHC2_SAC);
+
+    /* context 0 may only be used for decompression now */
+    memcpy(&ctx_prefix, prefix, sizeof(prefix));
+    expect(gnrc_sixlowpan_ctx_update(0, &ctx_prefix, TEST_PREFIX_LEN,
+                                     UINT16_MAX, false) != NULL);
+    _send_udp(&_global_src, &_global_dst, &iphc2);
+    TEST_ASSERT(!(iphc2 & SIXLOWPAN_IPHC2_SAC));
+}
+
+static void test_gnrc_sixlowpan_iphc_cache__netif_addr(void)
+{
+    static const uint8_t new_l2[] = TEST_SRC_L2_NEW;
+    uint8_t iphc2;
+
+    /* IID derived from the link-layer address of the interface */
+    _send_udp(&_ll_src, &_ll_dst, &iphc2);
+    TEST_ASSERT(!(iphc2 & SIXLOWPAN_IPHC2_SAC));
+    TEST_ASSERT_EQUAL_INT(SAM_L2, iphc2 & SIXLOWPAN_IPHC2_SAM);
+    _send_udp(&_ll_src, &_ll_dst, &iphc2);
+    TEST_ASSERT_EQUAL_INT(SAM_L2, iphc2 & SIXLOWPAN_IPHC2_SAM);
+
+    /* the IID of the source cannot be derived from the new address */
+    _set_l2addr(new_l2);
+    _send_udp(&_ll_src, &_ll_dst, &iphc2);
+    TEST_ASSERT(!(iphc2 & SIXLOWPAN_IPHC2_SAC));
+    TEST_ASSERT_EQUAL_INT(SAM_64, iphc2 & SIXLOWPAN_IPHC2_SAM);
+}
+
+static Test *tests_gnrc_sixlowpan_iphc_cache(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_sixlowpan_iphc_cache__ctx_update),
+        new_TestFixture(test_gnrc_sixlowpan_iphc_cache__ctx_no_comp),
+        new_TestFixture(test_gnrc_sixlowpan_iphc_cache__netif_addr),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, _set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(gnrc_nettype_t));
+    (void)netdev;
+
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_netdev_max_pdu_size(netdev_t *netdev, void *value,
+                                    size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = IEEE802154_FRAME_LEN_MAX;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_mock_l2);
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len >= sizeof(_mock_l2));
+    memcpy(value, _mock_l2, sizeof(_mock_l2));
+    return sizeof(_mock_l2);
+}
+
+static int _set_netdev_addr_long(netdev_t *netdev, const void *value,
+                                 size_t value_len)
+{
+    (void)netdev;
+    expect(value_len == sizeof(_mock_l2));
+    memcpy(_mock_l2, value, sizeof(_mock_l2));
+    return sizeof(_mock_l2);
+}
+
+static void _init_mock_netif(void)
+{
+    memcpy(_mock_l2, _src_l2, sizeof(_mock_l2));
+    netdev_test_setup(&_mock_dev, NULL);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_DEVICE_TYPE,
+                           _get_netdev_device_type);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_PROTO,
+                           _get_netdev_proto);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_MAX_PDU_SIZE,
+                           _get_netdev_max_pdu_size);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_SRC_LEN,
+                           _get_netdev_src_len);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_ADDRESS_LONG,
+                           _get_netdev_addr_long);
+    netdev_test_set_set_cb(&_mock_dev, NETOPT_ADDRESS_LONG,
+                           _set_netdev_addr_long);
+    netdev_test_set_send_cb(&_mock_dev, _send);
+    gnrc_netif_ieee802154_create(&_netif, _mock_netif_stack,
+                                 THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+                                 "mock_netif", (netdev_t *)&_mock_dev);
+    thread_yield_higher();
+}
+
+static void _init_addrs(void)
+{
+    static const uint8_t prefix[] = TEST_PREFIX;
+    eui64_t iid;
+
+    expect(l2util_ipv6_iid_from_addr(NETDEV_TYPE_IEEE802154, _src_l2,
+                                     sizeof(_src_l2), &iid) > 0);
+    ipv6_addr_set_link_local_prefix(&_ll_src);
+    ipv6_addr_set_aiid(&_ll_src, iid.uint8);
+    memcpy(&_global_src, prefix, sizeof(prefix));
+    ipv6_addr_set_aiid(&_global_src, iid.uint8);
+
+    expect(l2util_ipv6_iid_from_addr(NETDEV_TYPE_IEEE802154, _dst_l2,
+                                     sizeof(_dst_l2), &iid) > 0);
+    ipv6_addr_set_link_local_prefix(&_ll_dst);
+    ipv6_addr_set_aiid(&_ll_dst, iid.uint8);
+    memcpy(&_global_dst, prefix, sizeof(prefix));
+    ipv6_addr_set_aiid(&_global_dst, iid.uint8);
+}
+
+int main(void)
+{
+    _init_mock_netif();
+    _init_addrs();
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_sixlowpan_iphc_cache());
+    TESTS_END();
+    return 0;
+}
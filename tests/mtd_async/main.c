@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       mtd_async module test
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_async.h"
+#include "xtimer.h"
+
+#define SECTOR_COUNT    (4U)
+#define PAGE_PER_SECTOR (4U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+#define ERASE_US        (20U * US_PER_MS)
+
+/* Test mock object implementing a simple RAM-based mtd */
+typedef struct {
+    mtd_dev_t mtd;
+    uint8_t mem[SECTOR_COUNT * SECTOR_SIZE];
+    uint32_t busy_until;
+    unsigned erase_starts;
+} mock_dev_t;
+
+static int _init(mtd_dev_t *mtd)
+{
+    mock_dev_t *dev = container_of(mtd, mock_dev_t, mtd);
+
+    memset(dev->mem, 0xff, sizeof(dev->mem));
+    dev->busy_until = xtimer_now_usec();
+    return 0;
+}
+
+static int _read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t count)
+{
+    mock_dev_t *dev = container_of(mtd, mock_dev_t, mtd);
+
+    if (addr + count > sizeof(dev->mem)) {
+        return -EOVERFLOW;
+    }
+    memcpy(dest, &dev->mem[addr], count);
+    return 0;
+}
+
+static int _write(mtd_dev_t *mtd, const void *src, uint32_t addr,
+                  uint32_t count)
+{
+    mock_dev_t *dev = container_of(mtd, mock_dev_t, mtd);
+
+    if ((addr + count > sizeof(dev->mem)) ||
+        (((addr % PAGE_SIZE) + count) > PAGE_SIZE)) {
+        return -EOVERFLOW;
+    }
+    memcpy(&dev->mem[addr], src, count);
+    return 0;
+}
+
+static int _erase_sector(mtd_dev_t *mtd, uint32_t sector, uint32_t count)
+{
+    mock_dev_t *dev = container_of(mtd, mock_dev_t, mtd);
+
+    if (sector + count > SECTOR_COUNT) {
+        return -EOVERFLOW;
+    }
+    memset(&dev->mem[sector * SECTOR_SIZE], 0xff, count * SECTOR_SIZE);
+    return 0;
+}
+
+static int _erase_sector_start(mtd_dev_t *mtd, uint32_t sector,
+                               uint32_t count, uint32_t *wait_us)
+{
+    mock_dev_t *dev = container_of(mtd, mock_dev_t, mtd);
+
+    (void)count;
+    /* one sector per command, like a SPI NOR flash */
+    _erase_sector(mtd, sector, 1);
+    dev->busy_until = xtimer_now_usec() + ERASE_US;
+    dev->erase_starts++;
+    *wait_us = ERASE_US;
+    return 1;
+}
+
+static int _busy(mtd_dev_t *mtd)
+{
+    mock_dev_t *dev = container_of(mtd, mock_dev_t, mtd);
+
+    return (int32_t)(dev->busy_until - xtimer_now_usec()) > 0;
+}
+
+static const mtd_desc_t _split_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase_sector = _erase_sector,
+    .erase_sector_start = _erase_sector_start,
+    .busy = _busy,
+};
+
+static const mtd_desc_t _blocking_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase_sector = _erase_sector,
+};
+
+#define MOCK_DEV_INIT(_driver) { \
+    .mtd = { \
+        .driver = _driver, \
+        .sector_count = SECTOR_COUNT, \
+        .pages_per_sector = PAGE_PER_SECTOR, \
+        .page_size = PAGE_SIZE, \
+    }, \
+}
+
+static mock_dev_t _split = MOCK_DEV_INIT(&_split_driver);
+static mock_dev_t _blocking = MOCK_DEV_INIT(&_blocking_driver);
+static mtd_async_dev_t _async_split;
+static mtd_async_dev_t _async_blocking;
+
+/* completion order of the requests */
+static mtd_async_req_t *_done[8];
+static volatile unsigned _done_num;
+
+static void _cb(mtd_async_req_t *req)
+{
+    _done[_done_num++] = req;
+}
+
+static void _wait_for(unsigned num)
+{
+    while (_done_num < num) {
+        xtimer_usleep(US_PER_MS);
+    }
+}
+
+static void set_up(void)
+{
+    mtd_init(&_split.mtd);
+    mtd_init(&_blocking.mtd);
+    _split.erase_starts = 0;
+    _done_num = 0;
+}
+
+static void test_mtd_async_write_read(void)
+{
+    const char buf[] = "ABCDEFGH";
+    char buf_read[sizeof(buf)];
+    mtd_async_req_t write, read;
+
+    mtd_async_write_page_raw(&_async_blocking, &write, buf, 1, 3, sizeof(buf),
+                             _cb, NULL);
+    mtd_async_read_page(&_async_blocking, &read, buf_read, 1, 3,
+                        sizeof(buf_read), _cb, NULL);
+    _wait_for(2);
+
+    TEST_ASSERT(_done[0] == &write);
+    TEST_ASSERT(_done[1] == &read);
+    TEST_ASSERT_EQUAL_INT(0, write.res);
+    TEST_ASSERT_EQUAL_INT(0, read.res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, buf_read, sizeof(buf)));
+}
+
+static void test_mtd_async_error(void)
+{
+    mtd_async_req_t erase;
+
+    mtd_async_erase_sector(&_async_split, &erase, SECTOR_COUNT - 1, 2,
+                           _cb, NULL);
+    _wait_for(1);
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, erase.res);
+    TEST_ASSERT_EQUAL_INT(0, _split.erase_starts);
+}
+
+static void test_mtd_async_erase_overlap(void)
+{
+    const uint8_t buf[] = { 0x42 };
+    uint8_t buf_read[sizeof(buf)];
+    mtd_async_req_t erase, write, read;
+
+    memset(_split.mem, 0, sizeof(_split.mem));
+    uint32_t start = xtimer_now_usec();
+
+    mtd_async_erase_sector(&_async_split, &erase, 0, 2, _cb, NULL);
+    mtd_async_write_page_raw(&_async_blocking, &write, buf, 0, 0,
+                             sizeof(buf), _cb, NULL);
+    mtd_async_read_page(&_async_split, &read, buf_read, PAGE_PER_SECTOR, 0,
+                        sizeof(buf_read), _cb, NULL);
+    /* caller is not blocked by the erase */
+    TEST_ASSERT_EQUAL_INT(-EINPROGRESS, erase.res);
+    TEST_ASSERT((xtimer_now_usec() - start) < ERASE_US);
+    _wait_for(3);
+
+    /* the other device was served while the first one was erasing */
+    TEST_ASSERT(_done[0] == &write);
+    TEST_ASSERT(_done[1] == &erase);
+    TEST_ASSERT(_done[2] == &read);
+    TEST_ASSERT_EQUAL_INT(2, _split.erase_starts);
+    TEST_ASSERT((xtimer_now_usec() - start) >= 2 * ERASE_US);
+    TEST_ASSERT_EQUAL_INT(0, erase.res);
+    TEST_ASSERT_EQUAL_INT(0xff, buf_read[0]);
+    TEST_ASSERT_EQUAL_INT(0x00, _split.mem[2 * SECTOR_SIZE]);
+}
+
+static void test_mtd_async_erase_blocking(void)
+{
+    mtd_async_req_t erase;
+
+    memset(_blocking.mem, 0, sizeof(_blocking.mem));
+    mtd_async_erase_sector(&_async_blocking, &erase, 1, 2, _cb, NULL);
+    _wait_for(1);
+
+    TEST_ASSERT_EQUAL_INT(0, erase.res);
+    TEST_ASSERT_EQUAL_INT(0x00, _blocking.mem[SECTOR_SIZE - 1]);
+    TEST_ASSERT_EQUAL_INT(0xff, _blocking.mem[SECTOR_SIZE]);
+    TEST_ASSERT_EQUAL_INT(0xff, _blocking.mem[3 * SECTOR_SIZE - 1]);
+    TEST_ASSERT_EQUAL_INT(0x00, _blocking.mem[3 * SECTOR_SIZE]);
+}
+
+Test *tests_mtd_async_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_async_write_read),
+        new_TestFixture(test_mtd_async_error),
+        new_TestFixture(test_mtd_async_erase_overlap),
+        new_TestFixture(test_mtd_async_erase_blocking),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_async_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtd_async_tests;
+}
+
+int main(void)
+{
+    mtd_async_init(&_async_split, &_split.mtd);
+    mtd_async_init(&_async_blocking, &_blocking.mtd);
+
+    TESTS_START();
+    TESTS_RUN(tests_mtd_async_tests());
+    TESTS_END();
+
+    return 0;
+}
+/** @} */
@@ -101,6 +101,42 @@ static const uint8_t TC8_CHACHA20_BLOCK1[64] = {
     0x4f, 0x5e, 0x42, 0x68, 0xb9, 0x0a, 0x88, 0x04,
 };
 
+/*
+ *  ChaCha20 encryption test vector
+ *
+ *  https://tools.ietf.org/html/rfc8439#section-2.4.2
+ *
+ *  The nonce starts with four zero bytes, so the 96-bit nonce and 32-bit
+ *  counter of RFC 8439 match the 64-bit nonce and counter used here.
+ */
+
+static const uint8_t RFC8439_NONCE[8] = {
+    0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const char RFC8439_PLAINTEXT[] =
+    "Ladies and Gentlemen of the class of '99: If I could offer you only "
+    "one tip for the future, sunscreen would be it.";
+
+static const uint8_t RFC8439_CIPHERTEXT[] = {
+    0x6e, 0x2e, 0x35, 0x9a, 0x25, 0x68, 0xf9, 0x80,
+    0x41, 0xba, 0x07, 0x28, 0xdd, 0x0d, 0x69, 0x81,
+    0xe9, 0x7e, 0x7a, 0xec, 0x1d, 0x43, 0x60, 0xc2,
+    0x0a, 0x27, 0xaf, 0xcc, 0xfd, 0x9f, 0xae, 0x0b,
+    0xf9, 0x1b, 0x65, 0xc5, 0x52, 0x47, 0x33, 0xab,
+    0x8f, 0x59, 0x3d, 0xab, 0xcd, 0x62, 0xb3, 0x57,
+    0x16, 0x39, 0xd6, 0x24, 0xe6, 0x51, 0x52, 0xab,
+    0x8f, 0x53, 0x0c, 0x35, 0x9f, 0x08, 0x61, 0xd8,
+    0x07, 0xca, 0x0d, 0xbf, 0x50, 0x0d, 0x6a, 0x61,
+    0x56, 0xa3, 0x8e, 0x08, 0x8a, 0x22, 0xb6, 0x5e,
+    0x52, 0xbc, 0x51, 0x4d, 0x16, 0xcc, 0xf8, 0x06,
+    0x81, 0x8c, 0xe9, 0x1a, 0xb7, 0x79, 0x37, 0x36,
+    0x5a, 0xf9, 0x0b, 0xbf, 0x74, 0xa3, 0x5b, 0xe6,
+    0xb4, 0x0b, 0x8e, 0xed, 0xf2, 0x78, 0x5e, 0x42,
+    0x87, 0x4d,
+};
+
+
 static void _test_crypto_chacha(unsigned rounds, unsigned keylen,
                                 const uint8_t key[32], const uint8_t iv[8],
                                 const uint32_t after_init[16],
@@ -138,12 +174,58 @@ static void test_crypto_chacha20_tc8(void)
                         TC8_CHACHA20_BLOCK0, TC8_CHACHA20_BLOCK1);
 }
 
+static void test_crypto_chacha20_rfc8439(void)
+{
+    chacha_ctx ctx;
+    uint8_t key[32];
+    uint8_t keystream[2 * 64];
+    uint8_t out[sizeof(RFC8439_CIPHERTEXT)];
+
+    for (unsigned i = 0; i < sizeof(key); i++) {
+        key[i] = i;
+    }
+    TEST_ASSERT_EQUAL_INT(0, chacha_init(&ctx, 20, key, sizeof(key),
+                                         RFC8439_NONCE));
+    ctx.state[12] = 1;
+
+    chacha_keystream_blocks(&ctx, keystream, 2);
+    for (unsigned i = 0; i < sizeof(out); i++) {
+        out[i] = RFC8439_PLAINTEXT[i] ^ keystream[i];
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, RFC8439_CIPHERTEXT, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(3, ctx.state[12]);
+}
+
+static void test_crypto_chacha_blocks(void)
+{
+    /* more blocks than processed in parallel, crossing the wrap of the lower
+     * counter word */
+    static uint8_t blocks[9 * 64];
+    chacha_ctx ctx, ref;
+    uint8_t block[64];
+
+    TEST_ASSERT_EQUAL_INT(0, chacha_init(&ctx, 20, TC8_KEY, 16, TC8_IV));
+    ctx.state[12] = 0xfffffffd;
+    ref = ctx;
+
+    chacha_keystream_blocks(&ctx, blocks, 9);
+    for (unsigned i = 0; i < 9; i++) {
+        chacha_keystream_bytes(&ref, block);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(block, &blocks[64 * i], 64));
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ctx.state, ref.state, sizeof(ctx.state)));
+    TEST_ASSERT_EQUAL_INT(6, ctx.state[12]);
+    TEST_ASSERT_EQUAL_INT(1, ctx.state[13]);
+}
+
 Test *tests_crypto_chacha_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_chacha8_tc8),
         new_TestFixture(test_crypto_chacha12_tc8),
         new_TestFixture(test_crypto_chacha20_tc8),
+        new_TestFixture(test_crypto_chacha20_rfc8439),
+        new_TestFixture(test_crypto_chacha_blocks),
     };
     EMB_UNIT_TESTCALLER(crypto_chacha_tests, NULL, NULL, fixtures);
     return (Test *)&crypto_chacha_tests;
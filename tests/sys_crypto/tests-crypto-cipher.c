@@ -60,6 +60,78 @@ static void test_crypto_cipher_aes_decrypt(void)
     TEST_ASSERT_MESSAGE(1 == cmp, "wrong plaintext");
 }
 
+static void _check_blocks(const cipher_interface_t *interface)
+{
+    cipher_t cipher;
+    int err;
+    uint8_t input[3 * 16], output[3 * 16], expected[16];
+
+    err = cipher_init(&cipher, interface, TEST_KEY, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    for (unsigned i = 0; i < sizeof(input); i++) {
+        input[i] = i;
+    }
+
+    err = cipher_encrypt_blocks(&cipher, input, output, 3);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    for (unsigned i = 0; i < 3; i++) {
+        cipher_encrypt(&cipher, &input[i * 16], expected);
+        TEST_ASSERT_MESSAGE(1 == compare(expected, &output[i * 16], 16),
+                            "wrong ciphertext");
+    }
+
+    /* in place */
+    err = cipher_decrypt_blocks(&cipher, output, output, 3);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    TEST_ASSERT_MESSAGE(1 == compare(input, output, sizeof(input)),
+                        "wrong plaintext");
+}
+
+static void test_crypto_cipher_aes_blocks(void)
+{
+    _check_blocks(CIPHER_AES);
+}
+
+static void test_crypto_cipher_aes_blocks_fallback(void)
+{
+    /* a cipher without multi-block functions */
+    cipher_interface_t interface = *CIPHER_AES;
+
+    interface.encrypt_blocks = NULL;
+    interface.decrypt_blocks = NULL;
+    _check_blocks(&interface);
+}
+
+static void test_crypto_cipher_ctr_keystream(void)
+{
+    cipher_t cipher;
+    int err;
+    uint8_t counter[16] = { 0 }, stream[2 * 16], expected[16];
+
+    counter[15] = 0xff;
+    err = cipher_init(&cipher, CIPHER_AES, TEST_KEY, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    err = cipher_ctr_keystream(&cipher, counter, 8, stream, 2);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    /* the counter wrapped into its second byte */
+    TEST_ASSERT_EQUAL_INT(0x01, counter[15]);
+    TEST_ASSERT_EQUAL_INT(0x01, counter[14]);
+
+    counter[14] = 0;
+    counter[15] = 0xff;
+    cipher_encrypt(&cipher, counter, expected);
+    TEST_ASSERT_MESSAGE(1 == compare(expected, stream, 16),
+                        "wrong first block");
+    counter[14] = 1;
+    counter[15] = 0;
+    cipher_encrypt(&cipher, counter, expected);
+    TEST_ASSERT_MESSAGE(1 == compare(expected, &stream[16], 16),
+                        "wrong second block");
+}
+
 static void test_crypto_cipher_init_aes_key_length(void)
 {
     cipher_t cipher;
@@ -80,6 +152,9 @@ Test *tests_crypto_cipher_tests(void)
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_cipher_aes_encrypt),
         new_TestFixture(test_crypto_cipher_aes_decrypt),
+        new_TestFixture(test_crypto_cipher_aes_blocks),
+        new_TestFixture(test_crypto_cipher_aes_blocks_fallback),
+        new_TestFixture(test_crypto_cipher_ctr_keystream),
         new_TestFixture(test_crypto_cipher_init_aes_key_length),
     };
 
@@ -28,10 +28,35 @@ void test_crypto_wipe(void)
     TEST_ASSERT_EQUAL_INT(VALUE, secret[19]);
 }
 
+void test_crypto_xor(void)
+{
+    uint8_t a[11], b[12], out[12];
+
+    for (unsigned i = 0; i < sizeof(b); i++) {
+        b[i] = 0x11 * i;
+    }
+    memset(a, 0xf0, sizeof(a));
+    out[10] = 0xAA;
+
+    /* misaligned operands */
+    crypto_xor(out, a, b + 1, 10);
+    for (size_t i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_INT(0xf0 ^ (uint8_t)(0x11 * (i + 1)), out[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0xAA, out[10]);
+
+    /* in place */
+    crypto_xor(a, a, a, sizeof(a));
+    for (size_t i = 0; i < sizeof(a); i++) {
+        TEST_ASSERT_EQUAL_INT(0, a[i]);
+    }
+}
+
 Test *tests_crypto_helper_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_wipe),
+        new_TestFixture(test_crypto_xor),
     };
     EMB_UNIT_TESTCALLER(crypto_helper_tests, NULL, NULL, fixtures);
     return (Test *)&crypto_helper_tests;
@@ -14,6 +14,7 @@
 
 #include "embUnit.h"
 #include "crypto/ciphers.h"
+#include "crypto/helper.h"
 #include "crypto/modes/ctr.h"
 #include "tests-crypto.h"
 
@@ -248,11 +249,41 @@ static void test_crypto_modes_ctr_decrypt(void)
 }
 
 
+/* more blocks than generated at once, ending in a partial block */
+static void test_crypto_modes_ctr_long(void)
+{
+    cipher_t cipher;
+    int len;
+    uint8_t ctr[16], ref_ctr[16], stream[16];
+    uint8_t input[(CONFIG_CIPHER_CTR_STREAM_BLOCKS + 1) * 16 + 5];
+    uint8_t output[sizeof(input)];
+
+    for (unsigned i = 0; i < sizeof(input); i++) {
+        input[i] = i;
+    }
+    memcpy(ctr, TEST_COUNTER, sizeof(ctr));
+    memcpy(ref_ctr, TEST_COUNTER, sizeof(ref_ctr));
+
+    cipher_init(&cipher, CIPHER_AES, TEST_1_KEY, TEST_1_KEY_LEN);
+    len = cipher_encrypt_ctr(&cipher, ctr, 0, input, sizeof(input), output);
+    TEST_ASSERT_EQUAL_INT(sizeof(input), len);
+
+    for (unsigned i = 0; i < sizeof(input); i++) {
+        if (i % 16 == 0) {
+            cipher_encrypt(&cipher, ref_ctr, stream);
+            crypto_block_inc_ctr(ref_ctr, 16);
+        }
+        TEST_ASSERT_EQUAL_INT(input[i] ^ stream[i % 16], output[i]);
+    }
+    TEST_ASSERT_MESSAGE(1 == compare(ref_ctr, ctr, 16), "wrong counter");
+}
+
 Test *tests_crypto_modes_ctr_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_modes_ctr_encrypt),
-        new_TestFixture(test_crypto_modes_ctr_decrypt)
+        new_TestFixture(test_crypto_modes_ctr_decrypt),
+        new_TestFixture(test_crypto_modes_ctr_long),
     };
 
     EMB_UNIT_TESTCALLER(crypto_modes_ctr_tests, NULL, NULL, fixtures);
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/gcm.h"
+#include "tests-crypto.h"
+
+/* Test vectors from the GCM specification by McGrew and Viega, Appendix B,
+ * test cases 1 to 6 and 16. Test cases 1 and 2 use an all-zero key and
+ * nonce, the others a prefix of TEST_KEY. The expected output is the
+ * ciphertext followed by the 16 byte tag. */
+static const uint8_t TEST_ZERO[16] = { 0 };
+
+static const uint8_t TEST_KEY[] = {
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+    0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+    0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+};
+static const uint8_t TEST_PLAIN[] = {
+    0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5,
+    0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+    0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda,
+    0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+    0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53,
+    0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+    0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57,
+    0xba, 0x63, 0x7b, 0x39, 0x1a, 0xaf, 0xd2, 0x55,
+};
+static const uint8_t TEST_ADATA[] = {
+    0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+    0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+    0xab, 0xad, 0xda, 0xd2,
+};
+static const uint8_t TEST_NONCE_8[] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+};
+static const uint8_t TEST_NONCE_12[] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+    0xde, 0xca, 0xf8, 0x88,
+};
+static const uint8_t TEST_NONCE_60[] = {
+    0x93, 0x13, 0x22, 0x5d, 0xf8, 0x84, 0x06, 0xe5,
+    0x55, 0x90, 0x9c, 0x5a, 0xff, 0x52, 0x69, 0xaa,
+    0x6a, 0x7a, 0x95, 0x38, 0x53, 0x4f, 0x7d, 0xa1,
+    0xe4, 0xc3, 0x03, 0xd2, 0xa3, 0x18, 0xa7, 0x28,
+    0xc3, 0xc0, 0xc9, 0x51, 0x56, 0x80, 0x95, 0x39,
+    0xfc, 0xf0, 0xe2, 0x42, 0x9a, 0x6b, 0x52, 0x54,
+    0x16, 0xae, 0xdb, 0xf5, 0xa0, 0xde, 0x6a, 0x57,
+    0xa6, 0x37, 0xb3, 0x9b,
+};
+static const uint8_t TEST_1_EXPECTED[] = {
+    0x58, 0xe2, 0xfc, 0xce, 0xfa, 0x7e, 0x30, 0x61,
+    0x36, 0x7f, 0x1d, 0x57, 0xa4, 0xe7, 0x45, 0x5a,
+};
+static const uint8_t TEST_2_EXPECTED[] = {
+    0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92,
+    0xf3, 0x28, 0xc2, 0xb9, 0x71, 0xb2, 0xfe, 0x78,
+    0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd,
+    0xf5, 0x3a, 0x67, 0xb2, 0x12, 0x57, 0xbd, 0xdf,
+};
+static const uint8_t TEST_3_EXPECTED[] = {
+    0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24,
+    0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+    0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0,
+    0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+    0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c,
+    0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+    0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97,
+    0x3d, 0x58, 0xe0, 0x91, 0x47, 0x3f, 0x59, 0x85,
+    0x4d, 0x5c, 0x2a, 0xf3, 0x27, 0xcd, 0x64, 0xa6,
+    0x2c, 0xf3, 0x5a, 0xbd, 0x2b, 0xa6, 0xfa, 0xb4,
+};
+static const uint8_t TEST_4_EXPECTED[] = {
+    0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24,
+    0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+    0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0,
+    0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+    0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c,
+    0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+    0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97,
+    0x3d, 0x58, 0xe0, 0x91, 0x5b, 0xc9, 0x4f, 0xbc,
+    0x32, 0x21, 0xa5, 0xdb, 0x94, 0xfa, 0xe9, 0x5a,
+    0xe7, 0x12, 0x1a, 0x47,
+};
+static const uint8_t TEST_5_EXPECTED[] = {
+    0x61, 0x35, 0x3b, 0x4c, 0x28, 0x06, 0x93, 0x4a,
+    0x77, 0x7f, 0xf5, 0x1f, 0xa2, 0x2a, 0x47, 0x55,
+    0x69, 0x9b, 0x2a, 0x71, 0x4f, 0xcd, 0xc6, 0xf8,
+    0x37, 0x66, 0xe5, 0xf9, 0x7b, 0x6c, 0x74, 0x23,
+    0x73, 0x80, 0x69, 0x00, 0xe4, 0x9f, 0x24, 0xb2,
+    0x2b, 0x09, 0x75, 0x44, 0xd4, 0x89, 0x6b, 0x42,
+    0x49, 0x89, 0xb5, 0xe1, 0xeb, 0xac, 0x0f, 0x07,
+    0xc2, 0x3f, 0x45, 0x98, 0x36, 0x12, 0xd2, 0xe7,
+    0x9e, 0x3b, 0x07, 0x85, 0x56, 0x1b, 0xe1, 0x4a,
+    0xac, 0xa2, 0xfc, 0xcb,
+};
+static const uint8_t TEST_6_EXPECTED[] = {
+    0x8c, 0xe2, 0x49, 0x98, 0x62, 0x56, 0x15, 0xb6,
+    0x03, 0xa0, 0x33, 0xac, 0xa1, 0x3f, 0xb8, 0x94,
+    0xbe, 0x91, 0x12, 0xa5, 0xc3, 0xa2, 0x11, 0xa8,
+    0xba, 0x26, 0x2a, 0x3c, 0xca, 0x7e, 0x2c, 0xa7,
+    0x01, 0xe4, 0xa9, 0xa4, 0xfb, 0xa4, 0x3c, 0x90,
+    0xcc, 0xdc, 0xb2, 0x81, 0xd4, 0x8c, 0x7c, 0x6f,
+    0xd6, 0x28, 0x75, 0xd2, 0xac, 0xa4, 0x17, 0x03,
+    0x4c, 0x34, 0xae, 0xe5, 0x61, 0x9c, 0xc5, 0xae,
+    0xff, 0xfe, 0x0b, 0xfa, 0x46, 0x2a, 0xf4, 0x3c,
+    0x16, 0x99, 0xd0, 0x50,
+};
+static const uint8_t TEST_16_EXPECTED[] = {
+    0x52, 0x2d, 0xc1, 0xf0, 0x99, 0x56, 0x7d, 0x07,
+    0xf4, 0x7f, 0x37, 0xa3, 0x2a, 0x84, 0x42, 0x7d,
+    0x64, 0x3a, 0x8c, 0xdc, 0xbf, 0xe5, 0xc0, 0xc9,
+    0x75, 0x98, 0xa2, 0xbd, 0x25, 0x55, 0xd1, 0xaa,
+    0x8c, 0xb0, 0x8e, 0x48, 0x59, 0x0d, 0xbb, 0x3d,
+    0xa7, 0xb0, 0x8b, 0x10, 0x56, 0x82, 0x88, 0x38,
+    0xc5, 0xf6, 0x1e, 0x63, 0x93, 0xba, 0x7a, 0x0a,
+    0xbc, 0xc9, 0xf6, 0x62, 0x76, 0xfc, 0x6e, 0xce,
+    0x0f, 0x4e, 0x17, 0x68, 0xcd, 0xdf, 0x88, 0x53,
+    0xbb, 0x2d, 0x55, 0x1b,
+};
+
+static const struct {
+    const char *name;
+    const uint8_t *key;
+    uint8_t key_len;
+    const uint8_t *nonce;
+    uint8_t nonce_len;
+    const uint8_t *adata;
+    size_t adata_len;
+    size_t plain_len;
+    const uint8_t *plain;
+    const uint8_t *expected;
+} _tests[] = {
+    { "1", TEST_ZERO, 16, TEST_ZERO, 12, NULL, 0,
+      0, NULL, TEST_1_EXPECTED },
+    { "2", TEST_ZERO, 16, TEST_ZERO, 12, NULL, 0,
+      16, TEST_ZERO, TEST_2_EXPECTED },
+    { "3", TEST_KEY, 16, TEST_NONCE_12, 12, NULL, 0,
+      64, TEST_PLAIN, TEST_3_EXPECTED },
+    { "4", TEST_KEY, 16, TEST_NONCE_12, 12, TEST_ADATA, sizeof(TEST_ADATA),
+      60, TEST_PLAIN, TEST_4_EXPECTED },
+    { "5", TEST_KEY, 16, TEST_NONCE_8, 8, TEST_ADATA, sizeof(TEST_ADATA),
+      60, TEST_PLAIN, TEST_5_EXPECTED },
+    { "6", TEST_KEY, 16, TEST_NONCE_60, 60, TEST_ADATA, sizeof(TEST_ADATA),
+      60, TEST_PLAIN, TEST_6_EXPECTED },
+    { "16", TEST_KEY, 32, TEST_NONCE_12, 12, TEST_ADATA, sizeof(TEST_ADATA),
+      60, TEST_PLAIN, TEST_16_EXPECTED },
+};
+
+static uint8_t data[64 + GCM_TAG_MAX_LEN];
+
+static void test_crypto_modes_gcm_encrypt(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_tests); i++) {
+        cipher_t cipher;
+        int32_t len;
+
+        TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES,
+                                             _tests[i].key, _tests[i].key_len));
+
+        len = cipher_encrypt_gcm(&cipher, _tests[i].adata, _tests[i].adata_len,
+                                 GCM_TAG_MAX_LEN,
+                                 _tests[i].nonce, _tests[i].nonce_len,
+                                 _tests[i].plain, _tests[i].plain_len, data);
+        TEST_ASSERT_EQUAL_INT(_tests[i].plain_len + GCM_TAG_MAX_LEN, len);
+        TEST_ASSERT_MESSAGE(1 == compare(_tests[i].expected, data, len),
+                            _tests[i].name);
+    }
+}
+
+static void test_crypto_modes_gcm_decrypt(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_tests); i++) {
+        cipher_t cipher;
+        size_t enc_len = _tests[i].plain_len + GCM_TAG_MAX_LEN;
+        int32_t len;
+
+        TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES,
+                                             _tests[i].key, _tests[i].key_len));
+
+        /* in place */
+        memcpy(data, _tests[i].expected, enc_len);
+        len = cipher_decrypt_gcm(&cipher, _tests[i].adata, _tests[i].adata_len,
+                                 GCM_TAG_MAX_LEN,
+                                 _tests[i].nonce, _tests[i].nonce_len,
+                                 data, enc_len, data);
+        TEST_ASSERT_EQUAL_INT(_tests[i].plain_len, len);
+        TEST_ASSERT_MESSAGE(1 == compare(_tests[i].plain, data, len),
+                            _tests[i].name);
+
+        /* a modified tag is rejected and the plaintext wiped */
+        memcpy(data, _tests[i].expected, enc_len);
+        data[enc_len - 1] ^= 0x01;
+        len = cipher_decrypt_gcm(&cipher, _tests[i].adata, _tests[i].adata_len,
+                                 GCM_TAG_MAX_LEN,
+                                 _tests[i].nonce, _tests[i].nonce_len,
+                                 data, enc_len, data);
+        TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_TAG, len);
+        for (unsigned j = 0; j < _tests[i].plain_len; j++) {
+            TEST_ASSERT_EQUAL_INT(0, data[j]);
+        }
+    }
+}
+
+static void test_crypto_modes_gcm_short_tag(void)
+{
+    cipher_t cipher;
+    int32_t len;
+
+    /* a 12 byte tag is a prefix of the full tag */
+    cipher_init(&cipher, CIPHER_AES, TEST_KEY, 16);
+    len = cipher_encrypt_gcm(&cipher, TEST_ADATA, sizeof(TEST_ADATA), 12,
+                             TEST_NONCE_12, 12, TEST_PLAIN, 60, data);
+    TEST_ASSERT_EQUAL_INT(72, len);
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_4_EXPECTED, data, len),
+                        "wrong ciphertext");
+
+    len = cipher_decrypt_gcm(&cipher, TEST_ADATA, sizeof(TEST_ADATA), 12,
+                             TEST_NONCE_12, 12, data, 72, data);
+    TEST_ASSERT_EQUAL_INT(60, len);
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_PLAIN, data, len),
+                        "wrong plaintext");
+}
+
+static void test_crypto_modes_gcm_bad_parameter_values(void)
+{
+    uint8_t key[16] = { 0 }, nonce[12] = { 0 }, input[16] = { 0 };
+    cipher_t cipher;
+    int32_t rv;
+
+    cipher_init(&cipher, CIPHER_AES, key, 16);
+    /* tag length must be 4, 8 or 12 to 16 */
+    rv = cipher_encrypt_gcm(&cipher, NULL, 0, 0, nonce, sizeof(nonce),
+                            input, sizeof(input), data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_TAG_LENGTH, rv);
+    rv = cipher_encrypt_gcm(&cipher, NULL, 0, 10, nonce, sizeof(nonce),
+                            input, sizeof(input), data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_TAG_LENGTH, rv);
+    rv = cipher_encrypt_gcm(&cipher, NULL, 0, 17, nonce, sizeof(nonce),
+                            input, sizeof(input), data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_TAG_LENGTH, rv);
+    /* nonce must not be empty */
+    rv = cipher_encrypt_gcm(&cipher, NULL, 0, 16, nonce, 0,
+                            input, sizeof(input), data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_NONCE_LENGTH, rv);
+    /* ciphertext must hold the tag */
+    rv = cipher_decrypt_gcm(&cipher, NULL, 0, 16, nonce, sizeof(nonce),
+                            input, 15, data);
+    TEST_ASSERT_EQUAL_INT(GCM_ERR_INVALID_DATA_LENGTH, rv);
+}
+
+Test *tests_crypto_modes_gcm_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_modes_gcm_encrypt),
+        new_TestFixture(test_crypto_modes_gcm_decrypt),
+        new_TestFixture(test_crypto_modes_gcm_short_tag),
+        new_TestFixture(test_crypto_modes_gcm_bad_parameter_values),
+    };
+
+    EMB_UNIT_TESTCALLER(crypto_modes_gcm_tests, NULL, NULL, fixtures);
+
+    return (Test *)&crypto_modes_gcm_tests;
+}
@@ -216,12 +216,29 @@ static const uint8_t tag_11[] = {
     0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+/*
+ *  Poly1305 test vector
+ *
+ *  https://tools.ietf.org/html/rfc8439#section-2.5.2
+ */
+
+static const uint8_t key_12[] = {
+    0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33, 0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+    0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd, 0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b,
+};
+
+static const char msg_12[] = "Cryptographic Forum Research Group";
+
+static const uint8_t tag_12[] = {
+    0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6, 0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9,
+};
+
 static void _test_poly1305(const uint8_t *key, const uint8_t *msg, size_t msglen, const uint8_t *tag)
 {
     uint8_t gen_tag[16];
 
     poly1305_auth(gen_tag, msg, msglen, key);
-    for (unsigned i = 0; i < sizeof(tag); i++) {
+    for (unsigned i = 0; i < sizeof(gen_tag); i++) {
         TEST_ASSERT_EQUAL_INT(gen_tag[i], tag[i]);
     }
 }
@@ -281,6 +298,31 @@ static void test_crypto_poly1305_11(void)
     _test_poly1305(key_11, msg_11, sizeof(msg_11), tag_11);
 }
 
+static void test_crypto_poly1305_12(void)
+{
+    _test_poly1305(key_12, (const uint8_t *)msg_12, strlen(msg_12), tag_12);
+}
+
+static void test_crypto_poly1305_split(void)
+{
+    /* partial blocks are buffered, full blocks are processed directly */
+    static const size_t pieces[] = { 1, 5, 15, 16, 17, 33 };
+
+    for (unsigned i = 0; i < sizeof(pieces) / sizeof(pieces[0]); i++) {
+        poly1305_ctx_t ctx;
+        uint8_t gen_tag[16];
+
+        poly1305_init(&ctx, key_2);
+        for (size_t pos = 0; pos < sizeof(msg_2); pos += pieces[i]) {
+            size_t n = sizeof(msg_2) - pos;
+
+            poly1305_update(&ctx, &msg_2[pos], n < pieces[i] ? n : pieces[i]);
+        }
+        poly1305_finish(&ctx, gen_tag);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(gen_tag, tag_2, sizeof(gen_tag)));
+    }
+}
+
 Test *tests_crypto_poly1305_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -295,6 +337,8 @@ Test *tests_crypto_poly1305_tests(void)
         new_TestFixture(test_crypto_poly1305_9),
         new_TestFixture(test_crypto_poly1305_10),
         new_TestFixture(test_crypto_poly1305_11),
+        new_TestFixture(test_crypto_poly1305_12),
+        new_TestFixture(test_crypto_poly1305_split),
     };
     EMB_UNIT_TESTCALLER(crypto_poly1305_tests, NULL, NULL, fixtures);
     return (Test *) &crypto_poly1305_tests;
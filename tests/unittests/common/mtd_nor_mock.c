@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "mtd_nor_mock.h"
+
+static inline uint32_t _size(const mtd_dev_t *mtd)
+{
+    return mtd->sector_count * mtd->pages_per_sector * mtd->page_size;
+}
+
+static int _init(mtd_dev_t *mtd)
+{
+    (void)mtd;
+    return 0;
+}
+
+static int _read(mtd_dev_t *mtd, void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_nor_mock_t *dev = container_of(mtd, mtd_nor_mock_t, mtd);
+
+    if (addr + size > _size(mtd)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, &dev->mem[addr], size);
+    dev->stats->reads++;
+    dev->stats->bytes_read += size;
+    return 0;
+}
+
+static int _write(mtd_dev_t *mtd, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    mtd_nor_mock_t *dev = container_of(mtd, mtd_nor_mock_t, mtd);
+    const uint8_t *src = buff;
+
+    if ((addr + size > _size(mtd)) ||
+        (addr % dev->write_align) || (size % dev->write_align)) {
+        return -EOVERFLOW;
+    }
+    if (dev->page_writes &&
+        (((addr % mtd->page_size) + size) > mtd->page_size)) {
+        return -EOVERFLOW;
+    }
+    if (dev->power_lost) {
+        return -EIO;
+    }
+    if (dev->writes_left == 0) {
+        /* only the first half of the data makes it to the flash */
+        dev->power_lost = true;
+        size /= 2;
+    }
+    else if (dev->writes_left > 0) {
+        dev->writes_left--;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        if ((dev->mem[addr + i] != 0xff) && (src[i] != 0xff)) {
+            dev->stats->overwrites++;
+        }
+        dev->mem[addr + i] &= src[i];
+    }
+    dev->stats->writes++;
+    return dev->power_lost ? -EIO : 0;
+}
+
+static int _erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+{
+    mtd_nor_mock_t *dev = container_of(mtd, mtd_nor_mock_t, mtd);
+    const uint32_t sector_size = mtd->pages_per_sector * mtd->page_size;
+
+    if ((addr % sector_size) || (size % sector_size) ||
+        (addr + size > _size(mtd))) {
+        return -EOVERFLOW;
+    }
+    if (dev->power_lost) {
+        return -EIO;
+    }
+    if (dev->erase_res) {
+        return dev->erase_res;
+    }
+    memset(&dev->mem[addr], 0xff, size);
+    dev->stats->erases += size / sector_size;
+    if (dev->sector_erases) {
+        for (uint32_t s = addr / sector_size; s < (addr + size) / sector_size;
+             s++) {
+            dev->sector_erases[s]++;
+        }
+    }
+    return 0;
+}
+
+static int _power(mtd_dev_t *mtd, enum mtd_power_state power)
+{
+    (void)mtd;
+    (void)power;
+    return 0;
+}
+
+const mtd_desc_t mtd_nor_mock_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+};
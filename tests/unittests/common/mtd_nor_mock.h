@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @brief   RAM-based mock of a NOR flash for the unittests
+ *
+ * Programming can only clear bits, sectors are erased to 0xff.
+ */
+#ifndef MTD_NOR_MOCK_H
+#define MTD_NOR_MOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Operation counters of the mock
+ */
+typedef struct {
+    unsigned reads;             /**< read operations */
+    unsigned bytes_read;        /**< bytes read */
+    unsigned writes;            /**< program operations */
+    unsigned overwrites;        /**< bytes programmed twice with different
+                                     values */
+    unsigned erases;            /**< sectors erased */
+} mtd_nor_mock_stats_t;
+
+/**
+ * @brief   NOR flash mock device
+ */
+typedef struct {
+    mtd_dev_t mtd;              /**< MTD context */
+    uint8_t *mem;               /**< flash content */
+    mtd_nor_mock_stats_t *stats;    /**< counters to update */
+    unsigned *sector_erases;    /**< per sector erase counters or NULL */
+    uint32_t write_align;       /**< required alignment of address and size
+                                     of a write */
+    bool page_writes;           /**< writes must not cross a page boundary */
+    int erase_res;              /**< error to return on erase, 0 to erase */
+    int writes_left;            /**< writes until power is lost halfway
+                                     through the next one, negative for no
+                                     power loss */
+    bool power_lost;            /**< writes and erases fail with -EIO */
+} mtd_nor_mock_t;
+
+/**
+ * @brief   Mock driver
+ */
+extern const mtd_desc_t mtd_nor_mock_driver;
+
+/**
+ * @brief   Initializes a mock device
+ *
+ * @param[in] _mem              buffer of `_sectors * _pages * _page_size`
+ *                              bytes
+ * @param[in] _sectors          number of sectors
+ * @param[in] _pages            pages per sector
+ * @param[in] _page_size        page size
+ * @param[in] _stats            @ref mtd_nor_mock_stats_t to update
+ */
+#define MTD_NOR_MOCK_INIT(_mem, _sectors, _pages, _page_size, _stats) \
+{ \
+    .mtd = { \
+        .driver = &mtd_nor_mock_driver, \
+        .sector_count = _sectors, \
+        .pages_per_sector = _pages, \
+        .page_size = _page_size, \
+    }, \
+    .mem = _mem, \
+    .stats = _stats, \
+    .write_align = 1, \
+    .writes_left = -1, \
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_NOR_MOCK_H */
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "checksum/crc.h"
+#include "checksum/crc8.h"
+#include "checksum/crc16_ccitt.h"
+#include "kernel_defines.h"
+
+#include "tests-checksum.h"
+
+static const char _check[] = "123456789";
+
+static crc_table_t _table;
+static uint8_t _buf[300];
+
+static void _fill_buf(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = 7 * i + 3;
+    }
+}
+
+static void test_checksum_crc_check_values(void)
+{
+    /* check values of the CRC catalogue */
+    TEST_ASSERT_EQUAL_INT(0xf4, crc_calc(&crc_8, _check, 9));
+    TEST_ASSERT_EQUAL_INT(0xe5cc, crc_calc(&crc_16_ccitt, _check, 9));
+    TEST_ASSERT(0xcbf43926 == crc_calc(&crc_32, _check, 9));
+    TEST_ASSERT(0xe3069283 == crc_calc(&crc_32c, _check, 9));
+}
+
+static void test_checksum_crc_empty(void)
+{
+    TEST_ASSERT_EQUAL_INT(0x00, crc_calc(&crc_8, "", 0));
+    TEST_ASSERT_EQUAL_INT(0x1d0f, crc_calc(&crc_16_ccitt, "", 0));
+    TEST_ASSERT(0 == crc_calc(&crc_32, "", 0));
+}
+
+static void test_checksum_crc_split(void)
+{
+    static const crc_t *const crcs[] = {
+        &crc_8, &crc_16_ccitt, &crc_32, &crc_32c,
+    };
+
+    _fill_buf();
+    for (unsigned i = 0; i < ARRAY_SIZE(crcs); i++) {
+        uint32_t expect = crc_calc(crcs[i], _buf, sizeof(_buf));
+
+        for (size_t split = 0; split <= sizeof(_buf); split += 37) {
+            uint32_t reg = crc_start(crcs[i]);
+
+            reg = crc_update(crcs[i], reg, _buf, split);
+            reg = crc_update(crcs[i], reg, _buf + split, sizeof(_buf) - split);
+            TEST_ASSERT(expect == crc_finish(crcs[i], reg));
+        }
+    }
+}
+
+static void test_checksum_crc_vs_crc16_ccitt(void)
+{
+    _fill_buf();
+    for (size_t len = 0; len <= sizeof(_buf); len += 29) {
+        TEST_ASSERT_EQUAL_INT(crc16_ccitt_calc(_buf, len),
+                              crc_calc(&crc_16_ccitt, _buf, len));
+    }
+}
+
+static void test_checksum_crc_tables(void)
+{
+    static const crc_t *const crcs[] = {
+        &crc_8, &crc_16_ccitt, &crc_32, &crc_32c,
+    };
+
+    /* the tables expanded at compile time have to match the computed ones */
+    for (unsigned i = 0; i < ARRAY_SIZE(crcs); i++) {
+        crc_table_init(&_table, crcs[i]->poly, crcs[i]->width,
+                       crcs[i]->reflected);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(&_table, crcs[i]->table,
+                                        sizeof(_table)));
+    }
+}
+
+static void test_checksum_crc_custom(void)
+{
+    /* CRC-16/KERMIT, a reflected CRC-16 */
+    const crc_t kermit = {
+        .table = &_table,
+        .poly = 0x1021,
+        .width = 16,
+        .reflected = true,
+    };
+    /* the CRC-8 of tests-checksum-crc8.c */
+    const crc_t crc8_31 = {
+        .table = &_table,
+        .poly = 0x31,
+        .init = 0xff,
+        .width = 8,
+    };
+
+    crc_table_init(&_table, kermit.poly, kermit.width, kermit.reflected);
+    TEST_ASSERT_EQUAL_INT(0x2189, crc_calc(&kermit, _check, 9));
+
+    crc_table_init(&_table, crc8_31.poly, crc8_31.width, crc8_31.reflected);
+    TEST_ASSERT_EQUAL_INT(0xf7, crc_calc(&crc8_31, _check, 9));
+    _fill_buf();
+    TEST_ASSERT_EQUAL_INT(crc8(_buf, sizeof(_buf), 0x31, 0xff),
+                          crc_calc(&crc8_31, _buf, sizeof(_buf)));
+}
+
+Test *tests_checksum_crc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_checksum_crc_check_values),
+        new_TestFixture(test_checksum_crc_empty),
+        new_TestFixture(test_checksum_crc_split),
+        new_TestFixture(test_checksum_crc_vs_crc16_ccitt),
+        new_TestFixture(test_checksum_crc_tables),
+        new_TestFixture(test_checksum_crc_custom),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc_tests, NULL, NULL, fixtures);
+
+    return (Test *)&checksum_crc_tests;
+}
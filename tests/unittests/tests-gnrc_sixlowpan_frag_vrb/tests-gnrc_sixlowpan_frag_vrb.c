@@ -18,6 +18,8 @@
 
 #include "embUnit/embUnit.h"
 
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/sixlowpan/frag/fb.h"
 #include "net/gnrc/sixlowpan/frag/vrb.h"
 #include "xtimer.h"
@@ -56,6 +58,7 @@ static uint8_t _out_dst[] = TEST_OUT_DST;
 
 static void set_up(void)
 {
+    gnrc_pktbuf_init();
     gnrc_sixlowpan_frag_vrb_reset();
     gnrc_sixlowpan_frag_fb_reset();
 }
@@ -156,6 +159,156 @@ static void test_vrb_rm(void)
                                                  _base.tag));
 }
 
+static void test_vrb_rm__reuse(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = _base;
+    gnrc_sixlowpan_frag_vrb_t *first = NULL;
+
+    /* fill up VRB */
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        gnrc_sixlowpan_frag_vrb_t *res;
+
+        TEST_ASSERT_NOT_NULL((res = gnrc_sixlowpan_frag_vrb_add(
+                                        &base, &_dummy_netif,
+                                        _out_dst, sizeof(_out_dst))));
+        if (first == NULL) {
+            first = res;
+        }
+        base.tag++;
+    }
+    gnrc_sixlowpan_frag_vrb_rm(first);
+    /* removed entry makes room for another */
+    TEST_ASSERT(first == gnrc_sixlowpan_frag_vrb_add(&base, &_dummy_netif,
+                                                     _out_dst,
+                                                     sizeof(_out_dst)));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_base.src, _base.src_len,
+                                                 _base.tag));
+    /* all other entries are still found */
+    for (unsigned i = 1; i <= CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_get(_base.src,
+                                                         _base.src_len,
+                                                         _base.tag + i));
+    }
+}
+
+static void test_vrb_reverse(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *res;
+    gnrc_netif_t other_netif;
+
+    TEST_ASSERT_NOT_NULL((res = gnrc_sixlowpan_frag_vrb_add(&_base,
+                                                            &_dummy_netif,
+                                                            _out_dst,
+                                                            sizeof(_out_dst))));
+    TEST_ASSERT(res == gnrc_sixlowpan_frag_vrb_reverse(&_dummy_netif, _out_dst,
+                                                       sizeof(_out_dst),
+                                                       res->out_tag));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_reverse(&other_netif, _out_dst,
+                                                     sizeof(_out_dst),
+                                                     res->out_tag));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_reverse(&_dummy_netif, _base.src,
+                                                     _base.src_len,
+                                                     res->out_tag));
+    gnrc_sixlowpan_frag_vrb_rm(res);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_reverse(&_dummy_netif, _out_dst,
+                                                     sizeof(_out_dst),
+                                                     res->out_tag));
+}
+
+static void test_vrb_reverse__sfr_tag(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *res;
+
+    /* get outgoing tag out of SFR's value space */
+    for (unsigned i = 0; i <= UINT8_MAX; i++) {
+        gnrc_sixlowpan_frag_fb_next_tag();
+    }
+    TEST_ASSERT_NOT_NULL((res = gnrc_sixlowpan_frag_vrb_add(&_base,
+                                                            &_dummy_netif,
+                                                            _out_dst,
+                                                            sizeof(_out_dst))));
+    TEST_ASSERT(res->out_tag > UINT8_MAX);
+    /* SFR restricts out_tag to 8 bit after the entry was created */
+    res->out_tag &= UINT8_MAX;
+    TEST_ASSERT(res == gnrc_sixlowpan_frag_vrb_reverse(&_dummy_netif, _out_dst,
+                                                       sizeof(_out_dst),
+                                                       res->out_tag));
+}
+
+static void _recv_frag(gnrc_pktsnip_t **pkt, gnrc_pktsnip_t **netif)
+{
+    static const uint8_t src[] = TEST_SRC;
+    static const uint8_t dst[] = TEST_DST;
+
+    TEST_ASSERT_NOT_NULL((*pkt = gnrc_pktbuf_add(NULL, NULL, 32U,
+                                                 GNRC_NETTYPE_SIXLOWPAN)));
+    TEST_ASSERT_NOT_NULL((*netif = gnrc_netif_hdr_build(src, sizeof(src),
+                                                        dst, sizeof(dst))));
+    /* received packets are in reverse order */
+    (*pkt)->next = *netif;
+}
+
+static void _check_netif_hdr(gnrc_pktsnip_t *res, gnrc_pktsnip_t *frag)
+{
+    gnrc_netif_hdr_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(res);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_NETIF, res->type);
+    TEST_ASSERT(frag == res->next);
+    TEST_ASSERT_NULL(frag->next);
+    hdr = res->data;
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_netif_hdr_t) + sizeof(_out_dst),
+                          res->size);
+    TEST_ASSERT_EQUAL_INT(0, hdr->src_l2addr_len);
+    TEST_ASSERT_EQUAL_INT(sizeof(_out_dst), hdr->dst_l2addr_len);
+    TEST_ASSERT_EQUAL_INT(_dummy_netif.pid, hdr->if_pid);
+    TEST_ASSERT_EQUAL_INT(0, hdr->flags);
+    TEST_ASSERT_MESSAGE(memcmp(_out_dst, gnrc_netif_hdr_get_dst_addr(hdr),
+                               sizeof(_out_dst)) == 0,
+                        "TEST_OUT_DST != destination of netif header");
+}
+
+static void test_vrb_netif_hdr__in_place(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *pkt, *netif, *res;
+
+    TEST_ASSERT_NOT_NULL((vrbe = gnrc_sixlowpan_frag_vrb_add(&_base,
+                                                             &_dummy_netif,
+                                                             _out_dst,
+                                                             sizeof(_out_dst))));
+    _recv_frag(&pkt, &netif);
+    res = gnrc_sixlowpan_frag_vrb_netif_hdr(vrbe, pkt);
+    /* header of received fragment was reused */
+    TEST_ASSERT(netif == res);
+    _check_netif_hdr(res, pkt);
+    gnrc_pktbuf_release(res);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_vrb_netif_hdr__shared(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *pkt, *netif, *res;
+
+    TEST_ASSERT_NOT_NULL((vrbe = gnrc_sixlowpan_frag_vrb_add(&_base,
+                                                             &_dummy_netif,
+                                                             _out_dst,
+                                                             sizeof(_out_dst))));
+    _recv_frag(&pkt, &netif);
+    gnrc_pktbuf_hold(netif, 1);
+    res = gnrc_sixlowpan_frag_vrb_netif_hdr(vrbe, pkt);
+    /* shared header must not be overwritten */
+    TEST_ASSERT(netif != res);
+    _check_netif_hdr(res, pkt);
+    TEST_ASSERT_EQUAL_INT(1, netif->users);
+    TEST_ASSERT_EQUAL_INT(TEST_SRC_LEN,
+                          ((gnrc_netif_hdr_t *)netif->data)->src_l2addr_len);
+    gnrc_pktbuf_release(netif);
+    gnrc_pktbuf_release(res);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_vrb_gc(void)
 {
     gnrc_sixlowpan_frag_rb_base_t base = _base;
@@ -171,6 +324,66 @@ static void test_vrb_gc(void)
                                                  base.tag));
 }
 
+static void test_vrb_gc__only_expired(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = _base;
+
+    base.arrival = xtimer_now_usec();
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_add(&base, &_dummy_netif,
+                                                     _out_dst,
+                                                     sizeof(_out_dst)));
+    /* added later, but expires first */
+    base.tag++;
+    base.arrival -= CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US + 1000;
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_add(&base, &_dummy_netif,
+                                                     _out_dst,
+                                                     sizeof(_out_dst)));
+    gnrc_sixlowpan_frag_vrb_gc();
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(base.src, base.src_len,
+                                                 base.tag));
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_vrb_get(base.src, base.src_len,
+                                                     base.tag - 1));
+}
+
+static void test_vrb_refresh(void)
+{
+    gnrc_sixlowpan_frag_rb_base_t base = _base;
+    gnrc_sixlowpan_frag_vrb_t *res;
+
+    base.arrival = xtimer_now_usec() - CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US - 1000;
+    TEST_ASSERT_NOT_NULL((res = gnrc_sixlowpan_frag_vrb_add(&base,
+                                                            &_dummy_netif,
+                                                            _out_dst,
+                                                            sizeof(_out_dst))));
+    gnrc_sixlowpan_frag_vrb_refresh(res);
+    gnrc_sixlowpan_frag_vrb_gc();
+    TEST_ASSERT(res == gnrc_sixlowpan_frag_vrb_get(base.src, base.src_len,
+                                                   base.tag));
+}
+
+static void test_vrb_rm_delayed(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *res;
+
+    TEST_ASSERT_NOT_NULL((res = gnrc_sixlowpan_frag_vrb_add(&_base,
+                                                            &_dummy_netif,
+                                                            _out_dst,
+                                                            sizeof(_out_dst))));
+    gnrc_sixlowpan_frag_vrb_refresh(res);
+    gnrc_sixlowpan_frag_vrb_rm_delayed(res);
+    gnrc_sixlowpan_frag_vrb_gc();
+    if (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0) {
+        /* kept until CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER passed */
+        TEST_ASSERT(res == gnrc_sixlowpan_frag_vrb_get(_base.src,
+                                                       _base.src_len,
+                                                       _base.tag));
+    }
+    else {
+        TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_base.src, _base.src_len,
+                                                     _base.tag));
+    }
+}
+
 static Test *tests_gnrc_sixlowpan_frag_vrb_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -180,7 +393,15 @@ static Test *tests_gnrc_sixlowpan_frag_vrb_tests(void)
         new_TestFixture(test_vrb_get__empty),
         new_TestFixture(test_vrb_get__after_add),
         new_TestFixture(test_vrb_rm),
+        new_TestFixture(test_vrb_rm__reuse),
+        new_TestFixture(test_vrb_reverse),
+        new_TestFixture(test_vrb_reverse__sfr_tag),
+        new_TestFixture(test_vrb_netif_hdr__in_place),
+        new_TestFixture(test_vrb_netif_hdr__shared),
         new_TestFixture(test_vrb_gc),
+        new_TestFixture(test_vrb_gc__only_expired),
+        new_TestFixture(test_vrb_refresh),
+        new_TestFixture(test_vrb_rm_delayed),
     };
 
     EMB_UNIT_TESTCALLER(vrb_tests, set_up, NULL, fixtures);
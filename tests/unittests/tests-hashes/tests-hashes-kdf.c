@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     unittests
+ * @{
+ *
+ * @file
+ * @brief       testcases for the PBKDF2 and HKDF implementations
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "embUnit/embUnit.h"
+
+#include "hashes/hkdf.h"
+#include "hashes/pbkdf2.h"
+
+#include "tests-hashes.h"
+
+static int compare_str_vs_digest(const char *str, const uint8_t *hash)
+{
+    char ch[3] = { 0, 0, 0 };
+    size_t iter_hash = 0;
+    size_t str_length = strlen(str);
+    for (size_t i = 0; i < str_length; i += 2) {
+        ch[0] = str[i];
+        ch[1] = str[i + 1];
+
+        if (hash[iter_hash++] != strtol(ch, NULL, 16)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void test_hashes_pbkdf2_sha256(void)
+{
+    static const char password[] = "password";
+    static const char salt[] = "salt";
+    uint8_t key[PBKDF2_KEY_SIZE];
+
+    pbkdf2_sha256((const uint8_t *)password, strlen(password),
+                  (const uint8_t *)salt, strlen(salt), 1, key);
+    TEST_ASSERT(compare_str_vs_digest(
+                 "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b", key));
+
+    pbkdf2_sha256((const uint8_t *)password, strlen(password),
+                  (const uint8_t *)salt, strlen(salt), 2, key);
+    TEST_ASSERT(compare_str_vs_digest(
+                 "ae4d0c95af6b46d32d0adff928f06dd02a303f8ef3c251dfd6e2d85a95474c43", key));
+
+    pbkdf2_sha256((const uint8_t *)password, strlen(password),
+                  (const uint8_t *)salt, strlen(salt), 4096, key);
+    TEST_ASSERT(compare_str_vs_digest(
+                 "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a", key));
+}
+
+/*
+        The following testcases are taken from:
+        https://tools.ietf.org/html/rfc5869#appendix-A
+*/
+
+static void test_hashes_hkdf_sha256_case1(void)
+{
+    uint8_t ikm[22], salt[13], info[10];
+    uint8_t prk[HKDF_SHA256_PRK_SIZE];
+    uint8_t okm[42];
+
+    memset(ikm, 0x0b, sizeof(ikm));
+    for (unsigned i = 0; i < sizeof(salt); i++) {
+        salt[i] = i;
+    }
+    for (unsigned i = 0; i < sizeof(info); i++) {
+        info[i] = 0xf0 + i;
+    }
+
+    hkdf_sha256_extract(salt, sizeof(salt), ikm, sizeof(ikm), prk);
+    TEST_ASSERT(compare_str_vs_digest(
+                 "077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5", prk));
+
+    TEST_ASSERT_EQUAL_INT(0, hkdf_sha256_expand(prk, sizeof(prk), info,
+                                                sizeof(info), okm, sizeof(okm)));
+    TEST_ASSERT(compare_str_vs_digest(
+                 "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf"
+                 "34007208d5b887185865", okm));
+}
+
+static void test_hashes_hkdf_sha256_case2(void)
+{
+    uint8_t ikm[80], salt[80], info[80];
+    uint8_t okm[82];
+
+    for (unsigned i = 0; i < sizeof(ikm); i++) {
+        ikm[i] = i;
+        salt[i] = 0x60 + i;
+        info[i] = 0xb0 + i;
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, hkdf_sha256(salt, sizeof(salt), ikm, sizeof(ikm),
+                                         info, sizeof(info), okm, sizeof(okm)));
+    TEST_ASSERT(compare_str_vs_digest(
+                 "b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c"
+                 "59045a99cac7827271cb41c65e590e09da3275600c2f09b8367793a9aca3db71"
+                 "cc30c58179ec3e87c14c01d5c1f3434f1d87", okm));
+}
+
+static void test_hashes_hkdf_sha256_case3(void)
+{
+    uint8_t ikm[22];
+    uint8_t okm[42];
+
+    memset(ikm, 0x0b, sizeof(ikm));
+
+    TEST_ASSERT_EQUAL_INT(0, hkdf_sha256(NULL, 0, ikm, sizeof(ikm), NULL, 0,
+                                         okm, sizeof(okm)));
+    TEST_ASSERT(compare_str_vs_digest(
+                 "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d"
+                 "9d201395faa4b61a96c8", okm));
+}
+
+static void test_hashes_hkdf_sha256_too_long(void)
+{
+    uint8_t prk[HKDF_SHA256_PRK_SIZE] = { 0 };
+    uint8_t okm[1];
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          hkdf_sha256_expand(prk, sizeof(prk), NULL, 0, okm,
+                                             HKDF_SHA256_MAX_OKM_SIZE + 1));
+}
+
+Test *tests_hashes_kdf_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_hashes_pbkdf2_sha256),
+        new_TestFixture(test_hashes_hkdf_sha256_case1),
+        new_TestFixture(test_hashes_hkdf_sha256_case2),
+        new_TestFixture(test_hashes_hkdf_sha256_case3),
+        new_TestFixture(test_hashes_hkdf_sha256_too_long),
+    };
+
+    EMB_UNIT_TESTCALLER(hashes_kdf_tests, NULL, NULL, fixtures);
+
+    return (Test *)&hashes_kdf_tests;
+}
@@ -328,6 +328,63 @@ static void test_hashes_hmac_sha256_ite_hash_PRF6_split(void)
                  "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2", hmac));
 }
 
+static void test_hashes_hmac_sha256_mb(void)
+{
+    static const size_t lens[] = { 0, 9, 55, 64, 100, 32, 1, 150, 17 };
+    static const char key[] = "multi-buffer key";
+    static unsigned char buf[150];
+    unsigned char hmacs[ARRAY_SIZE(lens)][SHA256_DIGEST_LENGTH];
+    const void *data[ARRAY_SIZE(lens)];
+    void *digest[ARRAY_SIZE(lens)];
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = 3 * i;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        data[i] = &buf[(5 * i) % (sizeof(buf) - lens[i] + 1)];
+        digest[i] = hmacs[i];
+    }
+
+    hmac_sha256_mb(key, strlen(key), data, lens, digest, ARRAY_SIZE(lens));
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        unsigned char hmac[SHA256_DIGEST_LENGTH];
+
+        hmac_sha256(key, strlen(key), data[i], lens[i], hmac);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(hmac, hmacs[i], SHA256_DIGEST_LENGTH));
+    }
+}
+
+static void test_hashes_hmac_sha256_precomputed(void)
+{
+    static const char str[] = "what do ya want for nothing?";
+    unsigned char longKey[131];
+    unsigned char hmac[SHA256_DIGEST_LENGTH];
+    hmac_sha256_key_t pk;
+    hmac_context_t ctx;
+
+    /* Test Case PRF-2, in one go and split */
+    hmac_sha256_precompute(&pk, "Jefe", 4);
+    hmac_sha256_precomputed(&pk, str, strlen(str), hmac);
+    TEST_ASSERT(compare_str_vs_digest(
+                 "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843", hmac));
+
+    hmac_sha256_init_precomputed(&ctx, &pk);
+    hmac_sha256_update(&ctx, str, 10);
+    hmac_sha256_update(&ctx, str + 10, strlen(str) - 10);
+    hmac_sha256_final(&ctx, hmac);
+    TEST_ASSERT(compare_str_vs_digest(
+                 "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843", hmac));
+
+    /* Test Case PRF-5, the key is longer than a block */
+    static const char strPRF5[] = "Test Using Larger Than Block-Size Key - Hash Key First";
+    memset(longKey, 0xaa, sizeof(longKey));
+    hmac_sha256_precompute(&pk, longKey, sizeof(longKey));
+    hmac_sha256_precomputed(&pk, strPRF5, strlen(strPRF5), hmac);
+    TEST_ASSERT(compare_str_vs_digest(
+                 "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54", hmac));
+}
+
 Test *tests_hashes_sha256_hmac_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -346,6 +403,8 @@ Test *tests_hashes_sha256_hmac_tests(void)
         new_TestFixture(test_hashes_hmac_sha256_ite_hash_PRF5),
         new_TestFixture(test_hashes_hmac_sha256_ite_hash_PRF6),
         new_TestFixture(test_hashes_hmac_sha256_ite_hash_PRF6_split),
+        new_TestFixture(test_hashes_hmac_sha256_mb),
+        new_TestFixture(test_hashes_hmac_sha256_precomputed),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
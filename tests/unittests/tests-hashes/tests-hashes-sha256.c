@@ -266,6 +266,66 @@ static void test_hashes_sha256_hash_sequence_abc_long(void)
     TEST_ASSERT(calc_and_compare_hash_wrapper(teststring, h_fips_multiblock));
 }
 
+static void test_hashes_sha256_hash_split(void)
+{
+    /* feeding the long sequence in pieces of any size, which makes the
+     * compression run on the buffer and on several input blocks at once,
+     * gives the same hash */
+    static const char *teststring =
+        {"RIOT is an open-source microkernel-based operating system, designed"
+        " to match the requirements of Internet of Things (IoT) devices and"
+        " other embedded devices. These requirements include a very low memory"
+        " footprint (on the order of a few kilobytes), high energy efficiency"
+        ", real-time capabilities, communication stacks for both wireless and"
+        " wired networks, and support for a wide range of low-power hardware."};
+    static const size_t pieces[] = { 1, 13, 63, 64, 65, 128, 200 };
+    unsigned char hash[SHA256_DIGEST_LENGTH];
+    size_t len = strlen(teststring);
+
+    for (unsigned i = 0; i < sizeof(pieces) / sizeof(pieces[0]); i++) {
+        sha256_context_t sha256;
+
+        sha256_init(&sha256);
+        for (size_t pos = 0; pos < len; pos += pieces[i]) {
+            size_t n = len - pos < pieces[i] ? len - pos : pieces[i];
+            sha256_update(&sha256, teststring + pos, n);
+        }
+        sha256_final(&sha256, hash);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(hlong_sequence, hash,
+                                        SHA256_DIGEST_LENGTH));
+    }
+}
+
+static void test_hashes_sha256_mb(void)
+{
+    /* lengths around the padding boundaries, more messages than lanes and
+     * lanes finishing at different blocks */
+    static const size_t lens[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 200,
+                                   3, 128 };
+    static unsigned char buf[200];
+    unsigned char hashes[ARRAY_SIZE(lens)][SHA256_DIGEST_LENGTH];
+    const void *data[ARRAY_SIZE(lens)];
+    void *digest[ARRAY_SIZE(lens)];
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        /* a different message in each lane */
+        data[i] = &buf[(7 * i) % (sizeof(buf) - lens[i] + 1)];
+        digest[i] = hashes[i];
+    }
+
+    sha256_mb(data, lens, digest, ARRAY_SIZE(lens));
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        unsigned char hash[SHA256_DIGEST_LENGTH];
+
+        sha256(data[i], lens[i], hash);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(hash, hashes[i], SHA256_DIGEST_LENGTH));
+    }
+}
+
 Test *tests_hashes_sha256_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -281,6 +341,8 @@ Test *tests_hashes_sha256_tests(void)
         new_TestFixture(test_hashes_sha256_hash_sequence_failing_compare),
 
         new_TestFixture(test_hashes_sha256_hash_long_sequence),
+        new_TestFixture(test_hashes_sha256_hash_split),
+        new_TestFixture(test_hashes_sha256_mb),
 
         new_TestFixture(test_hashes_sha256_hash_sequence_abc),
         new_TestFixture(test_hashes_sha256_hash_sequence_abc_long),
@@ -79,6 +79,13 @@ Test *tests_hashes_sha256_hmac_tests(void);
  */
 Test *tests_hashes_sha256_chain_tests(void);
 
+/**
+ * @brief   Generates tests for hashes/pbkdf2.h and hashes/hkdf.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_hashes_kdf_tests(void);
+
   /**
  * @brief   Generates tests for hashes/sha3.h
  *
@@ -0,0 +1,446 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "kernel_defines.h"
+#include "kvstore.h"
+#include "mtd.h"
+#include "mtd_nor_mock.h"
+
+#include "tests-kvstore.h"
+
+#define SECTOR_COUNT    (4U)
+#define PAGE_PER_SECTOR (8U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+
+static uint8_t _flash[SECTOR_COUNT * SECTOR_SIZE];
+static mtd_nor_mock_stats_t _stats;
+static mtd_nor_mock_t _dev = MTD_NOR_MOCK_INIT(_flash, SECTOR_COUNT,
+                                               PAGE_PER_SECTOR, PAGE_SIZE,
+                                               &_stats);
+static unsigned _erase_count[SECTOR_COUNT];
+
+static kvstore_t _kv;
+static kvstore_entry_t _index[16];
+
+static void set_up(void)
+{
+    memset(_flash, 0xff, sizeof(_flash));
+    memset(_erase_count, 0, sizeof(_erase_count));
+    memset(&_stats, 0, sizeof(_stats));
+    _dev.sector_erases = _erase_count;
+    _dev.write_align = KVSTORE_ALIGN;
+    _dev.erase_res = 0;
+    _dev.writes_left = -1;
+    _dev.power_lost = false;
+}
+
+static void _mount(void)
+{
+    /* the index must be rebuilt from the flash */
+    memset(&_kv, 0, sizeof(_kv));
+    memset(_index, 0x5a, sizeof(_index));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_init(&_kv, &_dev.mtd, _index,
+                                          ARRAY_SIZE(_index)));
+}
+
+static void _check_u32(const char *key, uint32_t expected)
+{
+    uint32_t val = 0;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(val), kvstore_get(&_kv, key, &val,
+                                                   sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(expected, val);
+}
+
+static void test_kvstore_empty(void)
+{
+    uint32_t val;
+
+    _mount();
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_get(&_kv, "a", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_delete(&_kv, "a"));
+    TEST_ASSERT_EQUAL_INT(0, _erase_count[0]);
+}
+
+static void test_kvstore_set_get(void)
+{
+    uint32_t val = 42;
+    char buf[16];
+
+    _mount();
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "answer", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "name", "RIOT", 4));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "empty", NULL, 0));
+    _check_u32("answer", 42);
+    TEST_ASSERT_EQUAL_INT(4, kvstore_get(&_kv, "name", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "RIOT", 4));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_get(&_kv, "empty", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, kvstore_get(&_kv, "name", buf, 3));
+
+    /* the value may change its size */
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "name", "RIOT OS", 7));
+    TEST_ASSERT_EQUAL_INT(7, kvstore_get(&_kv, "name", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "RIOT OS", 7));
+    TEST_ASSERT_EQUAL_INT(3, _kv.entries);
+}
+
+static void test_kvstore_unchanged(void)
+{
+    uint32_t val = 1;
+
+    _mount();
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "mode", &val, sizeof(val)));
+    unsigned writes = _stats.writes;
+
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "mode", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(writes, _stats.writes);
+}
+
+static void test_kvstore_delete(void)
+{
+    uint32_t val = 7;
+
+    _mount();
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "a", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "b", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(0, kvstore_delete(&_kv, "a"));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_get(&_kv, "a", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_delete(&_kv, "a"));
+    _check_u32("b", 7);
+
+    _mount();
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvstore_get(&_kv, "a", &val, sizeof(val)));
+    _check_u32("b", 7);
+    TEST_ASSERT_EQUAL_INT(1, _kv.entries);
+
+    val = 8;
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "a", &val, sizeof(val)));
+    _mount();
+    _check_u32("a", 8);
+}
+
+static void test_kvstore_remount(void)
+{
+    _mount();
+    for (uint32_t i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, (i % 2) ? "odd" : "even",
+                                             &i, sizeof(i)));
+    }
+    _mount();
+    _check_u32("even", 18);
+    _check_u32("odd", 19);
+    TEST_ASSERT_EQUAL_INT(2, _kv.entries);
+}
+
+static void test_kvstore_wear(void)
+{
+    char key[8];
+
+    _mount();
+    for (uint32_t i = 0; i < 5; i++) {
+        snprintf(key, sizeof(key), "cfg%u", (unsigned)i);
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, key, &i, sizeof(i)));
+    }
+
+    /* a counter updated over and over */
+    for (uint32_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "counter", &i, sizeof(i)));
+    }
+    TEST_ASSERT(_kv.gc_runs > 0);
+
+    /* all sectors are erased in turn */
+    unsigned min = UINT_MAX, max = 0;
+    for (unsigned s = 0; s < SECTOR_COUNT; s++) {
+        min = (_erase_count[s] < min) ? _erase_count[s] : min;
+        max = (_erase_count[s] > max) ? _erase_count[s] : max;
+    }
+    TEST_ASSERT(min > 0);
+    TEST_ASSERT(max - min <= 1);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint32_t i = 0; i < 5; i++) {
+            snprintf(key, sizeof(key), "cfg%u", (unsigned)i);
+            _check_u32(key, i);
+        }
+        _check_u32("counter", 999);
+        _mount();
+    }
+}
+
+static void test_kvstore_torn(void)
+{
+    uint32_t val = 1;
+
+    _mount();
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "x", &val, sizeof(val)));
+    val = 2;
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "x", &val, sizeof(val)));
+
+    /* the second record was not completely programmed */
+    uint32_t end = _kv.head * SECTOR_SIZE + _kv.pos;
+    /* first byte of the value, after the header and the key */
+    _flash[end - 16 + 7] = 0xff;
+
+    _mount();
+    _check_u32("x", 1);
+
+    /* the store continues in the next sector */
+    val = 3;
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "x", &val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(1, _kv.head);
+    _mount();
+    _check_u32("x", 3);
+}
+
+static void test_kvstore_gc_interrupted(void)
+{
+    uint32_t i, val = 0xcafe;
+    int res = 0;
+
+    _mount();
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "keep", &val, sizeof(val)));
+
+    /* the erase at the end of the first garbage collection fails */
+    _dev.erase_res = -EIO;
+    for (i = 0; i < 1000; i++) {
+        res = kvstore_set(&_kv, "counter", &i, sizeof(i));
+        if (res < 0) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(-EIO, res);
+    _dev.erase_res = 0;
+
+    /* no sector is erased, mounting completes the garbage collection */
+    _mount();
+    TEST_ASSERT(_kv.oldest != (_kv.head + 1) % SECTOR_COUNT);
+    _check_u32("keep", 0xcafe);
+    _check_u32("counter", i - 1);
+
+    for (; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "counter", &i, sizeof(i)));
+    }
+    _mount();
+    _check_u32("keep", 0xcafe);
+    _check_u32("counter", 999);
+}
+
+#define GC_STATIC_KEYS  (6U)
+#define GC_STATIC_LEN   (40U)
+
+/* stores keys that stay current until the garbage collection copies them */
+static void _gc_static_set(void)
+{
+    uint8_t val[GC_STATIC_LEN];
+    char key[8];
+
+    _mount();
+    for (unsigned i = 0; i < GC_STATIC_KEYS; i++) {
+        snprintf(key, sizeof(key), "s%u", i);
+        memset(val, i, sizeof(val));
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, key, val, sizeof(val)));
+    }
+}
+
+static void _gc_static_check(void)
+{
+    uint8_t val[GC_STATIC_LEN];
+    char key[8];
+
+    for (unsigned i = 0; i < GC_STATIC_KEYS; i++) {
+        snprintf(key, sizeof(key), "s%u", i);
+        memset(val, 0xff, sizeof(val));
+        TEST_ASSERT_EQUAL_INT(sizeof(val), kvstore_get(&_kv, key, val,
+                                                       sizeof(val)));
+        TEST_ASSERT_EQUAL_INT(i, val[0]);
+        TEST_ASSERT_EQUAL_INT(i, val[sizeof(val) - 1]);
+    }
+}
+
+static void test_kvstore_gc_power_loss(void)
+{
+    uint32_t updates = 0;
+    int cut;
+
+    /* the number of counter updates up to the first garbage collection */
+    _gc_static_set();
+    while (_kv.gc_runs == 0) {
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "counter", &updates,
+                                             sizeof(updates)));
+        updates++;
+    }
+
+    /* power is lost at every program operation of the last update */
+    for (cut = 0; ; cut++) {
+        uint32_t i;
+        int res;
+
+        set_up();
+        _gc_static_set();
+        for (i = 0; i < updates - 1; i++) {
+            TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "counter", &i,
+                                                 sizeof(i)));
+        }
+        TEST_ASSERT_EQUAL_INT(0, _kv.gc_runs);
+
+        _dev.writes_left = cut;
+        res = kvstore_set(&_kv, "counter", &i, sizeof(i));
+        _dev.writes_left = -1;
+        if (!_dev.power_lost) {
+            TEST_ASSERT_EQUAL_INT(0, res);
+            break;
+        }
+        TEST_ASSERT_EQUAL_INT(-EIO, res);
+        _dev.power_lost = false;
+
+        /* mounting completes the garbage collection */
+        _mount();
+        _gc_static_check();
+        _check_u32("counter", updates - 2);
+
+        /* the store keeps working */
+        for (i = 0; i < 100; i++) {
+            TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, "counter", &i,
+                                                 sizeof(i)));
+        }
+        _mount();
+        _gc_static_check();
+        _check_u32("counter", 99);
+    }
+    /* the header of the new sector, copies of all static keys and the
+     * update itself were interrupted */
+    TEST_ASSERT(cut > (int)(2 * GC_STATIC_KEYS));
+}
+
+static void test_kvstore_index(void)
+{
+    char key[8];
+
+    _mount();
+    /* one entry of the index stays free */
+    for (uint32_t i = 0; i < ARRAY_SIZE(_index) - 1; i++) {
+        snprintf(key, sizeof(key), "k%u", (unsigned)i);
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, key, &i, sizeof(i)));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, kvstore_set(&_kv, "one more", key, 1));
+
+    /* removing entries keeps the others reachable */
+    for (uint32_t i = 0; i < ARRAY_SIZE(_index) - 1; i += 3) {
+        snprintf(key, sizeof(key), "k%u", (unsigned)i);
+        TEST_ASSERT_EQUAL_INT(0, kvstore_delete(&_kv, key));
+    }
+    for (uint32_t i = 0; i < ARRAY_SIZE(_index) - 1; i++) {
+        uint32_t val;
+
+        snprintf(key, sizeof(key), "k%u", (unsigned)i);
+        if (i % 3) {
+            _check_u32(key, i);
+        }
+        else {
+            TEST_ASSERT_EQUAL_INT(-ENOENT,
+                                  kvstore_get(&_kv, key, &val, sizeof(val)));
+        }
+    }
+}
+
+static void test_kvstore_full(void)
+{
+    static uint8_t value[CONFIG_KVSTORE_VALUE_MAX];
+    char key[4];
+    unsigned stored;
+    int res = 0;
+
+    _mount();
+    for (stored = 0; stored < ARRAY_SIZE(_index) - 1; stored++) {
+        snprintf(key, sizeof(key), "v%u", stored);
+        memset(value, stored, sizeof(value));
+        res = kvstore_set(&_kv, key, value, sizeof(value));
+        if (res < 0) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, res);
+    /* at least one value of the maximum size per sector but the erased one */
+    TEST_ASSERT(stored >= SECTOR_COUNT - 1);
+
+    /* updates still fit, even with the store full */
+    for (unsigned i = 0; i < 50; i++) {
+        snprintf(key, sizeof(key), "v%u", i % stored);
+        memset(value, i + 0x80, sizeof(value));
+        TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, key, value,
+                                             sizeof(value)));
+    }
+
+    _mount();
+    for (unsigned i = 50 - stored; i < 50; i++) {
+        snprintf(key, sizeof(key), "v%u", i % stored);
+        TEST_ASSERT_EQUAL_INT(sizeof(value), kvstore_get(&_kv, key, value,
+                                                         sizeof(value)));
+        TEST_ASSERT_EQUAL_INT((i + 0x80) & 0xff, value[0]);
+        TEST_ASSERT_EQUAL_INT((i + 0x80) & 0xff, value[sizeof(value) - 1]);
+    }
+}
+
+static void test_kvstore_invalid(void)
+{
+    static uint8_t value[CONFIG_KVSTORE_VALUE_MAX + 1];
+    char key[CONFIG_KVSTORE_KEY_MAX + 2];
+
+    _mount();
+    memset(key, 'k', sizeof(key) - 1);
+    key[sizeof(key) - 1] = '\0';
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, kvstore_set(&_kv, "", value, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, kvstore_set(&_kv, key, value, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, kvstore_set(&_kv, "v", value,
+                                               sizeof(value)));
+    key[sizeof(key) - 2] = '\0';
+    TEST_ASSERT_EQUAL_INT(0, kvstore_set(&_kv, key, value,
+                                         sizeof(value) - 1));
+}
+
+Test *tests_kvstore_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_kvstore_empty),
+        new_TestFixture(test_kvstore_set_get),
+        new_TestFixture(test_kvstore_unchanged),
+        new_TestFixture(test_kvstore_delete),
+        new_TestFixture(test_kvstore_remount),
+        new_TestFixture(test_kvstore_wear),
+        new_TestFixture(test_kvstore_torn),
+        new_TestFixture(test_kvstore_gc_interrupted),
+        new_TestFixture(test_kvstore_gc_power_loss),
+        new_TestFixture(test_kvstore_index),
+        new_TestFixture(test_kvstore_full),
+        new_TestFixture(test_kvstore_invalid),
+    };
+
+    EMB_UNIT_TESTCALLER(kvstore_tests, set_up, NULL, fixtures);
+
+    return (Test *)&kvstore_tests;
+}
+
+void tests_kvstore(void)
+{
+    TESTS_RUN(tests_kvstore_tests());
+}
+/** @} */
@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_bcache.h"
+#include "mtd_nor_mock.h"
+
+#include "tests-mtd_bcache.h"
+
+#define SECTOR_COUNT    (16U)
+#define PAGE_PER_SECTOR (8U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+#define BLOCK_SIZE      CONFIG_MTD_BCACHE_BLOCK_SIZE
+
+static uint8_t _flash[SECTOR_COUNT * SECTOR_SIZE];
+static mtd_nor_mock_stats_t _flash_stats;
+static mtd_nor_mock_t _flash_dev = MTD_NOR_MOCK_INIT(_flash, SECTOR_COUNT,
+                                                     PAGE_PER_SECTOR,
+                                                     PAGE_SIZE, &_flash_stats);
+
+/* RAM-based mock of a SD card: writes overwrite */
+static uint8_t _card[SECTOR_COUNT * SECTOR_SIZE];
+static unsigned _card_reads;
+
+static int _card_init(mtd_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _card_read(mtd_dev_t *dev, void *buff, uint32_t addr,
+                      uint32_t size)
+{
+    (void)dev;
+    if (addr + size > sizeof(_card)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, &_card[addr], size);
+    _card_reads++;
+    return 0;
+}
+
+static int _card_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                       uint32_t size)
+{
+    (void)dev;
+    if (addr + size > sizeof(_card)) {
+        return -EOVERFLOW;
+    }
+    memcpy(&_card[addr], buff, size);
+    return 0;
+}
+
+static const mtd_desc_t _card_driver = {
+    .init = _card_init,
+    .read = _card_read,
+    .write = _card_write,
+    .flags = MTD_DRIVER_FLAG_DIRECT_WRITE,
+};
+
+static mtd_dev_t _card_dev = {
+    .driver = &_card_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static mtd_bcache_t _cache = MTD_BCACHE_INIT(&_flash_dev.mtd);
+static mtd_bcache_t _card_cache = MTD_BCACHE_INIT(&_card_dev);
+static mtd_dev_t *dev = &_cache.mtd;
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < sizeof(_flash); i++) {
+        _flash[i] = i ^ (i / BLOCK_SIZE);
+    }
+    memset(_card, 0, sizeof(_card));
+    mtd_init(dev);
+    mtd_init(&_card_cache.mtd);
+    memset(&_cache.stats, 0, sizeof(_cache.stats));
+    memset(&_card_cache.stats, 0, sizeof(_card_cache.stats));
+    memset(&_flash_stats, 0, sizeof(_flash_stats));
+    _card_reads = 0;
+}
+
+static void _read_block(mtd_dev_t *mtd, uint32_t block)
+{
+    uint8_t buf[16];
+    uint32_t addr = block * BLOCK_SIZE + 7;
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(mtd, buf, addr, sizeof(buf)));
+    if (mtd == dev) {
+        TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_flash[addr], sizeof(buf)));
+    }
+}
+
+static void test_mtd_bcache_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, dev->page_size);
+    /* only erases if the backing device needs it */
+    TEST_ASSERT_EQUAL_INT(0, dev->driver->flags);
+    TEST_ASSERT_EQUAL_INT(MTD_DRIVER_FLAG_DIRECT_WRITE,
+                          _card_cache.mtd.driver->flags);
+
+    mtd_bcache_t *cache = mtd_bcache_get_first();
+    TEST_ASSERT(cache == &_card_cache);
+    TEST_ASSERT(cache->next == &_cache);
+}
+
+static void test_mtd_bcache_init_partial_block(void)
+{
+    /* size is not a multiple of the block size */
+    mtd_dev_t odd_dev = {
+        .driver = &_card_driver,
+        .sector_count = 3,
+        .pages_per_sector = 3,
+        .page_size = PAGE_SIZE,
+    };
+    mtd_bcache_t odd_cache = MTD_BCACHE_INIT(&odd_dev);
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, mtd_init(&odd_cache.mtd));
+    TEST_ASSERT(mtd_bcache_get_first() == &_card_cache);
+}
+
+static void test_mtd_bcache_hit(void)
+{
+    _read_block(dev, 3);
+    _read_block(dev, 3);
+    TEST_ASSERT_EQUAL_INT(1, _flash_stats.reads);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.misses);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.hits);
+
+    /* reads across a block boundary are served from two blocks */
+    uint8_t buf[32];
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(dev, buf, 4 * BLOCK_SIZE - 16,
+                                      sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_flash[4 * BLOCK_SIZE - 16],
+                                    sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(2, _cache.stats.hits);
+    TEST_ASSERT_EQUAL_INT(2, _cache.stats.misses);
+}
+
+static void test_mtd_bcache_readahead(void)
+{
+    for (uint32_t block = 0; block < 6; block++) {
+        _read_block(dev, block);
+    }
+    /* block 0, then blocks 1-3 and 4-6 in one request each */
+    TEST_ASSERT_EQUAL_INT(3, _flash_stats.reads);
+    TEST_ASSERT_EQUAL_INT(3, _cache.stats.misses);
+    TEST_ASSERT_EQUAL_INT(2 * CONFIG_MTD_BCACHE_READAHEAD,
+                          _cache.stats.readahead);
+    TEST_ASSERT_EQUAL_INT(3, _cache.stats.readahead_hits);
+
+    /* random access does not read ahead */
+    _read_block(dev, 12);
+    _read_block(dev, 9);
+    _read_block(dev, 13);
+    TEST_ASSERT_EQUAL_INT(2 * CONFIG_MTD_BCACHE_READAHEAD,
+                          _cache.stats.readahead);
+    /* and only up to the end of the device */
+    _read_block(dev, 14);
+    _read_block(dev, 15);
+    TEST_ASSERT_EQUAL_INT(2 * CONFIG_MTD_BCACHE_READAHEAD + 1,
+                          _cache.stats.readahead);
+    TEST_ASSERT_EQUAL_INT(7, _flash_stats.reads);
+}
+
+static void test_mtd_bcache_bypass(void)
+{
+    static uint8_t buf[2 * BLOCK_SIZE];
+
+    _read_block(dev, 3);
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(dev, buf, BLOCK_SIZE, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_flash[BLOCK_SIZE], sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(2, _flash_stats.reads);
+    TEST_ASSERT_EQUAL_INT(2, _cache.stats.bypassed);
+
+    /* up to the first cached block */
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(dev, buf, 2 * BLOCK_SIZE, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_flash[2 * BLOCK_SIZE], sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.hits);
+    TEST_ASSERT_EQUAL_INT(3, _cache.stats.bypassed);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.misses);
+}
+
+static void test_mtd_bcache_lru(void)
+{
+    /* fill the cache without sequential reads */
+    for (uint32_t i = 0; i < CONFIG_MTD_BCACHE_BLOCKS; i++) {
+        _read_block(dev, 2 * i);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _cache.stats.evictions);
+
+    /* block 0 is used again, so block 2 is replaced next */
+    _read_block(dev, 0);
+    _read_block(&_card_cache.mtd, 5);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.evictions);
+    _flash_stats.reads = 0;
+    _read_block(dev, 0);
+    TEST_ASSERT_EQUAL_INT(0, _flash_stats.reads);
+    _read_block(dev, 2);
+    TEST_ASSERT_EQUAL_INT(1, _flash_stats.reads);
+}
+
+static void test_mtd_bcache_write_flash(void)
+{
+    static const uint8_t buf[] = { 0x00, 0x0f };
+    uint8_t buf_read[sizeof(buf)];
+    const uint32_t addr = BLOCK_SIZE + 3;
+    uint8_t expected = _flash[addr + 1] & 0x0f;
+
+    _read_block(dev, 1);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(dev, buf, 0, addr,
+                                                sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0x00, _flash[addr]);
+    TEST_ASSERT_EQUAL_INT(expected, _flash[addr + 1]);
+
+    /* the flash content depends on what was there before */
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(dev, buf_read, addr, sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(0x00, buf_read[0]);
+    TEST_ASSERT_EQUAL_INT(expected, buf_read[1]);
+    TEST_ASSERT_EQUAL_INT(2, _cache.stats.misses);
+}
+
+static void test_mtd_bcache_write_card(void)
+{
+    static uint8_t buf[BLOCK_SIZE + 32];
+    uint8_t buf_read[sizeof(buf)];
+    mtd_dev_t *card = &_card_cache.mtd;
+
+    memset(buf, 0xa5, sizeof(buf));
+    _read_block(card, 0);
+    _read_block(card, 1);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(card, buf, 0, 16,
+                                                sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_card[16], buf, sizeof(buf)));
+
+    /* cached copies are updated */
+    _card_reads = 0;
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(card, buf_read, 16, sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf_read, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, _card_reads);
+    TEST_ASSERT_EQUAL_INT(0, _card[15]);
+    TEST_ASSERT_EQUAL_INT(0, _card[16 + sizeof(buf)]);
+}
+
+static void test_mtd_bcache_erase(void)
+{
+    uint8_t buf[4];
+
+    _read_block(dev, 2);
+    _read_block(dev, 6);
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase_sector(dev, 2, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(dev, buf, 2 * SECTOR_SIZE + 1,
+                                      sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0xff, buf[0]);
+    TEST_ASSERT_EQUAL_INT(0xff, buf[3]);
+    TEST_ASSERT_EQUAL_INT(3, _cache.stats.misses);
+
+    /* other blocks stay cached */
+    _read_block(dev, 6);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.hits);
+
+    mtd_bcache_invalidate(&_cache);
+    _read_block(dev, 6);
+    TEST_ASSERT_EQUAL_INT(4, _cache.stats.misses);
+}
+
+Test *tests_mtd_bcache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_bcache_init),
+        new_TestFixture(test_mtd_bcache_init_partial_block),
+        new_TestFixture(test_mtd_bcache_hit),
+        new_TestFixture(test_mtd_bcache_readahead),
+        new_TestFixture(test_mtd_bcache_bypass),
+        new_TestFixture(test_mtd_bcache_lru),
+        new_TestFixture(test_mtd_bcache_write_flash),
+        new_TestFixture(test_mtd_bcache_write_card),
+        new_TestFixture(test_mtd_bcache_erase),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_bcache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtd_bcache_tests;
+}
+
+void tests_mtd_bcache(void)
+{
+    TESTS_RUN(tests_mtd_bcache_tests());
+}
+/** @} */
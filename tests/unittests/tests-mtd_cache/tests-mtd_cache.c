@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "mtd_nor_mock.h"
+
+#include "tests-mtd_cache.h"
+
+#define SECTOR_COUNT    (4U)
+#define PAGE_PER_SECTOR (4U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+
+static uint8_t _flash[SECTOR_COUNT * SECTOR_SIZE];
+static mtd_nor_mock_stats_t _flash_stats;
+static mtd_nor_mock_t _flash_dev = MTD_NOR_MOCK_INIT(_flash, SECTOR_COUNT,
+                                                     PAGE_PER_SECTOR,
+                                                     PAGE_SIZE, &_flash_stats);
+
+static uint8_t _cache_buf[SECTOR_SIZE];
+static mtd_cache_t _cache = MTD_CACHE_INIT(&_flash_dev.mtd, _cache_buf);
+static mtd_dev_t *dev = &_cache.mtd;
+
+static void set_up(void)
+{
+    /* writes back what is left from the previous test */
+    mtd_init(dev);
+    memset(_flash, 0xff, sizeof(_flash));
+    memset(&_cache.stats, 0, sizeof(_cache.stats));
+    memset(&_flash_stats, 0, sizeof(_flash_stats));
+    _flash_dev.page_writes = true;
+}
+
+static void test_mtd_cache_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, dev->page_size);
+    TEST_ASSERT_EQUAL_INT(MTD_CACHE_SECTOR_NONE, _cache.sector);
+}
+
+static void test_mtd_cache_write_back(void)
+{
+    const char buf[] = "ABCDEFGH";
+    char buf_read[sizeof(buf)];
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, buf, PAGE_SIZE + 3, sizeof(buf)));
+    /* data is only in the cache */
+    TEST_ASSERT_EQUAL_INT(0xff, _flash[PAGE_SIZE + 3]);
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(dev, buf_read, PAGE_SIZE + 3,
+                                      sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, buf_read, sizeof(buf)));
+
+    _flash_stats.bytes_read = 0;
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_sync(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_flash[PAGE_SIZE + 3], sizeof(buf)));
+    /* the modified page is compared with the flash only once */
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _flash_stats.bytes_read);
+    /* range was erased, only the modified page is programmed */
+    TEST_ASSERT_EQUAL_INT(0, _flash_stats.erases);
+    TEST_ASSERT_EQUAL_INT(1, _flash_stats.writes);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.erases_avoided);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.pages_programmed);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.flushes);
+
+    /* nothing left to write back */
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_sync(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.flushes);
+}
+
+static void test_mtd_cache_clear_bits(void)
+{
+    const uint8_t first[] = { 0xf0, 0xff, 0x0f };
+    const uint8_t second[] = { 0x30, 0x0f, 0x03 };
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, first, 10, sizeof(first)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_sync(&_cache));
+    /* only clears bits, but the page is not programmed over */
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, second, 10, sizeof(second)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_sync(&_cache));
+
+    TEST_ASSERT_EQUAL_INT(0, memcmp(second, &_flash[10], sizeof(second)));
+    TEST_ASSERT_EQUAL_INT(1, _flash_stats.erases);
+    TEST_ASSERT_EQUAL_INT(0, _flash_stats.overwrites);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.erases_avoided);
+}
+
+static void test_mtd_cache_unmodified(void)
+{
+    const uint8_t buf[] = { 0x01, 0x02, 0x03 };
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, buf, 10, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_sync(&_cache));
+    /* same data again, nothing to program */
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, buf, 10, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_sync(&_cache));
+
+    TEST_ASSERT_EQUAL_INT(0, _flash_stats.erases);
+    TEST_ASSERT_EQUAL_INT(1, _flash_stats.writes);
+    TEST_ASSERT_EQUAL_INT(2, _cache.stats.erases_avoided);
+}
+
+static void test_mtd_cache_needs_erase(void)
+{
+    const uint8_t first[] = { 0x00, 0x00 };
+    const uint8_t second[] = { 0x55, 0xaa };
+    const uint8_t other[] = { 0x12 };
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, other, 2 * PAGE_SIZE,
+                                       sizeof(other)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, first, 0, sizeof(first)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_sync(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, second, 0, sizeof(second)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_sync(&_cache));
+
+    TEST_ASSERT_EQUAL_INT(1, _flash_stats.erases);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.erases);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(second, &_flash[0], sizeof(second)));
+    TEST_ASSERT_EQUAL_INT(0, _flash_stats.overwrites);
+    /* rest of the sector survived the erase */
+    TEST_ASSERT_EQUAL_INT(0x12, _flash[2 * PAGE_SIZE]);
+    TEST_ASSERT_EQUAL_INT(0xff, _flash[PAGE_SIZE]);
+}
+
+static void test_mtd_cache_merge(void)
+{
+    const uint8_t buf[] = { 0x00, 0x11, 0x22, 0x33 };
+
+    for (unsigned i = 0; i < PAGE_PER_SECTOR; i++) {
+        TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, buf, i * PAGE_SIZE,
+                                           sizeof(buf)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _flash_stats.writes);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, _cache.stats.writes);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR - 1, _cache.stats.writes_merged);
+
+    /* accessing another sector writes back the cached one */
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, buf, SECTOR_SIZE, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.flushes);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, _flash_stats.writes);
+    for (unsigned i = 0; i < PAGE_PER_SECTOR; i++) {
+        TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_flash[i * PAGE_SIZE],
+                                        sizeof(buf)));
+    }
+    TEST_ASSERT_EQUAL_INT(0xff, _flash[SECTOR_SIZE]);
+}
+
+static void test_mtd_cache_erase_write(void)
+{
+    uint8_t sector[SECTOR_SIZE];
+
+    /* erase and rewrite of an erased sector, as done by FatFs */
+    memset(sector, 0xff, sizeof(sector));
+    memset(sector, 0xa5, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase_sector(dev, 1, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(dev, sector, PAGE_PER_SECTOR,
+                                                0, sizeof(sector)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_power(dev, MTD_POWER_DOWN));
+
+    TEST_ASSERT_EQUAL_INT(0, _flash_stats.erases);
+    TEST_ASSERT_EQUAL_INT(1, _flash_stats.writes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(sector, &_flash[SECTOR_SIZE],
+                                    sizeof(sector)));
+
+    /* erased sector is written back as such */
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase_sector(dev, 1, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_sync(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _flash_stats.erases);
+    TEST_ASSERT_EQUAL_INT(1, _flash_stats.writes);
+    TEST_ASSERT_EQUAL_INT(0xff, _flash[SECTOR_SIZE]);
+}
+
+static void test_mtd_cache_erase_multiple(void)
+{
+    const uint8_t buf[] = { 0x42 };
+    uint8_t buf_read[sizeof(buf)];
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, buf, SECTOR_SIZE, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase_sector(dev, 0, 2));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase_sector(dev, 3, 2));
+
+    /* pending write was discarded */
+    TEST_ASSERT_EQUAL_INT(MTD_CACHE_SECTOR_NONE, _cache.sector);
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(dev, buf_read, SECTOR_SIZE,
+                                      sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(0xff, buf_read[0]);
+    TEST_ASSERT_EQUAL_INT(2, _flash_stats.erases);
+    TEST_ASSERT_EQUAL_INT(2, _cache.stats.erases);
+    TEST_ASSERT_EQUAL_INT(0, _flash_stats.writes);
+}
+
+static void test_mtd_cache_read_across_sectors(void)
+{
+    const uint8_t buf[] = { 0x01, 0x02, 0x03, 0x04 };
+    uint8_t buf_read[sizeof(buf)];
+
+    /* one half in the cached sector, the other half on the flash */
+    _flash[SECTOR_SIZE] = 0x03;
+    _flash[SECTOR_SIZE + 1] = 0x04;
+    TEST_ASSERT_EQUAL_INT(0, mtd_write(dev, buf, SECTOR_SIZE - 2, 2));
+    TEST_ASSERT_EQUAL_INT(0, mtd_read(dev, buf_read, SECTOR_SIZE - 2,
+                                      sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, buf_read, sizeof(buf)));
+}
+
+Test *tests_mtd_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_cache_init),
+        new_TestFixture(test_mtd_cache_write_back),
+        new_TestFixture(test_mtd_cache_clear_bits),
+        new_TestFixture(test_mtd_cache_unmodified),
+        new_TestFixture(test_mtd_cache_needs_erase),
+        new_TestFixture(test_mtd_cache_merge),
+        new_TestFixture(test_mtd_cache_erase_write),
+        new_TestFixture(test_mtd_cache_erase_multiple),
+        new_TestFixture(test_mtd_cache_read_across_sectors),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtd_cache_tests;
+}
+
+void tests_mtd_cache(void)
+{
+    TESTS_RUN(tests_mtd_cache_tests());
+}
+/** @} */
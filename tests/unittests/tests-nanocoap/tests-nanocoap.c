@@ -18,6 +18,7 @@
 #include <stdio.h>
 
 #include "embUnit.h"
+#include "kernel_defines.h"
 
 #include "net/nanocoap.h"
 
@@ -867,6 +868,81 @@ static void test_nanocoap__token_length_over_limit(void)
     TEST_ASSERT_EQUAL_INT(-EBADMSG, res);
 }
 
+/*
+ * Verifies that option lookup finds every option in a parsed packet carrying
+ * many options, and reports absent option numbers in between and at both ends.
+ */
+static void test_nanocoap__find_option_many(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    uint16_t msgid = 0xABCD;
+    uint8_t token[2] = {0xDA, 0xEC};
+    static const uint16_t optnums[] = {
+        COAP_OPT_URI_HOST, COAP_OPT_OBSERVE, COAP_OPT_CONTENT_FORMAT,
+        COAP_OPT_ACCEPT, COAP_OPT_BLOCK2, COAP_OPT_BLOCK1,
+        COAP_OPT_PROXY_SCHEME
+    };
+    static const uint16_t absent[] = {
+        1, COAP_OPT_LOCATION_PATH, COAP_OPT_URI_QUERY, COAP_OPT_PROXY_URI, 60
+    };
+
+    size_t len = coap_build_hdr((coap_hdr_t *)&buf[0], COAP_TYPE_CON,
+                                &token[0], 2, COAP_METHOD_GET, msgid);
+    coap_pkt_init(&pkt, &buf[0], sizeof(buf), len);
+    for (unsigned i = 0; i < ARRAY_SIZE(optnums); i++) {
+        ssize_t res = coap_opt_add_uint(&pkt, optnums[i], 100 + i);
+        TEST_ASSERT(res > 0);
+    }
+    len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+
+    memset(&pkt, 0, sizeof(pkt));
+    int res = coap_parse(&pkt, &buf[0], len);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(ARRAY_SIZE(optnums), pkt.options_len);
+
+    uint32_t value;
+    for (unsigned i = 0; i < ARRAY_SIZE(optnums); i++) {
+        res = coap_opt_get_uint(&pkt, optnums[i], &value);
+        TEST_ASSERT_EQUAL_INT(0, res);
+        TEST_ASSERT_EQUAL_INT(100 + i, value);
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(absent); i++) {
+        res = coap_opt_get_uint(&pkt, absent[i], &value);
+        TEST_ASSERT_EQUAL_INT(-ENOENT, res);
+    }
+
+    TEST_ASSERT_EQUAL_INT(102, coap_get_content_type(&pkt));
+}
+
+/*
+ * Verifies that coap_parse() rejects option numbers beyond 16 bit instead of
+ * wrapping them around.
+ */
+static void test_nanocoap__option_number_overflow(void)
+{
+    /* option delta 65535 (extended delta 0xfef2 + 269), empty value */
+    uint8_t buf_valid[] = {
+        0x40, 0x01, 0xAB, 0xCD,
+        0xE0, 0xFE, 0xF2
+    };
+    /* same option, followed by an option with delta 1 */
+    uint8_t buf_invalid[] = {
+        0x40, 0x01, 0xAB, 0xCD,
+        0xE0, 0xFE, 0xF2, 0x10
+    };
+    coap_pkt_t pkt;
+
+    int res = coap_parse(&pkt, buf_valid, sizeof(buf_valid));
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(1, pkt.options_len);
+    TEST_ASSERT_EQUAL_INT(UINT16_MAX, pkt.options[0].opt_num);
+
+    res = coap_parse(&pkt, buf_invalid, sizeof(buf_invalid));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, res);
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -895,6 +971,8 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__add_path_unterminated_string),
         new_TestFixture(test_nanocoap__add_get_proxy_uri),
         new_TestFixture(test_nanocoap__token_length_over_limit),
+        new_TestFixture(test_nanocoap__find_option_many),
+        new_TestFixture(test_nanocoap__option_number_overflow),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_nor_mock.h"
+#include "recordlog.h"
+
+#include "tests-recordlog.h"
+
+#define SECTOR_COUNT    (4U)
+#define PAGE_PER_SECTOR (4U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+
+static uint8_t _flash[SECTOR_COUNT * SECTOR_SIZE];
+static mtd_nor_mock_stats_t _stats;
+static mtd_nor_mock_t _dev = MTD_NOR_MOCK_INIT(_flash, SECTOR_COUNT,
+                                               PAGE_PER_SECTOR, PAGE_SIZE,
+                                               &_stats);
+
+static recordlog_t _log;
+static uint8_t _page_buf[PAGE_SIZE];
+
+static void set_up(void)
+{
+    memset(_flash, 0xff, sizeof(_flash));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+/* appends @p num records of 3 to 20 bytes with predictable content */
+static void _append(uint32_t first, uint32_t num)
+{
+    for (uint32_t i = first; i < first + num; i++) {
+        uint8_t rec[20];
+        uint32_t seq;
+
+        memset(rec, i, sizeof(rec));
+        TEST_ASSERT_EQUAL_INT(0, recordlog_append(&_log, rec, 3 + i % 18,
+                                                  &seq));
+        TEST_ASSERT_EQUAL_INT(i, seq);
+    }
+}
+
+/* checks that the log holds the records @p first to @p end - 1 */
+static void _check(uint32_t first, uint32_t end)
+{
+    recordlog_iter_t iter;
+    uint8_t buf[20];
+    uint32_t seq;
+    ssize_t len;
+
+    recordlog_iter_init(&_log, &iter);
+    for (uint32_t i = first; i < end; i++) {
+        len = recordlog_iter_next(&_log, &iter, buf, sizeof(buf), &seq);
+        TEST_ASSERT_EQUAL_INT(3 + i % 18, len);
+        TEST_ASSERT_EQUAL_INT(i, seq);
+        TEST_ASSERT_EQUAL_INT(i & 0xff, buf[0]);
+        TEST_ASSERT_EQUAL_INT(i & 0xff, buf[len - 1]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, recordlog_iter_next(&_log, &iter, buf,
+                                                 sizeof(buf), &seq));
+}
+
+static void test_recordlog_empty(void)
+{
+    recordlog_iter_t iter;
+    uint8_t buf[4];
+
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    recordlog_iter_init(&_log, &iter);
+    TEST_ASSERT_EQUAL_INT(0, recordlog_iter_next(&_log, &iter, buf,
+                                                 sizeof(buf), NULL));
+    TEST_ASSERT_EQUAL_INT(0, _stats.erases);
+}
+
+static void test_recordlog_append_iter(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _append(0, 40);
+    _check(0, 40);
+    TEST_ASSERT_EQUAL_INT(0, _stats.overwrites);
+}
+
+static void test_recordlog_batching(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+
+    /* the first records stay in the page buffer */
+    _append(0, 3);
+    TEST_ASSERT_EQUAL_INT(0, _stats.writes);
+    _check(0, 3);
+
+    /* flushing programs them, flushing again does nothing */
+    TEST_ASSERT_EQUAL_INT(0, recordlog_flush(&_log));
+    TEST_ASSERT_EQUAL_INT(0, recordlog_flush(&_log));
+    TEST_ASSERT_EQUAL_INT(1, _stats.writes);
+
+    /* later programs of the page only add the new bytes */
+    _append(3, 4);
+    TEST_ASSERT_EQUAL_INT(2, _stats.writes);
+    TEST_ASSERT_EQUAL_INT(0, _stats.overwrites);
+    _check(0, 7);
+}
+
+static void test_recordlog_recover(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _append(0, 30);
+    TEST_ASSERT_EQUAL_INT(0, recordlog_flush(&_log));
+
+    memset(&_log, 0, sizeof(_log));
+    memset(_page_buf, 0, sizeof(_page_buf));
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _check(0, 30);
+
+    /* the log continues in the partly programmed page */
+    _append(30, 5);
+    TEST_ASSERT_EQUAL_INT(0, recordlog_flush(&_log));
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _check(0, 35);
+    TEST_ASSERT_EQUAL_INT(0, _stats.overwrites);
+}
+
+static void test_recordlog_unflushed(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    /* records 0-3 and the start of 4 fill the first page */
+    _append(0, 7);
+    TEST_ASSERT_EQUAL_INT(1, _stats.writes);
+
+    /* the rest is lost, the log continues after the torn record 4 */
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _check(0, 4);
+    _append(4, 3);
+    TEST_ASSERT_EQUAL_INT(1, _log.sector);
+    _check(0, 7);
+}
+
+static void test_recordlog_wrap(void)
+{
+    recordlog_iter_t iter;
+    uint8_t buf[20];
+    uint32_t seq;
+
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    recordlog_iter_init(&_log, &iter);
+    TEST_ASSERT_EQUAL_INT(0, recordlog_iter_next(&_log, &iter, buf,
+                                                 sizeof(buf), &seq));
+
+    _append(0, 300);
+    TEST_ASSERT(_stats.erases > 0);
+    TEST_ASSERT_EQUAL_INT(0, _stats.overwrites);
+
+    /* the oldest records are gone, the iteration continues after them */
+    TEST_ASSERT(recordlog_iter_next(&_log, &iter, buf, sizeof(buf), &seq) > 0);
+    TEST_ASSERT(seq > 0);
+    TEST_ASSERT_EQUAL_INT(_log.first_seq, seq);
+
+    _check(_log.first_seq, 300);
+
+    TEST_ASSERT_EQUAL_INT(0, recordlog_flush(&_log));
+    uint32_t first = _log.first_seq;
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _check(first, 300);
+}
+
+static void test_recordlog_torn(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _append(0, 10);
+    TEST_ASSERT_EQUAL_INT(0, recordlog_flush(&_log));
+
+    /* the last record was not completely programmed */
+    uint32_t end = _log.pos;
+    _flash[end - 2] = 0xff;
+
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _check(0, 9);
+
+    /* the log continues in the next sector */
+    _append(9, 5);
+    TEST_ASSERT_EQUAL_INT(1, _log.sector);
+    TEST_ASSERT_EQUAL_INT(0, recordlog_flush(&_log));
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _check(0, 14);
+}
+
+static void test_recordlog_garbage(void)
+{
+    /* a device that contained something else */
+    memset(_flash, 0x5a, sizeof(_flash));
+
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _check(0, 0);
+    TEST_ASSERT_EQUAL_INT(1, _stats.erases);
+
+    _append(0, 10);
+    TEST_ASSERT_EQUAL_INT(0, recordlog_flush(&_log));
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _check(0, 10);
+}
+
+static void test_recordlog_size(void)
+{
+    static uint8_t rec[SECTOR_SIZE];
+    uint32_t seq;
+
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, recordlog_append(&_log, rec,
+                          SECTOR_SIZE - RECORDLOG_HDR_SIZE + 1, NULL));
+
+    /* a record that does not fit goes to the next sector */
+    TEST_ASSERT_EQUAL_INT(0, recordlog_append(&_log, rec, 4, NULL));
+    memset(rec, 0x42, sizeof(rec));
+    TEST_ASSERT_EQUAL_INT(0, recordlog_append(&_log, rec,
+                          SECTOR_SIZE - RECORDLOG_HDR_SIZE, &seq));
+    TEST_ASSERT_EQUAL_INT(1, seq);
+    TEST_ASSERT_EQUAL_INT(1, _log.sector);
+
+    recordlog_iter_t iter;
+    recordlog_iter_init(&_log, &iter);
+    TEST_ASSERT_EQUAL_INT(4, recordlog_iter_next(&_log, &iter, rec,
+                                                 sizeof(rec), NULL));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, recordlog_iter_next(&_log, &iter, rec,
+                                                        16, NULL));
+    memset(rec, 0, sizeof(rec));
+    TEST_ASSERT_EQUAL_INT(SECTOR_SIZE - RECORDLOG_HDR_SIZE,
+                          recordlog_iter_next(&_log, &iter, rec, sizeof(rec),
+                                              &seq));
+    TEST_ASSERT_EQUAL_INT(1, seq);
+    TEST_ASSERT_EQUAL_INT(0x42, rec[SECTOR_SIZE - RECORDLOG_HDR_SIZE - 1]);
+}
+
+static void test_recordlog_erase(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, recordlog_init(&_log, &_dev.mtd, _page_buf));
+    _append(0, 50);
+    TEST_ASSERT_EQUAL_INT(0, recordlog_erase(&_log));
+    _check(50, 50);
+
+    /* the sequence numbers continue */
+    _append(50, 3);
+    _check(50, 53);
+}
+
+Test *tests_recordlog_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_recordlog_empty),
+        new_TestFixture(test_recordlog_append_iter),
+        new_TestFixture(test_recordlog_batching),
+        new_TestFixture(test_recordlog_recover),
+        new_TestFixture(test_recordlog_unflushed),
+        new_TestFixture(test_recordlog_wrap),
+        new_TestFixture(test_recordlog_torn),
+        new_TestFixture(test_recordlog_garbage),
+        new_TestFixture(test_recordlog_size),
+        new_TestFixture(test_recordlog_erase),
+    };
+
+    EMB_UNIT_TESTCALLER(recordlog_tests, set_up, NULL, fixtures);
+
+    return (Test *)&recordlog_tests;
+}
+
+void tests_recordlog(void)
+{
+    TESTS_RUN(tests_recordlog_tests());
+}
+/** @} */
@@ -150,6 +150,30 @@ static void test_vfs_null_file_ops_write(void)
     TEST_ASSERT_EQUAL_INT(-EFAULT, res);
 }
 
+static void test_vfs_null_file_ops_readv(void)
+{
+    TEST_ASSERT(_test_vfs_file_op_my_fd >= 0);
+    uint8_t buf[8];
+    iolist_t iol = { .iol_base = buf, .iol_len = sizeof(buf) };
+    int res = vfs_readv(_test_vfs_file_op_my_fd, &iol);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, res);
+    iol.iol_base = NULL;
+    res = vfs_readv(_test_vfs_file_op_my_fd, &iol);
+    TEST_ASSERT_EQUAL_INT(-EFAULT, res);
+}
+
+static void test_vfs_null_file_ops_writev(void)
+{
+    TEST_ASSERT(_test_vfs_file_op_my_fd >= 0);
+    static const char buf[] = "Unit test";
+    iolist_t iol = { .iol_base = (void *)buf, .iol_len = sizeof(buf) };
+    int res = vfs_writev(_test_vfs_file_op_my_fd, &iol);
+    TEST_ASSERT_EQUAL_INT(-EBADF, res);
+    iol.iol_base = NULL;
+    res = vfs_writev(_test_vfs_file_op_my_fd, &iol);
+    TEST_ASSERT_EQUAL_INT(-EFAULT, res);
+}
+
 Test *tests_vfs_null_file_ops_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -159,6 +183,8 @@ Test *tests_vfs_null_file_ops_tests(void)
         new_TestFixture(test_vfs_null_file_ops_fstat),
         new_TestFixture(test_vfs_null_file_ops_read),
         new_TestFixture(test_vfs_null_file_ops_write),
+        new_TestFixture(test_vfs_null_file_ops_readv),
+        new_TestFixture(test_vfs_null_file_ops_writev),
     };
 
     EMB_UNIT_TESTCALLER(vfs_file_op_tests, setup, teardown, fixtures);
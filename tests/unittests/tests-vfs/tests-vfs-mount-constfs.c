@@ -171,6 +171,134 @@ static void test_vfs_constfs_read_lseek(void)
     TEST_ASSERT_EQUAL_INT(0, res);
 }
 
+static void _readv(vfs_mount_t *mountp)
+{
+    int res;
+    res = vfs_mount(mountp);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    int fd = vfs_open("/test/data.bin", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+
+    uint8_t head[3], body[20], tail[16];
+    iolist_t iol_tail = { .iol_base = tail, .iol_len = sizeof(tail) };
+    iolist_t iol_empty = { .iol_next = &iol_tail };
+    iolist_t iol_body = { .iol_next = &iol_empty, .iol_base = body,
+                          .iol_len = sizeof(body) };
+    iolist_t iol_head = { .iol_next = &iol_body, .iol_base = head,
+                          .iol_len = sizeof(head) };
+
+    /* the last buffer is only filled up to the end of the file */
+    ssize_t nbytes = vfs_readv(fd, &iol_head);
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data), nbytes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(head, bin_data, sizeof(head)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(body, &bin_data[sizeof(head)],
+                                    sizeof(body)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(tail, &bin_data[sizeof(head) + sizeof(body)],
+                                    sizeof(bin_data) - sizeof(head) - sizeof(body)));
+    nbytes = vfs_readv(fd, &iol_head);
+    TEST_ASSERT_EQUAL_INT(0, nbytes);
+
+    vfs_lseek(fd, sizeof(bin_data) - 2, SEEK_SET);
+    nbytes = vfs_readv(fd, &iol_head);
+    TEST_ASSERT_EQUAL_INT(2, nbytes);
+    TEST_ASSERT_EQUAL_INT(0xFE, head[0]);
+    TEST_ASSERT_EQUAL_INT(0xFF, head[1]);
+
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    res = vfs_umount(mountp);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
+static void test_vfs_constfs_readv(void)
+{
+    _readv(&_test_vfs_mount);
+}
+
+static void test_vfs_constfs_readv__fallback(void)
+{
+    /* constfs without its readv() hook */
+    static vfs_file_ops_t file_ops;
+    static vfs_file_system_t fs;
+    vfs_mount_t mount = {
+        .mount_point = "/test",
+        .fs = &fs,
+        .private_data = (void *)&fs_data,
+    };
+
+    file_ops = *constfs_file_system.f_op;
+    file_ops.readv = NULL;
+    fs = constfs_file_system;
+    fs.f_op = &file_ops;
+
+    _readv(&mount);
+}
+
+typedef struct {
+    uint8_t buf[sizeof(bin_data)];
+    size_t len;
+    size_t max_per_call;
+    size_t limit;
+} _sink_t;
+
+static ssize_t _sink(void *arg, const void *data, size_t len)
+{
+    _sink_t *sink = arg;
+
+    if (len > sink->max_per_call) {
+        len = sink->max_per_call;
+    }
+    if (len > sink->limit - sink->len) {
+        len = sink->limit - sink->len;
+    }
+    memcpy(&sink->buf[sink->len], data, len);
+    sink->len += len;
+    return len;
+}
+
+static void test_vfs_constfs_sendfile(void)
+{
+    int res;
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    int fd = vfs_open("/test/data.bin", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+
+    uint8_t chunk[5];
+    _sink_t sink = { .max_per_call = 3, .limit = sizeof(sink.buf) };
+
+    /* partial writes of the sink are resubmitted */
+    ssize_t nbytes = vfs_sendfile(fd, SIZE_MAX, chunk, sizeof(chunk),
+                                  _sink, &sink);
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data), nbytes);
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data), sink.len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(sink.buf, bin_data, sizeof(bin_data)));
+
+    /* a sink that stops leaves the position after the last byte consumed */
+    vfs_lseek(fd, 0, SEEK_SET);
+    sink.len = 0;
+    sink.limit = 7;
+    nbytes = vfs_sendfile(fd, SIZE_MAX, chunk, sizeof(chunk), _sink, &sink);
+    TEST_ASSERT_EQUAL_INT(7, nbytes);
+    TEST_ASSERT_EQUAL_INT(7, vfs_lseek(fd, 0, SEEK_CUR));
+
+    /* count limits the transfer */
+    sink.len = 0;
+    sink.limit = sizeof(sink.buf);
+    nbytes = vfs_sendfile(fd, 4, chunk, sizeof(chunk), _sink, &sink);
+    TEST_ASSERT_EQUAL_INT(4, nbytes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(sink.buf, &bin_data[7], 4));
+
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    res = vfs_umount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
 #if MODULE_NEWLIB || MODULE_PICOLIBC || defined(BOARD_NATIVE)
 static void test_vfs_constfs__posix(void)
 {
@@ -210,6 +338,9 @@ Test *tests_vfs_mount_constfs_tests(void)
         new_TestFixture(test_vfs_umount__invalid_mount),
         new_TestFixture(test_vfs_constfs_open),
         new_TestFixture(test_vfs_constfs_read_lseek),
+        new_TestFixture(test_vfs_constfs_readv),
+        new_TestFixture(test_vfs_constfs_readv__fallback),
+        new_TestFixture(test_vfs_constfs_sendfile),
 #if MODULE_NEWLIB || MODULE_PICOLIBC || defined(BOARD_NATIVE)
         new_TestFixture(test_vfs_constfs__posix),
 #endif
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2021 RIOT Developers
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the mount point lookup and fd allocation
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "embUnit/embUnit.h"
+
+#include "vfs.h"
+#include "fs/constfs.h"
+
+#include "tests-vfs.h"
+
+static const uint8_t _data[] = "lookup";
+
+static const constfs_file_t _files[] = {
+    {
+        .path = "/f",
+        .data = _data,
+        .size = sizeof(_data),
+    },
+};
+
+static const constfs_t _fs_data = {
+    .files = _files,
+    .nfiles = ARRAY_SIZE(_files),
+};
+
+/* nested and sibling mount points of different lengths */
+static const char *_mount_points[] = {
+    "/l", "/l/n", "/l/n/m", "/lo", "/lookup", "/l/nested", "/l/n/m/deep",
+    "/x",
+};
+
+/* more mounts than fit into the lookup table by default */
+#define MOUNT_NUM   ARRAY_SIZE(_mount_points)
+
+static vfs_mount_t _mounts[MOUNT_NUM];
+
+static void _mount(unsigned num)
+{
+    for (unsigned i = 0; i < num; i++) {
+        _mounts[i].mount_point = _mount_points[i];
+        _mounts[i].fs = &constfs_file_system;
+        _mounts[i].private_data = (void *)&_fs_data;
+        TEST_ASSERT_EQUAL_INT(0, vfs_mount(&_mounts[i]));
+    }
+}
+
+static void _umount(unsigned num)
+{
+    for (unsigned i = 0; i < num; i++) {
+        TEST_ASSERT_EQUAL_INT(0, vfs_umount(&_mounts[i]));
+    }
+}
+
+/* returns the index of the mount point a path resolves to */
+static int _resolve(const char *mount_point)
+{
+    char path[VFS_NAME_MAX + 1];
+    int res;
+
+    strcpy(path, mount_point);
+    strcat(path, "/f");
+
+    int fd = vfs_open(path, O_RDONLY, 0);
+    if (fd < 0) {
+        return fd;
+    }
+    const vfs_file_t *filp = vfs_file_get(fd);
+    res = filp->mp - _mounts;
+    vfs_close(fd);
+    return res;
+}
+
+static void test_vfs_mount_lookup__longest_prefix(void)
+{
+    _mount(MOUNT_NUM);
+
+    for (unsigned i = 0; i < MOUNT_NUM; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _resolve(_mount_points[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOENT, _resolve("/nothing"));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, _resolve("/loo"));
+
+    _umount(MOUNT_NUM);
+}
+
+static void test_vfs_mount_lookup__umount(void)
+{
+    _mount(2);
+
+    /* "/l/n" is resolved to "/l" once it is unmounted */
+    TEST_ASSERT_EQUAL_INT(1, _resolve("/l/n"));
+    TEST_ASSERT_EQUAL_INT(0, vfs_umount(&_mounts[1]));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, _resolve("/l/n"));
+
+    /* a mount with open files stays in the lookup */
+    int fd = vfs_open("/l/f", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(-EBUSY, vfs_umount(&_mounts[0]));
+    TEST_ASSERT_EQUAL_INT(0, _resolve("/l"));
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+
+    TEST_ASSERT_EQUAL_INT(0, vfs_umount(&_mounts[0]));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, _resolve("/l"));
+}
+
+static void test_vfs_fd_alloc(void)
+{
+    int fds[VFS_MAX_OPEN_FILES];
+    unsigned num = 0;
+    int fd;
+
+    _mount(1);
+
+    /* fill the table, stdio numbers are never handed out */
+    while ((fd = vfs_open("/l/f", O_RDONLY, 0)) >= 0) {
+        TEST_ASSERT(fd > STDERR_FILENO);
+        TEST_ASSERT(num < ARRAY_SIZE(fds));
+        fds[num++] = fd;
+    }
+    TEST_ASSERT_EQUAL_INT(-ENFILE, fd);
+    TEST_ASSERT_EQUAL_INT(num, atomic_load(&_mounts[0].open_files));
+
+    /* the lowest free fd is reused */
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fds[1]));
+    fd = vfs_open("/l/f", O_RDONLY, 0);
+    TEST_ASSERT_EQUAL_INT(fds[1], fd);
+
+    for (unsigned i = 0; i < num; i++) {
+        TEST_ASSERT_EQUAL_INT(0, vfs_close(fds[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-EBADF, vfs_close(fds[0]));
+
+    _umount(1);
+}
+
+Test *tests_vfs_mount_lookup_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_vfs_mount_lookup__longest_prefix),
+        new_TestFixture(test_vfs_mount_lookup__umount),
+        new_TestFixture(test_vfs_fd_alloc),
+    };
+
+    EMB_UNIT_TESTCALLER(vfs_mount_lookup_tests, NULL, NULL, fixtures);
+
+    return (Test *)&vfs_mount_lookup_tests;
+}
+
+/** @} */